@@ -50,6 +50,7 @@ set(MongoDB_INCLUDE_DIRS
     ${MongoDB_DIR}/src/third_party/mozjs-45/include
     ${MongoDB_DIR}/src/third_party/mozjs-45/mongo_sources
     ${MongoDB_DIR}/src/third_party/pcre-8.39
+    ${MongoDB_DIR}/src/third_party/zlib-1.2.8
     ${MongoDB_BUILD_DIR}
 )
 
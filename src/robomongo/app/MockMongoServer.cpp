@@ -0,0 +1,684 @@
+#include "robomongo/app/MockMongoServer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#include <QPointer>
+#include <QThread>
+#include <QTimer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QtEndian>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    // Wire protocol op codes
+    enum OpCode {
+        OpReply = 1,
+        OpUpdate = 2001,
+        OpInsert = 2002,
+        OpQuery = 2004,
+        OpGetMore = 2005,
+        OpDelete = 2006,
+        OpKillCursors = 2007,
+        OpMsg = 2013
+    };
+
+    enum { HeaderSize = 16, CursorNotFound = 1, MaxBsonObjectSize = 16 * 1024 * 1024 };
+
+    int readInt32(const char *data)
+    {
+        return qFromLittleEndian<qint32>(reinterpret_cast<const uchar*>(data));
+    }
+
+    long long readInt64(const char *data)
+    {
+        return qFromLittleEndian<qint64>(reinterpret_cast<const uchar*>(data));
+    }
+
+    void appendInt32(QByteArray &buffer, int value)
+    {
+        char data[4];
+        qToLittleEndian<qint32>(value, reinterpret_cast<uchar*>(data));
+        buffer.append(data, sizeof(data));
+    }
+
+    void appendInt64(QByteArray &buffer, long long value)
+    {
+        char data[8];
+        qToLittleEndian<qint64>(value, reinterpret_cast<uchar*>(data));
+        buffer.append(data, sizeof(data));
+    }
+
+    /**
+     * @brief Read BSON document at 'data' and advance 'data' past it.
+     *        Returns empty object if document does not fit into [data, end).
+     */
+    mongo::BSONObj readDocument(const char *&data, const char *end)
+    {
+        if (end - data < 5)
+            return mongo::BSONObj();
+
+        int const size = readInt32(data);
+        if (size < 5 || size > end - data)
+            return mongo::BSONObj();
+
+        mongo::BSONObj obj = mongo::BSONObj(data).getOwned();
+        data += size;
+        return obj;
+    }
+
+    std::string readCString(const char *&data, const char *end)
+    {
+        const char *zero = static_cast<const char*>(memchr(data, 0, end - data));
+        if (!zero)
+            return std::string();
+
+        std::string result(data, zero);
+        data = zero + 1;
+        return result;
+    }
+
+    std::string toLower(std::string text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+        return text;
+    }
+
+    std::string databaseName(const std::string &ns)
+    {
+        return ns.substr(0, ns.find('.'));
+    }
+
+    /**
+     * @brief Top-level equality match. Operators (fields starting with '$') are ignored.
+     */
+    bool matches(const mongo::BSONObj &doc, const mongo::BSONObj &filter)
+    {
+        mongo::BSONObjIterator it(filter);
+        while (it.more()) {
+            mongo::BSONElement expected = it.next();
+            if (expected.fieldName()[0] == '$')
+                continue;
+
+            mongo::BSONElement actual = doc.getField(expected.fieldName());
+            if (actual.eoo() || actual.woCompare(expected, false) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    mongo::BSONObj generateDocument(int index, std::mt19937 &random)
+    {
+        static const char *const categories[] = { "alpha", "beta", "gamma", "delta" };
+        std::uniform_real_distribution<double> price(0, 1000);
+        std::uniform_int_distribution<int> category(0, 3);
+
+        mongo::BSONObjBuilder builder;
+        builder.append("_id", index);
+        builder.append("name", "document-" + std::to_string(index));
+        builder.append("category", categories[category(random)]);
+        builder.append("price", price(random));
+        builder.appendDate("createdAt", mongo::Date_t::fromMillisSinceEpoch(1500000000000LL + index * 1000LL));
+
+        mongo::BSONObjBuilder nested(builder.subobjStart("details"));
+        nested.append("index", index);
+        nested.append("even", index % 2 == 0);
+        nested.done();
+
+        mongo::BSONArrayBuilder tags(builder.subarrayStart("tags"));
+        for (int i = 0; i < index % 4; ++i)
+            tags.append("tag" + std::to_string(i));
+        tags.done();
+
+        return builder.obj();
+    }
+}
+
+namespace Robomongo
+{
+    MockMongoServer::MockMongoServer(const MockMongoServerOptions &options) :
+        _thread(new QThread),
+        _worker(new MockMongoServerWorker(options))
+    {
+        _worker->moveToThread(_thread);
+        VERIFY(QObject::connect(_thread, SIGNAL(finished()), _worker, SLOT(deleteLater())));
+    }
+
+    MockMongoServer::~MockMongoServer()
+    {
+        if (_thread->isRunning()) {
+            stop();
+            _thread->quit();    // worker is deleted on thread's finished() signal
+            _thread->wait();
+        }
+        else {
+            delete _worker;
+        }
+        delete _thread;
+    }
+
+    void MockMongoServer::addCollection(const std::string &ns, int count, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        MockMongoServerWorker::Documents documents;
+        documents.reserve(count);
+        for (int i = 0; i < count; ++i)
+            documents.push_back(generateDocument(i, random));
+
+        _worker->addCollection(ns, documents);
+    }
+
+    quint16 MockMongoServer::start(quint16 port)
+    {
+        if (!_thread->isRunning())
+            _thread->start();
+
+        int result = 0;
+        QMetaObject::invokeMethod(_worker, "listen", Qt::BlockingQueuedConnection,
+                                  Q_RETURN_ARG(int, result), Q_ARG(int, port));
+        return static_cast<quint16>(result);
+    }
+
+    void MockMongoServer::stop()
+    {
+        if (_thread->isRunning())
+            QMetaObject::invokeMethod(_worker, "close", Qt::BlockingQueuedConnection);
+    }
+
+    int MockMongoServer::count(const std::string &ns) const
+    {
+        return _worker->count(ns);
+    }
+
+    int MockMongoServer::requestsCount() const
+    {
+        return _worker->requestsCount();
+    }
+
+    MockMongoServerWorker::MockMongoServerWorker(const MockMongoServerOptions &options) :
+        _options(options),
+        _server(nullptr),
+        _nextCursorId(1),
+        _nextRequestId(1),
+        _requestsCount(0)
+    {
+    }
+
+    void MockMongoServerWorker::addCollection(const std::string &ns, const Documents &documents)
+    {
+        QMutexLocker lock(&_mutex);
+        _collections[ns] = documents;
+    }
+
+    int MockMongoServerWorker::count(const std::string &ns) const
+    {
+        QMutexLocker lock(&_mutex);
+        auto const it = _collections.find(ns);
+        return it == _collections.end() ? 0 : static_cast<int>(it->second.size());
+    }
+
+    int MockMongoServerWorker::requestsCount() const
+    {
+        QMutexLocker lock(&_mutex);
+        return _requestsCount;
+    }
+
+    int MockMongoServerWorker::listen(int port)
+    {
+        if (!_server) {
+            _server = new QTcpServer(this);
+            VERIFY(connect(_server, SIGNAL(newConnection()), this, SLOT(onNewConnection())));
+        }
+
+        if (!_server->isListening() && !_server->listen(QHostAddress::LocalHost, static_cast<quint16>(port)))
+            return 0;
+
+        return _server->serverPort();
+    }
+
+    void MockMongoServerWorker::close()
+    {
+        if (_server)
+            _server->close();
+
+        for (QTcpSocket *socket : _buffers.keys())
+            socket->abort();
+    }
+
+    void MockMongoServerWorker::onNewConnection()
+    {
+        while (QTcpSocket *socket = _server->nextPendingConnection()) {
+            _buffers.insert(socket, QByteArray());
+            VERIFY(connect(socket, SIGNAL(readyRead()), this, SLOT(onReadyRead())));
+            VERIFY(connect(socket, SIGNAL(disconnected()), socket, SLOT(deleteLater())));
+            VERIFY(connect(socket, &QObject::destroyed, this, [this, socket]() { _buffers.remove(socket); }));
+        }
+    }
+
+    void MockMongoServerWorker::onReadyRead()
+    {
+        QTcpSocket *socket = qobject_cast<QTcpSocket*>(sender());
+        if (!socket)
+            return;
+
+        QByteArray &buffer = _buffers[socket];
+        buffer.append(socket->readAll());
+
+        // Process every complete message in buffer
+        while (buffer.size() >= HeaderSize) {
+            int const size = readInt32(buffer.constData());
+            if (size < HeaderSize || size > 2 * MaxBsonObjectSize) {
+                socket->abort();
+                return;
+            }
+
+            if (buffer.size() < size)
+                break;
+
+            handleMessage(socket, buffer.constData(), size);
+            buffer.remove(0, size);
+        }
+    }
+
+    void MockMongoServerWorker::handleMessage(QTcpSocket *socket, const char *message, int size)
+    {
+        {
+            QMutexLocker lock(&_mutex);
+            ++_requestsCount;
+        }
+
+        int const requestId = readInt32(message + 4);
+        int const opCode = readInt32(message + 12);
+        const char *body = message + HeaderSize;
+        const char *end = message + size;
+
+        switch (opCode) {
+        case OpQuery: handleQuery(socket, requestId, body, end); break;
+        case OpGetMore: handleGetMore(socket, requestId, body, end); break;
+        case OpInsert: handleInsert(body, end); break;
+        case OpKillCursors: handleKillCursors(body, end); break;
+        case OpMsg: handleMsg(socket, requestId, body, end); break;
+        default: break; // OP_UPDATE, OP_DELETE and others are not supported and have no reply
+        }
+    }
+
+    void MockMongoServerWorker::handleQuery(QTcpSocket *socket, int requestId, const char *body, const char *end)
+    {
+        body += 4; // flags
+        std::string const ns = readCString(body, end);
+        int const numberToSkip = readInt32(body);
+        int const numberToReturn = readInt32(body + 4);
+        body += 8;
+        mongo::BSONObj query = readDocument(body, end);
+
+        // Command
+        std::string const cmdSuffix = ".$cmd";
+        if (ns.size() > cmdSuffix.size() && ns.compare(ns.size() - cmdSuffix.size(), cmdSuffix.size(), cmdSuffix) == 0) {
+            // Commands may be wrapped, i.e. { $query: { isMaster: 1 }, $readPreference: {...} }
+            if (query.hasField("$query"))
+                query = query.getObjectField("$query");
+            sendReply(socket, requestId, { runCommand(databaseName(ns), query) });
+            return;
+        }
+
+        // Query may be wrapped, i.e. { $query: {...}, $orderby: {...} }
+        mongo::BSONObj filter = query;
+        if (query.hasField("$query"))
+            filter = query.getObjectField("$query");
+        else if (query.hasField("query") && query.getField("query").isABSONObj())
+            filter = query.getObjectField("query");
+
+        // Negative numberToReturn means "single batch, close cursor"
+        int const limit = numberToReturn < 0 ? -numberToReturn : 0;
+        long long cursorId = openCursor(ns, filter, numberToSkip, limit);
+        int const batchSize = numberToReturn == 0 ? _options.maxBatchSize : std::abs(numberToReturn);
+
+        Documents batch;
+        cursorId = nextBatch(cursorId, batchSize, batch);
+        sendReply(socket, requestId, batch, cursorId);
+    }
+
+    void MockMongoServerWorker::handleGetMore(QTcpSocket *socket, int requestId, const char *body, const char *end)
+    {
+        body += 4; // ZERO
+        readCString(body, end); // ns
+        int const numberToReturn = readInt32(body);
+        long long cursorId = readInt64(body + 4);
+
+        bool exists = false;
+        {
+            QMutexLocker lock(&_mutex);
+            exists = _cursors.count(cursorId) > 0;
+        }
+
+        if (!exists) {
+            sendReply(socket, requestId, Documents(), 0, 0, CursorNotFound);
+            return;
+        }
+
+        Documents batch;
+        cursorId = nextBatch(cursorId, numberToReturn == 0 ? _options.maxBatchSize : std::abs(numberToReturn), batch);
+        sendReply(socket, requestId, batch, cursorId);
+    }
+
+    void MockMongoServerWorker::handleInsert(const char *body, const char *end)
+    {
+        body += 4; // flags
+        std::string const ns = readCString(body, end);
+
+        QMutexLocker lock(&_mutex);
+        Documents &collection = _collections[ns];
+        while (body < end) {
+            mongo::BSONObj doc = readDocument(body, end);
+            if (doc.isEmpty())
+                break;
+            collection.push_back(doc);
+        }
+    }
+
+    void MockMongoServerWorker::handleKillCursors(const char *body, const char *end)
+    {
+        body += 4; // ZERO
+        int const count = readInt32(body);
+        body += 4;
+
+        QMutexLocker lock(&_mutex);
+        for (int i = 0; i < count && body + 8 <= end; ++i, body += 8)
+            _cursors.erase(readInt64(body));
+    }
+
+    void MockMongoServerWorker::handleMsg(QTcpSocket *socket, int requestId, const char *body, const char *end)
+    {
+        unsigned const flags = static_cast<unsigned>(readInt32(body));
+        body += 4;
+        if (flags & 1)      // checksumPresent
+            end -= 4;
+
+        mongo::BSONObj command;
+        std::map<std::string, Documents> sequences;
+        while (body < end) {
+            char const kind = *body++;
+            if (kind == 0) {        // Body
+                command = readDocument(body, end);
+            }
+            else if (kind == 1) {   // Document sequence
+                const char *sectionEnd = body + readInt32(body);
+                body += 4;
+                Documents &documents = sequences[readCString(body, sectionEnd)];
+                while (body < sectionEnd) {
+                    mongo::BSONObj doc = readDocument(body, sectionEnd);
+                    if (doc.isEmpty())
+                        break;
+                    documents.push_back(doc);
+                }
+                body = sectionEnd;
+            }
+            else {
+                break;
+            }
+        }
+
+        mongo::BSONObj const reply = runCommand(command.getStringField("$db"), command, sequences);
+
+        // moreToCome: client does not expect reply
+        if (!(flags & 2))
+            sendMsg(socket, requestId, reply);
+    }
+
+    mongo::BSONObj MockMongoServerWorker::runCommand(const std::string &db, const mongo::BSONObj &command,
+                                                     const std::map<std::string, Documents> &sequences)
+    {
+        mongo::BSONObjBuilder reply;
+        mongo::BSONElement const first = command.firstElement();
+        std::string const name = toLower(first.fieldName());
+
+        if (name == "ismaster" || name == "hello") {
+            reply.append("ismaster", true);
+            reply.append("maxBsonObjectSize", static_cast<int>(MaxBsonObjectSize));
+            reply.append("maxMessageSizeBytes", 48000000);
+            reply.append("maxWriteBatchSize", 1000);
+            reply.appendDate("localTime", mongo::Date_t::now());
+            reply.append("maxWireVersion", _options.maxWireVersion);
+            reply.append("minWireVersion", 0);
+        }
+        else if (name == "ping" || name == "getlasterror" || name == "getnonce" || name == "whatsmyuri") {
+            if (name == "getlasterror") {
+                reply.append("n", 0);
+                reply.appendNull("err");
+            }
+        }
+        else if (name == "buildinfo") {
+            reply.append("version", _options.version);
+            mongo::BSONArrayBuilder versionArray(reply.subarrayStart("versionArray"));
+            for (QString const& part : QtUtils::toQString(_options.version).split('.'))
+                versionArray.append(part.toInt());
+            versionArray.done();
+        }
+        else if (name == "serverstatus") {
+            mongo::BSONObjBuilder engine(reply.subobjStart("storageEngine"));
+            engine.append("name", _options.storageEngine);
+            engine.done();
+        }
+        else if (name == "listdatabases") {
+            QMutexLocker lock(&_mutex);
+            std::vector<std::string> names;
+            for (auto const& collection : _collections) {
+                std::string const dbName = databaseName(collection.first);
+                if (std::find(names.begin(), names.end(), dbName) == names.end())
+                    names.push_back(dbName);
+            }
+
+            mongo::BSONArrayBuilder databases(reply.subarrayStart("databases"));
+            for (auto const& dbName : names)
+                databases.append(BSON("name" << dbName << "sizeOnDisk" << 8192.0 << "empty" << false));
+            databases.done();
+            reply.append("totalSize", 8192.0 * names.size());
+        }
+        else if (name == "listcollections") {
+            QMutexLocker lock(&_mutex);
+            mongo::BSONObjBuilder cursor(reply.subobjStart("cursor"));
+            cursor.append("id", 0LL);
+            cursor.append("ns", db + ".$cmd.listCollections");
+            mongo::BSONArrayBuilder firstBatch(cursor.subarrayStart("firstBatch"));
+            for (auto const& collection : _collections) {
+                if (databaseName(collection.first) == db) {
+                    firstBatch.append(BSON("name" << collection.first.substr(db.size() + 1)
+                                           << "type" << "collection" << "options" << mongo::BSONObj()));
+                }
+            }
+            firstBatch.done();
+            cursor.done();
+        }
+        else if (name == "find") {
+            std::string const ns = db + "." + first.str();
+            int const batchSize = command.hasField("batchSize") ? command.getIntField("batchSize") : _options.maxBatchSize;
+            long long cursorId = openCursor(ns, command.getObjectField("filter"),
+                                            std::max(0, command.getIntField("skip")),
+                                            std::max(0, command.getIntField("limit")));
+            Documents batch;
+            cursorId = nextBatch(cursorId, batchSize, batch);
+
+            mongo::BSONObjBuilder cursor(reply.subobjStart("cursor"));
+            cursor.append("id", cursorId);
+            cursor.append("ns", ns);
+            cursor.append("firstBatch", batch);
+            cursor.done();
+        }
+        else if (name == "getmore") {
+            long long cursorId = first.numberLong();
+            bool exists = false;
+            {
+                QMutexLocker lock(&_mutex);
+                exists = _cursors.count(cursorId) > 0;
+            }
+
+            if (!exists) {
+                reply.append("ok", 0.0);
+                reply.append("errmsg", "cursor id " + std::to_string(cursorId) + " not found");
+                reply.append("code", 43);
+                return reply.obj();
+            }
+
+            int const batchSize = command.hasField("batchSize") ? command.getIntField("batchSize") : _options.maxBatchSize;
+            Documents batch;
+            cursorId = nextBatch(cursorId, batchSize, batch);
+
+            mongo::BSONObjBuilder cursor(reply.subobjStart("cursor"));
+            cursor.append("id", cursorId);
+            cursor.append("ns", db + "." + command.getStringField("collection"));
+            cursor.append("nextBatch", batch);
+            cursor.done();
+        }
+        else if (name == "insert") {
+            Documents documents;
+            mongo::BSONObjIterator it(command.getObjectField("documents"));
+            while (it.more())
+                documents.push_back(it.next().Obj().getOwned());
+
+            auto const sequence = sequences.find("documents");
+            if (sequence != sequences.end())
+                documents.insert(documents.end(), sequence->second.begin(), sequence->second.end());
+
+            QMutexLocker lock(&_mutex);
+            Documents &collection = _collections[db + "." + first.str()];
+            collection.insert(collection.end(), documents.begin(), documents.end());
+            reply.append("n", static_cast<int>(documents.size()));
+        }
+        else if (name == "count") {
+            QMutexLocker lock(&_mutex);
+            mongo::BSONObj const filter = command.getObjectField("query");
+            auto const collection = _collections.find(db + "." + first.str());
+            int n = 0;
+            if (collection != _collections.end())
+                n = static_cast<int>(std::count_if(collection->second.begin(), collection->second.end(),
+                                  [&filter](const mongo::BSONObj &doc) { return matches(doc, filter); }));
+            reply.append("n", n);
+        }
+        else if (name == "killcursors") {
+            QMutexLocker lock(&_mutex);
+            mongo::BSONObjIterator it(command.getObjectField("cursors"));
+            while (it.more())
+                _cursors.erase(it.next().numberLong());
+        }
+        else if (name == "replsetgetstatus") {
+            reply.append("ok", 0.0);
+            reply.append("errmsg", "not running with --replSet");
+            reply.append("code", 76);
+            return reply.obj();
+        }
+        else {
+            reply.append("ok", 0.0);
+            reply.append("errmsg", "no such command: '" + std::string(first.fieldName()) + "'");
+            reply.append("code", 59);
+            return reply.obj();
+        }
+
+        reply.append("ok", 1.0);
+        return reply.obj();
+    }
+
+    long long MockMongoServerWorker::openCursor(const std::string &ns, const mongo::BSONObj &filter, int skip, int limit)
+    {
+        QMutexLocker lock(&_mutex);
+        Cursor cursor;
+        cursor.ns = ns;
+        cursor.position = 0;
+
+        auto const collection = _collections.find(ns);
+        if (collection != _collections.end()) {
+            int skipped = 0;
+            for (auto const& doc : collection->second) {
+                if (!matches(doc, filter))
+                    continue;
+
+                if (skipped++ < skip)
+                    continue;
+
+                cursor.documents.push_back(doc);
+                if (limit > 0 && static_cast<int>(cursor.documents.size()) == limit)
+                    break;
+            }
+        }
+
+        long long const id = _nextCursorId++;
+        _cursors[id] = cursor;
+        return id;
+    }
+
+    long long MockMongoServerWorker::nextBatch(long long cursorId, int batchSize, Documents &batch)
+    {
+        QMutexLocker lock(&_mutex);
+        auto const it = _cursors.find(cursorId);
+        if (it == _cursors.end())
+            return 0;
+
+        Cursor &cursor = it->second;
+        size_t const count = std::min<size_t>(std::min(batchSize, _options.maxBatchSize),
+                                              cursor.documents.size() - cursor.position);
+        batch.insert(batch.end(), cursor.documents.begin() + cursor.position,
+                     cursor.documents.begin() + cursor.position + count);
+        cursor.position += count;
+
+        if (cursor.position >= cursor.documents.size()) {
+            _cursors.erase(it);
+            return 0;
+        }
+        return cursorId;
+    }
+
+    void MockMongoServerWorker::sendReply(QTcpSocket *socket, int responseTo, const Documents &documents,
+                                          long long cursorId, int startingFrom, int flags)
+    {
+        QByteArray message;
+        appendInt32(message, 0);    // messageLength, patched in write()
+        appendInt32(message, _nextRequestId++);
+        appendInt32(message, responseTo);
+        appendInt32(message, OpReply);
+        appendInt32(message, flags);
+        appendInt64(message, cursorId);
+        appendInt32(message, startingFrom);
+        appendInt32(message, static_cast<int>(documents.size()));
+        for (auto const& doc : documents)
+            message.append(doc.objdata(), doc.objsize());
+
+        write(socket, message);
+    }
+
+    void MockMongoServerWorker::sendMsg(QTcpSocket *socket, int responseTo, const mongo::BSONObj &body)
+    {
+        QByteArray message;
+        appendInt32(message, 0);    // messageLength, patched in write()
+        appendInt32(message, _nextRequestId++);
+        appendInt32(message, responseTo);
+        appendInt32(message, OpMsg);
+        appendInt32(message, 0);    // flagBits
+        message.append('\0');       // section kind: body
+        message.append(body.objdata(), body.objsize());
+
+        write(socket, message);
+    }
+
+    void MockMongoServerWorker::write(QTcpSocket *socket, const QByteArray &message)
+    {
+        QByteArray data = message;
+        qToLittleEndian<qint32>(data.size(), reinterpret_cast<uchar*>(data.data()));
+
+        if (_options.latencyMs <= 0) {
+            socket->write(data);
+            return;
+        }
+
+        // Replies are delayed by the same amount of time, so their order is preserved
+        QPointer<QTcpSocket> guard(socket);
+        QTimer::singleShot(_options.latencyMs, this, [guard, data]() {
+            if (guard)
+                guard->write(data);
+        });
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <map>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+class QTcpServer;
+class QTcpSocket;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    /**
+     * @brief Options of MockMongoServer
+     */
+    struct MockMongoServerOptions
+    {
+        MockMongoServerOptions() :
+            latencyMs(0),
+            maxBatchSize(101),
+            maxWireVersion(5),
+            version("3.4.10"),
+            storageEngine("wiredTiger") {}
+
+        int latencyMs;          // delay before every reply, simulates network round trip
+        int maxBatchSize;       // upper bound of documents in every query/getMore batch
+        int maxWireVersion;     // reported in isMaster, 5 is MongoDB 3.4, 6 enables OP_MSG in drivers
+        std::string version;    // reported by buildInfo
+        std::string storageEngine;  // reported by serverStatus
+    };
+
+    class MockMongoServerWorker;
+
+    /**
+     * @brief MongoDB stand-in which speaks enough of the wire protocol
+     *        (OP_QUERY, OP_GET_MORE, OP_INSERT, OP_KILL_CURSORS, OP_MSG) to serve synthetic
+     *        collections to MongoClient, MongoWorker and mongo shell without a live mongod.
+     *
+     *        Supported commands: isMaster/hello, ping, buildInfo, serverStatus, listDatabases,
+     *        listCollections, find, getMore, insert, count, killCursors, getLastError.
+     *        Query filters support only top-level equality (i.e. { _id: 5 }), sort is ignored.
+     *
+     *        Server runs on its own thread, so it can be used in-process from blocking tests
+     *        and benchmarks, or standalone via "mock_server" target.
+     */
+    class MockMongoServer
+    {
+    public:
+        explicit MockMongoServer(const MockMongoServerOptions &options = MockMongoServerOptions());
+        ~MockMongoServer();
+
+        /**
+         * @brief Create collection 'ns' (i.e. "test.items") with 'count' synthetic documents.
+         *        Documents are generated deterministically from 'seed'.
+         */
+        void addCollection(const std::string &ns, int count, unsigned seed = 0);
+
+        /**
+         * @brief Start listening on 127.0.0.1.
+         * @param port: port to listen on, 0 selects free port
+         * @return Actual port or 0 if server failed to listen
+         */
+        quint16 start(quint16 port = 0);
+        void stop();
+
+        /**
+         * @brief Number of documents in collection 'ns' (including inserted ones)
+         */
+        int count(const std::string &ns) const;
+
+        /**
+         * @brief Number of wire protocol messages handled so far
+         */
+        int requestsCount() const;
+
+    private:
+        QThread *_thread;
+        MockMongoServerWorker *_worker;
+    };
+
+    /**
+     * @brief Network part of MockMongoServer. Lives on server's thread.
+     */
+    class MockMongoServerWorker : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        typedef std::vector<mongo::BSONObj> Documents;
+
+        explicit MockMongoServerWorker(const MockMongoServerOptions &options);
+
+        void addCollection(const std::string &ns, const Documents &documents);
+        int count(const std::string &ns) const;
+        int requestsCount() const;
+
+    public Q_SLOTS:
+        int listen(int port);
+        void close();
+
+    private Q_SLOTS:
+        void onNewConnection();
+        void onReadyRead();
+
+    private:
+        struct Cursor
+        {
+            std::string ns;
+            Documents documents;    // snapshot of matched documents
+            size_t position;
+        };
+
+        void handleMessage(QTcpSocket *socket, const char *message, int size);
+        void handleQuery(QTcpSocket *socket, int requestId, const char *body, const char *end);
+        void handleGetMore(QTcpSocket *socket, int requestId, const char *body, const char *end);
+        void handleInsert(const char *body, const char *end);
+        void handleKillCursors(const char *body, const char *end);
+        void handleMsg(QTcpSocket *socket, int requestId, const char *body, const char *end);
+
+        mongo::BSONObj runCommand(const std::string &db, const mongo::BSONObj &command,
+                                  const std::map<std::string, Documents> &sequences = std::map<std::string, Documents>());
+
+        /**
+         * @brief Take next batch from cursor. Cursor is removed once exhausted.
+         * @return Id of cursor or 0 if there are no more documents.
+         */
+        long long nextBatch(long long cursorId, int batchSize, Documents &batch);
+        long long openCursor(const std::string &ns, const mongo::BSONObj &filter, int skip, int limit);
+
+        void sendReply(QTcpSocket *socket, int responseTo, const Documents &documents,
+                       long long cursorId = 0, int startingFrom = 0, int flags = 0);
+        void sendMsg(QTcpSocket *socket, int responseTo, const mongo::BSONObj &body);
+        void write(QTcpSocket *socket, const QByteArray &message);
+
+        const MockMongoServerOptions _options;
+        QTcpServer *_server;
+        QHash<QTcpSocket*, QByteArray> _buffers;
+
+        mutable QMutex _mutex;
+        std::map<std::string, Documents> _collections;
+        std::map<long long, Cursor> _cursors;
+        long long _nextCursorId;
+        int _nextRequestId;
+        int _requestsCount;
+    };
+}
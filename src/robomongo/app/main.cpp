@@ -77,6 +77,9 @@ int main(int argc, char *argv[], char** envp)
     mainWindow.show();
 
     int rc = app.exec();
+
+    // Settings changed shortly before exit may still wait for background save
+    settingsManager->flush();
     rbm_ssh_cleanup();
     return rc;
 }
@@ -0,0 +1,515 @@
+#include <chrono>
+#include <functional>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <QApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+
+#include <mongo/base/initializer.h>
+#include <mongo/bson/bsonobjbuilder.h>
+#include <parser.h>
+
+#include "robomongo/core/HexUtils.h"
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/settings/CredentialSettings.h"
+#include "robomongo/core/settings/SettingsWriter.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/gui/widgets/workarea/BsonTableModel.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
+#include "robomongo/shell/bson/json.h"
+
+/**
+ * Micro-benchmarks of BSON rendering, JSON parsing, BSON models and config file.
+ *
+ * Usage: robomongo_bench [--filter <substring>] [--seed <n>] [--docs <n>] [--min-time <ms>] [--out <file>]
+ *
+ * Results are printed as JSON in the format of Google Benchmark (--benchmark_format=json),
+ * so output of two commits can be compared with its tools/compare.py.
+ */
+
+namespace
+{
+    struct Options
+    {
+        Options() : seed(42), documents(1000), minTimeMs(300) {}
+
+        std::string filter;
+        std::string out;
+        unsigned seed;
+        int documents;
+        int minTimeMs;
+    };
+
+    struct Result
+    {
+        std::string name;
+        long long iterations;
+        double nsPerIteration;
+        double itemsPerSecond;
+        double bytesPerSecond;
+    };
+
+    typedef std::vector<mongo::BSONObj> Corpus;
+
+    /**
+     * @brief Seeded generators of synthetic documents
+     */
+    class CorpusGenerator
+    {
+    public:
+        explicit CorpusGenerator(unsigned seed) : _random(seed) {}
+
+        std::string randomString(int minLength, int maxLength)
+        {
+            static const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 \"\\\t\n";
+            int const length = std::uniform_int_distribution<int>(minLength, maxLength)(_random);
+            std::uniform_int_distribution<int> letter(0, sizeof(alphabet) - 2);
+            std::string result;
+            result.reserve(length);
+            for (int i = 0; i < length; ++i)
+                result += alphabet[letter(_random)];
+            return result;
+        }
+
+        std::string randomUuidHex()
+        {
+            std::uniform_int_distribution<int> byte(0, 255);
+            char raw[16];
+            for (char &c : raw)
+                c = static_cast<char>(byte(_random));
+            return Robomongo::HexUtils::toStdHexLower(raw, sizeof(raw));
+        }
+
+        // Unlike OID::gen(), which depends on time and process, derived from seed
+        mongo::OID randomOid()
+        {
+            std::uniform_int_distribution<int> byte(0, 255);
+            char raw[mongo::OID::kOIDSize];
+            for (char &c : raw)
+                c = static_cast<char>(byte(_random));
+            return mongo::OID(Robomongo::HexUtils::toStdHexLower(raw, sizeof(raw)));
+        }
+
+        mongo::BSONObj flat(int index)
+        {
+            mongo::BSONObjBuilder b;
+            b.append("_id", randomOid());
+            b.append("index", index);
+            for (int i = 0; i < 5; ++i) {
+                std::string const suffix = std::to_string(i);
+                b.append("int" + suffix, std::uniform_int_distribution<int>()(_random));
+                b.append("long" + suffix, static_cast<long long>(_random()) << 20);
+                b.append("double" + suffix, std::uniform_real_distribution<double>(-1e6, 1e6)(_random));
+                b.append("bool" + suffix, _random() % 2 == 0);
+                b.append("name" + suffix, randomString(5, 20));
+            }
+            std::string const uuid = randomUuidHex();
+            char bytes[Robomongo::HexUtils::uuidSize];
+            Robomongo::HexUtils::fromHex(uuid.data(), uuid.size(), bytes);
+            b.appendBinData("uuid", sizeof(bytes), mongo::newUUID, bytes);
+            return b.obj();
+        }
+
+        mongo::BSONObj nested(int index, int depth = 8)
+        {
+            mongo::BSONObjBuilder b;
+            b.append("_id", index);
+            appendNested(b, depth);
+            return b.obj();
+        }
+
+        mongo::BSONObj strings(int index)
+        {
+            mongo::BSONObjBuilder b;
+            b.append("_id", index);
+            for (int i = 0; i < 10; ++i)
+                b.append("text" + std::to_string(i), randomString(100, 1000));
+            return b.obj();
+        }
+
+        mongo::BSONObj arrays(int index)
+        {
+            mongo::BSONObjBuilder b;
+            b.append("_id", index);
+            mongo::BSONArrayBuilder numbers(b.subarrayStart("numbers"));
+            for (int i = 0; i < 50; ++i)
+                numbers.append(std::uniform_int_distribution<int>(0, 100000)(_random));
+            numbers.done();
+
+            mongo::BSONArrayBuilder items(b.subarrayStart("items"));
+            for (int i = 0; i < 20; ++i)
+                items.append(BSON("sku" << randomString(8, 8) << "qty" << i << "price" << i * 1.5));
+            items.done();
+            return b.obj();
+        }
+
+        mongo::BSONObj dates(int index)
+        {
+            std::uniform_int_distribution<long long> millis(0, 4102444800000LL);   // 1970 - 2100
+            mongo::BSONObjBuilder b;
+            b.append("_id", index);
+            for (int i = 0; i < 20; ++i) {
+                b.appendDate("date" + std::to_string(i), mongo::Date_t::fromMillisSinceEpoch(millis(_random)));
+            }
+            b.append("ts", mongo::Timestamp(static_cast<unsigned>(index), 1));
+            return b.obj();
+        }
+
+    private:
+        void appendNested(mongo::BSONObjBuilder &b, int depth)
+        {
+            b.append("level", depth);
+            b.append("label", randomString(3, 10));
+            if (depth == 0)
+                return;
+
+            mongo::BSONObjBuilder child(b.subobjStart("child"));
+            appendNested(child, depth - 1);
+            child.done();
+        }
+
+        std::mt19937 _random;
+    };
+
+    class Runner
+    {
+    public:
+        explicit Runner(const Options &options) : _options(options) {}
+
+        /**
+         * @brief Run 'body' until minimum time is reached.
+         * @param items: number of processed items (documents, strings) by single call of 'body'
+         * @param bytes: number of processed bytes by single call of 'body'
+         */
+        void run(const std::string &name, long long items, long long bytes, const std::function<void()> &body)
+        {
+            if (!_options.filter.empty() && name.find(_options.filter) == std::string::npos)
+                return;
+
+            typedef std::chrono::steady_clock clock;
+            body(); // warm-up
+
+            long long iterations = 0;
+            auto const start = clock::now();
+            auto elapsed = clock::duration::zero();
+            do {
+                body();
+                ++iterations;
+                elapsed = clock::now() - start;
+            } while (elapsed < std::chrono::milliseconds(_options.minTimeMs));
+
+            double const ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            double const seconds = ns / 1e9;
+
+            Result result;
+            result.name = name;
+            result.iterations = iterations;
+            result.nsPerIteration = ns / iterations;
+            result.itemsPerSecond = items * iterations / seconds;
+            result.bytesPerSecond = bytes * iterations / seconds;
+            _results.push_back(result);
+
+            std::cerr << name << ": " << static_cast<long long>(result.nsPerIteration) << " ns/iter ("
+                      << iterations << " iterations)" << std::endl;
+        }
+
+        void print(std::ostream &out) const
+        {
+            out << "{\n  \"context\": {\n"
+                << "    \"date\": \"" << QDateTime::currentDateTime().toString(Qt::ISODate).toStdString() << "\",\n"
+                << "    \"executable\": \"robomongo_bench\",\n"
+                << "    \"seed\": " << _options.seed << ",\n"
+                << "    \"documents\": " << _options.documents << ",\n"
+#ifdef NDEBUG
+                << "    \"library_build_type\": \"release\"\n"
+#else
+                << "    \"library_build_type\": \"debug\"\n"
+#endif
+                << "  },\n  \"benchmarks\": [";
+
+            for (size_t i = 0; i < _results.size(); ++i) {
+                Result const& r = _results[i];
+                out << (i ? "," : "") << "\n    {\n"
+                    << "      \"name\": \"" << r.name << "\",\n"
+                    << "      \"run_name\": \"" << r.name << "\",\n"
+                    << "      \"run_type\": \"iteration\",\n"
+                    << "      \"iterations\": " << r.iterations << ",\n"
+                    << "      \"real_time\": " << r.nsPerIteration << ",\n"
+                    << "      \"cpu_time\": " << r.nsPerIteration << ",\n"
+                    << "      \"time_unit\": \"ns\",\n"
+                    << "      \"bytes_per_second\": " << r.bytesPerSecond << ",\n"
+                    << "      \"items_per_second\": " << r.itemsPerSecond << "\n"
+                    << "    }";
+            }
+            out << "\n  ]\n}\n";
+        }
+
+    private:
+        const Options _options;
+        std::vector<Result> _results;
+    };
+
+    Options parseOptions(const QStringList &args)
+    {
+        Options options;
+        for (int i = 1; i + 1 < args.size(); i += 2) {
+            QString const& key = args[i];
+            QString const& value = args[i + 1];
+            if (key == "--filter")
+                options.filter = value.toStdString();
+            else if (key == "--seed")
+                options.seed = value.toUInt();
+            else if (key == "--docs")
+                options.documents = value.toInt();
+            else if (key == "--min-time")
+                options.minTimeMs = value.toInt();
+            else if (key == "--out")
+                options.out = value.toStdString();
+        }
+        return options;
+    }
+
+    long long totalSize(const Corpus &corpus)
+    {
+        long long size = 0;
+        for (auto const& doc : corpus)
+            size += doc.objsize();
+        return size;
+    }
+
+    void benchCorpus(Runner &runner, const std::string &corpusName, const Corpus &corpus)
+    {
+        using namespace Robomongo;
+        long long const items = static_cast<long long>(corpus.size());
+        long long const bytes = totalSize(corpus);
+
+        runner.run("BsonUtils::jsonString/" + corpusName, items, bytes, [&corpus]() {
+            for (auto const& doc : corpus) {
+                std::string json = BsonUtils::jsonString(doc, mongo::TenGen, 1, DefaultEncoding, Utc);
+                (void)json;
+            }
+        });
+
+        runner.run("BsonUtils::buildJsonString/" + corpusName, items, bytes, [&corpus]() {
+            for (auto const& doc : corpus) {
+                std::string json;
+                BsonUtils::buildJsonString(doc, json, DefaultEncoding, Utc);
+            }
+        });
+
+        std::vector<std::string> texts;
+        long long textBytes = 0;
+        for (auto const& doc : corpus) {
+            texts.push_back(BsonUtils::jsonString(doc, mongo::TenGen, 1, DefaultEncoding, Utc));
+            textBytes += texts.back().size();
+        }
+
+        runner.run("fromjson/" + corpusName, items, textBytes, [&texts]() {
+            for (auto const& text : texts) {
+                mongo::BSONObj obj = mongo::Robomongo::fromjson(text);
+                (void)obj;
+            }
+        });
+
+        // Whole corpus pasted into the insert dialog at once
+        std::string pasted;
+        for (auto const& text : texts)
+            pasted += text + "\n";
+
+        runner.run("fromjsonDocuments/" + corpusName, items, textBytes, [&pasted]() {
+            std::vector<mongo::BSONObj> objs = mongo::Robomongo::fromjsonDocuments(pasted);
+            (void)objs;
+        });
+
+        std::vector<MongoDocumentPtr> documents = MongoDocument::fromBsonObj(corpus);
+
+        runner.run("BsonTreeModel::BsonTreeModel/" + corpusName, items, bytes, [&documents]() {
+            BsonTreeModel model(documents);
+        });
+
+        runner.run("BsonTreeModel::fetchMore/" + corpusName, items, bytes, [&documents]() {
+            BsonTreeModel model(documents);
+            int const rows = model.rowCount();
+            for (int row = 0; row < rows; ++row) {
+                QModelIndex const parent = model.index(row, 0);
+                int const children = model.rowCount(parent);
+                for (int child = 0; child < children; ++child) {
+                    QModelIndex const index = model.index(child, 0, parent);
+                    if (model.canFetchMore(index))
+                        model.fetchMore(index);
+                }
+            }
+        });
+
+        runner.run("BsonTableModelProxy::setSourceModel/" + corpusName, items, bytes, [&documents]() {
+            BsonTreeModel model(documents);
+            BsonTableModelProxy proxy;
+            proxy.setSourceModel(&model);
+        });
+    }
+
+    void benchHexUtils(Runner &runner, CorpusGenerator &generator, int count)
+    {
+        using namespace Robomongo;
+        std::vector<std::string> hexes;
+        for (int i = 0; i < count; ++i)
+            hexes.push_back(generator.randomUuidHex());
+
+        const UUIDEncoding encodings[] = { DefaultEncoding, JavaLegacy, CSharpLegacy, PythonLegacy };
+        const char *const names[] = { "Default", "JavaLegacy", "CSharpLegacy", "PythonLegacy" };
+        for (int e = 0; e < 4; ++e) {
+            UUIDEncoding const encoding = encodings[e];
+            std::vector<std::string> uuids;
+            for (auto const& hex : hexes)
+                uuids.push_back(HexUtils::hexToUuid(hex, encoding));
+
+            runner.run(std::string("HexUtils::hexToUuid/") + names[e], count, count * 32, [&hexes, encoding]() {
+                for (auto const& hex : hexes) {
+                    std::string uuid = HexUtils::hexToUuid(hex, encoding);
+                    (void)uuid;
+                }
+            });
+
+            runner.run(std::string("HexUtils::uuidToHex/") + names[e], count, count * 36, [&uuids, encoding]() {
+                for (auto const& uuid : uuids) {
+                    std::string hex = HexUtils::uuidToHex(uuid, encoding);
+                    (void)hex;
+                }
+            });
+        }
+
+        // Rendering of UUID BinData in tree, table and text views
+        mongo::BSONObjBuilder builder;
+        for (int i = 0; i < count; ++i) {
+            char bytes[HexUtils::uuidSize];
+            HexUtils::fromHex(hexes[i].data(), hexes[i].size(), bytes);
+            builder.appendBinData(std::to_string(i), sizeof(bytes), i % 2 ? mongo::newUUID : mongo::bdtUUID, bytes);
+        }
+        mongo::BSONObj const uuidDocument = builder.obj();
+
+        runner.run("HexUtils::formatUuid", count, count * HexUtils::uuidSize, [&uuidDocument]() {
+            mongo::BSONObjIterator it(uuidDocument);
+            while (it.more()) {
+                std::string uuid = HexUtils::formatUuid(it.next(), JavaLegacy);
+                (void)uuid;
+            }
+        });
+
+        runner.run("HexUtils::fromHex", count, count * 32, [&hexes]() {
+            char bytes[HexUtils::uuidSize];
+            for (auto const& hex : hexes)
+                HexUtils::fromHex(hex.data(), hex.size(), bytes);
+        });
+    }
+
+    /**
+     * @brief Steps of config file with 'count' connections: connections are converted to map on
+     *        GUI thread when scheduled save is due, map is written by SettingsWriter on background
+     *        thread, file is parsed and connections are restored at startup.
+     *
+     *        SettingsManager itself is not used: it always reads and writes the user's config file.
+     */
+    void benchSettings(Runner &runner, int count)
+    {
+        using namespace Robomongo;
+        std::vector<std::unique_ptr<ConnectionSettings>> connections;
+        for (int i = 0; i < count; ++i) {
+            std::unique_ptr<ConnectionSettings> connection(new ConnectionSettings(false));
+            connection->setConnectionName("Connection " + std::to_string(i));
+            connection->setServerHost("db" + std::to_string(i) + ".example.com");
+            connection->setServerPort(27017 + i % 100);
+            connection->setDefaultDatabase("test");
+
+            auto credential = new CredentialSettings();
+            credential->setUserName("user" + std::to_string(i));
+            credential->setUserPassword("password");
+            credential->setDatabaseName("admin");
+            connection->addCredential(credential);
+            connections.push_back(std::move(connection));
+        }
+
+        auto const snapshot = [&connections]() {
+            QVariantList list;
+            for (auto const& connection : connections)
+                list.append(connection->toVariant());
+
+            QVariantMap map;
+            map.insert("connections", list);
+            return map;
+        };
+
+        std::string const suffix = "/" + std::to_string(count) + "connections";
+        runner.run("ConnectionSettings::toVariant" + suffix, count, 0, [&snapshot]() {
+            QVariantMap map = snapshot();
+            (void)map;
+        });
+
+        QString const path = QDir::temp().filePath("robomongo_bench_settings.json");
+        QVariantMap const map = snapshot();
+        SettingsWriter::write(path, map);
+        long long const bytes = QFile(path).size();
+
+        runner.run("SettingsWriter::write" + suffix, count, bytes, [&path, &map]() {
+            SettingsWriter::write(path, map);
+        });
+
+        runner.run("QJson::Parser+ConnectionSettings::fromVariant" + suffix, count, bytes, [&path]() {
+            QFile f(path);
+            f.open(QIODevice::ReadOnly);
+            bool ok;
+            QJson::Parser parser;
+            QVariantMap const loaded = parser.parse(f.readAll(), &ok).toMap();
+            for (auto const& item : loaded.value("connections").toList()) {
+                ConnectionSettings connection(false);
+                connection.fromVariant(item.toMap());
+            }
+        });
+
+        QFile::remove(path);
+    }
+}
+
+int main(int argc, char *argv[], char** envp)
+{
+    mongo::runGlobalInitializersOrDie(argc, argv, envp);
+
+    // Models use icons and fonts of GUI registry
+    QApplication app(argc, argv);
+    Options const options = parseOptions(app.arguments());
+
+    CorpusGenerator generator(options.seed);
+    Corpus flat, nested, strings, arrays, dates;
+    for (int i = 0; i < options.documents; ++i) {
+        flat.push_back(generator.flat(i));
+        nested.push_back(generator.nested(i));
+        strings.push_back(generator.strings(i));
+        arrays.push_back(generator.arrays(i));
+        dates.push_back(generator.dates(i));
+    }
+
+    Runner runner(options);
+    benchCorpus(runner, "flat", flat);
+    benchCorpus(runner, "nested", nested);
+    benchCorpus(runner, "strings", strings);
+    benchCorpus(runner, "arrays", arrays);
+    benchCorpus(runner, "dates", dates);
+    benchHexUtils(runner, generator, options.documents);
+    benchSettings(runner, 1000);
+
+    if (options.out.empty()) {
+        runner.print(std::cout);
+    }
+    else {
+        std::ofstream out(options.out);
+        runner.print(out);
+    }
+    return 0;
+}
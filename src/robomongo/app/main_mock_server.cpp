@@ -0,0 +1,64 @@
+#include <iostream>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <mongo/base/initializer.h>
+#include <mongo/util/exit_code.h>
+
+#include "robomongo/app/MockMongoServer.h"
+
+namespace mongo {
+    extern bool isShell;
+    void logProcessDetailsForLogRotate() {}
+    void exitCleanly(ExitCode code) {}
+}
+
+/**
+ * @brief Standalone MongoDB stand-in for performance tests of Robomongo without live mongod.
+ *        Example: mock_server --port 27017 --latency 50 --batch 101 --collection test.items:100000
+ */
+int main(int argc, char *argv[], char** envp)
+{
+    mongo::runGlobalInitializersOrDie(argc, argv, envp);
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("MongoDB wire protocol stand-in serving synthetic collections.");
+    parser.addHelpOption();
+    QCommandLineOption portOption("port", "Port to listen on.", "port", "27017");
+    QCommandLineOption latencyOption("latency", "Delay of every reply in milliseconds.", "ms", "0");
+    QCommandLineOption batchOption("batch", "Maximum number of documents in a batch.", "size", "101");
+    QCommandLineOption wireOption("wire-version", "Max wire version reported by isMaster.", "version", "5");
+    QCommandLineOption seedOption("seed", "Seed of synthetic documents.", "seed", "0");
+    QCommandLineOption collectionOption("collection", "Synthetic collection as <db.collection>:<count>. "
+                                        "Can be repeated.", "ns:count");
+    parser.addOptions({ portOption, latencyOption, batchOption, wireOption, seedOption, collectionOption });
+    parser.process(app);
+
+    Robomongo::MockMongoServerOptions options;
+    options.latencyMs = parser.value(latencyOption).toInt();
+    options.maxBatchSize = parser.value(batchOption).toInt();
+    options.maxWireVersion = parser.value(wireOption).toInt();
+
+    Robomongo::MockMongoServer server(options);
+
+    QStringList collections = parser.values(collectionOption);
+    if (collections.isEmpty())
+        collections << "test.items:1000";
+
+    for (QString const& collection : collections) {
+        QStringList const parts = collection.split(':');
+        server.addCollection(parts[0].toStdString(), parts.size() > 1 ? parts[1].toInt() : 1000,
+                             parser.value(seedOption).toUInt());
+    }
+
+    quint16 const port = server.start(static_cast<quint16>(parser.value(portOption).toUInt()));
+    if (!port) {
+        std::cerr << "Failed to listen on port " << parser.value(portOption).toStdString() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Mock MongoDB server is listening on 127.0.0.1:" << port << std::endl;
+    return app.exec();
+}
@@ -1,12 +1,37 @@
 #undef NDEBUG
 
+#include <algorithm>
+#include <memory>
 #include <sstream>
 #include <iostream>
 #include <assert.h>
+#include <ctype.h>
 #include <limits>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include <mongo/base/initializer.h>
+#include <mongo/bson/bsonobjbuilder.h>
+#include <mongo/client/dbclientinterface.h>
 #include <mongo/util/exit_code.h>
 #include <mongo/util/net/hostandport.h>
 
+#include "robomongo/app/MockMongoServer.h"
+#include "robomongo/core/HexUtils.h"
+#include "robomongo/core/domain/DocumentPatch.h"
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/domain/QueryPlanSummary.h"
+#include "robomongo/core/domain/ServerStatusSample.h"
+#include "robomongo/core/mongodb/MongoClient.h"
+#include "robomongo/core/utils/IncrementalJsonParser.h"
+#include "robomongo/core/utils/MpscQueue.h"
+#include "robomongo/core/utils/RingBuffer.h"
+#include "robomongo/core/utils/ScriptUtils.h"
+#include "robomongo/core/utils/TextRangeSet.h"
+#include "robomongo/shell/bson/json.h"
+#include "robomongo/shell/db/ptimeutil.h"
+
 namespace mongo {
     extern bool isShell;
     void logProcessDetailsForLogRotate() {}
@@ -68,9 +93,663 @@ void testPrecision() {
     precisionAssert("9.7", 9.7);
 }
 
+void testMockServer() {
+    Robomongo::MockMongoServerOptions options;
+    options.maxBatchSize = 100;
+    Robomongo::MockMongoServer server(options);
+    server.addCollection("test.items", 250);
+    server.addCollection("other.items", 10);
+    quint16 port = server.start();
+    assert(port != 0);
+
+    mongo::DBClientConnection conn;
+    assert(conn.connect(mongo::HostAndPort("127.0.0.1", port), "tests").isOK());
+
+    std::list<std::string> dbs = conn.getDatabaseNames();
+    assert(dbs.size() == 2);
+    assert(std::find(dbs.begin(), dbs.end(), "test") != dbs.end());
+
+    std::list<std::string> colls = conn.getCollectionNames("test");
+    assert(colls.size() == 1 && colls.front() == "items");
+
+    // All documents are returned in batches of at most 'maxBatchSize'
+    int const requestsBefore = server.requestsCount();
+    std::unique_ptr<mongo::DBClientCursor> cursor = conn.query("test.items", mongo::Query());
+    int count = 0;
+    while (cursor->more()) {
+        mongo::BSONObj doc = cursor->next();
+        assert(doc.getIntField("_id") == count);
+        ++count;
+    }
+    assert(count == 250);
+    assert(server.requestsCount() - requestsBefore == 3); // query + 2 x getMore
+
+    // Paging: skip and limit
+    cursor = conn.query("test.items", mongo::Query(), 20, 40);
+    assert(cursor->next().getIntField("_id") == 40);
+    assert(cursor->itcount() == 19);
+
+    // Equality filter
+    cursor = conn.query("test.items", BSON("_id" << 7));
+    assert(cursor->next().getIntField("_id") == 7);
+    assert(!cursor->more());
+
+    // Insert
+    conn.insert("test.items", BSON("_id" << 1000 << "name" << "inserted"));
+    assert(server.count("test.items") == 251);
+    assert(conn.count("test.items") == 251);
+
+    std::cout << "Mock server: correct." << std::endl;
+}
+
+void testMongoClient() {
+    Robomongo::MockMongoServerOptions options;
+    options.maxBatchSize = 100;
+    Robomongo::MockMongoServer server(options);
+    server.addCollection("test.items", 250);
+    quint16 port = server.start();
+    assert(port != 0);
+
+    mongo::DBClientConnection conn;
+    assert(conn.connect(mongo::HostAndPort("127.0.0.1", port), "tests").isOK());
+    Robomongo::MongoClient client(&conn);
+
+    // Steps of MongoWorker::handle(EstablishConnectionRequest) and explorer refresh
+    assert(client.getDatabaseNames() == std::vector<std::string>{ "test" });
+    assert(client.getCollectionNamesWithDbname("test") == std::vector<std::string>{ "test.items" });
+    assert(client.getVersion() > 3.39f && client.getVersion() < 3.41f);
+    assert(client.getStorageEngineType() == "wiredTiger");
+
+    // Second page of result as requested by OutputItemContentWidget
+    Robomongo::MongoQueryInfo page(Robomongo::CollectionInfo("127.0.0.1", "test", "items"),
+                                   mongo::BSONObj(), mongo::BSONObj(), 50, 50, 50, 0, false);
+    std::vector<Robomongo::MongoDocumentPtr> docs = client.query(page);
+    assert(docs.size() == 50);
+    assert(docs.front()->bsonObj().getIntField("_id") == 50);
+    assert(docs.back()->bsonObj().getIntField("_id") == 99);
+
+    // Limit -1 means that page is not loaded at all
+    page._limit = -1;
+    assert(client.query(page).empty());
+
+    client.insertDocument(BSON("_id" << 1000 << "name" << "inserted"), Robomongo::MongoNamespace("test", "items"));
+    assert(server.count("test.items") == 251);
+    client.done();
+
+    std::cout << "Mongo client against mock server: correct." << std::endl;
+}
+
+boost::posix_time::ptime ptimeFromMillis(long long milliseconds) {
+    // Split into hours and the rest, boost durations take 'long' which is 32 bit on Windows
+    boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+    return epoch + boost::posix_time::hours(static_cast<long>(milliseconds / 3600000))
+                 + boost::posix_time::milliseconds(static_cast<long>(milliseconds % 3600000));
+}
+
+long long millisFromIso(const std::string &isoDate) {
+    long long millis = 0;
+    assert(miutil::millisFromIsoString(isoDate.data(), isoDate.size(), millis));
+
+    // ptimeFromIsoString must agree with the fast parser
+    boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+    assert((miutil::ptimeFromIsoString(isoDate) - epoch).total_milliseconds() == millis);
+    return millis;
+}
+
+void expectIsoDateParsing(long long milliseconds, const std::string &isoDate) {
+    assert(miutil::isotimeString(ptimeFromMillis(milliseconds), true, false) == isoDate);
+    assert(millisFromIso(isoDate) == milliseconds);
+}
+
+void testIsoDateParser() {
+    // Vectors of DateConversion tests
+    assert(millisFromIso("1970-01-01T00:00:00.000Z") == 0);
+    assert(millisFromIso("1970-01-01T00:00:00.000+00:00") == 0);
+    assert(millisFromIso("1970-01-01T03:00:00.000+03:00") == 0);
+    assert(millisFromIso("1969-12-31T21:00:00.000-03:00") == 0);
+    expectIsoDateParsing(-2177452800000, "1901-01-01T00:00:00.000Z");
+    expectIsoDateParsing(-2208988800000, "1900-01-01T00:00:00.000Z");
+    expectIsoDateParsing(6977452800000, "2191-02-08T13:20:00.000Z");
+    expectIsoDateParsing(978307200127, "2001-01-01T00:00:00.127Z");
+    expectIsoDateParsing(1312291712320, "2011-08-02T13:28:32.320Z");
+    assert(millisFromIso("2013-08-13T01:39:34.411+03:00") == 1376347174411);
+    assert(millisFromIso("2013-08-13T01:39:34.411-13:50") == 1376407774411);
+    assert(millisFromIso("2013-08-12T22:39:34.411Z") == millisFromIso("2013-08-13T01:39:34.411+03:00"));
+    assert(millisFromIso("2013-08-13T09:09:34.001Z") == millisFromIso("2013-08-13T01:39:34.001-07:30"));
+    assert(millisFromIso("2011-08-02T13:28:32Z") == 1312291712000);
+
+    // Parity with boost::posix_time based decoding used before: the same date and time
+    // fields and the same ranges (boost::gregorian::date throws on invalid dates)
+    const char *const offsets[] = { "Z", "+00:00", "+03:00", "-03:00", "-13:50", "+05:45", "-11:00" };
+    const int years[] = { 1400, 1600, 1677, 1900, 1969, 1970, 1999, 2000, 2100, 2262, 9999 };
+    char buffer[64];
+    for (int year : years) {
+        for (int month = 0; month <= 13; ++month) {
+            for (int day = 0; day <= 32; ++day) {
+                bool isValidDate = true;
+                boost::gregorian::date date;
+                try {
+                    date = boost::gregorian::date(year, month, day);
+                } catch (const std::out_of_range &) {
+                    isValidDate = false;
+                }
+
+                for (int hour : { 0, 13, 23, 24, 99 }) {
+                    for (const char *offset : offsets) {
+                        int const minute = (day * 7) % 60, second = (day * 13) % 61, msecond = (day * 37) % 1000;
+                        sprintf(buffer, "%04d-%02d-%02dT%02d:%02d:%02d.%03d%s", year, month, day, hour, minute,
+                                second, msecond, offset);
+
+                        long long millis = 0;
+                        bool const parsed = miutil::millisFromIsoString(buffer, strlen(buffer), millis);
+                        if (!isValidDate) {
+                            assert(!parsed);
+                            continue;
+                        }
+
+                        int offsetHours = 0, offsetMinutes = 0;
+                        if (offset[0] != 'Z') {
+                            offsetHours = atoi(offset);     // with sign
+                            offsetMinutes = atoi(offset + 4);
+                        }
+
+                        boost::posix_time::ptime expected(date,
+                            boost::posix_time::time_duration(hour, minute, second, msecond * 1000));
+                        expected -= boost::posix_time::time_duration(offsetHours, offsetMinutes, 0);
+
+                        // Results outside of boost range are left to ptimeFromIsoString
+                        try {
+                            expected.date().year();
+                        } catch (const std::out_of_range &) {
+                            assert(!parsed);
+                            continue;
+                        }
+
+                        boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+                        assert(parsed);
+                        assert(millis == (expected - epoch).total_milliseconds());
+                    }
+                }
+            }
+        }
+    }
+
+    // Round trip of rendered dates in supported range, moving by 50 minutes (and some milliseconds)
+    for (long long ms = miutil::minDate; ms < miutil::maxDate; ms += 3000007) {
+        std::string const isoDate = miutil::isotimeString(ptimeFromMillis(ms), true, false);
+        long long millis = 0;
+        assert(miutil::millisFromIsoString(isoDate.data(), isoDate.size(), millis));
+        assert(millis == ms);
+    }
+
+    // Forms which were rejected or misread by the previous decoder
+    assert(millisFromIso("2011-08-02T13:28:32.3Z") == 1312291712300);          // fraction of 1 digit
+    assert(millisFromIso("2011-08-02T13:28:32.320999Z") == 1312291712320);     // microseconds are ignored
+    assert(millisFromIso("2011-08-02T16:28:32.320+0300") == 1312291712320);    // offset without ':'
+    assert(millisFromIso("2011-08-02T16:28:32+03") == 1312291712000);          // offset hours only
+    assert(millisFromIso("2011-08-02T13:28:32") == 1312291712000);             // no designator is UTC
+    assert(millisFromIso("2011-08-02T12:58:32.320-00:30") == 1312291712320);   // negative offset below 1 hour
+    assert(millisFromIso("2011-08-02 13:28:32.320Z") == 1312291712320);        // space separator
+
+    // Everything else is left to ptimeFromIsoString
+    long long millis = 0;
+    for (const char *isoDate : { "epoch", "now", "Fri, 16 Mar 2007 08:13:37 GMT", "2011-08-02", "2011-08-02T13:28:32.Z",
+                                 "2011-08-02T13:28:32.320Zfoo", " 2011-08-02T13:28:32Z", "2011-08-02T13:28:32+3",
+                                 "2011-8-02T13:28:32Z", "2011-02-29T13:28:32Z", "1400-01-01T00:00:00+00:01" })
+        assert(!miutil::millisFromIsoString(isoDate, strlen(isoDate), millis));
+    assert(miutil::ptimeFromIsoString("epoch") == boost::posix_time::ptime(boost::gregorian::date(1970, 1, 1)));
+
+    std::cout << "ISO date parser: correct." << std::endl;
+}
+
+void testRingBuffer() {
+    Robomongo::RingBuffer<int> buffer(3);
+    assert(buffer.empty() && buffer.capacity() == 3);
+
+    buffer.push(1);
+    buffer.push(2);
+    assert(buffer.size() == 2 && buffer[0] == 1 && buffer.back() == 2);
+
+    // Oldest items are overwritten, order is kept
+    for (int i = 3; i <= 7; ++i)
+        buffer.push(i);
+    assert(buffer.size() == 3 && buffer[0] == 5 && buffer[1] == 6 && buffer[2] == 7 && buffer.back() == 7);
+
+    buffer.clear();
+    buffer.push(8);
+    assert(buffer.size() == 1 && buffer[0] == 8);
+
+    std::cout << "Ring buffer: correct." << std::endl;
+}
+
+void testMpscQueue() {
+    Robomongo::MpscQueue<int> queue(3);
+    assert(queue.capacity() == 4);
+
+    int value = 0;
+    assert(!queue.tryPop(value));
+    for (int i = 0; i < 4; ++i)
+        assert(queue.tryPush(int(i)));
+    assert(!queue.tryPush(4));   // full
+    assert(queue.tryPop(value) && value == 0);
+    assert(queue.tryPush(4));
+
+    // Every item of every producer is popped once, in order of its producer
+    const int producers = 4;
+    const int itemsPerProducer = 100000;
+    Robomongo::MpscQueue<int> shared(256);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&shared, p]() {
+            for (int i = 0; i < itemsPerProducer; ++i) {
+                while (!shared.tryPush(p * itemsPerProducer + i))
+                    std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<int> next(producers, 0);
+    for (int popped = 0; popped < producers * itemsPerProducer; ) {
+        if (!shared.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int const producer = value / itemsPerProducer;
+        assert(value % itemsPerProducer == next[producer]);
+        ++next[producer];
+        ++popped;
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+    assert(!shared.tryPop(value));
+
+    std::cout << "MPSC queue: correct." << std::endl;
+}
+
+mongo::BSONObj serverStatus(long long uptime, long long inserts, long long bytesIn, double cacheBytes) {
+    return BSON("host" << "db1:27017" << "uptimeMillis" << uptime
+                << "opcounters" << BSON("insert" << inserts << "query" << 10 << "update" << 0
+                                        << "delete" << 0 << "getmore" << 0 << "command" << 100)
+                << "network" << BSON("bytesIn" << bytesIn << "bytesOut" << 0LL)
+                << "globalLock" << BSON("currentQueue" << BSON("readers" << 2 << "writers" << 1))
+                << "wiredTiger" << BSON("cache" << BSON("bytes currently in the cache" << cacheBytes
+                                                        << "maximum bytes configured" << 1000.0
+                                                        << "tracked dirty bytes in the cache" << 50.0))
+                << "connections" << BSON("current" << 12 << "available" << 800));
+}
+
+void testServerStatusRates() {
+    using Robomongo::ServerStatusSample;
+
+    // Counters of serverStatus may be int or long, depending on their values
+    ServerStatusSample const first = ServerStatusSample::fromServerStatus(serverStatus(5000, 100, 4096, 250), 1000);
+    assert(first.host == "db1:27017" && first.inserts == 100 && first.queuedReaders == 2 && first.connections == 12);
+
+    ServerStatusSample const second = ServerStatusSample::fromServerStatus(serverStatus(7000, 300, 6144, 500), 3000);
+    Robomongo::ServerStatusPoint point;
+    assert(ServerStatusSample::computePoint(first, second, point));
+    assert(point.timeMs == 3000);
+    assert(point.values[Robomongo::InsertsPerSec] == 100);
+    assert(point.values[Robomongo::QueriesPerSec] == 0);
+    assert(point.values[Robomongo::BytesInPerSec] == 1024);
+    assert(point.values[Robomongo::QueuedWriters] == 1);
+    assert(point.values[Robomongo::CacheUsedPercent] == 50);
+    assert(point.values[Robomongo::CacheDirtyPercent] == 5);
+    assert(point.values[Robomongo::Connections] == 12);
+
+    // Samples out of order, restarted server or failed poll give no point
+    assert(!ServerStatusSample::computePoint(second, first, point));
+    ServerStatusSample const restarted = ServerStatusSample::fromServerStatus(serverStatus(500, 10, 100, 0), 4000);
+    assert(!ServerStatusSample::computePoint(second, restarted, point));
+    ServerStatusSample failed;
+    failed.error = "Unable to connect";
+    failed.timeMs = 5000;
+    assert(!ServerStatusSample::computePoint(restarted, failed, point));
+
+    // Cache metrics are zero for other storage engines
+    ServerStatusSample const mmapv1 = ServerStatusSample::fromServerStatus(BSON("uptimeMillis" << 1000LL), 6000);
+    ServerStatusSample const mmapv1Next = ServerStatusSample::fromServerStatus(BSON("uptimeMillis" << 2000LL), 7000);
+    assert(ServerStatusSample::computePoint(mmapv1, mmapv1Next, point));
+    assert(point.values[Robomongo::CacheUsedPercent] == 0 && point.values[Robomongo::InsertsPerSec] == 0);
+
+    std::cout << "Server status rates: correct." << std::endl;
+}
+
+void testHexUtils() {
+    using namespace Robomongo;
+    namespace HexUtils = Robomongo::HexUtils;
+
+    // Known representations of the same BinData in every encoding
+    std::string const hex = "00112233445566778899aabbccddeeff";
+    assert(HexUtils::hexToUuid(hex, DefaultEncoding) == "00112233-4455-6677-8899-aabbccddeeff");
+    assert(HexUtils::hexToUuid(hex, PythonLegacy) == "00112233-4455-6677-8899-aabbccddeeff");
+    assert(HexUtils::hexToUuid(hex, CSharpLegacy) == "33221100-5544-7766-8899-aabbccddeeff");
+    assert(HexUtils::hexToUuid(hex, JavaLegacy) == "77665544-3322-1100-ffee-ddccbbaa9988");
+    assert(HexUtils::javaUuidToHex("{77665544-3322-1100-ffee-ddccbbaa9988}") == hex);
+    assert(HexUtils::uuidToHex("0011223344556677-8899aabbccddeeff") == hex);
+    assert(HexUtils::uuidToHex("00112233-4455-6677-8899-aabbccddeef", DefaultEncoding).empty());
+    assert(HexUtils::uuidToHex("00112233-4455-6677-8899-aabbccddeeff0", CSharpLegacy).empty());
+    assert(HexUtils::hexToUuid("0011").empty());
+
+    char bytes[HexUtils::uuidSize];
+    assert(!HexUtils::parseUuidBytes("00112233-4455-6677-8899-aabbccddeexx", DefaultEncoding, bytes));
+    assert(!HexUtils::fromHex("abc", 3, bytes));
+    assert(HexUtils::isHexString("09afAF") && !HexUtils::isHexString("0g"));
+
+    // Every value of every byte, in every encoding, survives the round trip
+    // bytes -> UUID string -> bytes and hex -> UUID string -> hex
+    const UUIDEncoding encodings[] = { DefaultEncoding, JavaLegacy, CSharpLegacy, PythonLegacy };
+    for (UUIDEncoding const encoding : encodings) {
+        for (int position = 0; position < HexUtils::uuidSize; ++position) {
+            for (int value = 0; value < 256; ++value) {
+                char raw[HexUtils::uuidSize];
+                for (int i = 0; i < HexUtils::uuidSize; ++i)
+                    raw[i] = static_cast<char>(i * 17 + position);
+                raw[position] = static_cast<char>(value);
+
+                char uuid[HexUtils::uuidStringLength];
+                HexUtils::formatUuidBytes(raw, encoding, uuid);
+                std::string const uuidString(uuid, sizeof(uuid));
+
+                char parsed[HexUtils::uuidSize];
+                assert(HexUtils::parseUuidBytes(uuidString, encoding, parsed));
+                assert(memcmp(raw, parsed, sizeof(raw)) == 0);
+
+                std::string const rawHex = HexUtils::toStdHexLower(raw, sizeof(raw));
+                assert(HexUtils::hexToUuid(rawHex, encoding) == uuidString);
+                assert(HexUtils::uuidToHex(uuidString, encoding) == rawHex);
+
+                // Upper case is accepted
+                std::string upper = uuidString;
+                std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+                assert(HexUtils::parseUuidBytes(upper, encoding, parsed) && memcmp(raw, parsed, sizeof(raw)) == 0);
+            }
+        }
+    }
+
+    // Shell representation of BinData
+    char const raw[] = "\x00\x11\x22\x33\x44\x55\x66\x77\x88\x99\xaa\xbb\xcc\xdd\xee\xff";
+    mongo::BSONObjBuilder builder;
+    builder.appendBinData("legacy", HexUtils::uuidSize, mongo::bdtUUID, raw);
+    builder.appendBinData("standard", HexUtils::uuidSize, mongo::newUUID, raw);
+    builder.appendBinData("short", 2, mongo::newUUID, raw);
+    mongo::BSONObj const obj = builder.obj();
+    assert(HexUtils::formatUuid(obj["legacy"], JavaLegacy) == "JUUID(\"77665544-3322-1100-ffee-ddccbbaa9988\")");
+    assert(HexUtils::formatUuid(obj["standard"], JavaLegacy) == "UUID(\"00112233-4455-6677-8899-aabbccddeeff\")");
+    assert(HexUtils::formatUuid(obj["short"], DefaultEncoding) == "BinData(4, \"ABE=\")");
+
+    std::cout << "Hex utils: correct." << std::endl;
+}
+
+mongo::BSONObj explainOutput(const mongo::BSONObj &winningPlan, long long keys, long long docs, long long returned) {
+    return BSON("queryPlanner" << BSON("winningPlan" << winningPlan) <<
+                "executionStats" << BSON("nReturned" << returned << "executionTimeMillis" << 1200 <<
+                                         "totalKeysExamined" << keys << "totalDocsExamined" << docs));
+}
+
+void testQueryPlanSummary() {
+    using Robomongo::QueryPlanSummary;
+
+    // Selective index
+    mongo::BSONObj const ixscan = BSON("stage" << "IXSCAN" << "keyPattern" << BSON("a" << 1));
+    QueryPlanSummary const indexed = QueryPlanSummary::fromExplain(
+        explainOutput(BSON("stage" << "FETCH" << "inputStage" << ixscan), 20, 20, 20));
+    assert(indexed.plan == "IXSCAN { a: 1 }");
+    assert(indexed.returned == 20 && indexed.executionMs == 1200);
+    assert(!indexed.isCollectionScan() && !indexed.isInefficient());
+
+    // Collection scan which reads far more than it returns
+    QueryPlanSummary const collscan = QueryPlanSummary::fromExplain(
+        explainOutput(BSON("stage" << "LIMIT" << "inputStage" << BSON("stage" << "COLLSCAN")), 0, 120000, 20));
+    assert(collscan.plan == "COLLSCAN" && collscan.docsExamined == 120000);
+    assert(collscan.isCollectionScan() && collscan.isInefficient());
+
+    // $or uses every index once
+    mongo::BSONArrayBuilder inputs;
+    inputs.append(ixscan);
+    inputs.append(BSON("stage" << "IXSCAN" << "keyPattern" << BSON("b" << 1)));
+    inputs.append(ixscan);
+    QueryPlanSummary const orPlan = QueryPlanSummary::fromExplain(
+        explainOutput(BSON("stage" << "OR" << "inputStages" << inputs.arr()), 5000, 5000, 10));
+    assert(orPlan.plan == "IXSCAN { a: 1 }, IXSCAN { b: 1 }");
+    assert(!orPlan.isCollectionScan() && orPlan.isInefficient());
+
+    // Servers before 3.0
+    QueryPlanSummary const legacy = QueryPlanSummary::fromExplain(
+        BSON("cursor" << "BasicCursor" << "n" << 3 << "nscanned" << 2000 << "nscannedObjects" << 2000 << "millis" << 7));
+    assert(legacy.plan == "COLLSCAN" && legacy.returned == 3 && legacy.executionMs == 7);
+    assert(legacy.isCollectionScan() && legacy.isInefficient());
+
+    QueryPlanSummary const legacyIndexed = QueryPlanSummary::fromExplain(
+        BSON("cursor" << "BtreeCursor a_1" << "n" << 3 << "nscanned" << 3 << "nscannedObjects" << 3));
+    assert(legacyIndexed.plan == "IXSCAN a_1" && !legacyIndexed.isInefficient());
+
+    std::cout << "Query plan summary: correct." << std::endl;
+}
+
+void testFromjsonDocuments() {
+    // Top level array is parsed element by element, with the same result as a whole
+    std::string text = "[";
+    for (int i = 0; i < 2000; ++i)
+        text += (i ? ", " : "") + std::string(i % 2 ? "[1, {b: 2}]" : "{_id: ObjectId('5a0b6f8e1c9d440000a1b2c3'), a: 1.5}");
+    text += "]\n{c: 3}";
+    std::vector<mongo::BSONObj> const documents = mongo::Robomongo::fromjsonDocuments(text);
+    assert(documents.size() == 2);
+    assert(documents[0].binaryEqual(mongo::Robomongo::fromjson(text.substr(0, text.find('\n')))));
+    assert(documents[1]["c"].numberInt() == 3);
+
+    // Error offsets are the ones of the whole parse
+    text.replace(text.find("1.5"), 3, "1.5,,");
+    int wholeOffset = -1;
+    try {
+        mongo::Robomongo::fromjson(text);
+    } catch (const mongo::Robomongo::ParseMsgAssertionException &ex) {
+        wholeOffset = ex.offset();
+    }
+    try {
+        mongo::Robomongo::fromjsonDocuments(text);
+        assert(false);
+    } catch (const mongo::Robomongo::ParseMsgAssertionException &ex) {
+        assert(wholeOffset > 0 && ex.offset() == wholeOffset);
+    }
+
+    // Bounded parse does not read the number past its bound
+    try {
+        mongo::Robomongo::fromjson("{a: 12}", 6);
+        assert(false);
+    } catch (const mongo::Robomongo::ParseMsgAssertionException &ex) {
+        assert(ex.offset() <= 6);
+    }
+
+    std::cout << "fromjsonDocuments: correct." << std::endl;
+}
+
+void testIncrementalJsonParser() {
+    Robomongo::IncrementalJsonParser parser;
+    std::string text = "{a: 1}\n{b: {c: 2}}\n{d: 3}\n";
+    assert(parser.parse(text) == 3);
+    assert(parser.errors().empty() && parser.documents().size() == 3);
+
+    // Edit inside one document parses that document only
+    text.replace(text.find("c: 2"), 4, "c: 20");
+    assert(parser.parse(text) == 1);
+    assert(parser.documents()[1]["b"].Obj()["c"].numberInt() == 20);
+    assert(parser.parse(text) == 0);
+
+    // Every broken document has its own error
+    text.replace(text.find("a: 1"), 4, "a: ");
+    text.replace(text.find("d: 3"), 4, "d: 3,,");
+    parser.parse(text);
+    Robomongo::JsonErrors const errors = parser.errors();
+    assert(errors.size() == 2 && parser.documents().empty());
+    assert(errors[0].begin == 0 && errors[0].offset < errors[0].end);
+    assert(errors[1].offset > text.find("d:") && errors[1].end <= text.size());
+
+    // Document which becomes unbalanced joins the rest of text, as in full parse
+    text = "{a: 1}\n{b: {c: 2}}, d: 3}";
+    parser.parse(text);
+    assert(parser.errors().size() == 1);
+    text.erase(text.find("}}"), 1);
+    parser.parse(text);
+    assert(parser.errors().empty() && parser.documents().size() == 2);
+    assert(parser.documents()[1].hasField("d"));
+
+    std::cout << "Incremental JSON parser: correct." << std::endl;
+}
+
+void testDocumentPatch() {
+    mongo::BSONObj const original = BSON("_id" << 1 << "a" << BSON("b" << 1 << "c" << 2) <<
+                                         "list" << BSON_ARRAY(1 << 2 << 3) << "s" << "text");
+    Robomongo::DocumentPatch patch(original);
+    assert(patch.isEmpty() && patch.toUpdate().isEmpty());
+
+    // Original value is not a change
+    patch.set("a.b", original.getFieldDotted("a.b"));
+    assert(patch.isEmpty());
+
+    patch.set("a.b", BSON("" << 10).firstElement());
+    patch.set("list.1", BSON("" << "two").firstElement());
+    patch.unset("s");
+    assert(patch.element("a.b").numberInt() == 10 && patch.element("a.c").numberInt() == 2);
+    assert(patch.element("s").eoo());
+    assert(patch.isChanged("a") && patch.isChanged("a.b") && !patch.isChanged("a.c") && !patch.isChanged("_id"));
+    assert(patch.toUpdate() == BSON("$set" << BSON("a.b" << 10 << "list.1" << "two") << "$unset" << BSON("s" << "")));
+
+    patch.set("a.d", BSON("" << 3).firstElement());
+    auto const fields = patch.fields("a");
+    assert(fields.size() == 3 && fields[0].first == "b" && fields[1].first == "c" && fields[2].first == "d");
+    assert(fields[0].second.numberInt() == 10 && fields[2].second.numberInt() == 3);
+    auto const topFields = patch.fields("");
+    assert(topFields.size() == 3 && topFields[0].first == "_id" && topFields[2].first == "list");
+    assert(topFields[2].second.type() == mongo::Array);
+
+    // Replaced field drops changes inside of it, later changes inside of it are applied to its value
+    patch.set("a", BSON("" << BSON("x" << 1)).firstElement());
+    patch.set("a.y", BSON("" << 2).firstElement());
+    patch.set("a", patch.element("a"));
+    assert(patch.element("a.b").eoo() && patch.element("a.y").numberInt() == 2);
+    assert(patch.toUpdate().getObjectField("$set").getObjectField("a") == BSON("x" << 1 << "y" << 2));
+    assert(patch.size() == 3);
+
+    // Removed array element becomes null, as with $unset
+    patch.set("list", BSON("" << BSON_ARRAY(5 << 6)).firstElement());
+    patch.unset("list.0");
+    assert(patch.element("list.0").isNull() && patch.element("list.1").numberInt() == 6);
+
+    std::cout << "Document patch: correct." << std::endl;
+}
+
+void testDocumentPatchDiff() {
+    mongo::BSONObj const original = BSON("_id" << 1 << "a" << BSON("b" << 1 << "c" << 2) <<
+                                         "list" << BSON_ARRAY(1 << 2) << "n" << 1 << "s" << "text");
+    Robomongo::DocumentPatch patch(original);
+    assert(patch.diff(original) && patch.isEmpty());
+
+    // Equal number of other type is a change, appended elements are pushed
+    mongo::BSONObj const edited = BSON("_id" << 1 << "a" << BSON("b" << 1 << "c" << 3 << "d" << 4) <<
+                                       "list" << BSON_ARRAY(1 << 2 << 3 << 4) << "n" << 1.0);
+    assert(patch.diff(edited));
+    assert(patch.toUpdate() == BSON("$set" << BSON("a.c" << 3 << "a.d" << 4 << "n" << 1.0) <<
+                                    "$unset" << BSON("s" << "") <<
+                                    "$push" << BSON("list" << BSON("$each" << BSON_ARRAY(3 << 4)))));
+    assert(patch.toQuery(false) == BSON("_id" << 1));
+    assert(patch.toQuery(true) == BSON("_id" << 1 << "a.c" << BSON("$eq" << 2) << "a.d" << BSON("$exists" << false) <<
+                                       "list" << BSON("$size" << 2) << "n" << BSON("$eq" << 1) <<
+                                       "s" << BSON("$eq" << "text")));
+
+    // Other change of pushed array sets it
+    patch.set("list.3", BSON("" << 7).firstElement());
+    assert(patch.toUpdate().getObjectField("$push").isEmpty());
+    assert(patch.toUpdate().getObjectField("$set")["list"].Obj() == BSON_ARRAY(1 << 2 << 3 << 7));
+
+    // Element of array of the same length is set, reordered object and shortened array are replaced
+    assert(patch.diff(BSON("_id" << 1 << "a" << BSON("c" << 2 << "b" << 1) << "list" << BSON_ARRAY(1 << 5) <<
+                           "n" << 1 << "s" << "text")));
+    assert(patch.toUpdate() == BSON("$set" << BSON("a" << BSON("c" << 2 << "b" << 1) << "list.1" << 5)));
+    assert(patch.diff(BSON("_id" << 1 << "a" << BSON("b" << 1 << "c" << 2) << "list" << BSON_ARRAY(2))));
+    assert(patch.toUpdate() == BSON("$set" << BSON("list" << BSON_ARRAY(2)) << "$unset" << BSON("n" << "" << "s" << "")));
+
+    // Changed _id or order of document fields cannot be made by update, patch is kept
+    assert(!patch.diff(BSON("_id" << 2)));
+    assert(!patch.diff(BSON("_id" << 1 << "s" << "text" << "n" << 1)));
+    assert(patch.size() == 3);
+
+    std::cout << "Document patch diff: correct." << std::endl;
+}
+
+void testTextRangeSet() {
+    typedef Robomongo::TextRangeSet::Range Range;
+    Robomongo::TextRangeSet ranges;
+    ranges.add(10, 20);
+    ranges.add(30, 40);
+    ranges.add(20, 25);     // adjacent ranges are merged
+    assert(ranges.ranges() == (std::map<int, int>{ { 10, 25 }, { 30, 40 } }));
+    assert(ranges.intersect(0, 35) == (std::vector<Range>{ Range(10, 25), Range(30, 35) }));
+    assert(ranges.intersect(25, 30).empty());
+
+    ranges.remove(15, 32);
+    assert(ranges.ranges() == (std::map<int, int>{ { 10, 15 }, { 32, 40 } }));
+
+    // Ranges follow the text: insertion inside grows range, removal of text with range drops it
+    ranges.inserted(12, 5);
+    ranges.inserted(37, 3);
+    assert(ranges.ranges() == (std::map<int, int>{ { 10, 20 }, { 40, 48 } }));
+    ranges.removed(5, 20);
+    assert(ranges.ranges() == (std::map<int, int>{ { 20, 28 } }));
+    ranges.removed(18, 4);
+    assert(ranges.ranges() == (std::map<int, int>{ { 18, 24 } }));
+
+    std::cout << "Text range set: correct." << std::endl;
+}
+
+void testScriptUtils() {
+    using Robomongo::ScriptUtils::isReadOnlyScript;
+    assert(isReadOnlyScript("db.getCollection('orders').find({ total: { $gt: 0x1F } }).limit(10)"));
+    assert(isReadOnlyScript("use shop\ndb.orders.aggregate([{ $match: { updated: 1e5 } }])"));
+    assert(isReadOnlyScript("db.orders.count(); db.orders.distinct('insertedBy')"));
+
+    assert(isReadOnlyScript("var total = 0;\nfor (var i = 0; i < 3; i++) { total += db.orders.find().itcount(); }"));
+
+    // Any call which is not known to be read-only makes script run on primary
+    assert(!isReadOnlyScript("db.orders.insertOne({ a: 1 })"));
+    assert(!isReadOnlyScript("db.orders.find().forEach(function(d) { db.copy.save(d); })"));
+    assert(!isReadOnlyScript("db.runCommand({ dbStats: 1 })"));
+    assert(!isReadOnlyScript("db.changeUserPassword('app', 'secret')"));
+    assert(!isReadOnlyScript("db.orders.copyTo('backup')"));
+    assert(!isReadOnlyScript("db.setProfilingLevel (2)"));
+    assert(!isReadOnlyScript("db.orders['remove']({})"));
+    assert(!isReadOnlyScript("(function() { return 1; })()"));
+
+    // Writing aggregation stages too, even inside strings
+    assert(!isReadOnlyScript("db.orders.aggregate([{ \"$out\": \"copy\" }])"));
+    assert(!isReadOnlyScript("db.orders.aggregate([{ $merge: { into: 'copy' } }])"));
+
+    assert(Robomongo::ScriptUtils::isNotMasterError("Error: not master and slaveOk=false"));
+    assert(!Robomongo::ScriptUtils::isNotMasterError("Error: socket exception"));
+
+    std::cout << "Script utils: correct." << std::endl;
+}
+
 int main(int argc, char *argv[], char** envp)
 {
+    mongo::runGlobalInitializersOrDie(argc, argv, envp);
+
     testHostAndPort();
     testPrecision();
+    testMockServer();
+    testMongoClient();
+    testIsoDateParser();
+    testRingBuffer();
+    testMpscQueue();
+    testServerStatusRates();
+    testQueryPlanSummary();
+    testHexUtils();
+    testFromjsonDocuments();
+    testIncrementalJsonParser();
+    testDocumentPatch();
+    testDocumentPatchDiff();
+    testTextRangeSet();
+    testScriptUtils();
     return 0;
 }
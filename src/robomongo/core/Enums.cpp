@@ -6,6 +6,7 @@ namespace
     const char *viewModeAsoc[Robomongo::Custom+1] = {"Text mode", "Tree mode", "Table mode", "Custom mode"};
     const char *timesAsoc[Robomongo::LocalTime+1] = {"UTC", "Local Timezone"};
     const char *uuidAsoc[Robomongo::PythonLegacy+1] = {"Default encoding", "Java encoding", "CSharp encoding", "Python encoding"};
+    const char *readPrefAsoc[Robomongo::ReadNearest+1] = {"primary", "secondaryPreferred", "nearest"};
 
     template<typename type, int size>
     inline type findTypeInArray(const char *(&arr)[size], const char *text)
@@ -52,5 +53,15 @@ namespace Robomongo
     {
         return findTypeInArray<ViewMode>(viewModeAsoc, text);
     }
+
+    const char *convertReadPreferenceToString(ReadPreferenceMode mode)
+    {
+        return readPrefAsoc[mode];
+    }
+
+    ReadPreferenceMode convertStringToReadPreference(const char *text)
+    {
+        return findTypeInArray<ReadPreferenceMode>(readPrefAsoc, text);
+    }
 }
 
@@ -31,6 +31,13 @@ namespace Robomongo
         AutocompleteNoCollectionNames = 2
     };
 
+    enum ReadPreferenceMode
+    {
+        ReadPrimary            = 0,
+        ReadSecondaryPreferred = 1,
+        ReadNearest            = 2
+    };
+
     const char *convertUUIDEncodingToString(UUIDEncoding uuidCode);
     UUIDEncoding convertStringToUUIDEncoding(const char *text);
 
@@ -39,5 +46,8 @@ namespace Robomongo
 
     const char *convertViewModeToString(ViewMode mode);
     ViewMode convertStringToViewMode(const char *text);
+
+    const char *convertReadPreferenceToString(ReadPreferenceMode mode);
+    ReadPreferenceMode convertStringToReadPreference(const char *text);
 }
 
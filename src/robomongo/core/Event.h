@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include <QObject>
 #include <QString>
 #include <QEvent>
@@ -19,7 +21,8 @@ namespace Robomongo
          * @brief Creates "non-error" event.
          */
         Event(QObject *sender) :
-            _sender(sender) {}
+            _sender(sender),
+            _createdAtNs(monotonicNs()) {}
 
         /**
          * @brief Creates "error-event" that highlights that state of this
@@ -27,7 +30,8 @@ namespace Robomongo
          */
         Event(QObject *sender, const EventError &error) :
             _sender(sender),
-            _error(error) { }
+            _error(error),
+            _createdAtNs(monotonicNs()) { }
 
         virtual ~Event() { }
 
@@ -58,6 +62,25 @@ namespace Robomongo
          */
         const EventError &error() const { return _error; }
 
+        /**
+         * @brief Time (see monotonicNs()) when event was created, i.e. enqueued to receiver.
+         */
+        long long createdAtNs() const { return _createdAtNs; }
+
+        /**
+         * @brief Approximate size in bytes of data carried by this event (script, documents).
+         * Used for worker metrics, zero for events without significant payload.
+         */
+        virtual long long payloadSize() const { return 0; }
+
+        /**
+         * @brief Monotonic clock in nanoseconds
+         */
+        static long long monotonicNs() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
     private:
         /**
          * @brief Sender that emits this event.
@@ -68,6 +91,11 @@ namespace Robomongo
          * @brief Possible error.
          */
         const EventError _error;
+
+        /**
+         * @brief Creation time, see createdAtNs()
+         */
+        const long long _createdAtNs;
     };
 }
 
@@ -1,4 +1,7 @@
 #include "robomongo/core/EventBusDispatcher.h"
+
+#include <QMetaMethod>
+
 #include "robomongo/core/EventWrapper.h"
 
 namespace Robomongo
@@ -22,9 +25,31 @@ namespace Robomongo
         const char *typeName = event->typeString();
         const QList<QObject*> &recivers = wrapper->receivers();
         for (QList<QObject*>::const_iterator it = recivers.begin(); it != recivers.end(); ++it) {
+            // Receivers which have slot 'handled(Event*,qint64,qint64)' are told how long handle(...) took
+            const QMetaObject *metaObject = (*it)->metaObject();
+            int const slot = timingSlot(metaObject);
+            qint64 const startNs = slot != -1 ? Event::monotonicNs() : 0;
+
             QMetaObject::invokeMethod(*it, "handle", QGenericArgument(typeName, &event));
+
+            if (slot != -1) {
+                qint64 const endNs = Event::monotonicNs();
+                metaObject->method(slot).invoke(*it, Qt::DirectConnection, Q_ARG(Event*, event),
+                                                      Q_ARG(qint64, startNs), Q_ARG(qint64, endNs));
+            }
         }
 
         return true;
     }
+
+    int EventBusDispatcher::timingSlot(const QMetaObject *metaObject)
+    {
+        auto const it = _timingSlots.find(metaObject);
+        if (it != _timingSlots.end())
+            return it->second;
+
+        int const slot = metaObject->indexOfSlot("handled(Event*,qint64,qint64)");
+        _timingSlots.emplace(metaObject, slot);
+        return slot;
+    }
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <QObject>
+#include <unordered_map>
 
 namespace Robomongo
 {
@@ -13,5 +14,14 @@ namespace Robomongo
         EventBusDispatcher(QObject *parent = 0);
     protected:
         virtual bool event(QEvent *qevent);
+
+    private:
+        /**
+         * @brief Index of slot 'handled(Event*,qint64,qint64)' of class, -1 if it has none
+         */
+        int timingSlot(const QMetaObject *metaObject);
+
+        // Dispatcher is used by its own thread only, so cache is not locked
+        std::unordered_map<const QMetaObject *, int> _timingSlots;
     };
 }
@@ -1,8 +1,151 @@
 #include "robomongo/core/HexUtils.h"
 
-#include <mongo/util/hex.h>
-#include <pcrecpp.h>
-#include <iostream>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+#include <mongo/util/base64.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROBOMONGO_HEX_SSE2
+#endif
+
+namespace
+{
+    using Robomongo::UUIDEncoding;
+
+    const char hexDigits[] = "0123456789abcdef";
+
+    // Byte of stored BinData for every byte of UUID string. Every order is its own inverse,
+    // so the same table converts in both directions.
+    const unsigned char byteOrders[][Robomongo::HexUtils::uuidSize] = {
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },    // DefaultEncoding
+        { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 },    // JavaLegacy: both halves reversed
+        { 3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15 },    // CSharpLegacy: first three fields reversed
+        { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 }     // PythonLegacy
+    };
+
+    // Hex digits of groups of UUID string, separated by dashes
+    const int uuidGroups[] = { 8, 4, 4, 4, 12 };
+
+    // Value of hex digit for every char, -1 for other chars
+    struct HexValues
+    {
+        HexValues()
+        {
+            std::memset(values, -1, sizeof(values));
+            for (int i = 0; i < 16; ++i) {
+                values[static_cast<unsigned char>(hexDigits[i])] = static_cast<signed char>(i);
+                values[static_cast<unsigned char>(std::toupper(hexDigits[i]))] = static_cast<signed char>(i);
+            }
+        }
+
+        signed char values[256];
+    };
+
+    const HexValues hexValues;
+
+    int hexValue(char c)
+    {
+        return hexValues.values[static_cast<unsigned char>(c)];
+    }
+
+    const unsigned char *byteOrder(UUIDEncoding encoding)
+    {
+        return byteOrders[encoding >= Robomongo::DefaultEncoding && encoding <= Robomongo::PythonLegacy
+                          ? encoding : Robomongo::DefaultEncoding];
+    }
+
+    // Reorder pairs of hex digits of UUID
+    void permuteHex(const char *hex, UUIDEncoding encoding, char *out)
+    {
+        const unsigned char *order = byteOrder(encoding);
+        for (int i = 0; i < Robomongo::HexUtils::uuidSize; ++i) {
+            out[2 * i] = hex[2 * order[i]];
+            out[2 * i + 1] = hex[2 * order[i] + 1];
+        }
+    }
+
+    // 32 hex digits to 36 chars of UUID string
+    void insertDashes(const char *hex, char *out)
+    {
+        for (int group = 0; group < 5; ++group) {
+            if (group > 0)
+                *out++ = '-';
+            std::memcpy(out, hex, uuidGroups[group]);
+            out += uuidGroups[group];
+            hex += uuidGroups[group];
+        }
+    }
+
+    // UUID string with optional braces and dashes to 32 hex digits, not validated
+    bool removeDashes(const std::string &uuid, char *out)
+    {
+        int length = 0;
+        for (char const c : uuid) {
+            if (c == '{' || c == '}' || c == '-')
+                continue;
+            if (length == Robomongo::HexUtils::uuidHexLength)
+                return false;
+            out[length++] = c;
+        }
+        return length == Robomongo::HexUtils::uuidHexLength;
+    }
+
+#ifdef ROBOMONGO_HEX_SSE2
+    __m128i nibblesToHex(__m128i nibbles)
+    {
+        __m128i const letters = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+        return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')),
+                            _mm_and_si128(letters, _mm_set1_epi8('a' - '0' - 10)));
+    }
+
+    // 16 bytes to 32 hex digits
+    void encode16(const char *raw, char *out)
+    {
+        __m128i const bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(raw));
+        __m128i const mask = _mm_set1_epi8(0x0f);
+        __m128i const high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+        __m128i const low = _mm_and_si128(bytes, mask);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), nibblesToHex(_mm_unpacklo_epi8(high, low)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), nibblesToHex(_mm_unpackhi_epi8(high, low)));
+    }
+
+    // 16 hex digits to 8 bytes, widened to 16-bit lanes. Returns false for non-hex chars.
+    bool decode16(const char *hex, __m128i &out)
+    {
+        __m128i const chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hex));
+        __m128i const lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+
+        // Chars above 0x7f are negative and fail both ranges
+        __m128i const digits = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+                                             _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chars));
+        __m128i const letters = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                              _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+        if (_mm_movemask_epi8(_mm_or_si128(digits, letters)) != 0xFFFF)
+            return false;
+
+        __m128i const nibbles = _mm_or_si128(_mm_and_si128(digits, _mm_sub_epi8(chars, _mm_set1_epi8('0'))),
+                                             _mm_and_si128(letters, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+
+        // Every 16-bit lane holds high nibble in its low byte and low nibble in its high byte
+        out = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00ff)), 4),
+                           _mm_srli_epi16(nibbles, 8));
+        return true;
+    }
+
+    // 32 hex digits to 16 bytes
+    bool decode32(const char *hex, char *out)
+    {
+        __m128i first, second;
+        if (!decode16(hex, first) || !decode16(hex + 16, second))
+            return false;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(first, second));
+        return true;
+    }
+#endif
+}
 
 namespace Robomongo
 {
@@ -10,151 +153,154 @@ namespace Robomongo
     {
         bool isHexString(const std::string &str)
         {
-            std::size_t i;
-            for (i = 0; i < str.size(); i++) {
-                if (!isxdigit(str[i])) {
+            for (char const c : str) {
+                if (hexValue(c) < 0)
                     return false;
-                }
             }
             return true;
         }
 
         std::string toStdHexLower(const char *raw, int len)
         {
-            const void* in = reinterpret_cast<const void*>(raw);
-            std::string stdstr = mongo::toHexLower(in, len);
-            return stdstr;
+            std::string hex(2 * len, '\0');
+            toHexLower(raw, len, &hex[0]);
+            return hex;
         }
 
-        const char *fromHex(const std::string &s, int *outBytes)
+        void toHexLower(const char *raw, size_t len, char *out)
         {
-            const int size = s.size();
-            if (size % 2 != 0)
-                return NULL;
+            size_t i = 0;
+#ifdef ROBOMONGO_HEX_SSE2
+            for (; i + 16 <= len; i += 16)
+                encode16(raw + i, out + 2 * i);
+#endif
+            for (; i < len; ++i) {
+                unsigned char const byte = static_cast<unsigned char>(raw[i]);
+                out[2 * i] = hexDigits[byte >> 4];
+                out[2 * i + 1] = hexDigits[byte & 0x0f];
+            }
+        }
 
-            const int bytes = size / 2; // number of bytes
-            char *data = new char[bytes];
+        bool fromHex(const char *hex, size_t length, char *out)
+        {
+            if (length % 2 != 0)
+                return false;
 
-            const char *p = s.c_str();
-            for (size_t i = 0; i < bytes; i++) {
-                data[i] = mongo::fromHex(p);
-                p += 2;
+            size_t i = 0;
+#ifdef ROBOMONGO_HEX_SSE2
+            for (; i + 32 <= length; i += 32) {
+                if (!decode32(hex + i, out + i / 2))
+                    return false;
             }
+#endif
+            for (; i < length; i += 2) {
+                int const high = hexValue(hex[i]);
+                int const low = hexValue(hex[i + 1]);
+                if (high < 0 || low < 0)
+                    return false;
+                out[i / 2] = static_cast<char>((high << 4) | low);
+            }
+            return true;
+        }
+
+        void formatUuidBytes(const char *bytes, UUIDEncoding encoding, char *out)
+        {
+            const unsigned char *order = byteOrder(encoding);
+            char permuted[uuidSize];
+            for (int i = 0; i < uuidSize; ++i)
+                permuted[i] = bytes[order[i]];
 
-            *outBytes = bytes;
-            return data;
+            char hex[uuidHexLength];
+            toHexLower(permuted, uuidSize, hex);
+            insertDashes(hex, out);
+        }
+
+        bool parseUuidBytes(const std::string &uuid, UUIDEncoding encoding, char *out)
+        {
+            char hex[uuidHexLength];
+            char bytes[uuidSize];
+            if (!removeDashes(uuid, hex) || !fromHex(hex, uuidHexLength, bytes))
+                return false;
+
+            const unsigned char *order = byteOrder(encoding);
+            for (int i = 0; i < uuidSize; ++i)
+                out[i] = bytes[order[i]];
+            return true;
         }
 
         std::string hexToUuid(const std::string &hex, UUIDEncoding encoding)
         {
-            switch(encoding) {
-            case DefaultEncoding: return hexToUuid(hex);
-            case JavaLegacy:      return hexToJavaUuid(hex);
-            case CSharpLegacy:    return hexToCSharpUuid(hex);
-            case PythonLegacy:    return hexToPythonUuid(hex);
-            default:              return hexToUuid(hex);
-            }
+            if (hex.size() != uuidHexLength)
+                return std::string();
+
+            char permuted[uuidHexLength];
+            permuteHex(hex.data(), encoding, permuted);
+
+            std::string uuid(uuidStringLength, '-');
+            insertDashes(permuted, &uuid[0]);
+            return uuid;
         }
 
         std::string hexToUuid(const std::string &hex)
         {
-            std::string uuid = hex.substr(0, 8) + '-' + hex.substr(8, 4) + '-' + hex.substr(12, 4) + '-' + hex.substr(16, 4) + '-' + hex.substr(20, 12);
-            return uuid;
+            return hexToUuid(hex, DefaultEncoding);
         }
 
         std::string hexToCSharpUuid(const std::string &hex)
         {
-            std::string a = hex.substr(6, 2) + hex.substr(4, 2) + hex.substr(2, 2) + hex.substr(0, 2);
-            std::string b = hex.substr(10, 2) + hex.substr(8, 2);
-            std::string c = hex.substr(14, 2) + hex.substr(12, 2);
-            std::string d = hex.substr(16, 16);
-            std::string temp = a + b + c + d;
-            std::string uuid = temp.substr(0, 8) + '-' + temp.substr(8, 4) + '-' + temp.substr(12, 4) + '-' + temp.substr(16, 4) + '-' + temp.substr(20, 12);
-            return uuid;
+            return hexToUuid(hex, CSharpLegacy);
         }
 
         std::string hexToJavaUuid(const std::string &hex)
         {
-            std::string msb = hex.substr(0, 16);
-            std::string lsb = hex.substr(16, 16);
-            msb = msb.substr(14, 2) + msb.substr(12, 2) + msb.substr(10, 2) + msb.substr(8, 2) + msb.substr(6, 2) + msb.substr(4, 2) + msb.substr(2, 2) + msb.substr(0, 2);
-            lsb = lsb.substr(14, 2) + lsb.substr(12, 2) + lsb.substr(10, 2) + lsb.substr(8, 2) + lsb.substr(6, 2) + lsb.substr(4, 2) + lsb.substr(2, 2) + lsb.substr(0, 2);
-            std::string temp = msb + lsb;
-            std::string uuid = temp.substr(0, 8) + '-' + temp.substr(8, 4) + '-' + temp.substr(12, 4) + '-' + temp.substr(16, 4) + '-' + temp.substr(20, 12);
-            return uuid;
+            return hexToUuid(hex, JavaLegacy);
         }
 
         std::string hexToPythonUuid(const std::string &hex)
         {
-            return hexToUuid(hex);
+            return hexToUuid(hex, PythonLegacy);
         }
 
         std::string uuidToHex(const std::string &uuid, Robomongo::UUIDEncoding encoding)
         {
-            switch(encoding) {
-            case DefaultEncoding: return uuidToHex(uuid);
-            case JavaLegacy:      return javaUuidToHex(uuid);
-            case CSharpLegacy:    return csharpUuidToHex(uuid);
-            case PythonLegacy:    return pythonUuidToHex(uuid);
-            default:              return uuidToHex(uuid);
-            }
+            char hex[uuidHexLength];
+            if (!removeDashes(uuid, hex))
+                return "";
+
+            std::string result(uuidHexLength, '\0');
+            permuteHex(hex, encoding, &result[0]);
+            return result;
         }
 
         std::string uuidToHex(const std::string &uuid)
         {
-            // remove extra characters
-            std::string hex = uuid;
-            pcrecpp::RE re("[{}-]");
-            re.GlobalReplace("", &hex);
-
-            if (hex.size() != 32)
-                return "";
-
-            return hex;
+            return uuidToHex(uuid, DefaultEncoding);
         }
 
         std::string csharpUuidToHex(const std::string &uuid)
         {
-            // remove extra characters
-            std::string hex = uuid;
-            pcrecpp::RE re("[{}-]");
-            re.GlobalReplace("", &hex);
-
-            if (hex.size() != 32)
-                return "";
-
-            std::string a = hex.substr(6, 2) + hex.substr(4, 2) + hex.substr(2, 2) + hex.substr(0, 2);
-            std::string b = hex.substr(10, 2) + hex.substr(8, 2);
-            std::string c = hex.substr(14, 2) + hex.substr(12, 2);
-            std::string d = hex.substr(16, 16);
-            std::string result = a + b + c + d;
-            return result;
+            return uuidToHex(uuid, CSharpLegacy);
         }
 
         std::string javaUuidToHex(const std::string &uuid)
         {
-            // remove extra characters
-            std::string hex = uuid;
-            pcrecpp::RE re("[{}-]");
-            re.GlobalReplace("", &hex);
-
-            if (hex.size() != 32)
-                return "";
-
-            std::string msb = hex.substr(0, 16);
-            std::string lsb = hex.substr(16, 16);
-            msb = msb.substr(14, 2) + msb.substr(12, 2) + msb.substr(10, 2) + msb.substr(8, 2) + msb.substr(6, 2) + msb.substr(4, 2) + msb.substr(2, 2) + msb.substr(0, 2);
-            lsb = lsb.substr(14, 2) + lsb.substr(12, 2) + lsb.substr(10, 2) + lsb.substr(8, 2) + lsb.substr(6, 2) + lsb.substr(4, 2) + lsb.substr(2, 2) + lsb.substr(0, 2);
-            std::string result = msb + lsb;
-            return result;
+            return uuidToHex(uuid, JavaLegacy);
         }
 
         std::string pythonUuidToHex(const std::string &uuid)
         {
-            return uuidToHex(uuid);
+            return uuidToHex(uuid, PythonLegacy);
         }
 
         std::string formatUuid(const mongo::BSONElement &element, Robomongo::UUIDEncoding encoding)
+        {
+            std::string result;
+            result.reserve(uuidStringLength + 10);
+            appendFormattedUuid(element, encoding, result);
+            return result;
+        }
+
+        void appendFormattedUuid(const mongo::BSONElement &element, UUIDEncoding encoding, std::string &out)
         {
             mongo::BinDataType binType = element.binDataType();
 
@@ -163,22 +309,30 @@ namespace Robomongo
 
             int len;
             const char *data = element.binData(len);
-            std::string hex = HexUtils::toStdHexLower(data, len);
+            if (len != uuidSize) {
+                out += "BinData(" + std::to_string(binType) + ", \"" + mongo::base64::encode(data, len) + "\")";
+                return;
+            }
 
+            const char *prefix = "UUID(\"";
             if (binType == mongo::bdtUUID) {
-                std::string uuid = HexUtils::hexToUuid(hex, encoding);
-
                 switch(encoding) {
-                case DefaultEncoding: return "LUUID(\"" + uuid + "\")";
-                case JavaLegacy:      return "JUUID(\"" + uuid + "\")";
-                case CSharpLegacy:    return "NUUID(\"" + uuid + "\")";
-                case PythonLegacy:    return "PYUUID(\"" + uuid + "\")";
-                default:              return "LUUID(\"" + uuid + "\")";
+                case DefaultEncoding: prefix = "LUUID(\""; break;
+                case JavaLegacy:      prefix = "JUUID(\""; break;
+                case CSharpLegacy:    prefix = "NUUID(\""; break;
+                case PythonLegacy:    prefix = "PYUUID(\""; break;
+                default:              prefix = "LUUID(\""; break;
                 }
-            } else {
-                std::string uuid = HexUtils::hexToUuid(hex, DefaultEncoding);
-                return "UUID(\"" + uuid + "\")";
             }
+            else {
+                encoding = DefaultEncoding;
+            }
+
+            char uuid[uuidStringLength];
+            formatUuidBytes(data, encoding, uuid);
+            out.append(prefix);
+            out.append(uuid, uuidStringLength);
+            out.append("\")");
         }
     }
 }
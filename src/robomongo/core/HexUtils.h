@@ -19,17 +19,43 @@ namespace Robomongo
      *  std::string puuid = HexUtils::hexToPythonUuid(hex.toStdString());
      *  std::string phex  = HexUtils::pythonUuidToHex(puuid);*
      *
+     *  Conversions work on fixed-size buffers: legacy encodings only differ in byte order,
+     *  which is given by permutation table of every encoding.
      */
     namespace HexUtils
     {
+        enum { uuidSize = 16 };             // bytes of BinData
+        enum { uuidHexLength = 32 };        // hex digits without dashes
+        enum { uuidStringLength = 36 };     // "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"
+
         bool isHexString(const std::string &hex);
         std::string toStdHexLower(const char *raw, int len);
+
+        /**
+         * @brief Write lower-case hex of 'len' bytes of 'raw' to 'out', which holds 2 * len chars.
+         */
+        void toHexLower(const char *raw, size_t len, char *out);
+
+        /**
+         * @param hex: data in hex format, 'length' chars.
+         * @param out: out param - length / 2 bytes.
+         * @return false if length is odd or 'hex' has non-hex characters.
+         */
+        bool fromHex(const char *hex, size_t length, char *out);
+
         /**
-         * @param str: data in hex format.
-         * @param outBytes: out param - number of bytes in array.
-         * @return array of bytes, with "outBytes" length.
+         * @brief Write UUID string (uuidStringLength chars, not terminated) of 16 BinData bytes
+         *        which are stored in byte order of 'encoding'.
          */
-        const char *fromHex(const std::string &str, int *outBytes);
+        void formatUuidBytes(const char *bytes, UUIDEncoding encoding, char *out);
+
+        /**
+         * @brief Parse UUID string with optional braces and dashes to 16 BinData bytes
+         *        in byte order of 'encoding'.
+         * @return false if 'uuid' does not have 32 hex digits.
+         */
+        bool parseUuidBytes(const std::string &uuid, UUIDEncoding encoding, char *out);
+
         std::string hexToUuid(const std::string &hex, UUIDEncoding encoding);
         std::string hexToUuid(const std::string &hex);
         std::string hexToCSharpUuid(const std::string &hex);
@@ -43,6 +69,12 @@ namespace Robomongo
         std::string csharpUuidToHex(const std::string &uuid);
         std::string javaUuidToHex(const std::string &uuid);
         std::string pythonUuidToHex(const std::string &uuid);
+
+        /**
+         * @brief Shell representation of UUID BinData, i.e. JUUID("...") for legacy UUID
+         *        in Java encoding. UUID of wrong length is shown as BinData(subtype, "base64").
+         */
         std::string formatUuid(const mongo::BSONElement &element, UUIDEncoding encoding);
+        void appendFormattedUuid(const mongo::BSONElement &element, UUIDEncoding encoding, std::string &out);
     }
 }
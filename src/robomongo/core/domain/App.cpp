@@ -247,15 +247,7 @@ namespace Robomongo
     }
 
     void App::handle(LogEvent *event) {
-        if (event->level == LogEvent::RBM_ERROR) {
-            LOG_MSG(event->message, mongo::logger::LogSeverity::Error());
-        } else if (event->level == LogEvent::RBM_WARN) {
-            LOG_MSG(event->message, mongo::logger::LogSeverity::Warning());
-        } else if (event->level == LogEvent::RBM_INFO) {
-            LOG_MSG(event->message, mongo::logger::LogSeverity::Info());
-        } else if (event->level == LogEvent::RBM_DEBUG) {
-            LOG_MSG(event->message, mongo::logger::LogSeverity::Log());
-        }
+        LOG_MSG(event->message, LogEvent::severity(event->level));
     }
 
     void App::handle(ListenSshConnectionResponse *event) {
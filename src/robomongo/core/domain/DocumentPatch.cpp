@@ -0,0 +1,473 @@
+#include "robomongo/core/domain/DocumentPatch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <mongo/bson/bsonobjbuilder.h>
+
+namespace
+{
+    bool isInside(const std::string &path, const std::string &ancestor)
+    {
+        return path.size() > ancestor.size() && path[ancestor.size()] == '.' &&
+               path.compare(0, ancestor.size(), ancestor) == 0;
+    }
+
+    /**
+     * @brief Strict ancestors of dotted path, from the outermost: "a", "a.b" for "a.b.c"
+     */
+    std::vector<std::string> ancestors(const std::string &path)
+    {
+        std::vector<std::string> result;
+        for (size_t dot = path.find('.'); dot != std::string::npos; dot = path.find('.', dot + 1))
+            result.push_back(path.substr(0, dot));
+        return result;
+    }
+
+    bool isAddressable(const char *name)
+    {
+        return name[0] != '\0' && name[0] != '$' && std::strchr(name, '.') == NULL;
+    }
+
+    /**
+     * @brief Same type and the same bytes of value, unlike woCompare() which finds
+     *        1 and 1.0 or differently ordered objects equal
+     */
+    bool sameValue(const mongo::BSONElement &left, const mongo::BSONElement &right)
+    {
+        return left.type() == right.type() && left.valuesize() == right.valuesize() &&
+               std::memcmp(left.value(), right.value(), left.valuesize()) == 0;
+    }
+
+    typedef std::unordered_map<std::string, mongo::BSONElement> Fields;
+
+    Fields fieldsByName(const mongo::BSONObj &obj)
+    {
+        Fields fields;
+        mongo::BSONObjIterator it(obj);
+        while (it.more()) {
+            mongo::BSONElement const element = it.next();
+            fields.emplace(element.fieldName(), element);
+        }
+        return fields;
+    }
+
+    /**
+     * @brief True if 'edited' can be made from 'original' by changing fields one by one:
+     *        names can be used in paths, kept fields have the same order and new fields
+     *        follow them in order of names, as $set appends new fields.
+     */
+    bool keepsOrder(const mongo::BSONObj &original, const Fields &originalFields,
+                    const mongo::BSONObj &edited, const Fields &editedFields)
+    {
+        mongo::BSONObjIterator kept(original);
+        const char *added = NULL;
+        mongo::BSONObjIterator it(edited);
+        while (it.more()) {
+            const char *name = it.next().fieldName();
+            if (!isAddressable(name))
+                return false;
+
+            if (!originalFields.count(name)) {
+                if (added && std::strcmp(added, name) >= 0)
+                    return false;
+                added = name;
+                continue;
+            }
+
+            if (added)
+                return false;
+
+            // Next original field which is not removed should be this one
+            for (;;) {
+                if (!kept.more())
+                    return false;
+                const char *next = kept.next().fieldName();
+                if (!isAddressable(next))
+                    return false;
+                if (editedFields.count(next)) {
+                    if (std::strcmp(next, name) != 0)
+                        return false;
+                    break;
+                }
+            }
+        }
+
+        // Removed fields which follow the last kept one
+        while (kept.more()) {
+            if (!isAddressable(kept.next().fieldName()))
+                return false;
+        }
+        return true;
+    }
+
+    void appendOriginal(mongo::BSONObjBuilder &query, const std::string &path, const mongo::BSONElement &original)
+    {
+        mongo::BSONObjBuilder condition(query.subobjStart(path));
+        if (original.eoo())
+            condition.append("$exists", false);
+        else
+            condition.appendAs(original, "$eq");    // plain value would be operator or regex
+        condition.done();
+    }
+
+    mongo::BSONObj wrap(const mongo::BSONElement &value)
+    {
+        mongo::BSONObjBuilder builder;
+        builder.appendAs(value, "");
+        return builder.obj();
+    }
+
+    /**
+     * @brief Copy of 'obj' with field at dotted 'path' replaced, or removed if 'value' is EOO.
+     *        Missing objects on the path are created, as $set does.
+     */
+    mongo::BSONObj withField(const mongo::BSONObj &obj, bool isArray, const std::string &path, const mongo::BSONElement &value)
+    {
+        size_t const dot = path.find('.');
+        std::string const name = path.substr(0, dot);
+        std::string const rest = dot == std::string::npos ? std::string() : path.substr(dot + 1);
+
+        mongo::BSONObjBuilder builder;
+        bool found = false;
+        mongo::BSONObjIterator it(obj);
+        while (it.more()) {
+            mongo::BSONElement const elem = it.next();
+            if (name != elem.fieldName()) {
+                builder.append(elem);
+                continue;
+            }
+
+            found = true;
+            if (!rest.empty()) {
+                if (!elem.isABSONObj()) {
+                    builder.append(elem);
+                } else if (elem.type() == mongo::Array) {
+                    builder.appendArray(name, withField(elem.embeddedObject(), true, rest, value));
+                } else {
+                    builder.append(name, withField(elem.embeddedObject(), false, rest, value));
+                }
+            } else if (!value.eoo()) {
+                builder.appendAs(value, name);
+            } else if (isArray) {
+                builder.appendNull(name);
+            }
+        }
+
+        if (!found && !value.eoo()) {
+            if (rest.empty())
+                builder.appendAs(value, name);
+            else
+                builder.append(name, withField(mongo::BSONObj(), false, rest, value));
+        }
+
+        return builder.obj();
+    }
+}
+
+namespace Robomongo
+{
+    DocumentPatch::DocumentPatch(const mongo::BSONObj &original) :
+        _original(original.getOwned()) {}
+
+    mongo::BSONElement DocumentPatch::element(const std::string &path) const
+    {
+        std::vector<std::string> paths = ancestors(path);
+        paths.push_back(path);
+
+        for (const std::string &changed : paths) {
+            auto const set = _sets.find(changed);
+            if (set != _sets.end()) {
+                mongo::BSONElement const value = set->second.firstElement();
+                if (changed == path)
+                    return value;
+                return value.isABSONObj() ? value.embeddedObject().getFieldDotted(path.substr(changed.size() + 1))
+                                          : mongo::BSONElement();
+            }
+
+            if (_unsets.count(changed))
+                return mongo::BSONElement();
+        }
+
+        return _original.getFieldDotted(path);
+    }
+
+    std::vector<std::pair<std::string, mongo::BSONElement>> DocumentPatch::fields(const std::string &path) const
+    {
+        std::vector<std::pair<std::string, mongo::BSONElement>> fields;
+        mongo::BSONElement const container = path.empty() ? mongo::BSONElement() : element(path);
+        if (!path.empty() && !container.isABSONObj())
+            return fields;
+
+        // Paths never overlap, so field is changed only by change of its own path
+        std::string const prefix = path.empty() ? std::string() : path + ".";
+        mongo::BSONObj const object = path.empty() ? _original : container.embeddedObject();
+        mongo::BSONObjIterator it(object);
+        while (it.more()) {
+            mongo::BSONElement const field = it.next();
+            std::string const fieldPath = prefix + field.fieldName();
+            auto const set = _sets.find(fieldPath);
+            if (set != _sets.end())
+                fields.push_back({ field.fieldName(), set->second.firstElement() });
+            else if (!_unsets.count(fieldPath))
+                fields.push_back({ field.fieldName(), field });
+        }
+
+        // Fields added to original object
+        for (auto set = _sets.lower_bound(prefix); set != _sets.end() && set->first.compare(0, prefix.size(), prefix) == 0; ++set) {
+            std::string const name = set->first.substr(prefix.size());
+            if (name.find('.') == std::string::npos && !object.hasField(name))
+                fields.push_back({ name, set->second.firstElement() });
+        }
+        return fields;
+    }
+
+    void DocumentPatch::set(const std::string &path, const mongo::BSONElement &value)
+    {
+        // Value may point into a change which is about to be replaced
+        mongo::BSONObj const copy = wrap(value);
+        if (changeReplaced(path, copy.firstElement()))
+            return;
+
+        eraseSubtree(path);
+
+        mongo::BSONElement const original = _original.getFieldDotted(path);
+        if (!original.eoo() && sameValue(original, copy.firstElement()))
+            return;
+
+        _sets[path] = copy;
+    }
+
+    void DocumentPatch::unset(const std::string &path)
+    {
+        size_t const dot = path.rfind('.');
+        if (dot != std::string::npos && element(path.substr(0, dot)).type() == mongo::Array) {
+            mongo::BSONObj const null = BSON("" << mongo::BSONNULL);
+            set(path, null.firstElement());
+            return;
+        }
+
+        if (changeReplaced(path, mongo::BSONElement()))
+            return;
+
+        eraseSubtree(path);
+
+        if (!_original.getFieldDotted(path).eoo())
+            _unsets.insert(path);
+    }
+
+    bool DocumentPatch::diff(const mongo::BSONObj &edited)
+    {
+        mongo::BSONElement const id = _original["_id"];
+        if (id.eoo() || !sameValue(id, edited["_id"]))
+            return false;
+
+        DocumentPatch result(_original);
+        if (!result.diffObject(std::string(), _original, edited))
+            return false;
+
+        _sets.swap(result._sets);
+        _unsets.swap(result._unsets);
+        _pushes.swap(result._pushes);
+        return true;
+    }
+
+    bool DocumentPatch::isChanged(const std::string &path) const
+    {
+        std::vector<std::string> paths = ancestors(path);
+        paths.push_back(path);
+        for (const std::string &changed : paths) {
+            if (_sets.count(changed) || _unsets.count(changed))
+                return true;
+        }
+
+        // Fields inside of 'path' follow it in order of paths
+        std::string const prefix = path + ".";
+        auto const set = _sets.lower_bound(prefix);
+        auto const unset = _unsets.lower_bound(prefix);
+        return (set != _sets.end() && isInside(set->first, path)) ||
+               (unset != _unsets.end() && isInside(*unset, path));
+    }
+
+    mongo::BSONObj DocumentPatch::toUpdate() const
+    {
+        mongo::BSONObjBuilder update;
+
+        if (_sets.size() > _pushes.size()) {
+            mongo::BSONObjBuilder set(update.subobjStart("$set"));
+            for (auto const &change : _sets) {
+                if (!_pushes.count(change.first))
+                    set.appendAs(change.second.firstElement(), change.first);
+            }
+            set.done();
+        }
+
+        if (!_unsets.empty()) {
+            mongo::BSONObjBuilder unset(update.subobjStart("$unset"));
+            for (const std::string &path : _unsets)
+                unset.append(path, "");
+            unset.done();
+        }
+
+        if (!_pushes.empty()) {
+            mongo::BSONObjBuilder push(update.subobjStart("$push"));
+            for (auto const &appended : _pushes) {
+                mongo::BSONObjBuilder each(push.subobjStart(appended.first));
+                mongo::BSONArrayBuilder elements(each.subarrayStart("$each"));
+                int index = 0;
+                mongo::BSONObjIterator it(_sets.at(appended.first).firstElement().embeddedObject());
+                while (it.more()) {
+                    mongo::BSONElement const element = it.next();
+                    if (index++ >= appended.second)
+                        elements.append(element);
+                }
+                elements.done();
+                each.done();
+            }
+            push.done();
+        }
+
+        return update.obj();
+    }
+
+    mongo::BSONObj DocumentPatch::toQuery(bool matchOriginal) const
+    {
+        mongo::BSONObjBuilder query;
+        mongo::BSONElement const id = _original["_id"];
+        if (!id.eoo())
+            query.append(id);
+
+        if (!matchOriginal)
+            return query.obj();
+
+        for (auto const &change : _sets) {
+            auto const pushed = _pushes.find(change.first);
+            if (pushed != _pushes.end())
+                query.append(change.first, BSON("$size" << pushed->second));
+            else
+                appendOriginal(query, change.first, _original.getFieldDotted(change.first));
+        }
+
+        for (const std::string &path : _unsets)
+            appendOriginal(query, path, _original.getFieldDotted(path));
+
+        return query.obj();
+    }
+
+    bool DocumentPatch::changeReplaced(const std::string &path, const mongo::BSONElement &value)
+    {
+        for (const std::string &changed : ancestors(path)) {
+            auto const set = _sets.find(changed);
+            if (set != _sets.end()) {
+                mongo::BSONElement const current = set->second.firstElement();
+                if (!current.isABSONObj())
+                    return true;    // scalar has no fields
+
+                mongo::BSONObjBuilder builder;
+                mongo::BSONObj const replaced = withField(current.embeddedObject(), current.type() == mongo::Array,
+                                                          path.substr(changed.size() + 1), value);
+                if (current.type() == mongo::Array)
+                    builder.appendArray("", replaced);
+                else
+                    builder.append("", replaced);
+                set->second = builder.obj();
+                _pushes.erase(changed);     // not only appended anymore
+                return true;
+            }
+
+            // Removed field has no fields
+            if (_unsets.count(changed))
+                return true;
+        }
+        return false;
+    }
+
+    void DocumentPatch::eraseSubtree(const std::string &path)
+    {
+        _sets.erase(path);
+        _unsets.erase(path);
+        _pushes.erase(path);
+
+        std::string const prefix = path + ".";
+        auto set = _sets.lower_bound(prefix);
+        while (set != _sets.end() && isInside(set->first, path))
+            set = _sets.erase(set);
+
+        auto unset = _unsets.lower_bound(prefix);
+        while (unset != _unsets.end() && isInside(*unset, path))
+            unset = _unsets.erase(unset);
+
+        auto push = _pushes.lower_bound(prefix);
+        while (push != _pushes.end() && isInside(push->first, path))
+            push = _pushes.erase(push);
+    }
+
+    bool DocumentPatch::diffObject(const std::string &prefix, const mongo::BSONObj &original, const mongo::BSONObj &edited)
+    {
+        Fields const originalFields = fieldsByName(original);
+        Fields const editedFields = fieldsByName(edited);
+        if (!keepsOrder(original, originalFields, edited, editedFields))
+            return false;
+
+        // Duplicated names cannot be set by path
+        if (originalFields.size() != static_cast<size_t>(original.nFields()) ||
+            editedFields.size() != static_cast<size_t>(edited.nFields()))
+            return false;
+
+        mongo::BSONObjIterator removed(original);
+        while (removed.more()) {
+            const char *name = removed.next().fieldName();
+            if (!editedFields.count(name))
+                _unsets.insert(prefix + name);
+        }
+
+        mongo::BSONObjIterator it(edited);
+        while (it.more()) {
+            mongo::BSONElement const element = it.next();
+            std::string const path = prefix + element.fieldName();
+            auto const before = originalFields.find(element.fieldName());
+            if (before != originalFields.end())
+                diffElement(path, before->second, element);
+            else
+                _sets[path] = wrap(element);
+        }
+        return true;
+    }
+
+    void DocumentPatch::diffElement(const std::string &path, const mongo::BSONElement &original, const mongo::BSONElement &edited)
+    {
+        if (sameValue(original, edited))
+            return;
+
+        if (original.type() == mongo::Object && edited.type() == mongo::Object &&
+            diffObject(path + ".", original.embeddedObject(), edited.embeddedObject()))
+            return;
+
+        if (original.type() == mongo::Array && edited.type() == mongo::Array) {
+            int const length = original.embeddedObject().nFields();
+            int const editedLength = edited.embeddedObject().nFields();
+            mongo::BSONObjIterator before(original.embeddedObject());
+            mongo::BSONObjIterator after(edited.embeddedObject());
+
+            if (editedLength == length) {
+                while (before.more()) {
+                    mongo::BSONElement const element = before.next();
+                    diffElement(path + "." + element.fieldName(), element, after.next());
+                }
+                return;
+            }
+
+            bool appended = editedLength > length;
+            while (appended && before.more())
+                appended = sameValue(before.next(), after.next());
+
+            if (appended) {
+                _sets[path] = wrap(edited);
+                _pushes[path] = length;
+                return;
+            }
+        }
+
+        _sets[path] = wrap(edited);
+    }
+}
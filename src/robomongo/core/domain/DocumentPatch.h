@@ -0,0 +1,98 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Changes of one document made by dotted paths ("a.b.0.c"), without copy of
+     *        the whole changed document. Saved as { $set: {...}, $unset: {...}, $push: {...} }
+     *        update.
+     *
+     *        Paths never overlap: change of a field replaces changes inside of it, change
+     *        inside of replaced field is applied to its new value.
+     */
+    class DocumentPatch
+    {
+    public:
+        explicit DocumentPatch(const mongo::BSONObj &original);
+
+        const mongo::BSONObj &original() const { return _original; }
+
+        /**
+         * @brief Current value of field: changed or original, EOO if it is removed or missing.
+         *        Valid until the next change of patch.
+         */
+        mongo::BSONElement element(const std::string &path) const;
+
+        /**
+         * @brief Names and current values of fields of object or array at 'path', of document
+         *        if 'path' is empty. Values are valid until the next change of patch.
+         */
+        std::vector<std::pair<std::string, mongo::BSONElement>> fields(const std::string &path) const;
+
+        /**
+         * @brief Replace or add field. Setting original value cancels the change.
+         */
+        void set(const std::string &path, const mongo::BSONElement &value);
+
+        /**
+         * @brief Remove field. Array element is set to null instead, as $unset does.
+         */
+        void unset(const std::string &path);
+
+        /**
+         * @brief Replace changes by the smallest changes which make 'edited' from original:
+         *        unchanged fields are skipped, objects and arrays of the same length are
+         *        compared field by field, elements appended to array are pushed.
+         * @return false if 'edited' cannot be made by update of fields (_id is changed, order
+         *         of document fields is changed, field names cannot be used in paths);
+         *         patch is not changed then.
+         */
+        bool diff(const mongo::BSONObj &edited);
+
+        bool isChanged(const std::string &path) const;
+        bool isEmpty() const { return _sets.empty() && _unsets.empty(); }
+        size_t size() const { return _sets.size() + _unsets.size(); }
+
+        /**
+         * @brief Update document with $set, $unset and $push operators, empty if nothing is changed
+         */
+        mongo::BSONObj toUpdate() const;
+
+        /**
+         * @brief Query of original document by _id. If 'matchOriginal' is true, changed fields
+         *        should have original values too (length for arrays with pushed elements), so
+         *        update does not overwrite concurrent changes of these fields.
+         */
+        mongo::BSONObj toQuery(bool matchOriginal) const;
+
+    private:
+        /**
+         * @brief Apply change inside of field which is already replaced
+         * @return false if no ancestor of 'path' is changed
+         */
+        bool changeReplaced(const std::string &path, const mongo::BSONElement &value);
+
+        /**
+         * @brief Forget changes of 'path' and of fields inside of it
+         */
+        void eraseSubtree(const std::string &path);
+
+        /**
+         * @brief Changes of fields of object at 'prefix' (with trailing dot, empty for document)
+         * @return false if fields of 'edited' cannot be changed one by one, nothing is changed then
+         */
+        bool diffObject(const std::string &prefix, const mongo::BSONObj &original, const mongo::BSONObj &edited);
+        void diffElement(const std::string &path, const mongo::BSONElement &original, const mongo::BSONElement &edited);
+
+        mongo::BSONObj const _original;
+        std::map<std::string, mongo::BSONObj> _sets;    // path -> { "": value }
+        std::set<std::string> _unsets;
+        std::map<std::string, int> _pushes;     // path of array in _sets -> original length, only appended to
+    };
+}
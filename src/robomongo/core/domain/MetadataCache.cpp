@@ -0,0 +1,168 @@
+#include "robomongo/core/domain/MetadataCache.h"
+
+#include <algorithm>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/Logger.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    // Increase when format of cache file changes, files of other versions are ignored
+    const int CacheFormatVersion = 1;
+
+    QString cacheDirectory()
+    {
+        return Robomongo::CacheDir + "metadata/";
+    }
+
+    QString cacheFilePath(const QString &connectionUuid)
+    {
+        // Uuid of QUuid::toString() is enclosed in braces
+        QString name = connectionUuid;
+        name.remove('{').remove('}');
+        return cacheDirectory() + name + ".json";
+    }
+
+    QJsonArray toJsonArray(const std::vector<std::string> &names)
+    {
+        QJsonArray array;
+        for (auto const& name : names)
+            array.append(Robomongo::QtUtils::toQString(name));
+        return array;
+    }
+
+    std::vector<std::string> fromJsonArray(const QJsonArray &array)
+    {
+        std::vector<std::string> names;
+        names.reserve(array.size());
+        for (auto const& value : array)
+            names.push_back(Robomongo::QtUtils::toStdString(value.toString()));
+        return names;
+    }
+}
+
+namespace Robomongo
+{
+    std::shared_ptr<MetadataCache> MetadataCache::forConnection(const QString &connectionUuid)
+    {
+        if (connectionUuid.isEmpty())
+            return nullptr;
+
+        // Cache lives while at least one MongoServer of the connection uses it
+        static std::map<QString, std::weak_ptr<MetadataCache>> caches;
+
+        std::shared_ptr<MetadataCache> cache = caches[connectionUuid].lock();
+        if (!cache) {
+            cache.reset(new MetadataCache(cacheFilePath(connectionUuid)));
+            cache->load();
+            caches[connectionUuid] = cache;
+        }
+
+        return cache;
+    }
+
+    void MetadataCache::remove(const QString &connectionUuid)
+    {
+        if (!connectionUuid.isEmpty())
+            QFile::remove(cacheFilePath(connectionUuid));
+    }
+
+    MetadataCache::MetadataCache(const QString &filePath) :
+        _filePath(filePath),
+        _hasDatabaseNames(false) {}
+
+    void MetadataCache::setDatabaseNames(const std::vector<std::string> &names)
+    {
+        bool changed = !_hasDatabaseNames || _databaseNames != names;
+        _hasDatabaseNames = true;
+        _databaseNames = names;
+
+        for (auto it = _collectionNames.begin(); it != _collectionNames.end();) {
+            if (std::find(names.begin(), names.end(), it->first) == names.end()) {
+                it = _collectionNames.erase(it);
+                changed = true;
+            }
+            else
+                ++it;
+        }
+
+        if (changed)
+            save();
+    }
+
+    bool MetadataCache::hasCollectionNames(const std::string &databaseName) const
+    {
+        return _collectionNames.find(databaseName) != _collectionNames.end();
+    }
+
+    std::vector<std::string> MetadataCache::collectionNames(const std::string &databaseName) const
+    {
+        auto const it = _collectionNames.find(databaseName);
+        return it != _collectionNames.end() ? it->second : std::vector<std::string>();
+    }
+
+    void MetadataCache::setCollectionNames(const std::string &databaseName, const std::vector<std::string> &names)
+    {
+        auto const it = _collectionNames.find(databaseName);
+        if (it != _collectionNames.end() && it->second == names)
+            return;
+
+        _collectionNames[databaseName] = names;
+        save();
+    }
+
+    void MetadataCache::load()
+    {
+        QFile file(_filePath);
+        if (!file.open(QIODevice::ReadOnly))
+            return;
+
+        QJsonObject const root = QJsonDocument::fromJson(file.readAll()).object();
+        if (root.value("version").toInt() != CacheFormatVersion)
+            return;
+
+        // Files written before database names were cached have no list of them
+        if (root.contains("databases")) {
+            _hasDatabaseNames = true;
+            _databaseNames = fromJsonArray(root.value("databases").toArray());
+        }
+
+        QJsonObject const collections = root.value("collections").toObject();
+        for (auto it = collections.begin(); it != collections.end(); ++it)
+            _collectionNames[QtUtils::toStdString(it.key())] = fromJsonArray(it.value().toArray());
+    }
+
+    void MetadataCache::save() const
+    {
+        QJsonObject collections;
+        for (auto const& database : _collectionNames)
+            collections.insert(QtUtils::toQString(database.first), toJsonArray(database.second));
+
+        QJsonObject root;
+        root.insert("version", CacheFormatVersion);
+        if (_hasDatabaseNames)
+            root.insert("databases", toJsonArray(_databaseNames));
+        root.insert("collections", collections);
+
+        if (!QDir().mkpath(cacheDirectory())) {
+            LOG_MSG("Could not create metadata cache directory: " + cacheDirectory(), 
+                    mongo::logger::LogSeverity::Warning());
+            return;
+        }
+
+        // Written into temporary file and renamed, so cache is never left half-written
+        QSaveFile file(_filePath);
+        if (!file.open(QIODevice::WriteOnly) ||
+            file.write(QJsonDocument(root).toJson(QJsonDocument::Compact)) < 0 ||
+            !file.commit()) {
+            LOG_MSG("Could not write metadata cache: " + _filePath, mongo::logger::LogSeverity::Warning());
+        }
+    }
+}
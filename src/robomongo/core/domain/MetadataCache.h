@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QString>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Robomongo
+{
+    /**
+     * @brief Last known database names and collection names of databases of one connection,
+     *        stored on disk in "<CacheDir>/metadata/<connection uuid>.json".
+     *
+     *        Explorer shows cached lists at once and revalidates them in background
+     *        (see MongoServer::tryConnect() and MongoDatabase::loadCollections()), so reconnecting
+     *        to a server with many databases or collections does not wait for the server.
+     *
+     *        All MongoServers of one connection share the same instance (see forConnection()),
+     *        which must be used from GUI thread only.
+     */
+    class MetadataCache
+    {
+    public:
+        /**
+         * @brief Cache of connection with given uuid, loaded from disk when first requested.
+         * @return nullptr for connections without uuid.
+         */
+        static std::shared_ptr<MetadataCache> forConnection(const QString &connectionUuid);
+
+        /**
+         * @brief Remove cache file of deleted connection
+         */
+        static void remove(const QString &connectionUuid);
+
+        bool hasDatabaseNames() const { return _hasDatabaseNames; }
+        const std::vector<std::string> &databaseNames() const { return _databaseNames; }
+
+        /**
+         * @brief Store actual list of databases and drop cached collection lists of databases
+         *        which are not in it. File is rewritten only if something changed.
+         */
+        void setDatabaseNames(const std::vector<std::string> &names);
+
+        bool hasCollectionNames(const std::string &databaseName) const;
+        std::vector<std::string> collectionNames(const std::string &databaseName) const;
+        void setCollectionNames(const std::string &databaseName, const std::vector<std::string> &names);
+
+    private:
+        explicit MetadataCache(const QString &filePath);
+
+        void load();
+        void save() const;
+
+        const QString _filePath;
+        bool _hasDatabaseNames;
+        std::vector<std::string> _databaseNames;
+        std::map<std::string, std::vector<std::string>> _collectionNames;
+    };
+}
@@ -14,6 +14,7 @@ namespace Robomongo
 
         std::string name() const { return _ns.collectionName(); }
         const MongoCollectionInfo info() const { return _info; }
+        void setInfo(const MongoCollectionInfo &info) { _info = info; }
         std::string fullName() const { return _ns.toString(); }
         MongoDatabase *database() const { return _database; }
 
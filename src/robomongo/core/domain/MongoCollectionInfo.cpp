@@ -4,9 +4,11 @@
 
 namespace Robomongo
 {
-    MongoCollectionInfo::MongoCollectionInfo(const std::string &ns) : _ns(ns) {}
+    MongoCollectionInfo::MongoCollectionInfo(const std::string &ns) :
+        _ns(ns), _hasStats(false), _sizeBytes(0), _storageSizeBytes(0), _count(0) {}
 
-/*    MongoCollectionInfo::MongoCollectionInfo(mongo::BSONObj stats) : _ns(stats.getStringField("ns"))
+    MongoCollectionInfo::MongoCollectionInfo(const std::string &ns, mongo::BSONObj stats) :
+        _ns(ns), _hasStats(true)
     {
         // if "size" and "storageSize" are of type Int32 or Int64, they
         // will be converted to double by "numberDouble()" function.
@@ -15,6 +17,5 @@ namespace Robomongo
 
         // NumberLong because of mongodb can have very big collections
         _count = BsonUtils::getField<mongo::NumberLong>(stats,"count");
-    }*/
+    }
 }
-
@@ -7,33 +7,45 @@ namespace Robomongo
     class MongoCollectionInfo
     {
     public:
-        MongoCollectionInfo() {}
+        MongoCollectionInfo() : _hasStats(false), _sizeBytes(0), _storageSizeBytes(0), _count(0) {}
         MongoCollectionInfo(const std::string &ns);
-//        MongoCollectionInfo(mongo::BSONObj stats);
+
+        /**
+         * @brief Collection with statistics, 'stats' is a result of { collStats: ... } command
+         */
+        MongoCollectionInfo(const std::string &ns, mongo::BSONObj stats);
 
         std::string name() const { return _ns.collectionName(); }
         std::string fullName() const { return _ns.toString(); }
         MongoNamespace ns() const { return _ns; }
 
+        /**
+         * @brief False if statistics were not loaded yet (collection names are loaded
+         *        without them, see LoadCollectionStatsRequest) or collStats failed (i.e. views).
+         */
+        bool hasStats() const { return _hasStats; }
+
         /**
          * @brief Size in bytes
          * It is double, because db.stats()'s "size" field may be double
          * for large values, while Int32 for small.
          */
-//        double sizeBytes() const { return _sizeBytes; }
+        double sizeBytes() const { return _sizeBytes; }
 
         /**
          * @brief Storage size in bytes
          * It is double, because db.stats()'s "storageSize" field may be double
          * for large values, while Int32 for small.
          */
-//        double storageSizeBytes() const { return _storageSizeBytes; }
+        double storageSizeBytes() const { return _storageSizeBytes; }
 
-//        long long count() const { return _count; }
+        long long count() const { return _count; }
 
     private:
         MongoNamespace _ns;
 
+        bool _hasStats;
+
         /**
          * @brief Size in bytes
          * It is double, because db.stats()'s "size" field may be double
@@ -51,4 +63,3 @@ namespace Robomongo
         long long _count;
     };
 }
-
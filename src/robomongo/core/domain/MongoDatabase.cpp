@@ -1,5 +1,9 @@
 #include "robomongo/core/domain/MongoDatabase.h"
 
+#include <unordered_map>
+#include <QDateTime>
+
+#include "robomongo/core/domain/MetadataCache.h"
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/domain/MongoCollection.h"
 #include "robomongo/core/mongodb/MongoWorker.h"
@@ -11,6 +15,7 @@
 namespace Robomongo
 {
     R_REGISTER_EVENT(MongoDatabaseCollectionListLoadedEvent)
+    R_REGISTER_EVENT(MongoDatabaseCollectionStatsLoadedEvent)
     R_REGISTER_EVENT(MongoDatabaseUsersLoadedEvent)
     R_REGISTER_EVENT(MongoDatabaseFunctionsLoadedEvent)
     R_REGISTER_EVENT(MongoDatabaseUsersLoadingEvent)
@@ -38,10 +43,52 @@ namespace Robomongo
 
     void MongoDatabase::loadCollections()
     {
+        // First load: show last known collections at once, response of the request below
+        // brings actual list and only differences are applied
+        MetadataCache *const cache = _server->metadataCache();
+        if (_collections.empty() && cache && cache->hasCollectionNames(_name)) {
+            for (auto const& name : cache->collectionNames(_name))
+                addCollection(new MongoCollection(this, cachedCollectionInfo(MongoCollectionInfo(_name + "." + name))));
+
+            _bus->publish(new MongoDatabaseCollectionListLoadedEvent(this, _collections));
+        }
+
         _bus->publish(new MongoDatabaseCollectionsLoadingEvent(this));
         _bus->send(_server->worker(), new LoadCollectionNamesRequest(this, _name));
     }
 
+    void MongoDatabase::loadCollectionStats(const std::vector<std::string> &collectionNames)
+    {
+        std::vector<std::string> chunk;
+        for (auto const& name : collectionNames) {
+            if (hasFreshCollectionStats(name))
+                continue;
+
+            _collectionStatsRequested.insert(name);
+            chunk.push_back(name);
+
+            // Small requests, so that results are shown progressively and
+            // other requests of the worker are not queued behind all of them
+            if (chunk.size() == collectionStatsChunkSize) {
+                _bus->send(_server->worker(), new LoadCollectionStatsRequest(this, _name, chunk));
+                chunk.clear();
+            }
+        }
+
+        if (!chunk.empty())
+            _bus->send(_server->worker(), new LoadCollectionStatsRequest(this, _name, chunk));
+    }
+
+    bool MongoDatabase::hasFreshCollectionStats(const std::string &collectionName) const
+    {
+        if (_collectionStatsRequested.count(collectionName))
+            return true;
+
+        auto const it = _collectionStats.find(collectionName);
+        return it != _collectionStats.end() &&
+               QDateTime::currentMSecsSinceEpoch() - it->second.loadedAtMs < collectionStatsTtlMs;
+    }
+
     void MongoDatabase::loadUsers()
     {
         _bus->publish(new MongoDatabaseUsersLoadingEvent(this));
@@ -118,15 +165,68 @@ namespace Robomongo
             return;
         }
 
-        clearCollections();
+        // Keep collections which still exist, so explorer updates only changed items
+        std::unordered_map<std::string, MongoCollection *> existing;
+        for (auto collection : _collections)
+            existing[collection->name()] = collection;
+
+        std::vector<MongoCollection *> collections;
+        std::vector<std::string> names;
+        for (auto const& collectionInfo : event->collectionInfos()) {
+            names.push_back(collectionInfo.name());
+
+            auto const it = existing.find(collectionInfo.name());
+            if (it != existing.end()) {
+                collections.push_back(it->second);
+                existing.erase(it);
+            }
+            else {
+                collections.push_back(new MongoCollection(this, cachedCollectionInfo(collectionInfo)));
+            }
+        }
+
+        // Collections that no longer exist
+        for (auto const& removed : existing)
+            delete removed.second;
+
+        _collections = collections;
 
-        for (auto const& collectionInfo : event->collectionInfos())
-            addCollection(new MongoCollection(this, collectionInfo));
+        MetadataCache *const cache = _server->metadataCache();
+        if (cache)
+            cache->setCollectionNames(_name, names);
 
         _bus->publish(new MongoDatabaseCollectionListLoadedEvent(this, _collections));
         LOG_MSG("'Collections' refreshed.", mongo::logger::LogSeverity::Info());
     }
 
+    void MongoDatabase::handle(LoadCollectionStatsResponse *event)
+    {
+        if (event->isError()) {
+            // Statistics are optional, do not bother user with message box
+            for (auto const& name : event->collectionNames())
+                _collectionStatsRequested.erase(name);
+
+            LOG_MSG(event->error().errorMessage(), mongo::logger::LogSeverity::Warning());
+            return;
+        }
+
+        qint64 const now = QDateTime::currentMSecsSinceEpoch();
+        std::unordered_map<std::string, MongoCollectionInfo> loaded;
+        for (auto const& info : event->collectionInfos()) {
+            _collectionStatsRequested.erase(info.name());
+            _collectionStats[info.name()] = CachedCollectionStats{ info, now };
+            loaded.insert(std::make_pair(info.name(), info));
+        }
+
+        for (auto collection : _collections) {
+            auto const it = loaded.find(collection->name());
+            if (it != loaded.end())
+                collection->setInfo(it->second);
+        }
+
+        _bus->publish(new MongoDatabaseCollectionStatsLoadedEvent(this, event->collectionInfos()));
+    }
+
     void MongoDatabase::handle(CreateFunctionResponse *event)
     {
         if (event->isError()) {
@@ -183,6 +283,13 @@ namespace Robomongo
         LOG_MSG("'Functions' refreshed.", mongo::logger::LogSeverity::Info());
     }
 
+    MongoCollectionInfo MongoDatabase::cachedCollectionInfo(const MongoCollectionInfo &info) const
+    {
+        // Show last known statistics until fresh ones are loaded
+        auto const cached = _collectionStats.find(info.name());
+        return cached != _collectionStats.end() ? cached->second.info : info;
+    }
+
     void MongoDatabase::clearCollections()
     {
         qDeleteAll(_collections);
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <QObject>
+#include <map>
+#include <set>
 #include <mongo/bson/bsonobj.h>
 
 #include "robomongo/core/Core.h"
+#include "robomongo/core/domain/MongoCollectionInfo.h"
 #include "robomongo/core/events/MongoEvents.h"
 
 namespace Robomongo
@@ -18,6 +21,12 @@ namespace Robomongo
         Q_OBJECT
 
     public:
+        // Statistics of collection older than this are reloaded when collection is shown again
+        enum { collectionStatsTtlMs = 60 * 1000 };
+
+        // Maximum number of collections in one LoadCollectionStatsRequest
+        enum { collectionStatsChunkSize = 16 };
+
         /**
         * @brief Database storage engine type
         */
@@ -49,6 +58,20 @@ namespace Robomongo
          */
         void loadCollections();
 
+        /**
+         * @brief Initiate asynchronous load of statistics (collStats) of given collections.
+         *        Collections with statistics not older than collectionStatsTtlMs and ones
+         *        already being loaded are skipped. Results are published by chunks
+         *        in MongoDatabaseCollectionStatsLoadedEvent.
+         */
+        void loadCollectionStats(const std::vector<std::string> &collectionNames);
+
+        /**
+         * @brief True if statistics of collection were loaded less than collectionStatsTtlMs ago
+         *        or are being loaded now.
+         */
+        bool hasFreshCollectionStats(const std::string &collectionName) const;
+
         /**
          * @brief Initiate loadUsers asynchronous operation.
          */
@@ -81,6 +104,7 @@ namespace Robomongo
 
     protected Q_SLOTS:
         void handle(LoadCollectionNamesResponse *event);
+        void handle(LoadCollectionStatsResponse *event);
         void handle(LoadUsersResponse *event);
         void handle(LoadFunctionsResponse *event);
         void handle(CreateFunctionResponse *event);
@@ -94,12 +118,27 @@ namespace Robomongo
 
     private:
         void clearCollections();
+        MongoCollectionInfo cachedCollectionInfo(const MongoCollectionInfo &info) const;
         void addCollection(MongoCollection *collection);
         void handleIfReplicaSetUnreachable(Event *event);
 
     private:
+        struct CachedCollectionStats
+        {
+            MongoCollectionInfo info;
+            qint64 loadedAtMs;
+        };
+
         MongoServer *_server;
         std::vector<MongoCollection *> _collections;
+
+        // Loaded statistics by collection name. Kept when collection list is reloaded,
+        // so refreshed list shows last known statistics at once.
+        std::map<std::string, CachedCollectionStats> _collectionStats;
+
+        // Collections with statistics being loaded now
+        std::set<std::string> _collectionStatsRequested;
+
         const std::string _name;
         const bool _system;
         EventBus *_bus;
@@ -119,6 +158,21 @@ namespace Robomongo
         std::vector<MongoCollection *> collections;
     };
 
+    /**
+     * @brief Published for every chunk of collection statistics loaded by
+     *        MongoDatabase::loadCollectionStats()
+     */
+    class MongoDatabaseCollectionStatsLoadedEvent : public Event
+    {
+        R_EVENT
+
+        MongoDatabaseCollectionStatsLoadedEvent(QObject *sender, const std::vector<MongoCollectionInfo> &infos) :
+            Event(sender),
+            collectionInfos(infos) { }
+
+        std::vector<MongoCollectionInfo> collectionInfos;
+    };
+
     class MongoDatabaseUsersLoadedEvent : public Event
     {
         R_EVENT
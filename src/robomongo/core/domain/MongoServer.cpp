@@ -1,11 +1,13 @@
 #include "robomongo/core/domain/MongoServer.h"
 
+#include "robomongo/core/domain/MetadataCache.h"
 #include "robomongo/core/domain/MongoDatabase.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/SshSettings.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/settings/ReplicaSetSettings.h"
 #include "robomongo/core/mongodb/MongoWorker.h"
+#include "robomongo/core/mongodb/MonitorWorker.h"
 #include "robomongo/core/mongodb/SshTunnelWorker.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/domain/App.h"
@@ -23,12 +25,15 @@ namespace Robomongo {
         _version(0.0f),
         _connectionType(connectionType),
         _worker(nullptr),
+        _monitorWorker(nullptr),
         _isConnected(false),
+        _databasesFromCache(false),
         _connSettings(settings),
         _handle(handle),
         _bus(AppRegistry::instance().bus()),
         _app(AppRegistry::instance().app()),
-        _replicaSetInfo(nullptr)
+        _replicaSetInfo(nullptr),
+        _metadataCache(MetadataCache::forConnection(settings->uuid()))
     {}
 
     bool MongoServer::isConnected() const {
@@ -46,15 +51,26 @@ namespace Robomongo {
             _worker->stopAndDelete();
         }
 
-        // MongoWorker "_worker" is not deleted here, because it is now owned by
-        // another thread (call to moveToThread() made in MongoWorker constructor).
-        // It will be deleted by this thread by means of "deleteLater()", which
-        // is also specified in MongoWorker constructor.
+        if (_monitorWorker) {
+            _monitorWorker->stopAndDelete();
+        }
+
+        // Workers "_worker" and "_monitorWorker" are not deleted here, because they are now owned by
+        // other threads (call to moveToThread() made in worker constructors).
+        // They will be deleted by these threads by means of "deleteLater()", which
+        // is also specified in worker constructors.
     }
 
     void MongoServer::tryConnect() 
     {
-        _bus->send(_worker, new EstablishConnectionRequest(this, _connectionType, _connSettings->uuid().toStdString()));
+        // Explorer is shown with cached databases at once, they are revalidated when connected
+        std::vector<std::string> cachedDatabases;
+        if (_metadataCache && ConnectionPrimary == _connectionType && _metadataCache->hasDatabaseNames())
+            cachedDatabases = _metadataCache->databaseNames();
+        _databasesFromCache = !cachedDatabases.empty();
+
+        _bus->send(_worker, new EstablishConnectionRequest(this, _connectionType, _connSettings->uuid().toStdString(),
+                                                           cachedDatabases));
     }
 
     void MongoServer::tryRefresh() 
@@ -133,6 +149,10 @@ namespace Robomongo {
         _bus->send(_worker, new InsertDocumentRequest(this, obj, ns, true));
     }
 
+    void MongoServer::updateDocument(const mongo::BSONObj &query, const mongo::BSONObj &update, const MongoNamespace &ns) {
+        _bus->send(_worker, new UpdateDocumentRequest(this, query, update, ns));
+    }
+
     void MongoServer::removeDocuments(mongo::Query query, const MongoNamespace &ns, 
                                       RemoveDocumentCount removeCount, int index) 
     {
@@ -209,6 +229,9 @@ namespace Robomongo {
             addDatabase(db);    // todo: serverClones for replica sets should not do this
         }
 
+        if (_metadataCache && ConnectionPrimary == _connectionType)
+            _metadataCache->setDatabaseNames(info._databases);
+
         if (_connSettings->isReplicaSet()) {
             _bus->publish(new ConnectionEstablishedEvent(this, event->connectionType, info));
             // In order to do first connection much faster, time consuming refresh 
@@ -216,7 +239,12 @@ namespace Robomongo {
             // successful connection.
             if (ConnectionPrimary == event->connectionType)
                 _bus->send(_worker, new RefreshReplicaSetFolderRequest(this, false));
+
+            // Single server revalidates cached databases when its explorer item is expanded on creation
+            if (_databasesFromCache && ConnectionPrimary == event->connectionType)
+                _bus->send(_worker, new LoadDatabaseNamesRequest(this));
         }
+        _databasesFromCache = false;
     }
 
     void MongoServer::handle(RefreshReplicaSetFolderResponse *event)
@@ -231,13 +259,24 @@ namespace Robomongo {
             return;
         }
 
-        clearDatabases();
-
+        // Keep databases which still exist (with their loaded collections),
+        // so explorer updates only changed items instead of rebuilding the tree
+        QList<MongoDatabase *> databases;
         for (auto const& dbname : event->databaseNames) {
-            MongoDatabase *db  = new MongoDatabase(this, dbname);
-            addDatabase(db);
+            MongoDatabase *db = findDatabaseByName(dbname);
+            if (db)
+                _databases.removeOne(db);
+            else
+                db = new MongoDatabase(this, dbname);
+            databases.append(db);
         }
 
+        clearDatabases();   // databases that no longer exist
+        _databases = databases;
+
+        if (_metadataCache)
+            _metadataCache->setDatabaseNames(event->databaseNames);
+
         _bus->publish(new DatabaseListLoadedEvent(this, _databases));
         LOG_MSG("Database list refreshed. Connection: " + _connSettings->connectionName(), 
                  mongo::logger::LogSeverity::Info());
@@ -266,6 +305,22 @@ namespace Robomongo {
 
     }
 
+    void MongoServer::handle(UpdateDocumentResponse *event)
+    {
+        if (event->isError()) {
+            if (_connSettings->isReplicaSet() &&
+                EventError::SetPrimaryUnreachable == event->error().errorCode()) {
+                auto refreshEvent = ReplicaSetRefreshed(this, event->error(), event->error().replicaSetInfo());
+                handle(&refreshEvent);
+            }
+            genericEventErrorHandler(event, "Failed to update document.", _bus, this);
+        }
+        else {
+            _bus->publish(new UpdateDocumentResponse(this));
+            LOG_MSG("Document updated.", mongo::logger::LogSeverity::Info());
+        }
+    }
+
     void MongoServer::handle(RemoveDocumentResponse *event) 
     {
         if (event->removeCount == RemoveDocumentCount::MULTI && event->index > 0)
@@ -302,6 +357,16 @@ namespace Robomongo {
                                   AppRegistry::instance().settingsManager()->shellTimeoutSec());
     }
 
+    MonitorWorker *MongoServer::monitorWorker()
+    {
+        if (!_monitorWorker) {
+            _monitorWorker = new MonitorWorker(_connSettings->clone(),
+                                               AppRegistry::instance().settingsManager()->mongoTimeoutSec());
+        }
+
+        return _monitorWorker;
+    }
+
     void MongoServer::handle(CreateDatabaseResponse *event) 
     {
         if (event->isError()) {
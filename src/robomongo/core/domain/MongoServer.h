@@ -1,5 +1,6 @@
 #pragma once
 #include <QObject>
+#include <memory>
 
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/events/MongoEvents.h"
@@ -7,7 +8,9 @@
 namespace Robomongo
 {
     class MongoWorker;
+    class MonitorWorker;
     class MongoDatabase;
+    class MetadataCache;
     class EventBus;
     class App;
 
@@ -16,6 +19,7 @@ namespace Robomongo
     struct RefreshReplicaSetFolderResponse;
     class LoadDatabaseNamesResponse;
     class InsertDocumentResponse;
+    class UpdateDocumentResponse;
     struct CreateDatabaseResponse;
     struct DropDatabaseResponse;
 
@@ -85,6 +89,11 @@ namespace Robomongo
         void insertDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
         void saveDocuments(const std::vector<mongo::BSONObj> &objCont, const MongoNamespace &ns);
         void saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
+
+        /**
+         * @brief Update one document by update operators, i.e. { $set: {...} }
+         */
+        void updateDocument(const mongo::BSONObj &query, const mongo::BSONObj &update, const MongoNamespace &ns);
         void removeDocuments(mongo::Query query, const MongoNamespace &ns, RemoveDocumentCount removeCount, 
                              int index = 0);
         float version() const{ return _version; }
@@ -101,6 +110,16 @@ namespace Robomongo
         void loadDatabases();
         MongoWorker *const worker() const { return _worker; }
 
+        /**
+         * @brief Worker which polls server status on its own connections, started on first use.
+         */
+        MonitorWorker *monitorWorker();
+
+        /**
+         * @brief Last known databases and collections of this connection, nullptr if there is no cache
+         */
+        MetadataCache *metadataCache() const { return _metadataCache.get(); }
+
         ReplicaSet* replicaSetInfo() const { return _replicaSetInfo.get(); }
 
         void handle(ReplicaSetRefreshed *event);
@@ -112,6 +131,7 @@ namespace Robomongo
         void handle(RefreshReplicaSetFolderResponse *event);
         void handle(LoadDatabaseNamesResponse *event);
         void handle(InsertDocumentResponse *event);
+        void handle(UpdateDocumentResponse *event);
         void handle(RemoveDocumentResponse *event);
         void handle(CreateDatabaseResponse *event);
         void handle(DropDatabaseResponse *event);
@@ -124,6 +144,7 @@ namespace Robomongo
         void handleConnectionFailure(EstablishConnectionResponse* event);
 
         MongoWorker *_worker;
+        MonitorWorker *_monitorWorker;
         std::unique_ptr<ConnectionSettings> _connSettings;
         EventBus *_bus;
         App *_app;
@@ -132,10 +153,12 @@ namespace Robomongo
         std::string _storageEngineType;
         ConnectionType _connectionType;
         bool _isConnected;
+        bool _databasesFromCache;     // primary connection was established with databases of MetadataCache
         int _handle;
 
         QList<MongoDatabase *> _databases;
         std::unique_ptr<ReplicaSet> _replicaSetInfo;
+        std::shared_ptr<MetadataCache> _metadataCache;
     };
 
     class MongoServerLoadingDatabasesEvent : public Event
@@ -4,6 +4,7 @@
 
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/mongodb/MongoWorker.h"
+#include "robomongo/core/mongodb/MonitorWorker.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/utils/QtUtils.h"
@@ -16,7 +17,9 @@ namespace Robomongo
     MongoShell::MongoShell(MongoServer *server, const ScriptInfo &scriptInfo) :
         QObject(),
         _scriptInfo(scriptInfo),
-        _server(server)
+        _server(server),
+        _readPreference(ReadPrimary),
+        _lastExplainId(0)
     {
     }
 
@@ -24,7 +27,8 @@ namespace Robomongo
     {
         AppRegistry::instance().bus()->publish(new ScriptExecutingEvent(this));
         _scriptInfo.setScript(QtUtils::toQString(script));
-        AppRegistry::instance().bus()->send(_server->worker(), new ExecuteScriptRequest(this, query(), dbName));
+        AppRegistry::instance().bus()->send(_server->worker(), new ExecuteScriptRequest(this, query(), dbName, 0, 0,
+                                                                                          _readPreference));
         LOG_MSG(_scriptInfo.script(), mongo::logger::LogSeverity::Info());
     }
 
@@ -37,19 +41,37 @@ namespace Robomongo
     {
         if (_scriptInfo.execute()) {
             AppRegistry::instance().bus()->publish(new ScriptExecutingEvent(this));
-            AppRegistry::instance().bus()->send(_server->worker(), new ExecuteScriptRequest(this, query(), dbName));
+            AppRegistry::instance().bus()->send(_server->worker(), new ExecuteScriptRequest(this, query(), dbName, 0, 0,
+                                                                                          _readPreference));
             if (!_scriptInfo.script().isEmpty())
                 LOG_MSG(_scriptInfo.script(), mongo::logger::LogSeverity::Info());
         } else {
             AppRegistry::instance().bus()->publish(new ScriptExecutingEvent(this));
             _scriptInfo.setScript("");
-            AppRegistry::instance().bus()->send(_server->worker(), new ExecuteScriptRequest(this, query() , dbName));
+            AppRegistry::instance().bus()->send(_server->worker(), new ExecuteScriptRequest(this, query() , dbName, 0, 0,
+                                                                                          _readPreference));
         }
     }
 
-    void MongoShell::query(int resultIndex, const MongoQueryInfo &info)
+    void MongoShell::query(int resultIndex, const MongoQueryInfo &info, const std::string &readTarget)
     {
-        AppRegistry::instance().bus()->send(_server->worker(), new ExecuteQueryRequest(this, resultIndex, info));
+        AppRegistry::instance().bus()->send(_server->worker(), new ExecuteQueryRequest(this, resultIndex, info,
+                                                                                     _readPreference, readTarget));
+    }
+
+    void MongoShell::explainIfSlow(int resultIndex, const MongoQueryInfo &info, long long elapsedMs,
+                                   const std::string &host)
+    {
+        // Explain still running for previous query of this result is outdated, also when this one is fast
+        int const requestId = ++_lastExplainId;
+        _explainIds[resultIndex] = requestId;
+
+        int const thresholdMs = AppRegistry::instance().settingsManager()->slowQueryExplainMs();
+        if (thresholdMs <= 0 || elapsedMs < thresholdMs || !info._info.isValid() || info._limit == -1)
+            return;
+
+        AppRegistry::instance().bus()->send(_server->monitorWorker(),
+                                            new ExplainQueryRequest(this, resultIndex, requestId, info, host));
     }
 
     void MongoShell::autocomplete(const std::string &prefix)
@@ -88,11 +110,16 @@ namespace Robomongo
             return;
         }
 
-        AppRegistry::instance().bus()->publish(new DocumentListLoadedEvent(this, event->resultIndex, event->queryInfo, query(), event->documents));
+        AppRegistry::instance().bus()->publish(new DocumentListLoadedEvent(this, event->resultIndex, event->queryInfo, query(),
+                                                                           event->documents, event->servedBy));
+        explainIfSlow(event->resultIndex, event->queryInfo, event->elapsedMs, event->servedBy);
     }
 
     void MongoShell::handle(ExecuteScriptResponse *event)
     {
+        // Results are replaced by the ones of this script
+        _explainIds.clear();
+
         if (event->isError()) {
             if (_server->connectionRecord()->isReplicaSet()) {
                 AppRegistry::instance().bus()->publish(
@@ -113,6 +140,23 @@ namespace Robomongo
                                                                        event->timeoutReached()));
     }
 
+    void MongoShell::handle(ExplainQueryResponse *event)
+    {
+        auto const expected = _explainIds.find(event->resultIndex());
+        if (expected == _explainIds.end() || expected->second != event->requestId())
+            return;
+
+        // Result view is not bothered when explain failed, the query itself succeeded
+        if (event->isError()) {
+            LOG_MSG("Failed to explain slow query. " + event->error().errorMessage(),
+                    mongo::logger::LogSeverity::Warning());
+            return;
+        }
+
+        AppRegistry::instance().bus()->publish(new ExplainQueryResponse(this, event->resultIndex(), event->requestId(),
+                                                                        event->plan()));
+    }
+
     void MongoShell::handle(AutocompleteResponse *event)
     {
         if (event->isError()) {
@@ -1,4 +1,5 @@
 #pragma once
+#include <map>
 #include <QObject>
 #include "robomongo/core/events/MongoEvents.h"
 #include "robomongo/core/domain/ScriptInfo.h"
@@ -13,7 +14,20 @@ namespace Robomongo
         MongoShell(MongoServer *server, const ScriptInfo &scriptInfo);
 
         void open(const std::string &script, const std::string &dbName = std::string());
-        void query(int resultIndex, const MongoQueryInfo &info);
+
+        /**
+         * @param readTarget: member which served previous page of the result, if any
+         */
+        void query(int resultIndex, const MongoQueryInfo &info, const std::string &readTarget = std::string());
+
+        /**
+         * @brief Explain query of result 'resultIndex' on separate connection if it took at least
+         *        SettingsManager::slowQueryExplainMs(). ExplainQueryResponse is published when done,
+         *        unless result 'resultIndex' got another query (i.e. next page) meanwhile.
+         * @param host: member which served the query, empty for primary
+         */
+        void explainIfSlow(int resultIndex, const MongoQueryInfo &info, long long elapsedMs,
+                           const std::string &host = std::string());
         void autocomplete(const std::string &prefix);
         void stop();
         MongoServer *server() const { return _server; }
@@ -25,6 +39,13 @@ namespace Robomongo
         void setScript(const QString &script) { return _scriptInfo.setScript(script); }
         QString filePath() const { return _scriptInfo.filePath(); }
 
+        /**
+         * @brief Read preference of this shell tab. For replica sets, queries and scripts
+         *        of non-primary tabs are routed to the lowest-latency eligible member.
+         */
+        ReadPreferenceMode readPreference() const { return _readPreference; }
+        void setReadPreference(ReadPreferenceMode mode) { _readPreference = mode; }
+
         bool saveToFile();
         bool saveToFileAs();
         bool loadFromFile();
@@ -33,10 +54,16 @@ namespace Robomongo
         void handle(ExecuteQueryResponse *event);
         void handle(ExecuteScriptResponse *event);
         void handle(AutocompleteResponse *event);
+        void handle(ExplainQueryResponse *event);
 
     private:        
         ScriptInfo _scriptInfo;
         MongoServer *_server;
+        ReadPreferenceMode _readPreference;
+
+        // Id of explain request for the last query of every result, responses with other ids are stale
+        std::map<int, int> _explainIds;
+        int _lastExplainId;
     };
 
 }
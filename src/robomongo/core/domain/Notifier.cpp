@@ -11,12 +11,14 @@
 #include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/DocumentPatch.h"
 #include "robomongo/core/events/MongoEvents.h"
 
 #include "robomongo/shell/db/ptimeutil.h"
 
 #include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 #include "robomongo/gui/dialogs/DocumentTextEditor.h"
+#include "robomongo/gui/dialogs/LargeDocumentEditor.h"
 #include "robomongo/gui/utils/DialogUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/core/EventBus.h"
@@ -103,6 +105,7 @@ namespace Robomongo
     {
         QWidget *wid = dynamic_cast<QWidget*>(_observer);
         AppRegistry::instance().bus()->subscribe(this, InsertDocumentResponse::Type, _shell->server());
+        AppRegistry::instance().bus()->subscribe(this, UpdateDocumentResponse::Type, _shell->server());
         AppRegistry::instance().bus()->subscribe(this, RemoveDocumentResponse::Type, _shell->server());
 
         _deleteDocumentAction = new QAction("Delete Document...", wid);
@@ -243,6 +246,13 @@ namespace Robomongo
         _shell->query(0, _queryInfo);
     }
 
+    void Notifier::handle(UpdateDocumentResponse *event)
+    {
+        // Errors are reported by MongoServer
+        if (!event->isError())
+            _shell->query(0, _queryInfo);
+    }
+
     void Notifier::handle(RemoveDocumentResponse *event)
     {
        if (event->isError()) {
@@ -360,6 +370,12 @@ namespace Robomongo
 
         mongo::BSONObj obj = documentItem->superRoot();
 
+        // Converting multi-megabyte document to text takes too long, it is edited as tree
+        if (obj.objsize() >= LargeDocumentEditor::largeDocumentSize) {
+            editLargeDocument(obj);
+            return;
+        }
+
         std::string str = BsonUtils::jsonString(obj, mongo::TenGen, 1,
             AppRegistry::instance().settingsManager()->uuidEncoding(),
             AppRegistry::instance().settingsManager()->timeZone());
@@ -373,10 +389,43 @@ namespace Robomongo
         int result = editor.exec();
 
         if (result == QDialog::Accepted) {
-            _shell->server()->saveDocuments(editor.bsonObj(), _queryInfo._info._ns);
+            DocumentTextEditor::ReturnType const documents = editor.bsonObj();
+
+            // Only changed fields are sent, whole document is saved if update of fields cannot make it
+            DocumentPatch patch(obj);
+            if (documents.size() == 1 && patch.diff(documents.front())) {
+                if (!patch.isEmpty())
+                    updateDocument(patch);
+                return;
+            }
+
+            _shell->server()->saveDocuments(documents, _queryInfo._info._ns);
         }
     }
 
+    void Notifier::updateDocument(const DocumentPatch &patch)
+    {
+        bool const matchOriginal = AppRegistry::instance().settingsManager()->checkConcurrentEdits();
+        _shell->server()->updateDocument(patch.toQuery(matchOriginal), patch.toUpdate(), _queryInfo._info._ns);
+    }
+
+    void Notifier::editLargeDocument(const mongo::BSONObj &obj)
+    {
+        mongo::BSONElement const id = obj["_id"];
+        if (id.eoo()) {
+            QMessageBox::warning(dynamic_cast<QWidget*>(_observer), "Edit Document",
+                                 "Document without _id cannot be updated.");
+            return;
+        }
+
+        LargeDocumentEditor editor(_queryInfo._info, obj, false, dynamic_cast<QWidget*>(_observer));
+        editor.setWindowTitle("Edit Document");
+        if (editor.exec() != QDialog::Accepted || editor.patch().isEmpty())
+            return;
+
+        updateDocument(editor.patch());
+    }
+
     void Notifier::onViewDocument()
     {
         QModelIndex selectedIndex = _observer->selectedIndex();
@@ -389,6 +438,15 @@ namespace Robomongo
 
         mongo::BSONObj obj = documentItem->superRoot();
 
+        if (obj.objsize() >= LargeDocumentEditor::largeDocumentSize) {
+            LargeDocumentEditor *editor = new LargeDocumentEditor(_queryInfo._info,
+                obj, true, dynamic_cast<QWidget*>(_observer));
+
+            editor->setWindowTitle("View Document");
+            editor->show();
+            return;
+        }
+
         std::string str = BsonUtils::jsonString(obj, mongo::TenGen, 1,
             AppRegistry::instance().settingsManager()->uuidEncoding(),
             AppRegistry::instance().settingsManager()->timeZone());
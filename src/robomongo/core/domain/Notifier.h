@@ -13,7 +13,9 @@ namespace Robomongo
 {
     class MongoShell;
     class BsonTreeItem;
+    class DocumentPatch;
     class InsertDocumentResponse;
+    class UpdateDocumentResponse;
     struct RemoveDocumentResponse;
 
     namespace detail
@@ -58,6 +60,7 @@ namespace Robomongo
         void onCopyTimestamp();
         void onCopyJson();
         void handle(InsertDocumentResponse *event);
+        void handle(UpdateDocumentResponse *event);
         void handle(RemoveDocumentResponse *event);
 
     private Q_SLOTS:
@@ -65,6 +68,16 @@ namespace Robomongo
         void onCopyPathDocument();
 
     private:
+        /**
+         * @brief Edit document with LargeDocumentEditor and save changed fields only
+         */
+        void editLargeDocument(const mongo::BSONObj &obj);
+
+        /**
+         * @brief Save changed fields of document, see SettingsManager::checkConcurrentEdits()
+         */
+        void updateDocument(const DocumentPatch &patch);
+
         QAction *_deleteDocumentAction;
         QAction *_deleteDocumentsAction;
         QAction *_editDocumentAction;
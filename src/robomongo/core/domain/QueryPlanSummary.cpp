@@ -0,0 +1,94 @@
+#include "robomongo/core/domain/QueryPlanSummary.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // Queries which examine fewer documents are fast enough in any case
+    long long const minExaminedForWarning = 1000;
+
+    // Examined documents or keys per returned document above which query is inefficient
+    long long const maxExaminedPerReturned = 10;
+
+    void collectLeafStages(const mongo::BSONObj &stage, std::vector<std::string> &leaves)
+    {
+        // Sharded cluster: every shard has its own winning plan
+        if (stage.hasField("shards")) {
+            mongo::BSONObjIterator shards(stage.getObjectField("shards"));
+            while (shards.more())
+                collectLeafStages(shards.next().Obj().getObjectField("winningPlan"), leaves);
+            return;
+        }
+
+        bool hasInputs = false;
+        if (stage.hasField("inputStage")) {
+            collectLeafStages(stage.getObjectField("inputStage"), leaves);
+            hasInputs = true;
+        }
+
+        mongo::BSONObjIterator inputs(stage.getObjectField("inputStages"));
+        while (inputs.more()) {
+            collectLeafStages(inputs.next().Obj(), leaves);
+            hasInputs = true;
+        }
+
+        if (hasInputs || stage.isEmpty())
+            return;
+
+        std::string leaf = stage.getStringField("stage");
+        if (stage.hasField("keyPattern"))
+            leaf += " " + stage.getObjectField("keyPattern").toString();
+
+        if (std::find(leaves.begin(), leaves.end(), leaf) == leaves.end())
+            leaves.push_back(leaf);
+    }
+}
+
+namespace Robomongo
+{
+    QueryPlanSummary::QueryPlanSummary() :
+        keysExamined(0), docsExamined(0), returned(0), executionMs(0) {}
+
+    QueryPlanSummary QueryPlanSummary::fromExplain(const mongo::BSONObj &explain)
+    {
+        QueryPlanSummary summary;
+        summary.explain = explain.getOwned();
+
+        // MongoDB before 3.0
+        if (explain.hasField("cursor")) {
+            std::string const cursor = explain.getStringField("cursor");
+            summary.plan = cursor == "BasicCursor" ? "COLLSCAN"
+                         : cursor.compare(0, 11, "BtreeCursor") == 0 ? "IXSCAN" + cursor.substr(11)
+                         : cursor;
+            summary.keysExamined = explain["nscanned"].safeNumberLong();
+            summary.docsExamined = explain["nscannedObjects"].safeNumberLong();
+            summary.returned = explain["n"].safeNumberLong();
+            summary.executionMs = explain["millis"].safeNumberLong();
+            return summary;
+        }
+
+        std::vector<std::string> leaves;
+        collectLeafStages(explain.getObjectField("queryPlanner").getObjectField("winningPlan"), leaves);
+        for (auto const& leaf : leaves)
+            summary.plan += (summary.plan.empty() ? "" : ", ") + leaf;
+
+        mongo::BSONObj const stats = explain.getObjectField("executionStats");
+        summary.keysExamined = stats["totalKeysExamined"].safeNumberLong();
+        summary.docsExamined = stats["totalDocsExamined"].safeNumberLong();
+        summary.returned = stats["nReturned"].safeNumberLong();
+        summary.executionMs = stats["executionTimeMillis"].safeNumberLong();
+        return summary;
+    }
+
+    bool QueryPlanSummary::isCollectionScan() const
+    {
+        return plan.find("COLLSCAN") != std::string::npos;
+    }
+
+    bool QueryPlanSummary::isInefficient() const
+    {
+        long long const examined = std::max(keysExamined, docsExamined);
+        return examined >= minExaminedForWarning && examined > maxExaminedPerReturned * returned;
+    }
+}
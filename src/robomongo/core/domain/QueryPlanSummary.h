@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Winning plan and execution counters of explain("executionStats") of one query.
+     */
+    struct QueryPlanSummary
+    {
+        QueryPlanSummary();
+
+        /**
+         * @brief Parse explain output of MongoDB 3.0+ (queryPlanner / executionStats)
+         *        or of older servers (cursor / nscanned / n).
+         */
+        static QueryPlanSummary fromExplain(const mongo::BSONObj &explain);
+
+        /**
+         * @brief True if winning plan reads whole collection.
+         */
+        bool isCollectionScan() const;
+
+        /**
+         * @brief True if query examines many more documents or keys than it returns,
+         *        i.e. index is missing or not selective enough.
+         */
+        bool isInefficient() const;
+
+        std::string plan;           // leaf stages of winning plan, i.e. "IXSCAN { a: 1 }", "COLLSCAN"
+        long long keysExamined;
+        long long docsExamined;
+        long long returned;
+        long long executionMs;
+        mongo::BSONObj explain;     // whole explain output
+    };
+}
@@ -0,0 +1,96 @@
+#include "robomongo/core/domain/ServerStatusSample.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+namespace Robomongo
+{
+    const char *serverMetricName(ServerMetric metric)
+    {
+        static const char *const names[ServerMetricCount] = {
+            "Inserts/s", "Queries/s", "Updates/s", "Deletes/s", "GetMores/s", "Commands/s",
+            "Network in/s", "Network out/s", "Queued readers", "Queued writers",
+            "Cache used %", "Cache dirty %", "Connections"
+        };
+        return names[metric];
+    }
+
+    ServerStatusPoint::ServerStatusPoint() :
+        timeMs(0)
+    {
+        for (double &value : values)
+            value = 0;
+    }
+
+    ServerStatusSample::ServerStatusSample() :
+        timeMs(0), uptimeMs(0),
+        inserts(0), queries(0), updates(0), deletes(0), getMores(0), commands(0), bytesIn(0), bytesOut(0),
+        queuedReaders(0), queuedWriters(0), cacheBytes(0), cacheMaxBytes(0), cacheDirtyBytes(0), connections(0) {}
+
+    ServerStatusSample ServerStatusSample::fromServerStatus(const mongo::BSONObj &status, long long timeMs)
+    {
+        ServerStatusSample sample;
+        sample.host = status.getStringField("host");
+        sample.timeMs = timeMs;
+        sample.uptimeMs = status["uptimeMillis"].safeNumberLong();
+
+        mongo::BSONObj const opcounters = status.getObjectField("opcounters");
+        sample.inserts = opcounters["insert"].safeNumberLong();
+        sample.queries = opcounters["query"].safeNumberLong();
+        sample.updates = opcounters["update"].safeNumberLong();
+        sample.deletes = opcounters["delete"].safeNumberLong();
+        sample.getMores = opcounters["getmore"].safeNumberLong();
+        sample.commands = opcounters["command"].safeNumberLong();
+
+        mongo::BSONObj const network = status.getObjectField("network");
+        sample.bytesIn = network["bytesIn"].safeNumberLong();
+        sample.bytesOut = network["bytesOut"].safeNumberLong();
+
+        mongo::BSONObj const queue = status.getObjectField("globalLock").getObjectField("currentQueue");
+        sample.queuedReaders = queue["readers"].numberInt();
+        sample.queuedWriters = queue["writers"].numberInt();
+
+        mongo::BSONObj const cache = status.getObjectField("wiredTiger").getObjectField("cache");
+        sample.cacheBytes = cache["bytes currently in the cache"].numberDouble();
+        sample.cacheMaxBytes = cache["maximum bytes configured"].numberDouble();
+        sample.cacheDirtyBytes = cache["tracked dirty bytes in the cache"].numberDouble();
+
+        sample.connections = status.getObjectField("connections")["current"].numberInt();
+        return sample;
+    }
+
+    bool ServerStatusSample::computePoint(const ServerStatusSample &previous, const ServerStatusSample &current,
+                                          ServerStatusPoint &point)
+    {
+        if (!previous.error.empty() || !current.error.empty())
+            return false;
+
+        long long const intervalMs = current.timeMs - previous.timeMs;
+        if (intervalMs <= 0 || current.uptimeMs < previous.uptimeMs)
+            return false;
+
+        // Counters are never decreasing while server is running
+        long long const counters[][2] = {
+            { previous.inserts, current.inserts }, { previous.queries, current.queries },
+            { previous.updates, current.updates }, { previous.deletes, current.deletes },
+            { previous.getMores, current.getMores }, { previous.commands, current.commands },
+            { previous.bytesIn, current.bytesIn }, { previous.bytesOut, current.bytesOut }
+        };
+        static_assert(sizeof(counters) / sizeof(counters[0]) == BytesOutPerSec + 1,
+                      "Every rate metric needs a counter");
+
+        double const seconds = intervalMs / 1000.0;
+        for (int i = 0; i <= BytesOutPerSec; ++i) {
+            if (counters[i][1] < counters[i][0])
+                return false;
+            point.values[i] = (counters[i][1] - counters[i][0]) / seconds;
+        }
+
+        point.timeMs = current.timeMs;
+        point.values[QueuedReaders] = current.queuedReaders;
+        point.values[QueuedWriters] = current.queuedWriters;
+        point.values[CacheUsedPercent] = current.cacheMaxBytes > 0 ? 100 * current.cacheBytes / current.cacheMaxBytes : 0;
+        point.values[CacheDirtyPercent] = current.cacheMaxBytes > 0 ? 100 * current.cacheDirtyBytes / current.cacheMaxBytes : 0;
+        point.values[Connections] = current.connections;
+        return true;
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Metrics shown by performance monitor. Counters of serverStatus are
+     *        converted to rates per second, other metrics are current values.
+     */
+    enum ServerMetric
+    {
+        InsertsPerSec,
+        QueriesPerSec,
+        UpdatesPerSec,
+        DeletesPerSec,
+        GetMoresPerSec,
+        CommandsPerSec,
+        BytesInPerSec,
+        BytesOutPerSec,
+        QueuedReaders,
+        QueuedWriters,
+        CacheUsedPercent,       // WiredTiger only
+        CacheDirtyPercent,      // WiredTiger only
+        Connections,
+        ServerMetricCount
+    };
+
+    const char *serverMetricName(ServerMetric metric);
+
+    /**
+     * @brief Values of all metrics at one moment.
+     */
+    struct ServerStatusPoint
+    {
+        ServerStatusPoint();
+
+        long long timeMs;
+        double values[ServerMetricCount];
+    };
+
+    /**
+     * @brief Raw counters and gauges of one serverStatus result.
+     */
+    struct ServerStatusSample
+    {
+        ServerStatusSample();
+
+        /**
+         * @brief Parse result of { serverStatus: 1 }, sections which are missing are left zero.
+         */
+        static ServerStatusSample fromServerStatus(const mongo::BSONObj &status, long long timeMs);
+
+        /**
+         * @brief Compute rates between 'previous' and 'current' sample of the same server.
+         * @return false if rates cannot be computed: samples are not in order or
+         *         server was restarted (counters were reset) between them.
+         */
+        static bool computePoint(const ServerStatusSample &previous, const ServerStatusSample &current,
+                                 ServerStatusPoint &point);
+
+        std::string host;
+        std::string error;          // not empty if serverStatus failed, other fields are zero
+        long long timeMs;           // when sample was taken, ms since epoch
+        long long uptimeMs;
+
+        long long inserts;
+        long long queries;
+        long long updates;
+        long long deletes;
+        long long getMores;
+        long long commands;
+        long long bytesIn;
+        long long bytesOut;
+
+        int queuedReaders;
+        int queuedWriters;
+        double cacheBytes;
+        double cacheMaxBytes;
+        double cacheDirtyBytes;
+        int connections;
+    };
+}
@@ -14,9 +14,23 @@ namespace Robomongo
     R_REGISTER_EVENT(LoadDatabaseNamesResponse)
     R_REGISTER_EVENT(LoadCollectionNamesRequest)
     R_REGISTER_EVENT(LoadCollectionNamesResponse)
+    R_REGISTER_EVENT(LoadCollectionStatsRequest)
+    R_REGISTER_EVENT(LoadCollectionStatsResponse)
     R_REGISTER_EVENT(LoadUsersRequest)
     R_REGISTER_EVENT(LoadCollectionIndexesRequest)
     R_REGISTER_EVENT(LoadCollectionIndexesResponse)
+    R_REGISTER_EVENT(LoadIndexStatsRequest)
+    R_REGISTER_EVENT(LoadIndexStatsResponse)
+    R_REGISTER_EVENT(LoadStorageStatsRequest)
+    R_REGISTER_EVENT(LoadStorageStatsResponse)
+    R_REGISTER_EVENT(ServerStatusRequest)
+    R_REGISTER_EVENT(ServerStatusResponse)
+    R_REGISTER_EVENT(CurrentOpRequest)
+    R_REGISTER_EVENT(CurrentOpResponse)
+    R_REGISTER_EVENT(KillOpRequest)
+    R_REGISTER_EVENT(KillOpResponse)
+    R_REGISTER_EVENT(ExplainQueryRequest)
+    R_REGISTER_EVENT(ExplainQueryResponse)
     R_REGISTER_EVENT(EnsureIndexRequest)
     R_REGISTER_EVENT(DropCollectionIndexRequest)
     R_REGISTER_EVENT(DeleteCollectionIndexResponse)
@@ -40,6 +54,12 @@ namespace Robomongo
     R_REGISTER_EVENT(ScriptExecutingEvent)
     R_REGISTER_EVENT(InsertDocumentRequest)
     R_REGISTER_EVENT(InsertDocumentResponse)
+    R_REGISTER_EVENT(UpdateDocumentRequest)
+    R_REGISTER_EVENT(UpdateDocumentResponse)
+    R_REGISTER_EVENT(InsertDocumentsRequest)
+    R_REGISTER_EVENT(InsertDocumentsResponse)
+    R_REGISTER_EVENT(ExportDocumentsRequest)
+    R_REGISTER_EVENT(ExportDocumentsResponse)
     R_REGISTER_EVENT(RemoveDocumentRequest)
     R_REGISTER_EVENT(RemoveDocumentResponse)
     R_REGISTER_EVENT(CreateDatabaseRequest)
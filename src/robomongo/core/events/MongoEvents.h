@@ -1,17 +1,23 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <QString>
 #include <QStringList>
 #include <QEvent>
 #include <mongo/client/dbclientinterface.h>
+#include <mongo/logger/log_severity.h>
 
 #include "robomongo/core/domain/MongoShellResult.h"
 #include "robomongo/core/domain/CursorPosition.h"
 #include "robomongo/core/domain/MongoUser.h"
 #include "robomongo/core/domain/MongoFunction.h"
+#include "robomongo/core/domain/QueryPlanSummary.h"
+#include "robomongo/core/domain/ServerStatusSample.h"
 #include "robomongo/core/events/MongoEventsInfo.h"
 #include "robomongo/core/Event.h"
 #include "robomongo/core/Enums.h"
+#include "robomongo/core/mongodb/DocumentExporter.h"
 #include "robomongo/core/mongodb/ReplicaSet.h"
 
 namespace Robomongo
@@ -31,13 +37,19 @@ namespace Robomongo
     {
         R_EVENT
 
-            EstablishConnectionRequest(QObject *sender, ConnectionType connectionType, std::string const& uuid) :
+            EstablishConnectionRequest(QObject *sender, ConnectionType connectionType, std::string const& uuid,
+                                       std::vector<std::string> const& cachedDatabases = std::vector<std::string>()) :
             Event(sender),
             connectionType(connectionType),
-            uuid(uuid) {}
+            uuid(uuid),
+            cachedDatabases(cachedDatabases) {}
 
         ConnectionType const connectionType;
         std::string const uuid;
+
+        // Last known databases of connection (see MetadataCache). When not empty, listDatabases is
+        // skipped and these are returned instead, sender is expected to revalidate them.
+        std::vector<std::string> const cachedDatabases;
     };
 
     struct EstablishConnectionResponse : public Event
@@ -208,6 +220,61 @@ namespace Robomongo
         std::vector<MongoCollectionInfo> _collectionInfos;
     };
 
+    /**
+     * @brief Load statistics (collStats) of some collections of database.
+     *        Collection names are loaded without statistics, these are requested
+     *        only for collections visible in explorer (see ExplorerTreeWidget).
+     */
+    class LoadCollectionStatsRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        LoadCollectionStatsRequest(QObject *sender, const std::string &databaseName,
+                                   const std::vector<std::string> &collectionNames) :
+            Event(sender),
+            _databaseName(databaseName),
+            _collectionNames(collectionNames) {}
+
+        std::string databaseName() const { return _databaseName; }
+        std::vector<std::string> collectionNames() const { return _collectionNames; }
+
+    private:
+        std::string _databaseName;
+        std::vector<std::string> _collectionNames;
+    };
+
+    class LoadCollectionStatsResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        LoadCollectionStatsResponse(QObject *sender, const std::string &databaseName,
+                                    const std::vector<MongoCollectionInfo> &collectionInfos) :
+            Event(sender),
+            _databaseName(databaseName),
+            _collectionInfos(collectionInfos) { }
+
+        LoadCollectionStatsResponse(QObject *sender, const std::string &databaseName,
+                                    const std::vector<std::string> &collectionNames, const EventError &error) :
+            Event(sender, error),
+            _databaseName(databaseName),
+            _collectionNames(collectionNames) {}
+
+        std::string databaseName() const { return _databaseName; }
+        std::vector<MongoCollectionInfo> collectionInfos() const { return _collectionInfos; }
+
+        /**
+         * @brief Names of requested collections, set only for error response
+         */
+        std::vector<std::string> collectionNames() const { return _collectionNames; }
+
+    private:
+        std::string _databaseName;
+        std::vector<MongoCollectionInfo> _collectionInfos;
+        std::vector<std::string> _collectionNames;
+    };
+
     class LoadCollectionIndexesRequest : public Event
     {
         R_EVENT
@@ -233,6 +300,164 @@ namespace Robomongo
         std::vector<EnsureIndexInfo> _indexes;
     };
 
+    class LoadIndexStatsRequest : public Event
+    {
+        R_EVENT
+    public:
+        LoadIndexStatsRequest(QObject *sender, const MongoCollectionInfo &collection) :
+            Event(sender), _collection(collection) {}
+        MongoCollectionInfo collection() const { return _collection; }
+    private:
+        const MongoCollectionInfo _collection;
+    };
+
+    class LoadIndexStatsResponse : public Event
+    {
+        R_EVENT
+    public:
+        LoadIndexStatsResponse(QObject *sender, const std::vector<IndexStatsInfo> &stats) :
+            Event(sender), _stats(stats) {}
+
+        LoadIndexStatsResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+        std::vector<IndexStatsInfo> stats() const { return _stats; }
+    private:
+        std::vector<IndexStatsInfo> _stats;
+    };
+
+    class LoadStorageStatsRequest : public Event
+    {
+        R_EVENT
+    public:
+        LoadStorageStatsRequest(QObject *sender, const std::shared_ptr<std::atomic<bool>> &cancelled) :
+            Event(sender), _cancelled(cancelled) {}
+
+        /**
+         * @brief Set by sender to stop loading, remaining statistics are not requested.
+         */
+        std::shared_ptr<std::atomic<bool>> cancelled() const { return _cancelled; }
+    private:
+        const std::shared_ptr<std::atomic<bool>> _cancelled;
+    };
+
+    /**
+     * @brief Sent several times for one LoadStorageStatsRequest, with statistics
+     *        completed since previous response. The last one has finished() set.
+     */
+    class LoadStorageStatsResponse : public Event
+    {
+        R_EVENT
+    public:
+        LoadStorageStatsResponse(QObject *sender, const std::vector<StorageStatsInfo> &stats,
+                                 bool finished, int failed, const std::string &lastFailure) :
+            Event(sender), _stats(stats), _finished(finished), _failed(failed), _lastFailure(lastFailure) {}
+
+        LoadStorageStatsResponse(QObject *sender, const EventError &error) :
+            Event(sender, error), _finished(true), _failed(0) {}
+
+        std::vector<StorageStatsInfo> stats() const { return _stats; }
+        bool finished() const { return _finished; }
+
+        /**
+         * @brief Number of databases or collections whose statistics failed so far
+         *        (i.e. not authorized), and error of the last one.
+         */
+        int failed() const { return _failed; }
+        std::string lastFailure() const { return _lastFailure; }
+    private:
+        std::vector<StorageStatsInfo> _stats;
+        bool _finished;
+        int _failed;
+        std::string _lastFailure;
+    };
+
+    /**
+     * @brief Poll serverStatus of every member of connection, handled by MonitorWorker.
+     */
+    class ServerStatusRequest : public Event
+    {
+        R_EVENT
+    public:
+        ServerStatusRequest(QObject *sender) : Event(sender) {}
+    };
+
+    /**
+     * @brief One sample per member, samples of unreachable members have error set.
+     */
+    class ServerStatusResponse : public Event
+    {
+        R_EVENT
+    public:
+        ServerStatusResponse(QObject *sender, const std::vector<ServerStatusSample> &samples) :
+            Event(sender), _samples(samples) {}
+
+        ServerStatusResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        const std::vector<ServerStatusSample> &samples() const { return _samples; }
+    private:
+        std::vector<ServerStatusSample> _samples;
+    };
+
+    /**
+     * @brief Load operations in progress on every member of connection, handled by MonitorWorker.
+     */
+    class CurrentOpRequest : public Event
+    {
+        R_EVENT
+    public:
+        CurrentOpRequest(QObject *sender) : Event(sender) {}
+    };
+
+    class CurrentOpResponse : public Event
+    {
+        R_EVENT
+    public:
+        CurrentOpResponse(QObject *sender, const std::vector<CurrentOpInfo> &ops,
+                          const std::vector<std::string> &failures) :
+            Event(sender), _ops(ops), _failures(failures) {}
+
+        CurrentOpResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        const std::vector<CurrentOpInfo> &ops() const { return _ops; }
+
+        /**
+         * @brief Members whose operations could not be loaded, "host: error"
+         */
+        const std::vector<std::string> &failures() const { return _failures; }
+    private:
+        std::vector<CurrentOpInfo> _ops;
+        std::vector<std::string> _failures;
+    };
+
+    class KillOpRequest : public Event
+    {
+        R_EVENT
+    public:
+        KillOpRequest(QObject *sender, const CurrentOpInfo &op) :
+            Event(sender), _op(op) {}
+
+        const CurrentOpInfo &op() const { return _op; }
+    private:
+        const CurrentOpInfo _op;
+    };
+
+    class KillOpResponse : public Event
+    {
+        R_EVENT
+    public:
+        KillOpResponse(QObject *sender, const CurrentOpInfo &op) :
+            Event(sender), _op(op) {}
+
+        KillOpResponse(QObject *sender, const CurrentOpInfo &op, const EventError &error) :
+            Event(sender, error), _op(op) {}
+
+        const CurrentOpInfo &op() const { return _op; }
+    private:
+        const CurrentOpInfo _op;
+    };
+
     class EnsureIndexRequest : public Event
     {
         R_EVENT
@@ -399,6 +624,7 @@ namespace Robomongo
         mongo::BSONObj obj() const { return _obj; }
         MongoNamespace ns() const { return _ns; }
         bool overwrite() const { return _overwrite; }
+        virtual long long payloadSize() const { return _obj.objsize(); }
 
     private:
         mongo::BSONObj _obj;
@@ -418,6 +644,171 @@ namespace Robomongo
             Event(sender, error) {}
     };
 
+    /**
+     * @brief Update of one document by update operators, i.e. changes of large document
+     */
+
+    class UpdateDocumentRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        UpdateDocumentRequest(QObject *sender, const mongo::BSONObj &query, const mongo::BSONObj &update, const MongoNamespace &ns) :
+            Event(sender),
+            _query(query),
+            _update(update),
+            _ns(ns) {}
+
+        mongo::BSONObj query() const { return _query; }
+        mongo::BSONObj update() const { return _update; }
+        MongoNamespace ns() const { return _ns; }
+        virtual long long payloadSize() const { return _query.objsize() + _update.objsize(); }
+
+    private:
+        mongo::BSONObj _query;
+        mongo::BSONObj _update;
+        const MongoNamespace _ns;
+    };
+
+    class UpdateDocumentResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        UpdateDocumentResponse(QObject *sender) :
+            Event(sender) {}
+
+        UpdateDocumentResponse(QObject *sender, EventError const& error) :
+            Event(sender, error) {}
+    };
+
+    /**
+     * @brief Bulk insert of one batch of imported documents
+     */
+
+    class InsertDocumentsRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        InsertDocumentsRequest(QObject *sender, const std::vector<mongo::BSONObj> &documents,
+                               const MongoNamespace &ns, bool ordered, long long batchId) :
+            Event(sender),
+            _documents(documents),
+            _ns(ns),
+            _ordered(ordered),
+            _batchId(batchId) {}
+
+        const std::vector<mongo::BSONObj> &documents() const { return _documents; }
+        MongoNamespace ns() const { return _ns; }
+        bool ordered() const { return _ordered; }
+        long long batchId() const { return _batchId; }
+
+        virtual long long payloadSize() const {
+            long long size = 0;
+            for (auto const& doc : _documents)
+                size += doc.objsize();
+            return size;
+        }
+
+    private:
+        std::vector<mongo::BSONObj> _documents;
+        const MongoNamespace _ns;
+        bool _ordered;
+        long long _batchId;
+    };
+
+    class InsertDocumentsResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        InsertDocumentsResponse(QObject *sender, long long batchId, const InsertDocumentsResult &result) :
+            Event(sender),
+            _batchId(batchId),
+            _result(result) {}
+
+        /**
+         * @brief The whole batch failed (i.e. connection lost), it is not known which documents were inserted
+         */
+        InsertDocumentsResponse(QObject *sender, long long batchId, EventError const& error) :
+            Event(sender, error),
+            _batchId(batchId) {}
+
+        long long batchId() const { return _batchId; }
+        const InsertDocumentsResult &result() const { return _result; }
+
+    private:
+        long long _batchId;
+        InsertDocumentsResult _result;
+    };
+
+    /**
+     * @brief Export documents into file. Every request exports one time-limited
+     *        chunk, sender continues export by sending Continue request after every
+     *        not finished response (see DocumentExporter).
+     */
+
+    class ExportDocumentsRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        enum Action { Start, Continue, Cancel };
+
+        ExportDocumentsRequest(QObject *sender, long long exportId, Action action,
+                               const ExportOptions &options = ExportOptions()) :
+            Event(sender),
+            _exportId(exportId),
+            _action(action),
+            _options(options) {}
+
+        long long exportId() const { return _exportId; }
+        Action action() const { return _action; }
+        const ExportOptions &options() const { return _options; }
+
+    private:
+        long long _exportId;
+        Action _action;
+        ExportOptions _options;
+    };
+
+    class ExportDocumentsResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        ExportDocumentsResponse(QObject *sender, long long exportId, long long exported, long long total,
+                                long long bytesWritten, bool finished) :
+            Event(sender),
+            _exportId(exportId),
+            _exported(exported),
+            _total(total),
+            _bytesWritten(bytesWritten),
+            _finished(finished) {}
+
+        ExportDocumentsResponse(QObject *sender, long long exportId, EventError const& error) :
+            Event(sender, error),
+            _exportId(exportId),
+            _exported(0),
+            _total(0),
+            _bytesWritten(0),
+            _finished(true) {}
+
+        long long exportId() const { return _exportId; }
+        long long exported() const { return _exported; }
+        long long total() const { return _total; }
+        long long bytesWritten() const { return _bytesWritten; }
+        bool finished() const { return _finished; }
+
+    private:
+        long long _exportId;
+        long long _exported;
+        long long _total;
+        long long _bytesWritten;
+        bool _finished;
+    };
+
     /**
      * @brief Remove Document
      */
@@ -889,35 +1280,112 @@ namespace Robomongo
         R_EVENT
 
     public:
-        ExecuteQueryRequest(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo) :
+        ExecuteQueryRequest(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo,
+                            ReadPreferenceMode readPreference = ReadPrimary,
+                            const std::string &readTarget = std::string()) :
             Event(sender),
             _resultIndex(resultIndex),
-            _queryInfo(queryInfo) {}
+            _queryInfo(queryInfo),
+            _readPreference(readPreference),
+            _readTarget(readTarget) {}
 
         int resultIndex() const { return _resultIndex; }
         MongoQueryInfo queryInfo() const { return _queryInfo; }
+        ReadPreferenceMode readPreference() const { return _readPreference; }
+
+        /**
+         * @brief Member which served previous page of the result, empty for first page.
+         *        Pages of one result are read from the same member.
+         */
+        std::string readTarget() const { return _readTarget; }
 
     private:
         int _resultIndex; //external user data;
         MongoQueryInfo _queryInfo;
+        ReadPreferenceMode const _readPreference;
+        std::string const _readTarget;
     };
 
     class ExecuteQueryResponse : public Event
     {
         R_EVENT
 
-        ExecuteQueryResponse(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents) :
+        ExecuteQueryResponse(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, 
+                             const std::vector<MongoDocumentPtr> &documents, std::string const& servedBy = "",
+                             long long elapsedMs = 0) :
             Event(sender),
             resultIndex(resultIndex),
             queryInfo(queryInfo),
-            documents(documents) { }
+            documents(documents),
+            servedBy(servedBy),
+            elapsedMs(elapsedMs) { }
 
         ExecuteQueryResponse(QObject *sender, const EventError &error) :
-            Event(sender, error) {}
+            Event(sender, error), elapsedMs(0) {}
+
+        virtual long long payloadSize() const {
+            long long size = 0;
+            for (auto const& doc : documents)
+                size += doc->bsonObj().objsize();
+            return size;
+        }
 
         int resultIndex;
         MongoQueryInfo queryInfo;
         std::vector<MongoDocumentPtr> documents;
+        // Replica set member which served the query (empty when read preference is primary)
+        std::string servedBy;
+        // Time of query on server, incl. loading of documents
+        long long elapsedMs;
+    };
+
+    /**
+     * @brief Explain query of result 'resultIndex' of shell, handled by MonitorWorker.
+     *        Sent by MongoShell when query was slow (see SettingsManager::slowQueryExplainMs()).
+     */
+    class ExplainQueryRequest : public Event
+    {
+        R_EVENT
+    public:
+        /**
+         * @param requestId: returned in response, to tell it from responses for earlier queries of result
+         * @param host: member which served the query, empty for primary
+         */
+        ExplainQueryRequest(QObject *sender, int resultIndex, int requestId, const MongoQueryInfo &queryInfo,
+                            const std::string &host) :
+            Event(sender), _resultIndex(resultIndex), _requestId(requestId), _queryInfo(queryInfo), _host(host) {}
+
+        int resultIndex() const { return _resultIndex; }
+        int requestId() const { return _requestId; }
+        const MongoQueryInfo &queryInfo() const { return _queryInfo; }
+        const std::string &host() const { return _host; }
+    private:
+        int const _resultIndex;
+        int const _requestId;
+        MongoQueryInfo const _queryInfo;
+        std::string const _host;
+    };
+
+    /**
+     * @brief Sent by MonitorWorker to MongoShell, and published by MongoShell to result views.
+     */
+    class ExplainQueryResponse : public Event
+    {
+        R_EVENT
+    public:
+        ExplainQueryResponse(QObject *sender, int resultIndex, int requestId, const QueryPlanSummary &plan) :
+            Event(sender), _resultIndex(resultIndex), _requestId(requestId), _plan(plan) {}
+
+        ExplainQueryResponse(QObject *sender, int resultIndex, int requestId, const EventError &error) :
+            Event(sender, error), _resultIndex(resultIndex), _requestId(requestId) {}
+
+        int resultIndex() const { return _resultIndex; }
+        int requestId() const { return _requestId; }
+        const QueryPlanSummary &plan() const { return _plan; }
+    private:
+        int const _resultIndex;
+        int const _requestId;
+        QueryPlanSummary const _plan;
     };
 
     class AutocompleteRequest : public Event
@@ -958,17 +1426,22 @@ namespace Robomongo
     {
         R_EVENT
 
-        ExecuteScriptRequest(QObject *sender, const std::string &script, const std::string &dbName, int take = 0, int skip = 0) :
+        ExecuteScriptRequest(QObject *sender, const std::string &script, const std::string &dbName, int take = 0, int skip = 0,
+                             ReadPreferenceMode readPreference = ReadPrimary) :
             Event(sender),
             script(script),
             databaseName(dbName),
             take(take),
-            skip(skip) {}
+            skip(skip),
+            readPreference(readPreference) {}
+
+        virtual long long payloadSize() const { return script.size(); }
 
         std::string script;
         std::string databaseName;
         int take; //
         int skip;
+        ReadPreferenceMode readPreference;
     };
 
     class ExecuteScriptResponse : public Event
@@ -984,6 +1457,15 @@ namespace Robomongo
 
         bool timeoutReached() const { return _timeoutReached; }
 
+        virtual long long payloadSize() const {
+            long long size = 0;
+            for (auto const& res : result.results()) {
+                for (auto const& doc : res.documents())
+                    size += doc->bsonObj().objsize();
+            }
+            return size;
+        }
+
         MongoShellExecResult result;
         bool empty;
         bool const _timeoutReached = false;
@@ -1070,12 +1552,14 @@ namespace Robomongo
         R_EVENT
 
     public:
-        DocumentListLoadedEvent(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::string &query, const std::vector<MongoDocumentPtr> &docs) :
+        DocumentListLoadedEvent(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::string &query, 
+                                const std::vector<MongoDocumentPtr> &docs, std::string const& servedBy = "") :
             Event(sender),
             _resultIndex(resultIndex),
             _queryInfo(queryInfo),
             _query(query),
-            _documents(docs) { }
+            _documents(docs),
+            _servedBy(servedBy) { }
 
         DocumentListLoadedEvent(QObject *sender, const EventError &error) :
             Event(sender, error) {}
@@ -1084,12 +1568,14 @@ namespace Robomongo
         MongoQueryInfo queryInfo() const { return _queryInfo; }
         std::vector<MongoDocumentPtr> documents() const { return _documents; }
         std::string query() const { return _query; }
+        std::string servedBy() const { return _servedBy; }
 
     private:
         int _resultIndex;
         MongoQueryInfo _queryInfo;
         std::vector<MongoDocumentPtr> _documents;
         std::string _query;
+        std::string _servedBy;
     };
 
     class ScriptExecutedEvent : public Event
@@ -1253,6 +1739,15 @@ namespace Robomongo
             message(message),
             level(level) {}
 
+        static mongo::logger::LogSeverity severity(LogLevel level) {
+            switch (level) {
+            case RBM_ERROR: return mongo::logger::LogSeverity::Error();
+            case RBM_WARN:  return mongo::logger::LogSeverity::Warning();
+            case RBM_INFO:  return mongo::logger::LogSeverity::Info();
+            default:        return mongo::logger::LogSeverity::Log();
+            }
+        }
+
         std::string message;
         LogLevel level;
     };
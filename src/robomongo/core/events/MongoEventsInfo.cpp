@@ -17,6 +17,14 @@ namespace Robomongo
         _languageOverride(languageOverride),
         _textWeights(textWeights) {}
 
+    long long IndexStatsInfo::totalOps() const
+    {
+        long long total = 0;
+        for (auto const& member : members)
+            total += member.ops;
+        return total;
+    }
+
         ConnectionInfo::ConnectionInfo(std::string const& uuid) :
             _address(),
             _databases(),
@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <vector>
 #include "robomongo/core/domain/MongoCollectionInfo.h"
 
 namespace Robomongo
@@ -32,6 +33,86 @@ namespace Robomongo
         std::string _textWeights;
     };
 
+    /**
+     * @brief Usage and size of one index: size from collStats of primary,
+     *        operation counters from $indexStats of every reachable member.
+     */
+    struct IndexStatsInfo
+    {
+        struct MemberUsage
+        {
+            MemberUsage(const std::string &host, long long ops, long long sinceMs) :
+                host(host), ops(ops), sinceMs(sinceMs) {}
+
+            std::string host;
+            long long ops;          // operations which used index since 'sinceMs'
+            long long sinceMs;      // counting start (server restart or index creation), ms since epoch
+        };
+
+        explicit IndexStatsInfo(const std::string &name = std::string()) :
+            name(name), sizeBytes(-1), lastUsedMs(0) {}
+
+        long long totalOps() const;
+
+        std::string name;
+        long long sizeBytes;                // -1 if unknown
+        std::vector<MemberUsage> members;
+        long long lastUsedMs;               // when counters were seen growing, ms since epoch, 0 if never
+    };
+
+    /**
+     * @brief Storage statistics of one collection (collStats) or of whole database (dbStats),
+     *        see LoadStorageStatsRequest.
+     */
+    struct StorageStatsInfo
+    {
+        StorageStatsInfo() :
+            hasStats(false), count(0), dataSize(0), storageSize(0), indexSize(0), indexes(0), collections(0) {}
+
+        bool isDatabase() const { return collectionName.empty(); }
+
+        std::string dbName;
+        std::string collectionName;     // empty for database totals
+        bool hasStats;                  // false if command is not supported (i.e. collStats of view)
+        long long count;
+        double dataSize;                // bytes, double because stats may be returned as doubles
+        double storageSize;
+        double indexSize;
+        int indexes;
+        int collections;                // database totals only
+    };
+
+    /**
+     * @brief Outcome of one bulk insert (see InsertDocumentsRequest).
+     */
+    struct InsertDocumentsResult
+    {
+        InsertDocumentsResult() : inserted(0) {}
+
+        int inserted;                                       // nInserted reported by server
+        std::vector<std::pair<int, std::string>> errors;    // index of failed document and its error
+        std::string writeConcernError;                      // documents are inserted, but not acknowledged
+    };
+
+    /**
+     * @brief One operation in progress on member 'host', from currentOp.
+     */
+    struct CurrentOpInfo
+    {
+        CurrentOpInfo() : microsecs(0), waitingForLock(false) {}
+
+        std::string host;
+        std::string opid;           // number, or "shard:number" string on mongos
+        std::string op;             // "query", "update", "command", ...
+        std::string ns;
+        std::string planSummary;
+        std::string client;
+        std::string desc;
+        long long microsecs;        // running time
+        bool waitingForLock;
+        mongo::BSONObj details;     // whole currentOp entry, opid of killOp is taken from it
+    };
+
     struct ConnectionInfo
     {
         ConnectionInfo(std::string const& uuid);
@@ -0,0 +1,305 @@
+#include "robomongo/core/mongodb/DocumentExporter.h"
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <zlib.h>
+
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    // Documents rendered by one round of render threads
+    const size_t RenderGroupSize = 2048;
+
+    // Rendered output is buffered and written to file (or deflated) by blocks of this size
+    const size_t WriteBlockSize = 1024 * 1024;
+
+    // Each render thread gets at least this number of documents
+    const size_t MinDocumentsPerThread = 64;
+
+    bool csvNeedsQuotes(const std::string &value)
+    {
+        return value.find_first_of(",\"\r\n") != std::string::npos ||
+               (!value.empty() && value.front() == ' ');
+    }
+
+    void throwError(const std::string &message)
+    {
+        throw mongo::DBException(message, mongo::ErrorCodes::InternalError);
+    }
+}
+
+namespace Robomongo
+{
+    struct DocumentExporter::GzipStream
+    {
+        GzipStream() : initialized(false) {
+            stream.zalloc = Z_NULL;
+            stream.zfree = Z_NULL;
+            stream.opaque = Z_NULL;
+        }
+
+        ~GzipStream() {
+            if (initialized)
+                deflateEnd(&stream);
+        }
+
+        z_stream stream;
+        bool initialized;
+        std::vector<char> buffer;
+    };
+
+    DocumentExporter::DocumentExporter(const ExportOptions &options) :
+        _options(options),
+        _file(QtUtils::toQString(options.filePath + ".part")),
+        _finished(false),
+        _exported(0),
+        _total(0),
+        _bytesWritten(0)
+    {
+    }
+
+    DocumentExporter::~DocumentExporter()
+    {
+        // Cancelled or failed export: do not leave partial file behind
+        if (!_finished && _file.isOpen()) {
+            _file.close();
+            _file.remove();
+        }
+    }
+
+    void DocumentExporter::start(mongo::DBClientBase *connection)
+    {
+        if (_options.format == ExportOptions::Csv && _options.fields.empty())
+            throwError("List of fields is required for CSV export");
+
+        mongo::BSONObjBuilder projectionBuilder;
+        for (auto const& field : _options.fields)
+            projectionBuilder.append(field, 1);
+        mongo::BSONObj const projection = projectionBuilder.obj();
+
+        if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            throwError("Cannot open file " + QtUtils::toStdString(_file.fileName()) + ": " +
+                       QtUtils::toStdString(_file.errorString()));
+
+        if (_options.gzip) {
+            _gzip.reset(new GzipStream);
+            // windowBits 15 + 16: write gzip header and trailer instead of zlib ones
+            if (deflateInit2(&_gzip->stream, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                throwError("Cannot initialize gzip compression");
+            _gzip->initialized = true;
+            _gzip->buffer.resize(WriteBlockSize);
+        }
+
+        _total = connection->count(_options.ns, _options.query);
+
+        _cursor = connection->query(_options.ns, _options.query, 0, 0,
+                                    projection.isEmpty() ? 0 : &projection,
+                                    mongo::QueryOption_NoCursorTimeout, _options.batchSize);
+
+        // DBClientBase::query may return nullptr
+        if (!_cursor)
+            throwError("Network error while attempting to run query");
+
+        if (_options.format == ExportOptions::JsonArray) {
+            write("[");
+        }
+        else if (_options.format == ExportOptions::Csv) {
+            std::string header;
+            for (auto const& field : _options.fields) {
+                if (!header.empty())
+                    header += ',';
+                if (csvNeedsQuotes(field))
+                    header += '"' + field + '"';
+                else
+                    header += field;
+            }
+            write(header + "\n");
+        }
+    }
+
+    bool DocumentExporter::exportChunk(int timeBudgetMs)
+    {
+        if (_finished)
+            return true;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        std::vector<mongo::BSONObj> documents;
+        documents.reserve(RenderGroupSize);
+
+        do {
+            documents.clear();
+
+            // Take only documents already received, so time budget is not exceeded by more than one getMore
+            while (documents.size() < RenderGroupSize && _cursor->more()) {
+                documents.push_back(_cursor->next().getOwned());
+                if (!_cursor->moreInCurrentBatch())
+                    break;
+            }
+
+            if (!documents.empty())
+                writeDocuments(documents);
+
+            if (!_cursor->more()) {
+                finish();
+                return true;
+            }
+        } while (timer.elapsed() < timeBudgetMs);
+
+        write(std::string(), SyncFlush);
+        return false;
+    }
+
+    void DocumentExporter::writeDocuments(const std::vector<mongo::BSONObj> &documents)
+    {
+        size_t const threads = std::max<size_t>(1, std::min<size_t>(std::thread::hardware_concurrency(),
+                                                                   documents.size() / MinDocumentsPerThread));
+
+        // Each thread renders contiguous range of documents, so output stays in cursor order
+        std::vector<std::string> rendered(threads);
+        auto renderRange = [&](size_t index) {
+            size_t const begin = documents.size() * index / threads;
+            size_t const end = documents.size() * (index + 1) / threads;
+            std::string &out = rendered[index];
+            for (size_t i = begin; i < end; ++i)
+                renderDocument(documents[i], out);
+        };
+
+        std::vector<std::future<void>> futures;
+        for (size_t i = 1; i < threads; ++i)
+            futures.push_back(std::async(std::launch::async, renderRange, i));
+
+        renderRange(0);
+
+        for (auto &future : futures)
+            future.get();   // rethrows exception of render thread
+
+        // Separator before the first document of JSON array is not needed
+        if (_options.format == ExportOptions::JsonArray && _exported == 0)
+            rendered[0].erase(0, 1);
+
+        for (size_t i = 0; i < threads; ++i) {
+            write(rendered[i]);
+            rendered[i].clear();
+            rendered[i].shrink_to_fit();
+        }
+
+        _exported += documents.size();
+    }
+
+    void DocumentExporter::renderDocument(const mongo::BSONObj &doc, std::string &out) const
+    {
+        switch (_options.format) {
+        case ExportOptions::JsonArray:
+            // Every document is preceded by separator, first one is removed in writeDocuments()
+            out += ',';
+            out += BsonUtils::jsonString(doc, mongo::Strict, 0, _options.uuidEncoding, _options.timeZone);
+            break;
+        case ExportOptions::NdJson:
+            out += BsonUtils::jsonString(doc, mongo::Strict, 0, _options.uuidEncoding, _options.timeZone);
+            out += '\n';
+            break;
+        case ExportOptions::Csv:
+            for (size_t i = 0; i < _options.fields.size(); ++i) {
+                if (i > 0)
+                    out += ',';
+                mongo::BSONElement const elem = doc.getFieldDotted(_options.fields[i]);
+                if (!elem.eoo())
+                    renderCsvValue(elem, out);
+            }
+            out += '\n';
+            break;
+        }
+    }
+
+    void DocumentExporter::renderCsvValue(const mongo::BSONElement &elem, std::string &out) const
+    {
+        switch (elem.type()) {
+        case mongo::NumberInt:
+            out += std::to_string(elem.Int());
+            return;
+        case mongo::NumberLong:
+            out += std::to_string(elem.Long());
+            return;
+        case mongo::jstNULL:
+        case mongo::Undefined:
+            return;
+        default:
+            break;
+        }
+
+        // Same representation as in table view of query results
+        std::string value;
+        BsonUtils::buildJsonString(elem, value, _options.uuidEncoding, _options.timeZone);
+
+        if (!csvNeedsQuotes(value)) {
+            out += value;
+            return;
+        }
+
+        out += '"';
+        for (char c : value) {
+            if (c == '"')
+                out += '"';
+            out += c;
+        }
+        out += '"';
+    }
+
+    void DocumentExporter::write(const std::string &data, FlushMode flush)
+    {
+        char const* begin = data.data();
+        size_t const size = data.size();
+
+        if (!_gzip) {
+            if (size > 0 && _file.write(begin, size) != static_cast<qint64>(size))
+                throwError("Error when writing file: " + QtUtils::toStdString(_file.errorString()));
+            if (flush != NoFlush)
+                _file.flush();
+            _bytesWritten += size;
+            return;
+        }
+
+        z_stream &stream = _gzip->stream;
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(begin));
+        stream.avail_in = static_cast<uInt>(size);
+        int const mode = flush == FinishFlush ? Z_FINISH : (flush == SyncFlush ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+
+        do {
+            stream.next_out = reinterpret_cast<Bytef*>(_gzip->buffer.data());
+            stream.avail_out = static_cast<uInt>(_gzip->buffer.size());
+            int const result = deflate(&stream, mode);
+            if (result == Z_STREAM_ERROR)
+                throwError("Error when compressing file");
+
+            qint64 const have = _gzip->buffer.size() - stream.avail_out;
+            if (have > 0 && _file.write(_gzip->buffer.data(), have) != have)
+                throwError("Error when writing file: " + QtUtils::toStdString(_file.errorString()));
+            _bytesWritten += have;
+        } while (stream.avail_out == 0);
+    }
+
+    void DocumentExporter::finish()
+    {
+        if (_options.format == ExportOptions::JsonArray)
+            write("]\n");
+
+        write(std::string(), FinishFlush);
+        _gzip.reset();
+
+        _file.close();
+        if (_file.error() != QFileDevice::NoError)
+            throwError("Error when writing file: " + QtUtils::toStdString(_file.errorString()));
+
+        QString const finalPath = QtUtils::toQString(_options.filePath);
+        QFile::remove(finalPath);
+        if (!_file.rename(finalPath))
+            throwError("Cannot rename " + QtUtils::toStdString(_file.fileName()) + " to " + _options.filePath);
+
+        _finished = true;
+    }
+}
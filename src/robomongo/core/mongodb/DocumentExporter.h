@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mongo/client/dbclientinterface.h>
+
+#include "robomongo/core/Enums.h"
+
+namespace Robomongo
+{
+    struct ExportOptions
+    {
+        enum Format { JsonArray, NdJson, Csv };
+
+        ExportOptions() :
+            format(JsonArray), gzip(false), batchSize(1000),
+            uuidEncoding(DefaultEncoding), timeZone(Utc) {}
+
+        std::string ns;
+        mongo::BSONObj query;
+        std::vector<std::string> fields;    // projection, also columns of CSV (required for CSV)
+        Format format;
+        bool gzip;
+        int batchSize;                      // cursor batch size
+        std::string filePath;
+        UUIDEncoding uuidEncoding;
+        SupportedTimes timeZone;
+    };
+
+    /**
+     * @brief Streams cursor of a query into JSON array, NDJSON or CSV file, optionally gzipped.
+     *        Lives in MongoWorker, which calls exportChunk() once per ExportDocumentsRequest,
+     *        so other requests of the worker are not blocked for the whole export.
+     *
+     *        Documents are rendered with BsonUtils by several threads at once, output is written
+     *        into "<file>.part" which is renamed to the final name only when export succeeded.
+     *        All errors are thrown as mongo::DBException.
+     */
+    class DocumentExporter
+    {
+    public:
+        explicit DocumentExporter(const ExportOptions &options);
+        ~DocumentExporter();
+
+        /**
+         * @brief Opens output file and cursor, counts documents to export.
+         */
+        void start(mongo::DBClientBase *connection);
+
+        /**
+         * @brief Exports documents for about 'timeBudgetMs'.
+         * @return true when all documents are exported and file is complete.
+         */
+        bool exportChunk(int timeBudgetMs);
+
+        long long exported() const { return _exported; }
+        long long total() const { return _total; }
+        long long bytesWritten() const { return _bytesWritten; }
+
+    private:
+        enum FlushMode { NoFlush, SyncFlush, FinishFlush };
+
+        void renderDocument(const mongo::BSONObj &doc, std::string &out) const;
+        void renderCsvValue(const mongo::BSONElement &elem, std::string &out) const;
+        void writeDocuments(const std::vector<mongo::BSONObj> &documents);
+        void write(const std::string &data, FlushMode flush = NoFlush);
+        void finish();
+
+        const ExportOptions _options;
+        std::unique_ptr<mongo::DBClientCursor> _cursor;
+        QFile _file;
+        struct GzipStream;
+        std::unique_ptr<GzipStream> _gzip;
+        bool _finished;
+        long long _exported;
+        long long _total;
+        long long _bytesWritten;
+    };
+}
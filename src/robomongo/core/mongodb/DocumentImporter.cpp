@@ -0,0 +1,522 @@
+#include "robomongo/core/mongodb/DocumentImporter.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTimer>
+#include <algorithm>
+#include <future>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/MonitorWorker.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/Logger.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/shell/bson/json.h"
+
+namespace
+{
+    const qint64 InitialWindowSize = 64 * 1024 * 1024;
+    const qint64 MaxWindowSize = 1024 * 1024 * 1024;
+    const size_t MaxQueuedBatches = 4;
+    const int CheckpointIntervalMs = 1000;
+
+    QString checkpointPath(const QString &filePath)
+    {
+        return filePath + ".robomongo-import";
+    }
+
+    inline bool isSpace(char c)
+    {
+        return isspace(static_cast<unsigned char>(c)) != 0;
+    }
+
+    // Documents of JSON array are separated by commas, the rest by whitespace
+    inline bool isSeparator(char c)
+    {
+        return c == ',' || isSpace(c);
+    }
+
+    mongo::StringData trimSeparators(const mongo::StringData &slice)
+    {
+        const char *begin = slice.rawData();
+        const char *const end = begin + slice.size();
+        while (begin < end && isSeparator(*begin))
+            ++begin;
+        return mongo::StringData(begin, end - begin);
+    }
+}
+
+namespace Robomongo
+{
+    DocumentImporter::DocumentImporter(const ConnectionSettings *connection, const QString &filePath,
+                                       const MongoNamespace &ns, const ImportOptions &options, QObject *parent) :
+        QObject(parent),
+        _worker(new MonitorWorker(connection->clone(), AppRegistry::instance().settingsManager()->mongoTimeoutSec())),
+        _filePath(filePath),
+        _ns(ns),
+        _options(options),
+        _fileSize(QFileInfo(filePath).size()),
+        _readerDone(false),
+        _cancelled(false),
+        _nextBatchId(0),
+        _parseFailed(0),
+        _running(false),
+        _throttled(false),
+        _checkpointOffset(options.resumeOffset),
+        _inserted(options.resumeInserted),
+        _failed(0),
+        _sentDocuments(0)
+    {
+    }
+
+    DocumentImporter::~DocumentImporter()
+    {
+        stopReader();
+
+        // Worker is deleted by its own thread (see MonitorWorker constructor)
+        _worker->stopAndDelete();
+    }
+
+    void DocumentImporter::start()
+    {
+        if (_running)
+            return;
+
+        _running = true;
+        _elapsed.start();
+        _sinceCheckpoint.start();
+        _reader = std::thread(&DocumentImporter::readFile, this);
+        emit progress(_checkpointOffset, _fileSize, _inserted, _failed);
+    }
+
+    void DocumentImporter::cancel()
+    {
+        if (!_running)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cancelled = true;
+        }
+        _queueNotFull.notify_all();
+        sendBatches();  // finishes right away if there are no batches in flight
+    }
+
+    bool DocumentImporter::loadCheckpoint(const QString &filePath, const MongoNamespace &ns,
+                                          qint64 *offset, long long *inserted)
+    {
+        QFile file(checkpointPath(filePath));
+        if (!file.open(QIODevice::ReadOnly))
+            return false;
+
+        QJsonObject const checkpoint = QJsonDocument::fromJson(file.readAll()).object();
+        QFileInfo const info(filePath);
+
+        // Checkpoint is valid only for the same collection and unchanged file
+        if (checkpoint.value("ns").toString() != QtUtils::toQString(ns.toString()) ||
+            checkpoint.value("size").toDouble() != static_cast<double>(info.size()) ||
+            checkpoint.value("modified").toDouble() != static_cast<double>(info.lastModified().toMSecsSinceEpoch()))
+            return false;
+
+        *offset = static_cast<qint64>(checkpoint.value("offset").toDouble());
+        *inserted = static_cast<long long>(checkpoint.value("inserted").toDouble());
+        return *offset > 0 && *offset <= info.size();
+    }
+
+    void DocumentImporter::removeCheckpoint(const QString &filePath)
+    {
+        QFile::remove(checkpointPath(filePath));
+    }
+
+    void DocumentImporter::saveCheckpoint()
+    {
+        if (_checkpointOffset <= 0)
+            return;
+
+        QFileInfo const info(_filePath);
+        QJsonObject checkpoint;
+        checkpoint.insert("file", _filePath);
+        checkpoint.insert("ns", QtUtils::toQString(_ns.toString()));
+        checkpoint.insert("size", static_cast<double>(info.size()));
+        checkpoint.insert("modified", static_cast<double>(info.lastModified().toMSecsSinceEpoch()));
+        checkpoint.insert("offset", static_cast<double>(_checkpointOffset));
+        checkpoint.insert("inserted", static_cast<double>(_inserted));
+
+        QSaveFile file(checkpointPath(_filePath));
+        if (!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(checkpoint).toJson()) < 0 || !file.commit())
+            LOG_MSG("Cannot save import checkpoint: " + file.errorString(), mongo::logger::LogSeverity::Warning());
+    }
+
+    void DocumentImporter::sendBatches()
+    {
+        if (!_running)
+            return;
+
+        // Ordered import waits for every batch, so that nothing is inserted after a failed batch
+        size_t const maxSentBatches = _options.ordered ? 1 : 2;
+        bool const stopping = _cancelled || !_insertError.isEmpty();
+
+        while (!stopping && !_throttled && _sent.size() < maxSentBatches) {
+            if (_options.maxDocsPerSecond > 0) {
+                double const allowed = _elapsed.elapsed() / 1000.0 * _options.maxDocsPerSecond;
+                if (_sentDocuments > allowed) {
+                    int const delayMs = static_cast<int>((_sentDocuments - allowed) * 1000 / _options.maxDocsPerSecond) + 1;
+                    _throttled = true;
+                    QTimer::singleShot(delayMs, this, [this]() {
+                        _throttled = false;
+                        sendBatches();
+                    });
+                    return;
+                }
+            }
+
+            Batch batch;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_queue.empty())
+                    break;
+
+                batch = std::move(_queue.front());
+                _queue.pop_front();
+            }
+            _queueNotFull.notify_one();
+
+            _sent.push_back({ batch.id, std::move(batch.endOffsets) });
+            _sentDocuments += batch.documents.size();
+            AppRegistry::instance().bus()->send(_worker,
+                new InsertDocumentsRequest(this, batch.documents, _ns, _options.ordered, batch.id));
+        }
+
+        if (!_sent.empty() || _throttled)
+            return;
+
+        if (!_insertError.isEmpty()) {
+            finish(false, "Import stopped on failed insert: " + _insertError);
+            return;
+        }
+
+        if (_cancelled) {
+            finish(false, "Import cancelled. It can be resumed from the last checkpoint.");
+            return;
+        }
+
+        QString readerError;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_readerDone || !_queue.empty())
+                return;
+
+            readerError = _readerError;
+        }
+
+        if (readerError.isEmpty())
+            finish(true, QString("Imported %1 documents.").arg(_inserted));
+        else
+            finish(false, readerError);
+    }
+
+    void DocumentImporter::handle(InsertDocumentsResponse *event)
+    {
+        if (_sent.empty() || _sent.front().id != event->batchId())
+            return;
+
+        SentBatch const batch = std::move(_sent.front());
+        _sent.pop_front();
+
+        if (event->isError()) {
+            // Whole batch failed, none of its documents is known to be inserted
+            _failed += batch.endOffsets.size();
+            std::string const error = event->error().errorMessage();
+            LOG_MSG("Import into " + _ns.toString() + ": " + error, mongo::logger::LogSeverity::Error());
+
+            // Unordered import goes on, documents of failed batch are reported as failed
+            if (_options.ordered)
+                _insertError = QtUtils::toQString(error);
+            else
+                _checkpointOffset = batch.endOffsets.back();
+        }
+        else {
+            InsertDocumentsResult const& result = event->result();
+            _inserted += result.inserted;
+            _failed += result.errors.size();
+
+            if (!result.writeConcernError.empty())
+                LOG_MSG("Import into " + _ns.toString() + ": " + result.writeConcernError,
+                        mongo::logger::LogSeverity::Warning());
+
+            if (!result.errors.empty()) {
+                // Errors are listed in order of documents
+                int const index = result.errors.front().first;
+                std::string const& error = result.errors.front().second;
+                LOG_MSG(QString("Import into %1: %2 of %3 documents of batch failed, first one at offset %4: %5")
+                        .arg(QtUtils::toQString(_ns.toString())).arg(result.errors.size())
+                        .arg(batch.endOffsets.size()).arg(index > 0 ? batch.endOffsets[index - 1] : _checkpointOffset)
+                        .arg(QtUtils::toQString(error)), mongo::logger::LogSeverity::Error());
+
+                // Ordered insert stopped at failed document, documents before it are inserted
+                if (_options.ordered) {
+                    if (index > 0)
+                        _checkpointOffset = batch.endOffsets[index - 1];
+                    _insertError = QtUtils::toQString(error);
+                }
+                else {
+                    _checkpointOffset = batch.endOffsets.back();
+                }
+            }
+            else {
+                _checkpointOffset = batch.endOffsets.back();
+            }
+        }
+
+        if (_sinceCheckpoint.elapsed() >= CheckpointIntervalMs) {
+            saveCheckpoint();
+            _sinceCheckpoint.restart();
+        }
+
+        emit progress(_checkpointOffset, _fileSize, _inserted, _failed + _parseFailed);
+        sendBatches();
+    }
+
+    void DocumentImporter::finish(bool success, const QString &message)
+    {
+        _running = false;
+        stopReader();
+
+        if (success)
+            removeCheckpoint(_filePath);
+        else
+            saveCheckpoint();
+
+        double const seconds = _elapsed.elapsed() / 1000.0;
+        long long const insertedNow = _inserted - _options.resumeInserted;
+        LOG_MSG(QString("Import of %1 into %2: %3 documents inserted in %4 s (%5 docs/s), %6 failed. %7")
+                .arg(_filePath).arg(QtUtils::toQString(_ns.toString())).arg(insertedNow)
+                .arg(seconds, 0, 'f', 1).arg(seconds > 0 ? insertedNow / seconds : 0, 0, 'f', 0)
+                .arg(_failed + _parseFailed).arg(message),
+                success ? mongo::logger::LogSeverity::Info() : mongo::logger::LogSeverity::Warning());
+
+        emit progress(success ? _fileSize : _checkpointOffset, _fileSize, _inserted, _failed + _parseFailed);
+        emit finished(success, message);
+    }
+
+    void DocumentImporter::stopReader()
+    {
+        {
+            // Under lock, so that reader waiting in pushBatch() can not miss the notification
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cancelled = true;
+        }
+        _queueNotFull.notify_all();
+        if (_reader.joinable())
+            _reader.join();
+    }
+
+    void DocumentImporter::setReaderError(const QString &error)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _readerError = error;
+            _readerDone = true;
+        }
+        QMetaObject::invokeMethod(this, "sendBatches", Qt::QueuedConnection);
+    }
+
+    void DocumentImporter::pushBatch(Batch &batch)
+    {
+        batch.id = _nextBatchId++;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _queueNotFull.wait(lock, [this]() { return _queue.size() < MaxQueuedBatches || _cancelled; });
+            if (_cancelled)
+                return;
+
+            _queue.push_back(std::move(batch));
+        }
+        batch = Batch();
+        QMetaObject::invokeMethod(this, "sendBatches", Qt::QueuedConnection);
+    }
+
+    bool DocumentImporter::parseSlices(const char *window, qint64 windowOffset,
+                                       const std::vector<mongo::StringData> &slices)
+    {
+        unsigned const threads = std::max(1u, std::thread::hardware_concurrency());
+
+        // Parse group by group, so that parsed documents of a whole window do not pile up in memory
+        size_t const groupSize = threads * static_cast<size_t>(std::max(1, _options.batchSize));
+        Batch batch;
+        int batchBytes = 0;
+
+        for (size_t groupStart = 0; groupStart < slices.size(); groupStart += groupSize) {
+            if (_cancelled)
+                return false;
+
+            size_t const groupEnd = std::min(slices.size(), groupStart + groupSize);
+            std::vector<mongo::BSONObj> documents(groupEnd - groupStart);
+            std::vector<QString> errors(groupEnd - groupStart);
+
+            // Every thread parses a contiguous range of the group
+            size_t const perThread = (groupEnd - groupStart + threads - 1) / threads;
+            std::vector<std::future<void>> tasks;
+            for (size_t begin = groupStart; begin < groupEnd; begin += perThread) {
+                size_t const end = std::min(groupEnd, begin + perThread);
+                tasks.push_back(std::async(std::launch::async, [&, begin, end]() {
+                    for (size_t i = begin; i < end; ++i) {
+                        mongo::StringData const slice = trimSeparators(slices[i]);
+                        try {
+                            documents[i - groupStart] = mongo::Robomongo::fromjson(slice.rawData(), slice.size());
+                        }
+                        catch (const mongo::Robomongo::ParseMsgAssertionException &ex) {
+                            errors[i - groupStart] = QString("Unable to parse JSON at offset %1: %2")
+                                .arg(windowOffset + (slice.rawData() - window) + ex.offset())
+                                .arg(QtUtils::toQString(ex.reason()));
+                            if (_options.ordered)
+                                return;     // following documents will not be inserted
+                        }
+                    }
+                }));
+            }
+            for (auto &task : tasks)
+                task.get();
+
+            for (size_t i = groupStart; i < groupEnd; ++i) {
+                QString const& error = errors[i - groupStart];
+                if (!error.isEmpty()) {
+                    if (_options.ordered) {
+                        if (!batch.documents.empty())
+                            pushBatch(batch);
+                        setReaderError(error);
+                        return false;
+                    }
+                    LOG_MSG(error, mongo::logger::LogSeverity::Warning());
+                    ++_parseFailed;
+                    continue;
+                }
+
+                mongo::BSONObj const& doc = documents[i - groupStart];
+                batch.documents.push_back(doc);
+                batch.endOffsets.push_back(windowOffset + (slices[i].rawData() + slices[i].size() - window));
+                batchBytes += doc.objsize();
+
+                if (static_cast<int>(batch.documents.size()) >= _options.batchSize ||
+                    batchBytes >= _options.maxBatchBytes) {
+                    pushBatch(batch);
+                    batchBytes = 0;
+                }
+            }
+        }
+
+        if (!batch.documents.empty())
+            pushBatch(batch);
+
+        return !_cancelled;
+    }
+
+    void DocumentImporter::readFile()
+    {
+        QFile file(_filePath);
+        if (!file.open(QIODevice::ReadOnly)) {
+            setReaderError("Cannot open file: " + file.errorString());
+            return;
+        }
+
+        qint64 offset = _options.resumeOffset;
+
+        // Skip UTF-8 BOM and detect JSON array, whose elements are the documents
+        bool arrayInput = false;
+        QByteArray const head = file.read(4096);
+        int pos = head.startsWith("\xEF\xBB\xBF") ? 3 : 0;
+        while (pos < head.size() && isSpace(head[pos]))
+            ++pos;
+        if (pos < head.size() && head[pos] == '[') {
+            arrayInput = true;
+            ++pos;
+        }
+        if (offset == 0)
+            offset = pos;
+
+        bool arrayClosed = false;
+        qint64 windowSize = InitialWindowSize;
+        while (offset < _fileSize && !_cancelled) {
+            qint64 const length = std::min(windowSize, _fileSize - offset);
+            bool const lastWindow = offset + length == _fileSize;
+            uchar *data = file.map(offset, length);
+            if (!data) {
+                setReaderError(QString("Cannot map file at offset %1: %2").arg(offset).arg(file.errorString()));
+                return;
+            }
+
+            const char *const window = reinterpret_cast<const char *>(data);
+            const char *const windowEnd = window + length;
+            size_t complete = 0;
+            bool parsed = true;
+            if (!arrayClosed) {
+                std::vector<mongo::StringData> const slices =
+                    mongo::Robomongo::splitJsonDocuments(mongo::StringData(window, length), &complete);
+                parsed = parseSlices(window, offset, slices);
+            }
+
+            // Look at what follows the last complete document of window
+            const char *rest = window + complete;
+            while (rest < windowEnd && (arrayClosed ? isSpace(*rest) : isSeparator(*rest)))
+                ++rest;
+
+            QString error;
+            if (rest < windowEnd && !arrayClosed && arrayInput && *rest == ']') {
+                arrayClosed = true;
+                ++rest;
+                while (rest < windowEnd && isSpace(*rest))
+                    ++rest;
+            }
+
+            if (rest < windowEnd) {
+                if (arrayClosed)
+                    error = QString("Unexpected data after the end of array at offset %1").arg(offset + (rest - window));
+                else if (*rest == '}' || *rest == ']')
+                    error = QString("Unexpected '%1' at offset %2").arg(*rest).arg(offset + (rest - window));
+                else if (lastWindow)
+                    error = QString("Incomplete document at offset %1").arg(offset + (rest - window));
+                else if (complete == 0 && windowSize >= MaxWindowSize)
+                    error = QString("Document at offset %1 is larger than %2 MB")
+                        .arg(offset + (rest - window)).arg(MaxWindowSize / (1024 * 1024));
+            }
+
+            qint64 const consumed = (arrayClosed || rest == windowEnd) ? length : complete;
+            file.unmap(data);
+
+            if (!parsed)
+                return;     // error is already reported (or cancelled)
+
+            if (!error.isEmpty()) {
+                setReaderError(error);
+                return;
+            }
+
+            // Single document does not fit into window
+            if (consumed == 0) {
+                windowSize *= 2;
+                continue;
+            }
+
+            offset += consumed;
+            windowSize = InitialWindowSize;
+        }
+
+        if (arrayInput && !arrayClosed && !_cancelled) {
+            setReaderError("Unexpected end of file, expecting ']'");
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _readerDone = true;
+        }
+        QMetaObject::invokeMethod(this, "sendBatches", Qt::QueuedConnection);
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QElapsedTimer>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <mongo/base/string_data.h>
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/domain/MongoNamespace.h"
+
+namespace Robomongo
+{
+    class ConnectionSettings;
+    class MonitorWorker;
+    class InsertDocumentsResponse;
+
+    struct ImportOptions
+    {
+        ImportOptions() :
+            ordered(true), batchSize(1000), maxBatchBytes(8 * 1024 * 1024),
+            maxDocsPerSecond(0), resumeOffset(0), resumeInserted(0) {}
+
+        bool ordered;               // stop on first failed document (parse or insert)
+        int batchSize;              // max documents in one bulk insert
+        int maxBatchBytes;          // max BSON bytes in one bulk insert
+        int maxDocsPerSecond;       // throttling, 0 - unlimited
+        qint64 resumeOffset;        // file offset to continue from (see DocumentImporter::loadCheckpoint)
+        long long resumeInserted;   // documents inserted before resumeOffset
+    };
+
+    /**
+     * @brief Streams JSON array, NDJSON or concatenated JSON documents from file into collection.
+     *
+     *        File is memory-mapped window by window and split at document boundaries
+     *        (splitJsonDocuments). Documents are parsed in parallel and grouped into batches,
+     *        which are sent as bulk inserts to importer's own MonitorWorker, so that neither
+     *        queries nor polling of the server wait for import. Reader thread blocks when there
+     *        are too many parsed batches waiting, so memory use does not depend on file size.
+     *        After every acknowledged batch a checkpoint (offset of the first not inserted
+     *        document) is saved next to the file, so interrupted import can be resumed.
+     */
+    class DocumentImporter : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        /**
+         * @param connection: settings of server to import into, importer does not take ownership.
+         */
+        DocumentImporter(const ConnectionSettings *connection, const QString &filePath, const MongoNamespace &ns,
+                         const ImportOptions &options, QObject *parent = nullptr);
+        ~DocumentImporter();
+
+        void start();
+
+        /**
+         * @brief Stops reading, waits for batches already sent and saves checkpoint.
+         *        finished() is emitted afterwards.
+         */
+        void cancel();
+
+        bool isRunning() const { return _running; }
+
+        /**
+         * @brief Loads checkpoint of previous import of the same (unchanged) file into 'ns'.
+         * @return false if there is no checkpoint.
+         */
+        static bool loadCheckpoint(const QString &filePath, const MongoNamespace &ns,
+                                   qint64 *offset, long long *inserted);
+        static void removeCheckpoint(const QString &filePath);
+
+    Q_SIGNALS:
+        void progress(qint64 bytesDone, qint64 bytesTotal, long long inserted, long long failed);
+        void finished(bool success, const QString &message);
+
+    public Q_SLOTS:
+        void handle(InsertDocumentsResponse *event);
+
+    private Q_SLOTS:
+        void sendBatches();
+
+    private:
+        struct Batch
+        {
+            long long id;
+            std::vector<mongo::BSONObj> documents;
+            std::vector<qint64> endOffsets;     // file offset right after every document of batch
+        };
+
+        struct SentBatch
+        {
+            long long id;
+            std::vector<qint64> endOffsets;
+        };
+
+        // Reader thread
+        void readFile();
+        bool parseSlices(const char *window, qint64 windowOffset, const std::vector<mongo::StringData> &slices);
+        void pushBatch(Batch &batch);
+        void setReaderError(const QString &error);
+        void stopReader();
+
+        void saveCheckpoint();
+        void finish(bool success, const QString &message);
+
+        MonitorWorker *const _worker;
+        const QString _filePath;
+        const MongoNamespace _ns;
+        const ImportOptions _options;
+        qint64 _fileSize;
+
+        std::thread _reader;
+        std::mutex _mutex;
+        std::condition_variable _queueNotFull;
+        std::deque<Batch> _queue;                   // parsed batches, guarded by _mutex
+        QString _readerError;                       // guarded by _mutex
+        bool _readerDone;                           // guarded by _mutex
+        std::atomic<bool> _cancelled;
+        long long _nextBatchId;                     // used by reader thread only
+        std::atomic<long long> _parseFailed;
+
+        // GUI thread
+        std::deque<SentBatch> _sent;
+        bool _running;
+        bool _throttled;
+        qint64 _checkpointOffset;
+        long long _inserted;
+        long long _failed;
+        long long _sentDocuments;
+        QString _insertError;
+        QElapsedTimer _elapsed;
+        QElapsedTimer _sinceCheckpoint;
+    };
+}
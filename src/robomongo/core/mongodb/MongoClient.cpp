@@ -1,5 +1,8 @@
 #include "robomongo/core/mongodb/MongoClient.h"
 
+#include <mutex>
+#include <set>
+
 #include "mongo/db/namespace_string.h"
 
 #include "robomongo/core/domain/MongoDocument.h"
@@ -8,6 +11,10 @@
 
 namespace
 {
+    // Sections of serverStatus reported by servers so far, see MongoClient::getStorageEngineType()
+    std::mutex serverStatusSectionsMutex;
+    std::set<std::string> serverStatusSections;
+
     Robomongo::EnsureIndexInfo makeEnsureIndexInfoFromBsonObj(
         const Robomongo::MongoCollectionInfo &collection,
         const mongo::BSONObj &obj)
@@ -63,8 +70,30 @@ namespace Robomongo
 
     std::string MongoClient::getStorageEngineType() const
     {
+        // Only 'storageEngine' section is needed. Server can not be asked for one section, but it
+        // can be asked to skip sections, so every section seen in earlier responses is skipped.
+        // Sections differ between server versions, so they are learned instead of listed here.
+        mongo::BSONObjBuilder command;
+        command.append("serverStatus", 1);
+        {
+            std::lock_guard<std::mutex> lock(serverStatusSectionsMutex);
+            for (auto const& section : serverStatusSections)
+                command.append(section, 0);
+        }
+
         mongo::BSONObj resultObj;
-        _dbclient->runCommand("db", BSON("serverStatus" << "1"), resultObj);
+        _dbclient->runCommand("admin", command.obj(), resultObj);
+
+        {
+            std::lock_guard<std::mutex> lock(serverStatusSectionsMutex);
+            mongo::BSONObjIterator it(resultObj);
+            while (it.more()) {
+                mongo::BSONElement const element = it.next();
+                std::string const name = element.fieldName();
+                if (element.type() == mongo::Object && name != "storageEngine")
+                    serverStatusSections.insert(name);
+            }
+        }
         return resultObj.getObjectField("storageEngine").getStringField("name");
     }
 
@@ -528,6 +557,34 @@ namespace Robomongo
         checkLastErrorAndThrow(ns.databaseName());
     }
 
+    InsertDocumentsResult MongoClient::insertDocuments(const std::vector<mongo::BSONObj> &documents,
+                                                       const MongoNamespace &ns, bool ordered)
+    {
+        mongo::BSONObjBuilder command;
+        command.append("insert", ns.collectionName());
+        mongo::BSONArrayBuilder array(command.subarrayStart("documents"));
+        for (auto const& doc : documents)
+            array.append(doc);
+        array.done();
+        command.append("ordered", ordered);
+
+        // Failed documents do not fail the command, they are listed in writeErrors
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(ns.databaseName(), command.obj(), result))
+            throw mongo::DBException(result.getStringField("errmsg"), 0);
+
+        InsertDocumentsResult inserted;
+        inserted.inserted = result["n"].numberInt();
+        mongo::BSONObjIterator it(result.getObjectField("writeErrors"));
+        while (it.more()) {
+            mongo::BSONObj const error = it.next().Obj();
+            inserted.errors.push_back({ error["index"].numberInt(), error.getStringField("errmsg") });
+        }
+
+        inserted.writeConcernError = result.getObjectField("writeConcernError").getStringField("errmsg");
+        return inserted;
+    }
+
     void MongoClient::saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns)
     {
         mongo::BSONElement id = obj.getField("_id");
@@ -540,6 +597,19 @@ namespace Robomongo
         checkLastErrorAndThrow(ns.databaseName());
     }
 
+    bool MongoClient::updateDocument(const mongo::BSONObj &query, const mongo::BSONObj &update, const MongoNamespace &ns)
+    {
+        _dbclient->update(ns.toString(), mongo::Query(query), update, false, false);
+
+        // Number of matched documents is needed, so error is checked here
+        mongo::BSONObj const result = _dbclient->getLastErrorDetailed(ns.databaseName());
+        std::string const lastError = mongo::DBClientWithCommands::getLastErrorString(result);
+        if (!lastError.empty())
+            throw mongo::DBException(lastError, mongo::ErrorCodes::InternalError);
+
+        return result["n"].numberInt() > 0;
+    }
+
     void MongoClient::removeDocuments(const MongoNamespace &ns, mongo::Query query, bool justOne /*= true*/)
     {
         _dbclient->remove(ns.toString(), query, justOne);
@@ -576,33 +646,203 @@ namespace Robomongo
 
     MongoCollectionInfo MongoClient::runCollStatsCommand(const std::string &ns)
     {
-        MongoCollectionInfo info(ns);
-        return info;
-
-/*      // Commented for now, to speedup load of collection names
         MongoNamespace mongons(ns);
 
-        mongo::BSONObjBuilder command; // { collStats: "db.collection", scale : 1 }
+        mongo::BSONObjBuilder command; // { collStats: "collection", scale : 1 }
         command.append("collStats", mongons.collectionName());
         command.append("scale", 1);
 
+        // collStats fails for views, such collections are shown without statistics
         mongo::BSONObj result;
-        _dbclient->runCommand(mongons.databaseName(), command.obj(), result);
-        std::string isCV = result.toString();
-        MongoCollectionInfo newInfo(result);
-        return newInfo;
-        */
+        if (!_dbclient->runCommand(mongons.databaseName(), command.obj(), result))
+            return MongoCollectionInfo(ns);
+
+        return MongoCollectionInfo(ns, result);
     }
 
-    std::vector<MongoCollectionInfo> MongoClient::runCollStatsCommand(const std::vector<std::string> &namespaces)
+    std::map<std::string, long long> MongoClient::getIndexSizes(const MongoCollectionInfo &collection)
     {
-        std::vector<MongoCollectionInfo> infos;
-        for (auto const& ns : namespaces) {
-            MongoCollectionInfo info = runCollStatsCommand(ns);
-            if (info.ns().isValid()) 
-                infos.push_back(info);
+        MongoNamespace const ns = collection.ns();
+
+        mongo::BSONObjBuilder command; // { collStats: "collection", scale : 1 }
+        command.append("collStats", ns.collectionName());
+        command.append("scale", 1);
+
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(ns.databaseName(), command.obj(), result))
+            throw mongo::DBException("Failed to load index sizes: " + std::string(result.getStringField("errmsg")),
+                                     mongo::ErrorCodes::InternalError);
+
+        std::map<std::string, long long> sizes;
+        mongo::BSONObjIterator it(result.getObjectField("indexSizes"));
+        while (it.more()) {
+            mongo::BSONElement const elem = it.next();
+            sizes[elem.fieldName()] = elem.safeNumberLong();
         }
-        return infos;
+        return sizes;
+    }
+
+    std::vector<IndexStatsInfo> MongoClient::getIndexUsage(const MongoCollectionInfo &collection)
+    {
+        MongoNamespace const ns = collection.ns();
+
+        // { aggregate: "collection", pipeline: [ { $indexStats: {} } ], cursor: {} }
+        // Result has one document per index, so it always fits into the first batch.
+        // Usage is loaded from every replica set member, secondaries included.
+        mongo::BSONObjBuilder command;
+        command.append("aggregate", ns.collectionName());
+        command.append("pipeline", BSON_ARRAY(BSON("$indexStats" << mongo::BSONObj())));
+        command.append("cursor", mongo::BSONObj());
+
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(ns.databaseName(), command.obj(), result, mongo::QueryOption_SlaveOk))
+            throw mongo::DBException("Failed to load index usage: " + std::string(result.getStringField("errmsg")),
+                                     mongo::ErrorCodes::InternalError);
+
+        std::vector<IndexStatsInfo> usage;
+        mongo::BSONObjIterator it(result.getObjectField("cursor").getObjectField("firstBatch"));
+        while (it.more()) {
+            mongo::BSONObj const stats = it.next().Obj();
+            mongo::BSONObj const accesses = stats.getObjectField("accesses");
+
+            mongo::BSONElement const since = accesses["since"];
+
+            IndexStatsInfo info(stats.getStringField("name"));
+            info.members.push_back(IndexStatsInfo::MemberUsage(stats.getStringField("host"),
+                                   accesses["ops"].safeNumberLong(),
+                                   since.type() == mongo::Date ? since.Date().toMillisSinceEpoch() : 0));
+            usage.push_back(info);
+        }
+        return usage;
+    }
+
+    StorageStatsInfo MongoClient::getStorageStats(const std::string &dbName, const std::string &collectionName)
+    {
+        StorageStatsInfo info;
+        info.dbName = dbName;
+        info.collectionName = collectionName;
+
+        mongo::BSONObj const command = collectionName.empty() ? BSON("dbStats" << 1 << "scale" << 1)
+                                                              : BSON("collStats" << collectionName << "scale" << 1);
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(dbName, command, result))
+            return info;
+
+        // Field names of dbStats and collStats differ, numbers may be Int32, Int64 or Double
+        info.hasStats = true;
+        if (info.isDatabase()) {
+            info.count = result["objects"].safeNumberLong();
+            info.dataSize = result["dataSize"].numberDouble();
+            info.indexSize = result["indexSize"].numberDouble();
+            info.indexes = result["indexes"].numberInt();
+            info.collections = result["collections"].numberInt();
+        }
+        else {
+            info.count = result["count"].safeNumberLong();
+            info.dataSize = result["size"].numberDouble();
+            info.indexSize = result["totalIndexSize"].numberDouble();
+            info.indexes = result["nindexes"].numberInt();
+        }
+        info.storageSize = result["storageSize"].numberDouble();
+        return info;
+    }
+
+    mongo::BSONObj MongoClient::explainQuery(const MongoQueryInfo &info)
+    {
+        MongoNamespace const ns(info._info._ns);
+
+        // Special query is { query: <filter>, orderby: <sort>, $hint: <index>, ... }
+        mongo::BSONObjBuilder find;
+        find.append("find", ns.collectionName());
+        find.append("filter", info._special ? info._query.getObjectField("query") : info._query);
+        if (info._fields.nFields())
+            find.append("projection", info._fields);
+        if (info._special && info._query.hasField("orderby"))
+            find.appendAs(info._query["orderby"], "sort");
+        if (info._special && info._query.hasField("$hint"))
+            find.appendAs(info._query["$hint"], "hint");
+        if (info._skip > 0)
+            find.append("skip", info._skip);
+
+        // Unlimited query is explained as its first batch, which is what was actually loaded
+        int const limit = info._limit > 0 ? info._limit : info._batchSize;
+        if (limit > 0)
+            find.append("limit", limit);
+
+        mongo::BSONObj result;
+        if (_dbclient->runCommand(ns.databaseName(), BSON("explain" << find.obj() << "verbosity" << "executionStats"),
+                                  result, mongo::QueryOption_SlaveOk))
+            return result;
+
+        // MongoDB before 3.2 has no find command, legacy $explain includes execution statistics.
+        // Limit is negative like in shell's cursor.explain(), so that explain describes a single batch.
+        std::string const error = result.getStringField("errmsg");
+        mongo::Query query(info._query);
+        query.explain();
+        try {
+            std::unique_ptr<mongo::DBClientCursor> cursor = _dbclient->query(ns.toString(), query, -limit, info._skip,
+                info._fields.nFields() ? &info._fields : 0, mongo::QueryOption_SlaveOk);
+            if (!cursor || !cursor->more())
+                throw std::runtime_error("no explain result");
+            return cursor->next().getOwned();
+        }
+        catch (const std::exception &) {
+            throw mongo::DBException("Failed to explain query: " + error, mongo::ErrorCodes::InternalError);
+        }
+    }
+
+    std::vector<CurrentOpInfo> MongoClient::getCurrentOps()
+    {
+        // MongoDB before 3.2 has no currentOp command, pseudo collection is used instead
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand("admin", BSON("currentOp" << 1), result)) {
+            if (result["code"].numberInt() != mongo::ErrorCodes::CommandNotFound)
+                throw mongo::DBException("Failed to load current operations: " + std::string(result.getStringField("errmsg")),
+                                         mongo::ErrorCodes::InternalError);
+
+            result = _dbclient->findOne("admin.$cmd.sys.inprog", mongo::Query());
+        }
+
+        std::vector<CurrentOpInfo> ops;
+        mongo::BSONObjIterator it(result.getObjectField("inprog"));
+        while (it.more()) {
+            mongo::BSONObj const entry = it.next().Obj();
+            if (!entry["opid"].ok())
+                continue;
+
+            CurrentOpInfo op;
+            op.opid = entry["opid"].type() == mongo::String ? entry["opid"].String()
+                                                            : std::to_string(entry["opid"].safeNumberLong());
+            op.op = entry.getStringField("op");
+            op.ns = entry.getStringField("ns");
+            op.planSummary = entry.getStringField("planSummary");
+            op.client = entry.hasField("client") ? entry.getStringField("client") : entry.getStringField("client_s");
+            op.desc = entry.getStringField("desc");
+            op.microsecs = entry.hasField("microsecs_running") ? entry["microsecs_running"].safeNumberLong()
+                                                               : entry["secs_running"].safeNumberLong() * 1000000;
+            op.waitingForLock = entry["waitingForLock"].trueValue();
+            op.details = entry.getOwned();
+            ops.push_back(op);
+        }
+        return ops;
+    }
+
+    void MongoClient::killOp(const CurrentOpInfo &op)
+    {
+        mongo::BSONObjBuilder command;
+        command.append("killOp", 1);
+        command.appendAs(op.details["opid"], "op");
+
+        mongo::BSONObj result;
+        if (_dbclient->runCommand("admin", command.obj(), result))
+            return;
+
+        if (result["code"].numberInt() != mongo::ErrorCodes::CommandNotFound)
+            throw mongo::DBException("Failed to kill operation " + op.opid + ": " + result.getStringField("errmsg"),
+                                     mongo::ErrorCodes::InternalError);
+
+        // MongoDB before 3.2
+        _dbclient->findOne("admin.$cmd.sys.killop", BSON("op" << op.details["opid"]));
     }
 
     void MongoClient::done()
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>
 #include <mongo/client/dbclientinterface.h>
 #include <mongo/bson/bsonobj.h>
 
@@ -19,6 +20,11 @@ namespace Robomongo
         std::vector<std::string> getCollectionNamesWithDbname(const std::string &dbname) const;
         std::vector<std::string> getDatabaseNames() const;
         float getVersion() const;
+
+        /**
+         * @brief Name of storage engine (empty for MongoDB 2.6 and older).
+         *        Runs serverStatus with sections seen in earlier responses excluded.
+         */
         std::string getStorageEngineType() const;
 
         std::vector<MongoUser> getUsers(const std::string &dbName);
@@ -47,12 +53,57 @@ namespace Robomongo
         void copyCollectionToDiffServer(mongo::DBClientBase *const, const MongoNamespace &from, const MongoNamespace &to);
 
         void insertDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
+        /**
+         * @brief Bulk insert with insert command. When not 'ordered', server continues after failed documents.
+         * @return Number of inserted documents and errors of failed ones
+         * @throws DBException, if the whole command failed
+         */
+        InsertDocumentsResult insertDocuments(const std::vector<mongo::BSONObj> &documents,
+                                              const MongoNamespace &ns, bool ordered);
         void saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
+        /**
+         * @brief Update of one document
+         * @return false if no document matches 'query'
+         */
+        bool updateDocument(const mongo::BSONObj &query, const mongo::BSONObj &update, const MongoNamespace &ns);
         void removeDocuments(const MongoNamespace &ns, mongo::Query query, bool justOne = true);
         std::vector<MongoDocumentPtr> query(const MongoQueryInfo &info);
 
         MongoCollectionInfo runCollStatsCommand(const std::string &ns);
-        std::vector<MongoCollectionInfo> runCollStatsCommand(const std::vector<std::string> &namespaces);
+
+        /**
+         * @brief Sizes of indexes of collection (index name -> bytes), from collStats.
+         */
+        std::map<std::string, long long> getIndexSizes(const MongoCollectionInfo &collection);
+
+        /**
+         * @brief Usage counters of indexes on the server of this connection, from $indexStats
+         *        (MongoDB 3.2+). Every returned item has one entry in 'members'.
+         */
+        std::vector<IndexStatsInfo> getIndexUsage(const MongoCollectionInfo &collection);
+
+        /**
+         * @brief Storage statistics of collection (collStats) or, when 'collectionName'
+         *        is empty, of whole database (dbStats).
+         */
+        StorageStatsInfo getStorageStats(const std::string &dbName, const std::string &collectionName = std::string());
+
+        /**
+         * @brief explain("executionStats") of query, with the same filter, projection, sort,
+         *        hint, skip and limit. May be run on secondary.
+         */
+        mongo::BSONObj explainQuery(const MongoQueryInfo &info);
+
+        /**
+         * @brief Operations in progress on the server of this connection.
+         *        Idle connections and system operations are not included.
+         */
+        std::vector<CurrentOpInfo> getCurrentOps();
+
+        /**
+         * @brief Kill operation returned by getCurrentOps() of this server.
+         */
+        void killOp(const CurrentOpInfo &op);
 
         void done();
 
@@ -1,19 +1,22 @@
 #include "robomongo/core/mongodb/MongoWorker.h"
 
 #include <algorithm>
+#include <atomic>
+#include <future>
 
 #include <QThread>
+#include <QDateTime>
+#include <QElapsedTimer>
 
 #include "mongo/client/global_conn_pool.h"
 #include "mongo/client/replica_set_monitor.h"
-#include <mongo/util/net/ssl_manager.h>
-#include <mongo/util/net/ssl_options.h>
 
 #include "robomongo/core/events/MongoEvents.h"
 #include "robomongo/core/engine/ScriptEngine.h"
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/mongodb/MongoClient.h"
+#include "robomongo/core/mongodb/SslParamsGuard.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/ReplicaSetSettings.h"
 #include "robomongo/core/domain/MongoShellResult.h"
@@ -24,6 +27,7 @@
 #include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/core/utils/Logger.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/core/utils/ScriptUtils.h"
 #include "robomongo/utils/string_operations.h"
 
 namespace Robomongo
@@ -43,7 +47,11 @@ namespace Robomongo
         _isQuiting(0),
         _dbclient(nullptr),
         _dbclientRepSet(nullptr),
-        _connSettings(connection)
+        _connSettings(connection),
+        _metrics(WorkerMetricsRegistry::instance().cluster(connection->connectionName() + " (" + 
+                                                           connection->getFullAddress() + ")")),
+        _replyPayloadBytes(0),
+        _replyError(false)
     {
         _thread = new QThread();
         moveToThread(_thread);
@@ -76,10 +84,28 @@ namespace Robomongo
                 pingDatabase(_dbclientRepSet.get());
             }
 
+            for (auto const& member : _memberConnections) {
+                pingDatabase(member.second.get());
+            }
+
+            for (auto const& conn : _metadataConnections) {
+                pingDatabase(conn.get());
+            }
+
             if (_scriptEngine) {
                 _scriptEngine->ping();
             }
 
+            if (_readScriptEngine) {
+                _readScriptEngine->ping();
+            }
+
+            // Refresh members and their latencies only for tabs which actually route reads to members
+            if (_dbclientRepSet && !_memberConnections.empty()) {
+                _readSetInfo.reset(new ReplicaSet(getReplicaSetInfo(false)));
+                measureMembersLatency(*_readSetInfo);
+            }
+
         } catch(std::exception &ex) {
             LOG_MSG("Failed to ping the server. MongoWorker::keepAlive() failed. " + std::string(ex.what()), 
                     mongo::logger::LogSeverity::Error());
@@ -89,8 +115,21 @@ namespace Robomongo
     void MongoWorker::init()
     {        
         try {
+            // Measure connection time of the new shell (incl. TLS handshake for SSL connections)
+            QElapsedTimer timer;
+            timer.start();
+
             _scriptEngine.reset(new ScriptEngine(_connSettings, _shellTimeoutSec));
-            _scriptEngine->init(_isLoadMongoRcJs);
+            {
+                auto const ssl = sslScope();
+                _scriptEngine->init(_isLoadMongoRcJs);
+            }
+
+            if (_connSettings->sslSettings()->sslEnabled()) {
+                LOG_MSG(QString("Shell SSL connection established in %1 ms.").arg(timer.elapsed()),
+                        mongo::logger::LogSeverity::Info());
+            }
+
             _scriptEngine->use(_connSettings->defaultDatabase());
             _scriptEngine->setBatchSize(_batchSize);
             _timerId = startTimer(pingTimeMs);
@@ -107,6 +146,8 @@ namespace Robomongo
                 return;
 
             _scriptEngine->interrupt();
+            if (_readScriptEngine)
+                _readScriptEngine->interrupt();
         } catch(const mongo::DBException &ex) {
             LOG_MSG(ex.what(), mongo::logger::LogSeverity::Error());
         }
@@ -137,6 +178,18 @@ namespace Robomongo
         _scriptEngine->changeTimeout(newTimeout);
     }
 
+    void MongoWorker::handled(Event *request, qint64 startNs, qint64 endNs)
+    {
+        std::string requestType = request->typeString();    // i.e. "ExecuteQueryRequest*"
+        if (!requestType.empty() && requestType.back() == '*')
+            requestType.pop_back();
+
+        _metrics->record(requestType, request->createdAtNs(), startNs, endNs,
+                         request->payloadSize() + _replyPayloadBytes, _replyError);
+        _replyPayloadBytes = 0;
+        _replyError = false;
+    }
+
     /**
      * @brief Initiate connection to MongoDB
      */
@@ -147,8 +200,15 @@ namespace Robomongo
         std::unique_ptr<ReplicaSet> repSetInfo(new ReplicaSet);
         auto errorCode = EventError::ErrorCode::Unknown;
 
+        // Timing breakdown of connect phases, logged on success
+        QElapsedTimer totalTimer, phaseTimer;
+        totalTimer.start();
+        phaseTimer.start();
+        qint64 connectMs = 0, authMs = 0, dbNamesMs = 0, initMs = 0, serverInfoWaitMs = 0;
+
         try {
             mongo::DBClientBase *conn = getConnection(true);
+            connectMs = phaseTimer.restart();
             
             // --- Connection failed for single server & replica set (no member of the set is reachable)
             if (!conn) 
@@ -173,8 +233,6 @@ namespace Robomongo
                     else    // single server
                         errorReason = "Network is unreachable.";                    
                 }
-                resetGlobalSSLparams();
-
                 reply(event->sender(), new EstablishConnectionResponse(this, EventError(errorReason, errorCode),             
                       event->connectionType, event->uuid, *repSetInfo.release(), 
                       EstablishConnectionResponse::MongoConnection));
@@ -211,29 +269,33 @@ namespace Robomongo
                 }
             }
 
-            if (_connSettings->hasEnabledPrimaryCredential()) {
-                CredentialSettings *credentials = _connSettings->primaryCredential();
-
-                // Building BSON object:
-                mongo::BSONObj authParams(mongo::BSONObjBuilder()
-                    .append("user", credentials->userName())
-                    .append("db", credentials->databaseName())
-                    .append("pwd", credentials->userPassword())
-                    .append("mechanism", credentials->mechanism())
-                    .obj());
+            // buildInfo and serverStatus do not depend on auth, listDatabases or shell init results, 
+            // so fetch them concurrently over a side connection while this thread does the rest.
+            // When connection fails below, this handler does not wait for the side connection to time out:
+            // the task is owned by worker, and it is waited for by the next connect or on destruction.
+            auto const host = _connSettings->isReplicaSet() ? repSetInfo->primary : _connSettings->hostAndPort();
+            std::shared_ptr<ConnectionSettings const> const settings(_connSettings->clone());
+            int const timeoutSec = _mongoTimeoutSec;
+            _serverInfo = std::async(std::launch::async, [settings, host, timeoutSec]() {
+                return fetchServerInfo(settings.get(), host, timeoutSec);
+            });
 
-                conn->auth(authParams);
+            if (_connSettings->hasEnabledPrimaryCredential()) {
+                authenticate(conn);
 
                 // If authentication succeed and database name is 'admin' -
                 // then user is admin, otherwise user is not admin
-                std::string dbName = credentials->databaseName();
+                std::string dbName = _connSettings->primaryCredential()->databaseName();
                 std::transform(dbName.begin(), dbName.end(), dbName.begin(), ::tolower);
                 if (dbName.compare("admin") != 0) // dbName is NOT "admin"
                     _isAdmin = false;
             }
+            authMs = phaseTimer.restart();
 
             boost::scoped_ptr<MongoClient> client(getClient());
-            std::vector<std::string> dbNames = getDatabaseNamesSafe();
+            std::vector<std::string> dbNames = event->cachedDatabases.empty() ? getDatabaseNamesSafe()
+                                                                             : event->cachedDatabases;
+            dbNamesMs = phaseTimer.restart();
 
             // If we do not have databases, it means that we are unable to
             // execute "listdatabases" command and we have nothing to show.
@@ -242,11 +304,28 @@ namespace Robomongo
 
             if (!_connSettings->isReplicaSet())
                 init(); // Init MongoWorker for single server (for replica set connections early init is used)
+            initMs = phaseTimer.restart();
+
+            std::pair<float, std::string> versionAndEngine;
+            try {
+                versionAndEngine = _serverInfo.get();
+            }
+            catch (const std::exception &ex) {
+                // Side connection failed (i.e. connection limit reached), use the main one
+                LOG_MSG("Failed to load server info concurrently, retrying sequentially. " + std::string(ex.what()),
+                        mongo::logger::LogSeverity::Warning());
+                versionAndEngine = { client->getVersion(), client->getStorageEngineType() };
+            }
+            serverInfoWaitMs = phaseTimer.restart();
 
-            resetGlobalSSLparams();
+            auto connInfo = ConnectionInfo(_connSettings->getFullAddress(), dbNames, versionAndEngine.first, 
+                                           versionAndEngine.second, event->uuid);
 
-            auto connInfo = ConnectionInfo(_connSettings->getFullAddress(), dbNames, client->getVersion(), 
-                                           client->getStorageEngineType(), event->uuid);
+            LOG_MSG(QString("Connected to %1 in %2 ms (connect: %3 ms, auth: %4 ms, listDatabases: %5 ms, "
+                            "shell init: %6 ms, waiting for buildInfo/serverStatus: %7 ms)")
+                    .arg(QtUtils::toQString(_connSettings->getFullAddress())).arg(totalTimer.elapsed())
+                    .arg(connectMs).arg(authMs).arg(dbNamesMs).arg(initMs).arg(serverInfoWaitMs),
+                    mongo::logger::LogSeverity::Info());
 
             // todo: two ctors for rep.set and single server.
             reply(event->sender(), new EstablishConnectionResponse(this, connInfo, event->connectionType, 
@@ -254,7 +333,6 @@ namespace Robomongo
             return true;
         } 
         catch(const std::exception &ex) {
-            resetGlobalSSLparams();
             auto errorReason = _connSettings->sslSettings()->sslEnabled() ?
                                EstablishConnectionResponse::ErrorReason::MongoSslConnection : 
                                EstablishConnectionResponse::ErrorReason::MongoAuth;
@@ -268,7 +346,7 @@ namespace Robomongo
 
     void MongoWorker::handle(RefreshReplicaSetFolderRequest *event)
     {
-		configureSSL();
+        auto const ssl = sslScope();
         ReplicaSet const& replicaSetInfo = getReplicaSetInfo(true);
 
         // Primary is unreachable, but there might be reachable secondary(ies)
@@ -352,9 +430,18 @@ namespace Robomongo
             boost::scoped_ptr<MongoClient> client(getClient());
 
             auto const& namespaces = client->getCollectionNamesWithDbname(event->databaseName());
-            std::vector<MongoCollectionInfo> const& collInfos = client->runCollStatsCommand(namespaces);
             client->done();
 
+            // Statistics are not loaded here: with thousands of collections one collStats
+            // per collection delays the list too much. See LoadCollectionStatsRequest.
+            std::vector<MongoCollectionInfo> collInfos;
+            collInfos.reserve(namespaces.size());
+            for (auto const& ns : namespaces) {
+                MongoCollectionInfo info(ns);
+                if (info.ns().isValid())
+                    collInfos.push_back(info);
+            }
+
             reply(event->sender(), new LoadCollectionNamesResponse(this, event->databaseName(), collInfos));
         } catch(const mongo::DBException &ex) {
             if (_connSettings->isReplicaSet()) {
@@ -371,6 +458,42 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(LoadCollectionStatsRequest *event)
+    {
+        std::string const& dbName = event->databaseName();
+        std::vector<std::string> const& names = event->collectionNames();
+
+        try {
+            std::vector<mongo::DBClientBase *> const& connections = getMetadataConnections(names.size());
+
+            // Every connection is used by one thread, threads take next collection from shared index
+            std::vector<MongoCollectionInfo> infos(names.size());
+            std::atomic<size_t> next(0);
+            auto loadStats = [&](mongo::DBClientBase *conn) {
+                MongoClient client(conn);
+                for (size_t i = next++; i < names.size(); i = next++)
+                    infos[i] = client.runCollStatsCommand(dbName + "." + names[i]);
+            };
+
+            std::vector<std::future<void>> futures;
+            for (size_t i = 1; i < connections.size(); ++i)
+                futures.push_back(std::async(std::launch::async, loadStats, connections[i]));
+
+            loadStats(connections[0]);
+
+            for (auto &future : futures)
+                future.get();   // rethrows exception of stats thread
+
+            reply(event->sender(), new LoadCollectionStatsResponse(this, dbName, infos));
+        }
+        catch(const std::exception &ex) {
+            // Connection state is unknown after failure, reconnect on next request
+            _metadataConnections.clear();
+            reply(event->sender(), new LoadCollectionStatsResponse(this, dbName, names,
+                  EventError(std::string("Failed to load collection statistics. ") + ex.what())));
+        }
+    }
+
     void MongoWorker::handle(LoadUsersRequest *event)
     {
         try {
@@ -408,6 +531,96 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(LoadIndexStatsRequest *event)
+    {
+        MongoCollectionInfo const collection = event->collection();
+        try {
+            // Sizes are taken from primary (or single server), usage counters from every member,
+            // each command runs on its own connection
+            std::vector<mongo::DBClientBase *> const metadata = getMetadataConnections(_dbclientRepSet ? 1 : 2);
+
+            std::vector<std::pair<std::string, mongo::DBClientBase *>> servers;
+            if (_dbclientRepSet) {
+                for (auto const& member : getReplicaSetInfo(false).membersAndHealths) {
+                    if (!member.second)
+                        continue;
+                    try {
+                        servers.push_back({ member.first, getMemberConnection(member.first) });
+                    }
+                    catch (const std::exception &ex) {
+                        LOG_MSG("Failed to load index usage of member " + member.first + ". " + ex.what(),
+                                mongo::logger::LogSeverity::Warning());
+                    }
+                }
+            }
+            else {
+                servers.push_back({ _connSettings->hostAndPort().toString(), metadata.back() });
+            }
+
+            auto sizes = std::async(std::launch::async, [&]() {
+                return MongoClient(metadata.front()).getIndexSizes(collection);
+            });
+
+            std::vector<std::future<std::vector<IndexStatsInfo>>> usages;
+            for (auto const& server : servers) {
+                usages.push_back(std::async(std::launch::async, [&collection](mongo::DBClientBase *conn) {
+                    return MongoClient(conn).getIndexUsage(collection);
+                }, server.second));
+            }
+
+            std::map<std::string, IndexStatsInfo> stats;
+            for (auto const& size : sizes.get()) {
+                IndexStatsInfo &info = stats.emplace(size.first, IndexStatsInfo(size.first)).first->second;
+                info.sizeBytes = size.second;
+            }
+
+            for (size_t i = 0; i < usages.size(); ++i) {
+                try {
+                    for (auto const& usage : usages[i].get()) {
+                        IndexStatsInfo &info = stats.emplace(usage.name, IndexStatsInfo(usage.name)).first->second;
+                        info.members.insert(info.members.end(), usage.members.begin(), usage.members.end());
+                    }
+                }
+                catch (const std::exception &ex) {
+                    // $indexStats requires MongoDB 3.2, member may also go down meanwhile
+                    if (_dbclientRepSet)
+                        _memberConnections.erase(servers[i].first);
+                    LOG_MSG("Failed to load index usage of " + servers[i].first + ". " + ex.what(),
+                            mongo::logger::LogSeverity::Warning());
+                }
+            }
+
+            // $indexStats has no last access time: remember when counters were seen growing
+            long long const now = QDateTime::currentMSecsSinceEpoch();
+            std::vector<IndexStatsInfo> result;
+            for (auto &item : stats) {
+                IndexStatsInfo &info = item.second;
+                long long const ops = info.totalOps();
+                auto const key = std::make_pair(collection.ns().toString(), info.name);
+                auto const seen = _indexOpsSeen.find(key);
+                if (seen == _indexOpsSeen.end()) {
+                    _indexOpsSeen[key] = std::make_pair(ops, 0LL);
+                }
+                else {
+                    if (ops > seen->second.first)
+                        seen->second.second = now;
+                    seen->second.first = ops;   // also when counters were reset by restart
+                    info.lastUsedMs = seen->second.second;
+                }
+                result.push_back(info);
+            }
+
+            reply(event->sender(), new LoadIndexStatsResponse(this, result));
+        }
+        catch (const std::exception &ex) {
+            // Connection state is unknown after failure, reconnect on next request
+            _metadataConnections.clear();
+            std::string const error = std::string("Failed to load index statistics. ") + ex.what();
+            reply(event->sender(), new LoadIndexStatsResponse(this, EventError(error)));
+            LOG_MSG(error, mongo::logger::LogSeverity::Warning());
+        }
+    }
+
     void MongoWorker::handle(EnsureIndexRequest *event)
     {
         const EnsureIndexInfo &newInfo = event->newInfo();
@@ -519,6 +732,77 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(UpdateDocumentRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            bool const updated = client->updateDocument(event->query(), event->update(), event->ns());
+            client->done();
+
+            if (!updated) {
+                reply(event->sender(), new UpdateDocumentResponse(this, EventError(
+                      "Document was not updated: it was removed or its edited fields were changed "
+                      "since it was loaded. Reload the document and edit it again.")));
+                return;
+            }
+
+            reply(event->sender(), new UpdateDocumentResponse(this));
+        }
+        catch(const mongo::DBException &ex) {
+            if (_connSettings->isReplicaSet()) {
+                ReplicaSet const& replicaSetInfo = getReplicaSetInfo(true);
+                if (replicaSetInfo.primary.empty()) {  // primary not reachable
+                    reply(event->sender(), new UpdateDocumentResponse(this,
+                          EventError(PRIMARY_UNREACHABLE, replicaSetInfo, false)));
+                    return;
+                }
+            }
+            reply(event->sender(), new UpdateDocumentResponse(this, EventError(ex.toString())));
+        }
+    }
+
+    void MongoWorker::handle(ExportDocumentsRequest *event)
+    {
+        // Time spent by one request, so that other requests of this worker are not delayed for long
+        const int chunkTimeMs = 250;
+        long long const exportId = event->exportId();
+
+        if (event->action() == ExportDocumentsRequest::Cancel) {
+            _exports.erase(exportId);   // removes partially written file
+            return;
+        }
+
+        try {
+            auto it = _exports.find(exportId);
+            if (event->action() == ExportDocumentsRequest::Start) {
+                mongo::DBClientBase *const connection = getConnection();
+                if (!connection)
+                    throw mongo::DBException("Cannot connect to server", mongo::ErrorCodes::InternalError);
+
+                std::unique_ptr<DocumentExporter> exporter(new DocumentExporter(event->options()));
+                exporter->start(connection);
+                it = _exports.insert(std::make_pair(exportId, std::move(exporter))).first;
+            }
+            else if (it == _exports.end()) {
+                reply(event->sender(), new ExportDocumentsResponse(this, exportId, EventError("Export was cancelled")));
+                return;
+            }
+
+            DocumentExporter *const exporter = it->second.get();
+            bool const finished = exporter->exportChunk(chunkTimeMs);
+            reply(event->sender(), new ExportDocumentsResponse(this, exportId, exporter->exported(),
+                  exporter->total(), exporter->bytesWritten(), finished));
+
+            if (finished)
+                _exports.erase(it);
+        }
+        catch(const mongo::DBException &ex) {
+            _exports.erase(exportId);
+            reply(event->sender(), new ExportDocumentsResponse(this, exportId,
+                  EventError("Error when exporting documents: " + ex.toString())));
+        }
+    }
+
     void MongoWorker::handle(RemoveDocumentRequest *event)
     {
         try {
@@ -549,12 +833,43 @@ namespace Robomongo
     void MongoWorker::handle(ExecuteQueryRequest *event)
     {
         try {
-            boost::scoped_ptr<MongoClient> client(getClient());
-            std::vector<MongoDocumentPtr> docs = client->query(event->queryInfo());
+            MongoQueryInfo queryInfo = event->queryInfo();
+
+            // Next pages of result are read from the member which served its first page
+            std::string target = event->readTarget();
+            if (target.empty() || event->readPreference() == ReadPrimary || !_dbclientRepSet)
+                target = selectReadTarget(event->readPreference());
+            else if (target == _dbclientRepSet->getSuspectedPrimaryHostAndPort().toString())
+                target.clear();
+
+            boost::scoped_ptr<MongoClient> client;
+            if (target.empty()) {
+                client.reset(getClient());
+            }
+            else {
+                client.reset(new MongoClient(getMemberConnection(target)));
+                queryInfo._options |= mongo::QueryOption_SlaveOk;
+            }
+
+            QElapsedTimer timer;
+            timer.start();
+            std::vector<MongoDocumentPtr> docs = client->query(queryInfo);
             client->done();
+            qint64 const elapsedMs = timer.elapsed();
+
+            std::string servedBy;
+            if (event->readPreference() != ReadPrimary) {
+                servedBy = target.empty() ? _dbclientRepSet->getSuspectedPrimaryHostAndPort().toString() 
+                                          : target;
+            }
+
+            reply(event->sender(), new ExecuteQueryResponse(this, event->resultIndex(), event->queryInfo(), docs,
+                                                            servedBy, elapsedMs));
+        } catch(const std::exception &ex) {
+            // Member may be down, it is re-selected with fresh state on next query
+            if (event->readPreference() != ReadPrimary)
+                forgetReadTargets();
 
-            reply(event->sender(), new ExecuteQueryResponse(this, event->resultIndex(), event->queryInfo(), docs));
-        } catch(const mongo::DBException &ex) {
             reply(event->sender(), new ExecuteQueryResponse(this, EventError(ex.what())));
             LOG_MSG(ex.what(), mongo::logger::LogSeverity::Error());
         }
@@ -575,6 +890,7 @@ namespace Robomongo
             // Try to handle case where new shell (which was opened when server unreachable) was re-executed
             if (_scriptEngine->failedScope()) {
                 try {
+                    auto const ssl = sslScope();
                     _scriptEngine->init(_isLoadMongoRcJs);
                 }
                 catch (std::exception const& ex) {     
@@ -583,11 +899,44 @@ namespace Robomongo
                 }
             }
 
+            // Read-only scripts of tabs with non-primary read preference run in a separate shell
+            // scope bound to the selected member. Shell scope of the tab stays on primary, so its
+            // variables and functions survive, but they are not visible to routed scripts.
+            std::string const readTarget = _connSettings->isReplicaSet() && event->readPreference != ReadPrimary &&
+                                           ScriptUtils::isReadOnlyScript(event->script)
+                                         ? selectReadTarget(event->readPreference) : std::string();
+            if (!readTarget.empty()) {
+                MongoShellExecResult result = readScriptEngine(readTarget)->exec(event->script,
+                                                                                 _connSettings->defaultDatabase());
+                if (result.error()) {
+                    // Script is not re-run on primary: statements before the failure already ran.
+                    // Member is re-selected with fresh state on next execution.
+                    forgetReadTargets();
+                    std::string error = result.errorMessage();
+                    if (ScriptUtils::isNotMasterError(error))
+                        error = "Script tried to write on secondary " + readTarget +
+                                ", run it with read preference 'primary'. " + error;
+                    reply(event->sender(), new ExecuteScriptResponse(this, EventError(error)));
+                    return;
+                }
+
+                // Database switched by 'use' is followed by shell scope of the tab
+                if (result.isCurrentDatabaseValid() && result.currentDatabase() != scriptEngineDatabase()) {
+                    _scriptEngineDatabase = result.currentDatabase();
+                    _scriptEngine->use(_scriptEngineDatabase);
+                }
+
+                result.setCurrentServer(readTarget);
+                reply(event->sender(), new ExecuteScriptResponse(this, result, event->script.empty(),
+                                                                 result.timeoutReached()));
+                return;
+            }
+
             // todo: should we use dbName from event or _connSettings? 
             MongoShellExecResult result = _scriptEngine->exec(event->script, _connSettings->defaultDatabase());
 
             // To fix the problem where 'result' comes with old primary address.
-            if (_connSettings->isReplicaSet()) 
+            if (_connSettings->isReplicaSet())
                 result.setCurrentServer(_dbclientRepSet->getSuspectedPrimaryHostAndPort().toString());
 
             // Robomongo shell timeout
@@ -605,8 +954,11 @@ namespace Robomongo
                         return;
                     }
                     else {  // primary reachable
-                        _scriptEngine->init(_isLoadMongoRcJs, replicaSetInfo.primary.toString(),
-                                            _connSettings->defaultDatabase());
+                        {
+                            auto const ssl = sslScope();
+                            _scriptEngine->init(_isLoadMongoRcJs, replicaSetInfo.primary.toString(),
+                                                scriptEngineDatabase());
+                        }
                         result = _scriptEngine->exec(event->script, _connSettings->defaultDatabase());
                     }
                 }
@@ -617,6 +969,10 @@ namespace Robomongo
                 }
             }
 
+            // Database switched by 'use' is kept when scope is re-initialised, also used by routed scripts
+            if (!result.error() && result.isCurrentDatabaseValid())
+                _scriptEngineDatabase = result.currentDatabase();
+
             reply(event->sender(), new ExecuteScriptResponse(this, result, event->script.empty(), timeoutReached));
         } 
         catch(const std::exception &ex) {
@@ -939,13 +1295,12 @@ namespace Robomongo
 
     mongo::DBClientBase *MongoWorker::getConnection(bool mayReturnNull /* = false */)
     {
-        configureSSL();
-
         // --- Perform connection ---
         if (_connSettings->isReplicaSet()) // connection to replica set 
         {  
             if (!_dbclientRepSet) 
             {
+                auto const ssl = sslScope();
                 init(); // Init mongoworker for early-use of _scriptEngine
 
                 // Step-1: Use user entered set name or retrieve set name from cache or from a reachable member
@@ -971,6 +1326,8 @@ namespace Robomongo
         }
         else {  // connection to single server
             if (!_dbclient) {
+                auto const ssl = sslScope();
+
                 // Timeout for operations
                 // Connect timeout is fixed, but short, at 5 seconds (see headers for DBClientConnection)
                 _dbclient = DBClientConnection(new mongo::DBClientConnection(true, _mongoTimeoutSec));
@@ -988,51 +1345,9 @@ namespace Robomongo
         return new MongoClient(getConnection());
     }
 
-    void MongoWorker::configureSSL()
-    {
-        // As a precaution reset SSL global params for any kind of connection request (SSL or non-SSL)
-        resetGlobalSSLparams();
-        // Update global SSL mode and global mongo SSL settings
-        if (_connSettings->sslSettings()->sslEnabled()) {
-            // Force SSL mode for outgoing connections
-            mongo::sslGlobalParams.sslMode.store(mongo::SSLParams::SSLMode_requireSSL);
-            updateGlobalSSLparams();
-        }
-        else {
-            // Disable forced SSL mode for outgoing connections
-            mongo::sslGlobalParams.sslMode.store(mongo::SSLParams::SSLMode_allowSSL);
-        }
-    }
-
-    void MongoWorker::updateGlobalSSLparams() const
-    {
-        resetGlobalSSLparams();
-        const SslSettings * const sslSettings = _connSettings->sslSettings();
-        mongo::sslGlobalParams.sslAllowInvalidCertificates = sslSettings->allowInvalidCertificates();
-        if (!mongo::sslGlobalParams.sslAllowInvalidCertificates)
-        {
-            mongo::sslGlobalParams.sslCAFile = sslSettings->caFile();
-        }
-        if (sslSettings->usePemFile())
-        {
-            mongo::sslGlobalParams.sslPEMKeyFile = sslSettings->pemKeyFile();
-            mongo::sslGlobalParams.sslPEMKeyPassword = sslSettings->pemPassPhrase();
-        }
-        if (sslSettings->useAdvancedOptions())
-        {
-            mongo::sslGlobalParams.sslCRLFile = sslSettings->crlFile();
-            mongo::sslGlobalParams.sslAllowInvalidHostnames = sslSettings->allowInvalidHostnames();
-        }
-    }
-
-    void MongoWorker::resetGlobalSSLparams() const
+    SslParamsGuard::Scope MongoWorker::sslScope() const
     {
-        mongo::sslGlobalParams.sslAllowInvalidCertificates = false;
-        mongo::sslGlobalParams.sslCAFile = "";
-        mongo::sslGlobalParams.sslPEMKeyFile = "";
-        mongo::sslGlobalParams.sslPEMKeyPassword = "";
-        mongo::sslGlobalParams.sslCRLFile = "";
-        mongo::sslGlobalParams.sslAllowInvalidHostnames = false;
+        return SslParamsGuard::Scope(_connSettings->sslSettings());
     }
 
     ReplicaSet MongoWorker::getReplicaSetInfo(bool refresh /*= true*/) const
@@ -1128,6 +1443,9 @@ namespace Robomongo
         if (_isQuiting)
             return;
 
+        _replyPayloadBytes += event->payloadSize();
+        _replyError = _replyError || event->isError();
+
         AppRegistry::instance().bus()->send(receiver, event);
     }
 
@@ -1145,4 +1463,200 @@ namespace Robomongo
             dbclient->runCommand(authBase, command.obj(), result);
         }
     }
+
+    void MongoWorker::authenticate(mongo::DBClientBase *conn) const
+    {
+        authenticate(conn, _connSettings);
+    }
+
+    void MongoWorker::authenticate(mongo::DBClientBase *conn, ConnectionSettings const* settings)
+    {
+        if (!settings->hasEnabledPrimaryCredential())
+            return;
+
+        CredentialSettings *credentials = settings->primaryCredential();
+
+        // Building BSON object:
+        mongo::BSONObj authParams(mongo::BSONObjBuilder()
+            .append("user", credentials->userName())
+            .append("db", credentials->databaseName())
+            .append("pwd", credentials->userPassword())
+            .append("mechanism", credentials->mechanism())
+            .obj());
+
+        conn->auth(authParams);
+    }
+
+    std::pair<float, std::string> MongoWorker::fetchServerInfo(ConnectionSettings const* settings,
+                                                               mongo::HostAndPort const& host, int timeoutSec)
+    {
+        auto conn = DBClientConnection(new mongo::DBClientConnection(true, timeoutSec));
+        {
+            SslParamsGuard::Scope const ssl(settings->sslSettings());
+            mongo::Status const status = conn->connect(host, "Robomongo");
+            if (!status.isOK())
+                throw std::runtime_error("Unable to connect to " + host.toString() + ": " + status.reason());
+        }
+
+        authenticate(conn.get(), settings);
+        MongoClient client(conn.get());
+        return { client.getVersion(), client.getStorageEngineType() };
+    }
+
+    std::string MongoWorker::selectReadTarget(ReadPreferenceMode mode)
+    {
+        if (mode == ReadPrimary || !_connSettings->isReplicaSet() || !_dbclientRepSet)
+            return std::string();
+
+        // Members and their latencies are refreshed by keepAlive() and after a member failed
+        if (!_readSetInfo || _membersLatencyMs.empty()) {
+            _readSetInfo.reset(new ReplicaSet(getReplicaSetInfo(false)));
+            measureMembersLatency(*_readSetInfo);
+        }
+
+        ReplicaSet const& setInfo = *_readSetInfo;
+
+        std::string const primary = setInfo.primary.toString();
+        std::string best;
+        double bestLatency = 0;
+        for (auto const& member : setInfo.membersAndHealths) {
+            if (!member.second)     // unhealthy
+                continue;
+
+            if (mode == ReadSecondaryPreferred && member.first == primary)
+                continue;
+
+            auto const latency = _membersLatencyMs.find(member.first);
+            if (latency == _membersLatencyMs.end())     // unreachable during last measurement
+                continue;
+
+            if (best.empty() || latency->second < bestLatency) {
+                best = latency->first;
+                bestLatency = latency->second;
+            }
+        }
+
+        // No eligible secondary or primary itself is the nearest one
+        if (best == primary)
+            return std::string();
+
+        return best;
+    }
+
+    void MongoWorker::measureMembersLatency(ReplicaSet const& setInfo)
+    {
+        for (auto const& member : setInfo.membersAndHealths) {
+            if (!member.second) {
+                _membersLatencyMs.erase(member.first);
+                continue;
+            }
+
+            try {
+                mongo::DBClientBase *conn = getMemberConnection(member.first);
+                QElapsedTimer timer;
+                timer.start();
+                pingDatabase(conn);
+                double const rtt = static_cast<double>(timer.nsecsElapsed()) / 1000000.0;
+
+                // Exponentially weighted moving average to smooth out single slow pings
+                auto const it = _membersLatencyMs.find(member.first);
+                if (it == _membersLatencyMs.end())
+                    _membersLatencyMs[member.first] = rtt;
+                else
+                    it->second = 0.8 * it->second + 0.2 * rtt;
+            }
+            catch (const std::exception &ex) {
+                _membersLatencyMs.erase(member.first);
+                _memberConnections.erase(member.first);
+                LOG_MSG("Failed to measure latency of member " + member.first + ". " + ex.what(), 
+                        mongo::logger::LogSeverity::Warning());
+            }
+        }
+    }
+
+    mongo::DBClientBase *MongoWorker::getMemberConnection(std::string const& member)
+    {
+        auto const it = _memberConnections.find(member);
+        if (it != _memberConnections.end())
+            return it->second.get();
+
+        auto conn = DBClientConnection(new mongo::DBClientConnection(true, _mongoTimeoutSec));
+        {
+            auto const ssl = sslScope();
+            mongo::Status const status = conn->connect(mongo::HostAndPort(member), "Robomongo");
+            if (!status.isOK())
+                throw std::runtime_error("Unable to connect to " + member + ": " + status.reason());
+        }
+
+        authenticate(conn.get());
+        return (_memberConnections[member] = std::move(conn)).get();
+    }
+
+    std::vector<mongo::DBClientBase *> MongoWorker::getMetadataConnections(size_t requests)
+    {
+        // Primary is not known until worker is connected
+        if (!getConnection(true))
+            throw std::runtime_error("Not connected");
+
+        std::string const host = _dbclientRepSet ? _dbclientRepSet->getSuspectedPrimaryHostAndPort().toString()
+                                                 : _connSettings->hostAndPort().toString();
+
+        // Primary has changed since connections were opened
+        if (host != _metadataHost) {
+            _metadataConnections.clear();
+            _metadataHost = host;
+        }
+
+        size_t const needed = std::max<size_t>(1, std::min<size_t>(requests, maxMetadataConnections));
+        while (_metadataConnections.size() < needed) {
+            auto conn = DBClientConnection(new mongo::DBClientConnection(true, _mongoTimeoutSec));
+            {
+                auto const ssl = sslScope();
+                mongo::Status const status = conn->connect(mongo::HostAndPort(host), "Robomongo");
+                if (!status.isOK())
+                    throw std::runtime_error("Unable to connect to " + host + ": " + status.reason());
+            }
+
+            authenticate(conn.get());
+            _metadataConnections.push_back(std::move(conn));
+        }
+
+        std::vector<mongo::DBClientBase *> connections;
+        for (size_t i = 0; i < needed; ++i)
+            connections.push_back(_metadataConnections[i].get());
+        return connections;
+    }
+
+    ScriptEngine *MongoWorker::readScriptEngine(std::string const& target)
+    {
+        std::string const dbName = scriptEngineDatabase();
+        if (!_readScriptEngine || _readScriptEngine->failedScope() || target != _readScriptEngineTarget) {
+            _readScriptEngine.reset(new ScriptEngine(_connSettings, _shellTimeoutSec));
+            _readScriptEngineTarget.clear();
+            {
+                auto const ssl = sslScope();
+                _readScriptEngine->init(_isLoadMongoRcJs, target, dbName);
+            }
+            _readScriptEngine->setBatchSize(_batchSize);
+            _readScriptEngineTarget = target;
+        }
+
+        // ScriptEngine::use() also issues rs.slaveOk() which allows reads on secondaries
+        _readScriptEngine->use(dbName);
+        return _readScriptEngine.get();
+    }
+
+    void MongoWorker::forgetReadTargets()
+    {
+        _membersLatencyMs.clear();
+        _readSetInfo.reset();
+    }
+
+    std::string MongoWorker::scriptEngineDatabase() const
+    {
+        if (!_scriptEngineDatabase.empty())
+            return _scriptEngineDatabase;
+
+        return _connSettings->defaultDatabase().empty() ? "test" : _connSettings->defaultDatabase();
+    }
 }
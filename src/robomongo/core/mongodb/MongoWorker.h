@@ -2,11 +2,16 @@
 
 #include <QObject>
 #include <QMutex>
+#include <future>
 #include <unordered_set>
+#include <map>
 
 #include <mongo/client/dbclient_rs.h> 
 
 #include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/DocumentExporter.h"
+#include "robomongo/core/mongodb/SslParamsGuard.h"
+#include "robomongo/core/mongodb/WorkerMetrics.h"
 
 QT_BEGIN_NAMESPACE
 class QThread;
@@ -26,6 +31,9 @@ namespace Robomongo
     public:
         enum { pingTimeMs = 60 * 1000 };
 
+        // Number of connections used to load collection statistics in parallel
+        enum { maxMetadataConnections = 4 };
+
         typedef std::vector<std::string> DatabasesContainerType;
         using DBClientReplicaSet = std::unique_ptr<mongo::DBClientReplicaSet>;
         using DBClientConnection = std::unique_ptr<mongo::DBClientConnection>;
@@ -42,6 +50,13 @@ namespace Robomongo
 
         void init();
 
+        /**
+         * @brief Record latency metrics of handled request. Invoked by EventBusDispatcher
+         *        right after handle(...) of this worker returned.
+         * @param startNs, endNs: start and end of handler (see Event::monotonicNs())
+         */
+        void handled(Event *request, qint64 startNs, qint64 endNs);
+
         /**
          * @brief Every minute we are issuing { ping : 1 } command to every used connection
          * in order to avoid dropped connections.
@@ -69,6 +84,11 @@ namespace Robomongo
          */
         void handle(LoadCollectionNamesRequest *event);
 
+        /**
+         * @brief Load statistics of given collections, in parallel over metadata connections
+         */
+        void handle(LoadCollectionStatsRequest *event);
+
         /**
          * @brief Load list of all users
          */
@@ -79,6 +99,11 @@ namespace Robomongo
         */
         void handle(LoadCollectionIndexesRequest *event);
 
+        /**
+        * @brief Load sizes and usage of indexes in collection, usage from all members in parallel
+        */
+        void handle(LoadIndexStatsRequest *event);
+
         /**
         * @brief Load indexes in collection
         */
@@ -104,6 +129,16 @@ namespace Robomongo
          */
         void handle(InsertDocumentRequest *event);
 
+        /**
+         * @brief Updates document by update operators
+         */
+        void handle(UpdateDocumentRequest *event);
+
+        /**
+         * @brief Start, continue (one time-limited chunk) or cancel export of documents into file
+         */
+        void handle(ExportDocumentsRequest *event);
+
         /**
          * @brief Remove documents
          */
@@ -152,20 +187,10 @@ namespace Robomongo
         MongoClient *getClient();
 
         /**
-        *@brief Reset and update global mongo SSL settings (mongo::sslGlobalParams)
-        */
-        void configureSSL();
-
-        /**
-        *@brief Update global mongo SSL settings (mongo::sslGlobalParams) according to active connection 
-        *       request's SSL settings.
+        *@brief Apply SSL settings of this connection to global mongo SSL settings (mongo::sslGlobalParams)
+        *       until returned scope is gone. New connections must be opened within it. See SslParamsGuard.
         */
-        void updateGlobalSSLparams() const;
-
-        /**
-        *@brief Reset global mongo SSL settings (mongo::sslGlobalParams) into default zero state
-        */
-        void resetGlobalSSLparams() const;
+        SslParamsGuard::Scope sslScope() const;
 
         /**
         *@brief Update Replica Set related parameters/settings.
@@ -191,11 +216,72 @@ namespace Robomongo
         */
         void pingDatabase(mongo::DBClientBase *dbclient) const;
 
+        /**
+        * @brief Authenticate 'conn' with primary credential of this connection (if any)
+        */
+        void authenticate(mongo::DBClientBase *conn) const;
+        static void authenticate(mongo::DBClientBase *conn, ConnectionSettings const* settings);
+
+        /**
+        * @brief Fetch server version (buildInfo) and storage engine name over a separate, 
+        *        short-lived connection to 'host'. Does not use worker's state, so it can run
+        *        concurrently with the worker thread (see _serverInfo).
+        */
+        static std::pair<float, std::string> fetchServerInfo(ConnectionSettings const* settings,
+                                                             mongo::HostAndPort const& host, int timeoutSec);
+
+        /**
+        * @brief Select replica set member to serve reads of given read preference.
+        * @return Address of the lowest-latency eligible member, or empty string when 
+        *         reads should go to the primary (single server, 'primary' preference or
+        *         primary is the fastest eligible member).
+        */
+        std::string selectReadTarget(ReadPreferenceMode mode);
+
+        /**
+        * @brief Issue { ping : 1 } to every healthy member of the set and update smoothed 
+        *        round-trip times in _membersLatencyMs.
+        */
+        void measureMembersLatency(ReplicaSet const& setInfo);
+
+        /**
+        * @brief Return (lazily created and authenticated) direct connection to replica set member
+        */
+        mongo::DBClientBase *getMemberConnection(std::string const& member);
+
+        /**
+        * @brief Return up to maxMetadataConnections (at least one) lazily created and authenticated
+        *        connections to primary, used for metadata commands running in parallel
+        *        (i.e. collStats). These are separate from the connection serving queries.
+        */
+        std::vector<mongo::DBClientBase *> getMetadataConnections(size_t requests);
+
+        /**
+        * @brief Shell scope for read-only scripts routed to 'target' member, (re)created when
+        *        target changed. Shell scope of the tab is never re-bound, so user state in it survives.
+        */
+        ScriptEngine *readScriptEngine(std::string const& target);
+
+        /**
+        * @brief Drop cached members and latencies, read target is selected with fresh ones next time.
+        */
+        void forgetReadTargets();
+
+        /**
+        * @brief Database shell scope is re-initialised with: the one last used by scripts,
+        *        or default database of connection.
+        */
+        std::string scriptEngineDatabase() const;
+
         QThread *_thread;
         QMutex _firstConnectionMutex;
 
         std::unique_ptr<ScriptEngine> _scriptEngine;
 
+        // Shell scope serving routed read-only scripts and member it is bound to
+        std::unique_ptr<ScriptEngine> _readScriptEngine;
+        std::string _readScriptEngineTarget;
+
         bool _isAdmin;
         const bool _isLoadMongoRcJs;
         const int _batchSize;
@@ -216,6 +302,40 @@ namespace Robomongo
         // We save all created databases in this collection and merge with
         // list of real databases returned from MongoDB server.
         std::unordered_set<std::string> _createdDbs;
+
+        // Members of replica set used to select read target, refreshed together with latencies
+        std::unique_ptr<ReplicaSet> _readSetInfo;
+
+        // Smoothed round-trip times (ms) of replica set members, keyed by "host:port"
+        std::map<std::string, double> _membersLatencyMs;
+
+        // Direct connections to replica set members used for non-primary reads
+        std::map<std::string, DBClientConnection> _memberConnections;
+
+        // Connections to primary (or single server) used for parallel metadata commands
+        std::vector<DBClientConnection> _metadataConnections;
+        std::string _metadataHost;
+
+        // Total index operations seen by last LoadIndexStatsRequest and when they were seen growing,
+        // keyed by (namespace, index name)
+        std::map<std::pair<std::string, std::string>, std::pair<long long, long long>> _indexOpsSeen;
+
+        // Current database of shell scope after last successful script (changed by 'use')
+        std::string _scriptEngineDatabase;
+
+        // Handler latency metrics of this worker's cluster
+        std::shared_ptr<WorkerMetrics> _metrics;
+
+        // Payload size and error state of replies sent by currently running handler
+        long long _replyPayloadBytes;
+        bool _replyError;
+
+        // Version and storage engine fetched while connection is established. Future of std::async,
+        // so connection of task is closed before the next connect or destruction of worker completes.
+        std::future<std::pair<float, std::string>> _serverInfo;
+
+        // Running exports, keyed by export id. Declared after connections: cursors use them.
+        std::map<long long, std::unique_ptr<DocumentExporter>> _exports;
     };
 
 }
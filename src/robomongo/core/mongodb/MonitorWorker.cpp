@@ -0,0 +1,444 @@
+#include "robomongo/core/mongodb/MonitorWorker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+
+#include <QDateTime>
+#include <QThread>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoNamespace.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/MongoClient.h"
+#include "robomongo/core/mongodb/SslParamsGuard.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/settings/CredentialSettings.h"
+#include "robomongo/core/settings/ReplicaSetSettings.h"
+#include "robomongo/core/utils/Logger.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace Robomongo
+{
+    MonitorWorker::MonitorWorker(ConnectionSettings *connection, int mongoTimeoutSec) :
+        QObject(),
+        _connSettings(connection),
+        _mongoTimeoutSec(mongoTimeoutSec),
+        _isQuiting(false),
+        _membersRefreshedMs(0)
+    {
+        _thread = new QThread();
+        moveToThread(_thread);
+        VERIFY(connect( _thread, SIGNAL(finished()), _thread, SLOT(deleteLater()) ));
+        VERIFY(connect( _thread, SIGNAL(finished()), this, SLOT(deleteLater()) ));
+        _thread->start();
+    }
+
+    MonitorWorker::~MonitorWorker() {}
+
+    void MonitorWorker::stopAndDelete()
+    {
+        _isQuiting = true;
+        _thread->quit();
+    }
+
+    void MonitorWorker::handle(ServerStatusRequest *event)
+    {
+        try {
+            std::vector<std::string> const hosts = members();
+            std::vector<ServerStatusSample> samples(hosts.size());
+            std::vector<std::string> const errors = runOnMembers(hosts, [&samples](size_t member,
+                                                                                   mongo::DBClientBase *conn) {
+                // Sections not used by monitor are large, skip them
+                mongo::BSONObj status;
+                mongo::BSONObj const command = BSON("serverStatus" << 1 << "repl" << 0 << "metrics" << 0
+                                                    << "locks" << 0 << "tcmalloc" << 0);
+                if (!conn->runCommand("admin", command, status))
+                    throw std::runtime_error(status.getStringField("errmsg"));
+
+                samples[member] = ServerStatusSample::fromServerStatus(status, QDateTime::currentMSecsSinceEpoch());
+            });
+
+            // Member is identified by host it was polled at, not by name it reports
+            for (size_t i = 0; i < hosts.size(); ++i) {
+                samples[i].host = hosts[i];
+                samples[i].error = errors[i];
+            }
+
+            reply(event->sender(), new ServerStatusResponse(this, samples));
+        }
+        catch (const std::exception &ex) {
+            reply(event->sender(), new ServerStatusResponse(this, EventError(ex.what())));
+        }
+    }
+
+    void MonitorWorker::handle(CurrentOpRequest *event)
+    {
+        try {
+            std::vector<std::string> const hosts = members();
+            std::vector<std::vector<CurrentOpInfo>> memberOps(hosts.size());
+            std::vector<std::string> const errors = runOnMembers(hosts, [&memberOps](size_t member,
+                                                                                     mongo::DBClientBase *conn) {
+                memberOps[member] = MongoClient(conn).getCurrentOps();
+            });
+
+            std::vector<CurrentOpInfo> ops;
+            std::vector<std::string> failures;
+            for (size_t i = 0; i < hosts.size(); ++i) {
+                if (!errors[i].empty())
+                    failures.push_back(hosts[i] + ": " + errors[i]);
+
+                for (auto &op : memberOps[i]) {
+                    op.host = hosts[i];
+                    ops.push_back(op);
+                }
+            }
+
+            reply(event->sender(), new CurrentOpResponse(this, ops, failures));
+        }
+        catch (const std::exception &ex) {
+            reply(event->sender(), new CurrentOpResponse(this, EventError(ex.what())));
+        }
+    }
+
+    void MonitorWorker::handle(KillOpRequest *event)
+    {
+        CurrentOpInfo const& op = event->op();
+        std::vector<std::string> const errors = runOnMembers({ op.host }, [&op](size_t, mongo::DBClientBase *conn) {
+            MongoClient(conn).killOp(op);
+        });
+
+        if (errors.front().empty()) {
+            LOG_MSG("Operation " + op.opid + " killed on " + op.host, mongo::logger::LogSeverity::Info());
+            reply(event->sender(), new KillOpResponse(this, op));
+        }
+        else {
+            LOG_MSG(errors.front(), mongo::logger::LogSeverity::Error());
+            reply(event->sender(), new KillOpResponse(this, op, EventError(errors.front())));
+        }
+    }
+
+    void MonitorWorker::handle(ExplainQueryRequest *event)
+    {
+        QObject *const sender = event->sender();
+        int const resultIndex = event->resultIndex();
+        int const requestId = event->requestId();
+        try {
+            std::string host = event->host();
+            if (host.empty()) {
+                auto const& hosts = members();
+                host = _primary.empty() ? hosts.front() : _primary;
+            }
+
+            // Explain with execution statistics runs the slow query again. It has its own thread and
+            // connection, so polling of this worker is not stalled by it. Finished explains are forgotten.
+            _explains.erase(std::remove_if(_explains.begin(), _explains.end(), [](const std::future<void> &explain) {
+                return explain.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }), _explains.end());
+
+            MongoQueryInfo const info = event->queryInfo();
+            _explains.push_back(std::async(std::launch::async, [this, sender, resultIndex, requestId, info, host]() {
+                try {
+                    DBClientConnection conn = openConnection(host);
+                    QueryPlanSummary const plan = QueryPlanSummary::fromExplain(MongoClient(conn.get()).explainQuery(info));
+                    LOG_MSG("Slow query on " + info._info._ns.toString() + " explained, plan: " + plan.plan,
+                            mongo::logger::LogSeverity::Info());
+                    reply(sender, new ExplainQueryResponse(this, resultIndex, requestId, plan));
+                }
+                catch (const std::exception &ex) {
+                    // Background explain, failure is only logged by shell
+                    reply(sender, new ExplainQueryResponse(this, resultIndex, requestId,
+                                                           EventError(ex.what(), EventError::Unknown, false)));
+                }
+            }));
+        }
+        catch (const std::exception &ex) {
+            reply(sender, new ExplainQueryResponse(this, resultIndex, requestId,
+                                                   EventError(ex.what(), EventError::Unknown, false)));
+        }
+    }
+
+    void MonitorWorker::handle(LoadStorageStatsRequest *event)
+    {
+        try {
+            auto const& hosts = members();
+            std::string const host = _primary.empty() ? hosts.front() : _primary;
+
+            // Connections of this scan are not kept, scan is rare and polling does not wait for them
+            DBClientConnection first = openConnection(host);
+            std::vector<std::string> dbNames;
+            try {
+                dbNames = MongoClient(first.get()).getDatabaseNames();
+            }
+            catch (const std::exception &) {
+                // User who is not an admin can not list databases, only its own one is scanned
+                if (!_connSettings->hasEnabledPrimaryCredential())
+                    throw;
+                dbNames.push_back(_connSettings->primaryCredential()->databaseName());
+            }
+
+            // Queue of (database, collection) pairs, empty collection means dbStats of database.
+            // Collections of database are queued when dbStats of that database is done.
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::deque<std::pair<std::string, std::string>> queue;
+            for (auto const& dbName : dbNames)
+                queue.push_back({ dbName, std::string() });
+
+            std::shared_ptr<std::atomic<bool>> const cancelled = event->cancelled();
+            size_t pending = queue.size();      // queued or running
+            std::vector<StorageStatsInfo> completed;
+            int failed = 0;
+            std::string lastFailure;
+
+            auto loadStats = [&](DBClientConnection conn) {
+                // Other connections are opened by their tasks, the first one always makes progress
+                if (!conn) {
+                    try {
+                        conn = openConnection(host);
+                    }
+                    catch (const std::exception &) {
+                        return;
+                    }
+                }
+
+                MongoClient client(conn.get());
+                std::unique_lock<std::mutex> lock(mutex);
+                for (;;) {
+                    if ((*cancelled || _isQuiting) && !queue.empty()) {
+                        pending -= queue.size();
+                        queue.clear();
+                        changed.notify_all();
+                    }
+
+                    // Queue may be empty while other threads still list collections
+                    changed.wait(lock, [&]() { return !queue.empty() || pending == 0; });
+                    if (queue.empty())
+                        return;
+
+                    auto const item = queue.front();
+                    queue.pop_front();
+                    lock.unlock();
+
+                    StorageStatsInfo stats;
+                    std::vector<std::string> collections;
+                    std::string error;
+                    try {
+                        stats = client.getStorageStats(item.first, item.second);
+                        if (stats.isDatabase())
+                            collections = client.getCollectionNamesWithDbname(item.first);
+                    }
+                    catch (const std::exception &ex) {
+                        error = ex.what();
+                    }
+
+                    lock.lock();
+                    for (auto const& ns : collections)
+                        queue.push_back({ item.first, MongoNamespace(ns).collectionName() });
+                    pending += collections.size();
+
+                    if (!error.empty() || (!stats.hasStats && stats.isDatabase())) {
+                        ++failed;
+                        lastFailure = error.empty() ? "dbStats failed for database " + item.first : error;
+                    }
+                    else if (stats.hasStats) {
+                        completed.push_back(stats);
+                    }
+
+                    --pending;
+                    changed.notify_all();
+                }
+            };
+
+            std::vector<std::future<void>> futures;
+            futures.push_back(std::async(std::launch::async, loadStats, std::move(first)));
+            for (int i = 1; i < storageStatsConnections; ++i)
+                futures.push_back(std::async(std::launch::async, loadStats, DBClientConnection()));
+
+            // Send what is completed every storageStatsBatchMs, until everything is done
+            for (bool finished = false; !finished; ) {
+                std::vector<StorageStatsInfo> batch;
+                int failedSoFar;
+                std::string failure;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    finished = changed.wait_for(lock, std::chrono::milliseconds(storageStatsBatchMs),
+                                                [&]() { return pending == 0; });
+                    batch.swap(completed);
+                    failedSoFar = failed;
+                    failure = lastFailure;
+                }
+
+                if (!batch.empty() || finished)
+                    reply(event->sender(), new LoadStorageStatsResponse(this, batch, finished, failedSoFar, failure));
+            }
+
+            for (auto &future : futures)
+                future.get();
+        }
+        catch (const std::exception &ex) {
+            std::string const error = std::string("Failed to load storage statistics. ") + ex.what();
+            reply(event->sender(), new LoadStorageStatsResponse(this, EventError(error)));
+            LOG_MSG(error, mongo::logger::LogSeverity::Warning());
+        }
+    }
+
+    void MonitorWorker::handle(InsertDocumentsRequest *event)
+    {
+        try {
+            members();
+            if (_primary.empty())
+                throw std::runtime_error("Replica set has no primary");
+
+            DBClientConnection &conn = _connections[_primary];
+            if (!conn)
+                conn = openConnection(_primary);
+
+            InsertDocumentsResult const result =
+                MongoClient(conn.get()).insertDocuments(event->documents(), event->ns(), event->ordered());
+            reply(event->sender(), new InsertDocumentsResponse(this, event->batchId(), result));
+        }
+        catch (const std::exception &ex) {
+            // Primary may have changed, it is discovered again for the next batch
+            _connections.erase(_primary);
+            _membersRefreshedMs = 0;
+            reply(event->sender(), new InsertDocumentsResponse(this, event->batchId(),
+                  EventError("Error when inserting documents: " + std::string(ex.what()))));
+        }
+    }
+
+    void MonitorWorker::reply(QObject *receiver, Event *event)
+    {
+        if (_isQuiting)
+            return;
+
+        AppRegistry::instance().bus()->send(receiver, event);
+    }
+
+    const std::vector<std::string> &MonitorWorker::members()
+    {
+        if (!_connSettings->isReplicaSet()) {
+            if (_members.empty()) {
+                _members.push_back(_connSettings->hostAndPort().toString());
+                _primary = _members.front();
+            }
+            return _members;
+        }
+
+        long long const now = QDateTime::currentMSecsSinceEpoch();
+        if (!_members.empty() && now - _membersRefreshedMs < membersRefreshMs)
+            return _members;
+
+        // Known members are asked first, seeds from settings are used when all of them are down
+        std::vector<std::string> seeds = _members;
+        for (auto const& member : _connSettings->replicaSetSettings()->members())
+            seeds.push_back(member);
+
+        std::string lastError = "Replica set has no members";
+        for (auto const& seed : seeds) {
+            try {
+                DBClientConnection &conn = _connections[seed];
+                if (!conn)
+                    conn = openConnection(seed);
+
+                mongo::BSONObj isMaster;
+                if (!conn->runCommand("admin", BSON("isMaster" << 1), isMaster))
+                    throw std::runtime_error(isMaster.getStringField("errmsg"));
+
+                std::vector<std::string> hosts;
+                for (char const *field : { "hosts", "passives" }) {
+                    mongo::BSONObjIterator it(isMaster.getObjectField(field));
+                    while (it.more())
+                        hosts.push_back(it.next().String());
+                }
+                if (hosts.empty())
+                    throw std::runtime_error(seed + " is not a member of replica set");
+
+                _members = hosts;
+                _primary = isMaster.getStringField("primary");
+                _membersRefreshedMs = now;
+
+                // Connections to removed members are closed
+                for (auto it = _connections.begin(); it != _connections.end();) {
+                    if (std::find(hosts.begin(), hosts.end(), it->first) == hosts.end())
+                        it = _connections.erase(it);
+                    else
+                        ++it;
+                }
+                return _members;
+            }
+            catch (const std::exception &ex) {
+                _connections.erase(seed);
+                lastError = ex.what();
+            }
+        }
+
+        if (_members.empty())
+            throw std::runtime_error(lastError);
+
+        LOG_MSG("Failed to refresh replica set members for monitoring. " + lastError,
+                mongo::logger::LogSeverity::Warning());
+        return _members;
+    }
+
+    std::vector<std::string> MonitorWorker::runOnMembers(const std::vector<std::string> &hosts,
+                                                         const std::function<void(size_t, mongo::DBClientBase *)> &task)
+    {
+        std::vector<std::future<std::string>> runs;
+        for (size_t i = 0; i < hosts.size(); ++i) {
+            // Connection slot is used by one task only, elements of map are not moved by insertion
+            DBClientConnection &conn = _connections[hosts[i]];
+            runs.push_back(std::async(std::launch::async, [this, &conn, &hosts, &task](size_t member) {
+                try {
+                    if (!conn)
+                        conn = openConnection(hosts[member]);
+
+                    task(member, conn.get());
+                    return std::string();
+                }
+                catch (const std::exception &ex) {
+                    if (conn && conn->isFailed())
+                        conn.reset();
+                    return std::string(ex.what());
+                }
+            }, i));
+        }
+
+        std::vector<std::string> errors;
+        for (auto &run : runs) {
+            errors.push_back(run.get());
+
+            // Member may be down or removed from replica set
+            if (!errors.back().empty())
+                _membersRefreshedMs = 0;
+        }
+        return errors;
+    }
+
+    MonitorWorker::DBClientConnection MonitorWorker::openConnection(const std::string &host) const
+    {
+        auto conn = DBClientConnection(new mongo::DBClientConnection(true, _mongoTimeoutSec));
+        {
+            // Members are connected from several threads at once, global SSL params must not change meanwhile
+            SslParamsGuard::Scope const ssl(_connSettings->sslSettings());
+            mongo::Status const status = conn->connect(mongo::HostAndPort(host), "Robomongo");
+            if (!status.isOK())
+                throw std::runtime_error("Unable to connect to " + host + ": " + status.reason());
+        }
+
+        if (_connSettings->hasEnabledPrimaryCredential()) {
+            CredentialSettings *credentials = _connSettings->primaryCredential();
+            conn->auth(mongo::BSONObjBuilder()
+                .append("user", credentials->userName())
+                .append("db", credentials->databaseName())
+                .append("pwd", credentials->userPassword())
+                .append("mechanism", credentials->mechanism())
+                .obj());
+        }
+        return conn;
+    }
+}
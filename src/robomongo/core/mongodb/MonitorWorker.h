@@ -0,0 +1,116 @@
+#pragma once
+
+#include <QObject>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <mongo/client/dbclientinterface.h>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class ConnectionSettings;
+    class Event;
+    class ServerStatusRequest;
+    class CurrentOpRequest;
+    class KillOpRequest;
+    class ExplainQueryRequest;
+    class LoadStorageStatsRequest;
+    class InsertDocumentsRequest;
+
+    /**
+     * @brief Serves monitoring requests of one MongoServer on its own thread, so polling
+     *        is never queued behind queries and scripts handled by MongoWorker.
+     *
+     *        Worker keeps one direct connection per member (replica set members are
+     *        discovered with isMaster) and polls all members at once.
+     *
+     *        DocumentImporter runs its own instance, so that long import holds up
+     *        neither MongoWorker nor polling of the server.
+     */
+    class MonitorWorker : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        // Members of replica set are re-discovered after this interval or after any member failed
+        enum { membersRefreshMs = 30 * 1000 };
+
+        // Number of connections used to load storage statistics in parallel
+        enum { storageStatsConnections = 4 };
+
+        // Storage statistics completed within this interval are sent to GUI in one response
+        enum { storageStatsBatchMs = 200 };
+
+        using DBClientConnection = std::unique_ptr<mongo::DBClientConnection>;
+
+        /**
+         * @param connection: MonitorWorker will own this ConnectionSettings.
+         */
+        MonitorWorker(ConnectionSettings *connection, int mongoTimeoutSec);
+        ~MonitorWorker();
+
+        void stopAndDelete();
+
+    protected Q_SLOTS:
+        void handle(ServerStatusRequest *event);
+        void handle(CurrentOpRequest *event);
+        void handle(KillOpRequest *event);
+        void handle(ExplainQueryRequest *event);
+
+        /**
+         * @brief Load dbStats of all databases and collStats of all their collections from primary,
+         *        in parallel over storageStatsConnections connections opened for this request.
+         *        Results are sent in several responses as they complete.
+         */
+        void handle(LoadStorageStatsRequest *event);
+
+        /**
+         * @brief Bulk insert of imported documents into primary, over the connection to it
+         */
+        void handle(InsertDocumentsRequest *event);
+
+    private:
+        void reply(QObject *receiver, Event *event);
+
+        /**
+         * @brief Hosts of all members, discovered with isMaster for replica set.
+         * @throws std::exception, if none of members is reachable
+         */
+        const std::vector<std::string> &members();
+
+        /**
+         * @brief Run task(index of member, connection) for all 'hosts' at once, every task on its own connection.
+         * @return Error of every member, empty if its task succeeded
+         */
+        std::vector<std::string> runOnMembers(const std::vector<std::string> &hosts,
+                                              const std::function<void(size_t, mongo::DBClientBase *)> &task);
+
+        /**
+         * @brief Open direct authenticated connection to member. Thread safe.
+         * @throws std::exception, if connection failed
+         */
+        DBClientConnection openConnection(const std::string &host) const;
+
+        QThread *_thread;
+        std::unique_ptr<ConnectionSettings> _connSettings;
+        int const _mongoTimeoutSec;
+        volatile bool _isQuiting;
+
+        std::vector<std::string> _members;
+        std::string _primary;       // empty if replica set has no primary
+        long long _membersRefreshedMs;
+        std::map<std::string, DBClientConnection> _connections;
+
+        // Explains running on their own threads. Declared last: they are waited for on destruction,
+        // before settings they use are gone.
+        std::vector<std::future<void>> _explains;
+    };
+}
@@ -162,6 +162,10 @@ namespace Robomongo
         if (_isQuiting)
             return;
 
+        // Debug output of SSH is verbose, do not post events which Logger drops anyway
+        if (!Logger::instance().isEnabled(LogEvent::severity((LogEvent::LogLevel)level)))
+            return;
+
         AppRegistry::instance().bus()->send(
             AppRegistry::instance().app(),
             new LogEvent(this, message, (LogEvent::LogLevel)level));
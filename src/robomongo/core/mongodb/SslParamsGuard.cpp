@@ -0,0 +1,109 @@
+#include "robomongo/core/mongodb/SslParamsGuard.h"
+
+#include <mongo/util/net/ssl_options.h>
+
+#include "robomongo/core/settings/SslSettings.h"
+
+namespace Robomongo
+{
+    SslParamsGuard::SslParamsGuard() :
+        _appliedKey(),
+        _scopes(0)
+    {
+    }
+
+    SslParamsGuard::Scope::Scope(const SslSettings *settings) :
+        _active(true)
+    {
+        SslParamsGuard::instance().enter(settings);
+    }
+
+    SslParamsGuard::Scope::Scope(Scope &&other) :
+        _active(other._active)
+    {
+        other._active = false;
+    }
+
+    SslParamsGuard::Scope::~Scope()
+    {
+        if (_active)
+            SslParamsGuard::instance().leave();
+    }
+
+    void SslParamsGuard::enter(const SslSettings *settings)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // Params of other settings are in use by connections being opened
+        std::string const key = settingsKey(settings);
+        _left.wait(lock, [&]() { return _scopes == 0 || key == _appliedKey; });
+
+        if (key != _appliedKey) {
+            write(settings);
+            _appliedKey = key;
+        }
+        ++_scopes;
+    }
+
+    void SslParamsGuard::leave()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (--_scopes == 0)
+            _left.notify_all();
+    }
+
+    std::string SslParamsGuard::settingsKey(const SslSettings *settings)
+    {
+        if (!settings->sslEnabled())
+            return "0";
+
+        std::string key = "1|";
+        key += settings->allowInvalidCertificates() ? "1|" : ("0|" + settings->caFile() + "|");
+        if (settings->usePemFile())
+            key += settings->pemKeyFile() + "|" + settings->pemPassPhrase() + "|";
+
+        if (settings->useAdvancedOptions())
+            key += settings->crlFile() + "|" + (settings->allowInvalidHostnames() ? "1" : "0");
+
+        return key;
+    }
+
+    void SslParamsGuard::write(const SslSettings *settings) const
+    {
+        reset();
+
+        if (!settings->sslEnabled()) {
+            // Disable forced SSL mode for outgoing connections
+            mongo::sslGlobalParams.sslMode.store(mongo::SSLParams::SSLMode_allowSSL);
+            return;
+        }
+
+        // Force SSL mode for outgoing connections
+        mongo::sslGlobalParams.sslMode.store(mongo::SSLParams::SSLMode_requireSSL);
+        mongo::sslGlobalParams.sslAllowInvalidCertificates = settings->allowInvalidCertificates();
+        if (!mongo::sslGlobalParams.sslAllowInvalidCertificates)
+        {
+            mongo::sslGlobalParams.sslCAFile = settings->caFile();
+        }
+        if (settings->usePemFile())
+        {
+            mongo::sslGlobalParams.sslPEMKeyFile = settings->pemKeyFile();
+            mongo::sslGlobalParams.sslPEMKeyPassword = settings->pemPassPhrase();
+        }
+        if (settings->useAdvancedOptions())
+        {
+            mongo::sslGlobalParams.sslCRLFile = settings->crlFile();
+            mongo::sslGlobalParams.sslAllowInvalidHostnames = settings->allowInvalidHostnames();
+        }
+    }
+
+    void SslParamsGuard::reset() const
+    {
+        mongo::sslGlobalParams.sslAllowInvalidCertificates = false;
+        mongo::sslGlobalParams.sslCAFile = "";
+        mongo::sslGlobalParams.sslPEMKeyFile = "";
+        mongo::sslGlobalParams.sslPEMKeyPassword = "";
+        mongo::sslGlobalParams.sslCRLFile = "";
+        mongo::sslGlobalParams.sslAllowInvalidHostnames = false;
+    }
+}
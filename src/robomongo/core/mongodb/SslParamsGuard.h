@@ -0,0 +1,71 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+#include "robomongo/core/utils/SingletonPattern.hpp"
+
+namespace Robomongo
+{
+    class SslSettings;
+
+    /**
+    * @brief Process-wide owner of mongo SSL settings (mongo::sslGlobalParams).
+    *
+    *        Mongo driver has no SSL context per connection: connect() and its TLS handshake read
+    *        mongo::sslGlobalParams, which are global to the process, while each connection may have
+    *        its own SSL settings. All code which opens new connections (DBClientConnection,
+    *        DBClientReplicaSet, shell scope) does it within a Scope of its settings.
+    *
+    *        Scopes of the same settings exist at once, so connections to the same cluster (shells,
+    *        metadata and monitor connections) are opened in parallel and never wait for each other.
+    *        Scope of other settings waits until all of them are gone, then rewrites global params.
+    *        Connections which driver opens lazily outside of any scope (i.e. DBClientReplicaSet
+    *        to secondaries) use params applied last.
+    */
+    class SslParamsGuard : public Patterns::LazySingleton<SslParamsGuard>
+    {
+        friend class Patterns::LazySingleton<SslParamsGuard>;
+
+    public:
+        /**
+        * @brief Keeps SSL settings applied to global params while it exists. Connection has to be
+        *        opened (connect and TLS handshake) within scope of its settings.
+        *        Scopes may be nested on one thread only when settings are the same.
+        */
+        class Scope
+        {
+        public:
+            explicit Scope(const SslSettings *settings);
+            Scope(Scope &&other);
+            ~Scope();
+
+        private:
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+            bool _active;
+        };
+
+        /**
+        * @brief Key which uniquely identifies effective SSL settings, i.e. "1|ca.pem|client.pem|..."
+        *        Settings which are not used (i.e. PEM file when 'usePemFile' is off) are not part of key.
+        */
+        static std::string settingsKey(const SslSettings *settings);
+
+    private:
+        SslParamsGuard();
+
+        void enter(const SslSettings *settings);
+        void leave();
+
+        void write(const SslSettings *settings) const;
+        void reset() const;
+
+        std::mutex _mutex;
+        std::condition_variable _left;
+        std::string _appliedKey;
+        int _scopes;            // number of existing scopes, all of them with _appliedKey
+    };
+}
@@ -0,0 +1,188 @@
+#include "robomongo/core/mongodb/WorkerMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QDateTime>
+#include <QJsonDocument>
+
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    // Values below 'LinearLimit' are recorded exactly, every following power of two range
+    // is split into 'SubBuckets' linear sub-buckets.
+    const int SubBucketsBits = 4;
+    const int SubBuckets = 1 << SubBucketsBits;
+    const int LinearLimit = SubBuckets * 2;
+    const int Magnitudes = 44;     // up to ~2^48 us
+    const int BucketsCount = LinearLimit + Magnitudes * SubBuckets;
+
+    int highestBit(unsigned long long value)
+    {
+        int bit = -1;
+        while (value) {
+            value >>= 1;
+            ++bit;
+        }
+        return bit;
+    }
+}
+
+namespace Robomongo
+{
+    LatencyHistogram::LatencyHistogram() :
+        _buckets(BucketsCount, 0),
+        _count(0),
+        _sum(0),
+        _min(std::numeric_limits<long long>::max()),
+        _max(0)
+    {
+    }
+
+    int LatencyHistogram::bucketIndex(long long value)
+    {
+        if (value < LinearLimit)
+            return static_cast<int>(std::max(0LL, value));
+
+        int const shift = highestBit(value) - SubBucketsBits;  // >= 1
+        int const subBucket = static_cast<int>(value >> shift) - SubBuckets;  // 0..SubBuckets-1
+        int const index = LinearLimit + (shift - 1) * SubBuckets + subBucket;
+        return std::min(index, BucketsCount - 1);
+    }
+
+    long long LatencyHistogram::bucketHighestValue(int index)
+    {
+        if (index < LinearLimit)
+            return index;
+
+        int const shift = (index - LinearLimit) / SubBuckets + 1;
+        long long const subBucket = (index - LinearLimit) % SubBuckets + SubBuckets;
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+    void LatencyHistogram::record(long long valueUs)
+    {
+        valueUs = std::max(0LL, valueUs);
+        ++_buckets[bucketIndex(valueUs)];
+        ++_count;
+        _sum += valueUs;
+        _min = std::min(_min, valueUs);
+        _max = std::max(_max, valueUs);
+    }
+
+    void LatencyHistogram::merge(const LatencyHistogram &other)
+    {
+        for (int i = 0; i < BucketsCount; ++i)
+            _buckets[i] += other._buckets[i];
+
+        _count += other._count;
+        _sum += other._sum;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+    }
+
+    long long LatencyHistogram::valueAtPercentile(double percentile) const
+    {
+        if (!_count)
+            return 0;
+
+        long long const target = std::max(1LL,
+            static_cast<long long>(std::ceil(std::min(percentile, 100.0) / 100.0 * _count)));
+        long long cumulative = 0;
+        for (int i = 0; i < BucketsCount; ++i) {
+            cumulative += _buckets[i];
+            if (cumulative >= target)
+                return std::min(bucketHighestValue(i), _max);
+        }
+        return _max;
+    }
+
+    QVariantMap LatencyHistogram::toVariant() const
+    {
+        QVariantMap map;
+        map.insert("count", _count);
+        map.insert("min", min());
+        map.insert("max", max());
+        map.insert("mean", mean());
+        map.insert("p50", valueAtPercentile(50));
+        map.insert("p90", valueAtPercentile(90));
+        map.insert("p95", valueAtPercentile(95));
+        map.insert("p99", valueAtPercentile(99));
+        map.insert("p999", valueAtPercentile(99.9));
+        return map;
+    }
+
+    void WorkerMetrics::record(const std::string &requestType, long long enqueuedNs, long long startNs,
+                               long long endNs, long long payloadBytes, bool isError)
+    {
+        QMutexLocker lock(&_mutex);
+        HandlerMetrics &metrics = _handlers[requestType];
+        metrics.queueWait.record((startNs - enqueuedNs) / 1000);
+        metrics.service.record((endNs - startNs) / 1000);
+        metrics.total.record((endNs - enqueuedNs) / 1000);
+        metrics.payloadBytes += payloadBytes;
+        if (isError)
+            ++metrics.errors;
+    }
+
+    WorkerMetrics::HandlersContainerType WorkerMetrics::snapshot() const
+    {
+        QMutexLocker lock(&_mutex);
+        return _handlers;
+    }
+
+    void WorkerMetrics::reset()
+    {
+        QMutexLocker lock(&_mutex);
+        _handlers.clear();
+    }
+
+    std::shared_ptr<WorkerMetrics> WorkerMetricsRegistry::cluster(const std::string &name)
+    {
+        QMutexLocker lock(&_mutex);
+        std::shared_ptr<WorkerMetrics> &metrics = _clusters[name];
+        if (!metrics)
+            metrics = std::make_shared<WorkerMetrics>();
+        return metrics;
+    }
+
+    WorkerMetricsRegistry::ClustersContainerType WorkerMetricsRegistry::clusters() const
+    {
+        QMutexLocker lock(&_mutex);
+        return _clusters;
+    }
+
+    void WorkerMetricsRegistry::reset()
+    {
+        QMutexLocker lock(&_mutex);
+        for (auto const& cluster : _clusters)
+            cluster.second->reset();
+    }
+
+    QByteArray WorkerMetricsRegistry::toJson() const
+    {
+        QVariantMap clustersMap;
+        for (auto const& cluster : clusters()) {
+            QVariantMap handlersMap;
+            for (auto const& handler : cluster.second->snapshot()) {
+                HandlerMetrics const& metrics = handler.second;
+                QVariantMap map;
+                map.insert("count", metrics.total.count());
+                map.insert("errors", metrics.errors);
+                map.insert("payloadBytes", metrics.payloadBytes);
+                map.insert("queueWaitUs", metrics.queueWait.toVariant());
+                map.insert("serviceUs", metrics.service.toVariant());
+                map.insert("totalUs", metrics.total.toVariant());
+                handlersMap.insert(QtUtils::toQString(handler.first), map);
+            }
+            clustersMap.insert(QtUtils::toQString(cluster.first), handlersMap);
+        }
+
+        QVariantMap root;
+        root.insert("exportedAt", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+        root.insert("clusters", clustersMap);
+        return QJsonDocument::fromVariant(root).toJson();
+    }
+}
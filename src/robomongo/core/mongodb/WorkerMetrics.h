@@ -0,0 +1,117 @@
+#pragma once
+
+#include <QMutex>
+#include <QVariant>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "robomongo/core/utils/SingletonPattern.hpp"
+
+namespace Robomongo
+{
+    /**
+     * @brief HDR-style latency histogram with log-linear buckets.
+     *        Values (microseconds) are recorded with ~6% relative precision,
+     *        memory use is constant regardless of number of recorded values.
+     */
+    class LatencyHistogram
+    {
+    public:
+        LatencyHistogram();
+
+        void record(long long valueUs);
+        void merge(const LatencyHistogram &other);
+
+        long long count() const { return _count; }
+        long long min() const { return _count ? _min : 0; }
+        long long max() const { return _max; }
+        double mean() const { return _count ? static_cast<double>(_sum) / _count : 0; }
+
+        /**
+         * @brief Value (in microseconds) below which 'percentile' percent of values fall
+         * @param percentile: 0..100
+         */
+        long long valueAtPercentile(double percentile) const;
+
+        /**
+         * @brief { count, min, max, mean, p50, p90, p95, p99, p999 }
+         */
+        QVariantMap toVariant() const;
+
+    private:
+        static int bucketIndex(long long value);
+        static long long bucketHighestValue(int index);
+
+        std::vector<long long> _buckets;
+        long long _count;
+        long long _sum;
+        long long _min;
+        long long _max;
+    };
+
+    /**
+     * @brief Metrics of single request type (i.e. "ExecuteQueryRequest") handled by MongoWorker
+     */
+    struct HandlerMetrics
+    {
+        HandlerMetrics() : errors(0), payloadBytes(0) {}
+
+        LatencyHistogram queueWait;     // from sending request to start of handler
+        LatencyHistogram service;       // execution of handler (network + server + worker)
+        LatencyHistogram total;         // from sending request to end of handler
+        long long errors;               // handlers which replied with error event
+        long long payloadBytes;         // sum of request and reply payloads
+    };
+
+    /**
+     * @brief Per-request-type handler metrics of all MongoWorkers of one cluster.
+     *        Thread safe: written from worker threads, read from GUI thread.
+     */
+    class WorkerMetrics
+    {
+    public:
+        typedef std::map<std::string, HandlerMetrics> HandlersContainerType;
+
+        void record(const std::string &requestType, long long enqueuedNs, long long startNs, long long endNs,
+                    long long payloadBytes, bool isError);
+
+        HandlersContainerType snapshot() const;
+        void reset();
+
+    private:
+        mutable QMutex _mutex;
+        HandlersContainerType _handlers;
+    };
+
+    /**
+     * @brief Registry of WorkerMetrics, one per cluster (connection address)
+     */
+    class WorkerMetricsRegistry : public Patterns::LazySingleton<WorkerMetricsRegistry>
+    {
+        friend class Patterns::LazySingleton<WorkerMetricsRegistry>;
+
+    public:
+        typedef std::map<std::string, std::shared_ptr<WorkerMetrics>> ClustersContainerType;
+
+        /**
+         * @brief Returns metrics of cluster, creates them if needed
+         */
+        std::shared_ptr<WorkerMetrics> cluster(const std::string &name);
+        ClustersContainerType clusters() const;
+        void reset();
+
+        /**
+         * @brief Export all metrics as JSON document:
+         *        { "clusters": { "<name>": { "<request type>": { "count": ..., "queueWaitUs": {...} ... } } } }
+         */
+        QByteArray toJson() const;
+
+    private:
+        WorkerMetricsRegistry() {}
+
+        mutable QMutex _mutex;
+        ClustersContainerType _clusters;
+    };
+}
@@ -23,8 +23,10 @@
 #include <parser.h>
 #include <serializer.h>
 
+#include "robomongo/core/domain/MetadataCache.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/CredentialSettings.h"
+#include "robomongo/core/settings/SettingsWriter.h"
 #include "robomongo/core/settings/SshSettings.h"
 #include "robomongo/core/settings/SslSettings.h"
 #include "robomongo/core/utils/Logger.h"
@@ -106,10 +108,14 @@ namespace Robomongo
         _textFontPointSize(-1),
         _mongoTimeoutSec(10),
         _shellTimeoutSec(15),
-        _imported(false)
+        _slowQueryExplainMs(1000),
+        _syntaxHighlightingLimitKb(4096),
+        _logLevel("debug"),
+        _imported(false),
+        _writer(new SettingsWriter(ConfigFilePath, [this]() { return convertToMap(); }))
     {
         if (!load()) {  // if load fails (probably due to non-existing config. file or directory)
-            save();     // create empty settings file
+            SettingsWriter::write(ConfigFilePath, convertToMap());  // create empty settings file
             load();     // try loading again for the purpose of import from previous Robomongo versions
         }
 
@@ -118,6 +124,8 @@ namespace Robomongo
 
     SettingsManager::~SettingsManager()
     {
+        // Scheduled save needs connections
+        _writer->flush();
         std::for_each(_connections.begin(), _connections.end(), stdutils::default_delete<ConnectionSettings *>());
     }
 
@@ -146,32 +154,16 @@ namespace Robomongo
     }
 
     /**
-     * Saves all settings to config file.
-     * @return true if success, false otherwise
+     * Schedules saving of all settings to config file.
      */
-    bool SettingsManager::save()
+    void SettingsManager::save()
     {
-        QVariantMap map = convertToMap();
-
-        if (!QDir().mkpath(ConfigDir)) {
-            LOG_MSG("ERROR: Could not create settings path: " + ConfigDir, mongo::logger::LogSeverity::Error());
-            return false;
-        }
-
-        QFile f(ConfigFilePath);
-        if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
-            LOG_MSG("ERROR: Could not write settings to: " + ConfigFilePath, mongo::logger::LogSeverity::Error());
-            return false;
-        }
-
-        bool ok;
-        QJson::Serializer s;
-        s.setIndentMode(QJson::IndentFull);
-        s.serialize(map, &f, &ok);
-
-        LOG_MSG("Settings saved to: " + ConfigFilePath, mongo::logger::LogSeverity::Info());
+        _writer->schedule();
+    }
 
-        return ok;
+    bool SettingsManager::flush()
+    {
+        return _writer->flush();
     }
 
     void SettingsManager::addCacheData(QString const& key, QVariant const& value)
@@ -251,6 +243,9 @@ namespace Robomongo
         if (map.contains("checkForUpdates"))
             _checkForUpdates = map.value("checkForUpdates").toBool();
 
+        if (map.contains("checkConcurrentEdits"))
+            _checkConcurrentEdits = map.value("checkConcurrentEdits").toBool();
+
         _currentStyle = map.value("style").toString();
         if (_currentStyle.isEmpty()) {
             _currentStyle = AppStyle::StyleName;
@@ -268,6 +263,18 @@ namespace Robomongo
             _shellTimeoutSec = map.value("shellTimeoutSec").toInt();
         }
 
+        if (map.contains("slowQueryExplainMs")) {
+            setSlowQueryExplainMs(map.value("slowQueryExplainMs").toInt());
+        }
+
+        if (map.contains("syntaxHighlightingLimitKb")) {
+            setSyntaxHighlightingLimitKb(map.value("syntaxHighlightingLimitKb").toInt());
+        }
+
+        if (map.contains("logLevel")) {
+            setLogLevel(map.value("logLevel").toString());
+        }
+
         // 5. Load connections
         _connections.clear();
 
@@ -355,8 +362,12 @@ namespace Robomongo
         // 9. Save batchSize
         map.insert("batchSize", _batchSize);
         map.insert("checkForUpdates", _checkForUpdates);
+        map.insert("checkConcurrentEdits", _checkConcurrentEdits);
         map.insert("mongoTimeoutSec", _mongoTimeoutSec);
         map.insert("shellTimeoutSec", _shellTimeoutSec);
+        map.insert("slowQueryExplainMs", _slowQueryExplainMs);
+        map.insert("syntaxHighlightingLimitKb", _syntaxHighlightingLimitKb);
+        map.insert("logLevel", _logLevel);
 
         // 10. Save style
         map.insert("style", _currentStyle);
@@ -457,6 +468,7 @@ namespace Robomongo
         ConnectionSettingsContainerType::iterator it = std::find(_connections.begin(), _connections.end(), connection);
         if (it != _connections.end()) {
             _connections.erase(it);
+            MetadataCache::remove(connection->uuid());
             delete connection;
         }
     }
@@ -519,6 +531,23 @@ namespace Robomongo
         _textFontPointSize = pointSize > 0 ? pointSize : -1;
     }
 
+    void SettingsManager::setLogLevel(const QString &level)
+    {
+        QString const name = level.toLower();
+        mongo::logger::LogSeverity severity = mongo::logger::LogSeverity::Log();
+        if (name == "error")
+            severity = mongo::logger::LogSeverity::Error();
+        else if (name == "warning")
+            severity = mongo::logger::LogSeverity::Warning();
+        else if (name == "info")
+            severity = mongo::logger::LogSeverity::Info();
+        else if (name != "debug")
+            return;
+
+        _logLevel = name;
+        Logger::instance().setThreshold(severity);
+    }
+
     void SettingsManager::reorderConnections(const ConnectionSettingsContainerType &connections)
     {
         _connections = connections;
@@ -5,6 +5,8 @@
 #include <QSet>
 #include <QDir>
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 #include <cstdlib>
 
@@ -13,6 +15,7 @@
 namespace Robomongo
 {
     class ConnectionSettings;
+    class SettingsWriter;
     struct ConfigFileAndImportFunction;
         
     // Current cache directory
@@ -79,10 +82,16 @@ namespace Robomongo
         bool load();
 
         /**
-         * @brief Saves all settings to config file.
-         * @return true if success, false otherwise
+         * @brief Saves all settings to config file. Saves are coalesced and written on
+         *        background thread after SettingsWriter::saveDelayMs.
          */
-        bool save();
+        void save();
+
+        /**
+         * @brief Writes scheduled save now, i.e. before application exits.
+         * @return true if success or nothing to save, false otherwise
+         */
+        bool flush();
 
         /**
          * @brief Adds connection to the end of list.
@@ -164,6 +173,13 @@ namespace Robomongo
         void setCheckForUpdates(bool checkForUpdates) { _checkForUpdates = checkForUpdates; }
         bool checkForUpdates() const { return _checkForUpdates; }
 
+        /**
+         * @brief Edited document is updated only if its changed fields still have the
+         *        original values, concurrent changes of these fields are not overwritten.
+         */
+        void setCheckConcurrentEdits(bool check) { _checkConcurrentEdits = check; }
+        bool checkConcurrentEdits() const { return _checkConcurrentEdits; }
+
         void setBatchSize(int batchSize) { _batchSize = batchSize; }
         int batchSize() const { return _batchSize; }
 
@@ -181,6 +197,27 @@ namespace Robomongo
 
         void setShellTimeoutSec(int newValue) { _shellTimeoutSec = std::abs(newValue); }
 
+        /**
+         * @brief Queries of result views running at least this long are explained
+         *        automatically (plan badge of result), 0 disables explain.
+         */
+        int slowQueryExplainMs() const { return _slowQueryExplainMs; }
+        void setSlowQueryExplainMs(int ms) { _slowQueryExplainMs = std::max(ms, 0); }
+
+        /**
+         * @brief Larger text of editors is shown as plain text without syntax highlighting,
+         *        0 disables the limit.
+         */
+        int syntaxHighlightingLimitKb() const { return _syntaxHighlightingLimitKb; }
+        void setSyntaxHighlightingLimitKb(int kb) { _syntaxHighlightingLimitKb = std::max(kb, 0); }
+
+        /**
+         * @brief Least severe messages which are logged: "error", "warning", "info" or "debug".
+         *        Less severe messages are dropped by Logger before they are formatted.
+         */
+        QString logLevel() const { return _logLevel; }
+        void setLogLevel(const QString &level);
+
         // True when settings from previous versions of Robomongo are imported
         void setImported(bool imported) { _imported = imported; }
         bool imported() const { return _imported; }
@@ -239,15 +276,21 @@ namespace Robomongo
         QSet<QString> _acceptedEulaVersions;
         int _batchSize;
         bool _checkForUpdates = true;
+        bool _checkConcurrentEdits = true;
         QString _currentStyle;
         QString _textFontFamily;
         int _textFontPointSize;
 
         int _mongoTimeoutSec;
         int _shellTimeoutSec;
+        int _slowQueryExplainMs;
+        int _syntaxHighlightingLimitKb;
+        QString _logLevel;
 
         // True when settings from previous versions of Robomongo are imported
         bool _imported;
+
+        std::unique_ptr<SettingsWriter> const _writer;
         
         /**
         * @brief This is an anonymous string taken from QUuid that is generated when Robomongo 
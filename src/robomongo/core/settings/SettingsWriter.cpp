@@ -0,0 +1,124 @@
+#include "robomongo/core/settings/SettingsWriter.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTimer>
+
+#include <serializer.h>
+
+#include "robomongo/core/utils/Logger.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace Robomongo
+{
+    SettingsWriter::SettingsWriter(const QString &path, const std::function<QVariantMap()> &snapshot) :
+        _path(path), _snapshot(snapshot), _timer(new QTimer(this)), _stopping(false)
+    {
+        _timer->setSingleShot(true);
+        _timer->setInterval(saveDelayMs);
+        VERIFY(connect(_timer, SIGNAL(timeout()), this, SLOT(takeSnapshot())));
+
+        _thread = std::thread(&SettingsWriter::run, this);
+    }
+
+    SettingsWriter::~SettingsWriter()
+    {
+        flush();
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_one();
+        _thread.join();
+    }
+
+    void SettingsWriter::schedule()
+    {
+        // Delay is not restarted, so continuous changes are still saved every saveDelayMs
+        if (!_timer->isActive())
+            _timer->start();
+    }
+
+    bool SettingsWriter::flush()
+    {
+        std::unique_ptr<QVariantMap> map;
+        if (_timer->isActive()) {
+            _timer->stop();
+            map.reset(new QVariantMap(_snapshot()));
+        }
+
+        // Background write in progress finishes first, so it cannot overwrite newer settings
+        std::lock_guard<std::mutex> writeLock(_writeMutex);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!map)
+                map = std::move(_pending);
+            _pending.reset();
+        }
+
+        return map ? write(_path, *map) : true;
+    }
+
+    void SettingsWriter::takeSnapshot()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending.reset(new QVariantMap(_snapshot()));
+        }
+        _wake.notify_one();
+    }
+
+    void SettingsWriter::run()
+    {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [this]() { return _pending || _stopping; });
+                if (_stopping)
+                    return;
+            }
+
+            std::lock_guard<std::mutex> writeLock(_writeMutex);
+            std::unique_ptr<QVariantMap> map;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                map = std::move(_pending);
+            }
+
+            // Already written by flush()
+            if (map)
+                write(_path, *map);
+        }
+    }
+
+    bool SettingsWriter::write(const QString &path, const QVariantMap &map)
+    {
+        QString const dir = QFileInfo(path).absolutePath();
+        if (!QDir().mkpath(dir)) {
+            LOG_MSG("ERROR: Could not create settings path: " + dir, mongo::logger::LogSeverity::Error());
+            return false;
+        }
+
+        bool ok;
+        QJson::Serializer s;
+        s.setIndentMode(QJson::IndentFull);
+        QByteArray const json = s.serialize(map, &ok);
+        if (!ok) {
+            LOG_MSG("ERROR: Could not serialize settings: " + s.errorMessage(), mongo::logger::LogSeverity::Error());
+            return false;
+        }
+
+        // Written to temporary file in the same directory, which is renamed to 'path' by commit()
+        QSaveFile f(path);
+        if (!f.open(QIODevice::WriteOnly) || f.write(json) != json.size() || !f.commit()) {
+            LOG_MSG("ERROR: Could not write settings to: " + path + " (" + f.errorString() + ")",
+                    mongo::logger::LogSeverity::Error());
+            return false;
+        }
+
+        LOG_MSG("Settings saved to: " + path, mongo::logger::LogSeverity::Info());
+        return true;
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <QObject>
+#include <QString>
+#include <QVariantMap>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    /**
+     * @brief Writes config file of SettingsManager on background thread.
+     *
+     *        schedule() calls made within saveDelayMs are coalesced: settings are converted
+     *        to map once, on the thread of SettingsWriter (GUI), when delay elapses. The map is
+     *        serialized and written by background thread to temporary file which replaces
+     *        config file, so config file is never left half-written.
+     */
+    class SettingsWriter : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        enum { saveDelayMs = 500 };
+
+        /**
+         * @param snapshot: converts current settings to map, called on thread of SettingsWriter
+         */
+        SettingsWriter(const QString &path, const std::function<QVariantMap()> &snapshot);
+
+        /**
+         * @brief Writes pending settings and stops background thread
+         */
+        ~SettingsWriter();
+
+        /**
+         * @brief Save settings after delay, unless save is already scheduled
+         */
+        void schedule();
+
+        /**
+         * @brief Write scheduled settings now, on calling thread, and wait for background write.
+         *        Does nothing if nothing is scheduled.
+         * @return false if writing failed
+         */
+        bool flush();
+
+        /**
+         * @brief Serialize map as JSON to temporary file and rename it to 'path'
+         * @return true if success, false otherwise
+         */
+        static bool write(const QString &path, const QVariantMap &map);
+
+    private Q_SLOTS:
+        void takeSnapshot();
+
+    private:
+        void run();
+
+        QString const _path;
+        std::function<QVariantMap()> const _snapshot;
+        QTimer *_timer;
+
+        std::mutex _mutex;                      // guards _pending and _stopping
+        std::condition_variable _wake;
+        std::unique_ptr<QVariantMap> _pending;  // latest snapshot not yet written
+        bool _stopping;
+
+        std::mutex _writeMutex;                 // held while config file is written
+        std::thread _thread;
+    };
+}
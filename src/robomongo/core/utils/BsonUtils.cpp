@@ -615,8 +615,7 @@ namespace Robomongo
                 {
                     mongo::BinDataType binType = elem.binDataType();
                     if (binType == mongo::newUUID || binType == mongo::bdtUUID) {
-                        std::string uu = HexUtils::formatUuid(elem, uuid);
-                        con.append(uu);
+                        HexUtils::appendFormattedUuid(elem, uuid, con);
                         break;
                     }
                     con.append("<binary>");
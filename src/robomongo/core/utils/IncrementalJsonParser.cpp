@@ -0,0 +1,123 @@
+#include "robomongo/core/utils/IncrementalJsonParser.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "robomongo/shell/bson/json.h"
+
+namespace
+{
+    bool isBlank(mongo::StringData str)
+    {
+        for (size_t i = 0; i < str.size(); ++i) {
+            if (!std::isspace(static_cast<unsigned char>(str[i])))
+                return false;
+        }
+        return true;
+    }
+}
+
+namespace Robomongo
+{
+    size_t IncrementalJsonParser::parse(const std::string &text)
+    {
+        size_t const oldLength = _text.size();
+        size_t const newLength = text.size();
+        size_t const shorter = std::min(oldLength, newLength);
+
+        // Changed range is what is left between common prefix and common suffix
+        size_t const prefix = std::mismatch(_text.begin(), _text.begin() + shorter, text.begin()).first - _text.begin();
+        if (prefix == shorter && oldLength == newLength)
+            return 0;
+
+        size_t const suffix = std::mismatch(_text.rbegin(), _text.rbegin() + (shorter - prefix), text.rbegin()).first - _text.rbegin();
+        size_t const changedEnd = oldLength - suffix;
+
+        // Documents touching the changed range, including the ones which end right before it
+        // or begin right after it: the change may join them
+        auto const first = std::lower_bound(_documents.begin(), _documents.end(), prefix,
+            [](const Document &doc, size_t pos) { return doc.end < pos; });
+        auto next = std::upper_bound(first, _documents.end(), changedEnd,
+            [](size_t pos, const Document &doc) { return pos < doc.begin; });
+
+        // Documents are adjacent, only whitespace after the last one is not covered
+        size_t const rangeBegin = first == _documents.begin() ? 0 : (first - 1)->end;
+        size_t const rangeEnd = next == _documents.end() ? oldLength : next->begin;
+
+        // Unbalanced range changes how the rest of text is split, so it is parsed to the end
+        std::vector<Document> parsed;
+        if (!parseRange(text, rangeBegin, rangeEnd + newLength - oldLength, parsed) && next != _documents.end()) {
+            parsed.clear();
+            parseRange(text, rangeBegin, newLength, parsed);
+            next = _documents.end();
+        }
+
+        for (auto it = next; it != _documents.end(); ++it) {
+            it->begin = it->begin + newLength - oldLength;
+            it->end = it->end + newLength - oldLength;
+            it->errorOffset = it->errorOffset + newLength - oldLength;
+        }
+
+        auto const pos = _documents.erase(first, next);
+        _documents.insert(pos, parsed.begin(), parsed.end());
+        _text = text;
+        return parsed.size();
+    }
+
+    std::vector<mongo::BSONObj> IncrementalJsonParser::documents() const
+    {
+        std::vector<mongo::BSONObj> result;
+        result.reserve(_documents.size());
+        for (const Document &doc : _documents) {
+            if (!doc.valid)
+                return std::vector<mongo::BSONObj>();
+            result.push_back(doc.obj);
+        }
+        return result;
+    }
+
+    JsonErrors IncrementalJsonParser::errors() const
+    {
+        JsonErrors result;
+        for (const Document &doc : _documents) {
+            if (!doc.valid)
+                result.push_back({ doc.begin, doc.end, doc.errorOffset, doc.reason });
+        }
+        return result;
+    }
+
+    bool IncrementalJsonParser::parseRange(const std::string &text, size_t begin, size_t end, std::vector<Document> &out)
+    {
+        mongo::StringData const range(text.data() + begin, end - begin);
+        size_t complete = 0;
+        std::vector<mongo::StringData> slices = mongo::Robomongo::splitJsonDocuments(range, &complete);
+
+        // Rest which could not be split is parsed as one more document, unless it is whitespace
+        mongo::StringData const rest(range.rawData() + complete, range.size() - complete);
+        bool const balanced = isBlank(rest);
+        if (!balanced)
+            slices.push_back(rest);
+
+        for (const mongo::StringData &slice : slices) {
+            size_t const sliceBegin = slice.rawData() - text.data();
+            Document doc = { sliceBegin, sliceBegin + slice.size(), mongo::BSONObj(), true, 0, std::string() };
+
+            try {
+                int len = 0;
+                doc.obj = mongo::Robomongo::fromjson(slice.rawData(), slice.size(), &len);
+                if (static_cast<size_t>(len) != slice.size()) {
+                    doc.valid = false;
+                    doc.errorOffset = sliceBegin + len;
+                    doc.reason = "Unexpected characters after document";
+                }
+            } catch (const mongo::Robomongo::ParseMsgAssertionException &ex) {
+                doc.valid = false;
+                doc.errorOffset = sliceBegin + ex.offset();
+                doc.reason = ex.reason().empty() ? std::string(ex.what()) : ex.reason();
+            }
+
+            out.push_back(doc);
+        }
+        return balanced;
+    }
+}
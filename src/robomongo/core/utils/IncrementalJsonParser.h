@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Parse error of one document, offsets are relative to the whole text.
+     */
+    struct JsonError
+    {
+        size_t begin;           // range of document text
+        size_t end;
+        size_t offset;          // where parser stopped
+        std::string reason;
+    };
+
+    typedef std::vector<JsonError> JsonErrors;
+
+    /**
+     * @brief Parses concatenated JSON documents ("{a: 1} {b: 2}") of text which is edited
+     *        again and again, i.e. in DocumentTextEditor.
+     *
+     *        Text is split to documents by mongo::Robomongo::splitJsonDocuments() and every
+     *        document is parsed on its own, so every one of them gets its own error. When text
+     *        is parsed again, only documents which overlap range changed since previous text
+     *        (with their neighbours) are split and parsed again, the rest is only shifted.
+     *        Not thread-safe: used by one thread at a time.
+     */
+    class IncrementalJsonParser
+    {
+    public:
+        /**
+         * @return number of documents which were parsed again
+         */
+        size_t parse(const std::string &text);
+
+        /**
+         * @brief Parsed documents, empty if text has errors
+         */
+        std::vector<mongo::BSONObj> documents() const;
+
+        /**
+         * @brief Errors ordered by offset
+         */
+        JsonErrors errors() const;
+
+        size_t documentCount() const { return _documents.size(); }
+
+    private:
+        struct Document
+        {
+            size_t begin;       // with leading whitespace
+            size_t end;         // after closing brace
+            mongo::BSONObj obj;
+            bool valid;
+            size_t errorOffset;
+            std::string reason;
+        };
+
+        /**
+         * @brief Split and parse [begin, end) of 'text'
+         * @return false if range does not end with complete document or whitespace
+         */
+        static bool parseRange(const std::string &text, size_t begin, size_t end, std::vector<Document> &out);
+
+        std::string _text;
+        std::vector<Document> _documents;
+    };
+}
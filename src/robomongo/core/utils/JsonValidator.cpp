@@ -0,0 +1,89 @@
+#include "robomongo/core/utils/JsonValidator.h"
+
+#include <QMetaType>
+
+namespace Robomongo
+{
+    JsonValidator::JsonValidator(QObject *parent) : QObject(parent),
+        _pendingRevision(-1),
+        _submittedRevision(-1),
+        _parsedRevision(-1),
+        _stopping(false)
+    {
+        qRegisterMetaType<JsonErrors>("Robomongo::JsonErrors");
+        _thread = std::thread(&JsonValidator::run, this);
+    }
+
+    JsonValidator::~JsonValidator()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_one();
+        _done.notify_all();
+        _thread.join();
+    }
+
+    void JsonValidator::submit(std::string &&text, int revision)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending.reset(new std::string(std::move(text)));
+            _pendingRevision = revision;
+            _submittedRevision = revision;
+        }
+        _wake.notify_one();
+    }
+
+    std::vector<mongo::BSONObj> JsonValidator::wait(int revision, JsonErrors &errors)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (revision > _submittedRevision) {
+            errors = JsonErrors(1, JsonError{ 0, 0, 0, "Text was not submitted for validation" });
+            return std::vector<mongo::BSONObj>();
+        }
+
+        _done.wait(lock, [this, revision]() { return _parsedRevision >= revision || _stopping; });
+        if (_parsedRevision < revision) {
+            errors = JsonErrors(1, JsonError{ 0, 0, 0, "Validation was stopped" });
+            return std::vector<mongo::BSONObj>();
+        }
+
+        errors = _errors;
+        return _documents;
+    }
+
+    void JsonValidator::run()
+    {
+        // Used by this thread only, keeps documents of previous text
+        IncrementalJsonParser parser;
+
+        for (;;) {
+            std::unique_ptr<std::string> text;
+            int revision;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [this]() { return _pending || _stopping; });
+                if (_stopping)
+                    return;
+
+                text = std::move(_pending);
+                revision = _pendingRevision;
+            }
+
+            parser.parse(*text);
+            std::vector<mongo::BSONObj> documents = parser.documents();
+            JsonErrors const errors = parser.errors();
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _documents = std::move(documents);
+                _errors = errors;
+                _parsedRevision = revision;
+            }
+            _done.notify_all();
+
+            emit validated(revision, errors);
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <QObject>
+
+#include "robomongo/core/utils/IncrementalJsonParser.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Parses text of DocumentTextEditor on background thread with IncrementalJsonParser.
+     *
+     *        Every version of text has revision number. Only the latest submitted text is
+     *        parsed: texts submitted while parser is busy replace each other. Errors of every
+     *        parsed revision are reported by validated() signal (queued to the thread of validator).
+     */
+    class JsonValidator : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        explicit JsonValidator(QObject *parent = NULL);
+        ~JsonValidator();
+
+        /**
+         * @brief Parse 'text' on background thread
+         */
+        void submit(std::string &&text, int revision);
+
+        /**
+         * @brief Wait until 'revision' is parsed. Returns at once with error if 'revision' is
+         *        newer than the last submitted one, or validator is being destroyed.
+         * @return documents of revision, empty if text has errors
+         */
+        std::vector<mongo::BSONObj> wait(int revision, JsonErrors &errors);
+
+    Q_SIGNALS:
+        void validated(int revision, const Robomongo::JsonErrors &errors);
+
+    private:
+        void run();
+
+        std::mutex _mutex;                      // guards all fields below
+        std::condition_variable _wake;          // new text submitted, or stopping
+        std::condition_variable _done;          // revision parsed, or stopping
+        std::unique_ptr<std::string> _pending;
+        int _pendingRevision;
+        int _submittedRevision;                 // the last one passed to submit()
+        int _parsedRevision;
+        std::vector<mongo::BSONObj> _documents; // of _parsedRevision
+        JsonErrors _errors;
+        bool _stopping;
+
+        std::thread _thread;
+    };
+}
@@ -1,6 +1,9 @@
 #include "robomongo/core/utils/Logger.h"
 
+#include <chrono>
+#include <QDateTime>
 #include <QDir>
+#include <QFile>
 #include <QMetaType>
 
 #include "robomongo/core/utils/QtUtils.h"
@@ -9,55 +12,198 @@ namespace
 {
     std::string getLoggerPath()
     {
-        static std::string path = 
+        static std::string path =
             Robomongo::QtUtils::toStdString(QString("%1/" PROJECT_NAME_LOWERCASE ".log").arg(QDir::tempPath()));
 
         return path;
     }
+
+    // Make uniform log level strings e.g "Error: ", "Info: " etc...
+    QString severityPrefix(mongo::logger::LogSeverity level)
+    {
+        auto logLevelStr = QString::fromStdString(level.toStringData().toString());
+        if (!logLevelStr.isEmpty()) {
+            logLevelStr = logLevelStr.toLower();
+            logLevelStr[0] = logLevelStr[0].toUpper();
+            logLevelStr += ": ";
+        }
+        return logLevelStr;
+    }
+
+    /**
+     * @brief Log file which is renamed to backup when it grows over maximum size:
+     *        robomongo.log -> robomongo.log.1 -> robomongo.log.2 ...
+     *        Used by writer thread of Logger only.
+     */
+    class RotatingLogFile
+    {
+    public:
+        RotatingLogFile(const QString &path, qint64 maxSize, int maxBackups) :
+            _file(path), _size(0), _maxSize(maxSize), _maxBackups(maxBackups)
+        {
+            open();
+        }
+
+        void write(const QString &line)
+        {
+            QByteArray const bytes = (line + "\n").toUtf8();
+            if (_size > 0 && _size + bytes.size() > _maxSize)
+                rotate();
+
+            if (!_file.isOpen())
+                return;
+
+            _size += _file.write(bytes);
+        }
+
+        void flush()
+        {
+            if (_file.isOpen())
+                _file.flush();
+        }
+
+    private:
+        void open()
+        {
+            if (_file.open(QIODevice::WriteOnly | QIODevice::Append))
+                _size = _file.size();
+        }
+
+        QString backupName(int index) const
+        {
+            return QString("%1.%2").arg(_file.fileName()).arg(index);
+        }
+
+        void rotate()
+        {
+            _file.close();
+            QFile::remove(backupName(_maxBackups));
+            for (int i = _maxBackups - 1; i > 0; --i)
+                QFile::rename(backupName(i), backupName(i + 1));
+
+            QFile::rename(_file.fileName(), backupName(1));
+            _size = 0;
+            open();
+        }
+
+        QFile _file;
+        qint64 _size;
+        qint64 const _maxSize;
+        int const _maxBackups;
+    };
 }
 
 namespace Robomongo
 {
-    Logger::Logger()
+    Logger::Logger() :
+        _queue(queueCapacity),
+        _threshold(mongo::logger::LogSeverity::Log().toInt()),
+        _dropped(0),
+        _stopping(false)
     {
-        // v0.9
-        // qRegisterMetaType<mongo::logger::LogSeverity>("mongo::LogLevel");
-        std::string path = getLoggerPath();
-        QFile file(QtUtils::toQString(path)); //delete file if it size more than 5mb
-        if (file.exists() && file.size() > 5 * 1024 * 1024) {
-            file.remove();
-        }
-        // v0.9
-        // mongo::initLogging(path,true);
+        // Batches are delivered to log dock by queued connection
+        qRegisterMetaType<LogEntries>("Robomongo::LogEntries");
+        _writer = std::thread(&Logger::run, this);
     }
 
     Logger::~Logger()
-    {   
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_one();
+        _writer.join();
+    }
+
+    mongo::logger::LogSeverity Logger::threshold() const
+    {
+        return mongo::logger::LogSeverity::cast(_threshold.load(std::memory_order_relaxed));
+    }
+
+    void Logger::setThreshold(mongo::logger::LogSeverity level)
+    {
+        _threshold.store(level.toInt(), std::memory_order_relaxed);
     }
 
     void Logger::print(const char *mess, mongo::logger::LogSeverity level, bool notify)
     {
-        print(std::string(mess), level, notify);
+        if (isEnabled(level))
+            enqueue(std::string(mess), level, notify);
     }
 
     void Logger::print(const std::string &mess, mongo::logger::LogSeverity level, bool notify)
-    {       
-        print(QtUtils::toQString(mess), level, notify);
+    {
+        if (isEnabled(level))
+            enqueue(std::string(mess), level, notify);
     }
 
     void Logger::print(const QString &mess, mongo::logger::LogSeverity level, bool notify)
     {
-        // v0.9
-//        LOG(level) << "[" PROJECT_NAME_TITLE "] " << QtUtils::toStdString(mess) << std::endl;
-        if (notify) {
-            // Make uniform log level strings e.g "Error: ", "Info: " etc...
-            auto logLevelStr = QString::fromStdString(level.toStringData().toString());
-            if (!logLevelStr.isEmpty()) {
-                logLevelStr = logLevelStr.toLower();
-                logLevelStr[0] = logLevelStr[0].toUpper();
-                logLevelStr += ": ";
+        if (isEnabled(level))
+            enqueue(QtUtils::toStdString(mess), level, notify);
+    }
+
+    void Logger::enqueue(std::string &&mess, mongo::logger::LogSeverity level, bool notify)
+    {
+        Record record = { std::move(mess), level.toInt(), QDateTime::currentMSecsSinceEpoch(), notify };
+        if (!_queue.tryPush(std::move(record)))
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Logger::run()
+    {
+        RotatingLogFile file(QtUtils::toQString(getLoggerPath()), maxFileSize, maxBackupFiles);
+        Record record;
+        LogEntries batch;
+        long long notShown = 0;
+
+        for (bool stopping = false; !stopping; ) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait_for(lock, std::chrono::milliseconds(flushIntervalMs), [this]() { return _stopping.load(); });
+                stopping = _stopping;
             }
-            emit printed(logLevelStr + mess, level);
+
+            // Producers may keep the queue non-empty, one lap of it is written per flush
+            for (int i = 0; i < queueCapacity && _queue.tryPop(record); ++i) {
+                mongo::logger::LogSeverity const level = mongo::logger::LogSeverity::cast(record.severity);
+                QString const message = severityPrefix(level) + QtUtils::toQString(record.message);
+                file.write(QDateTime::fromMSecsSinceEpoch(record.timeMs).toString("yyyy-MM-dd hh:mm:ss.zzz ") + message);
+
+                if (!record.notify)
+                    continue;
+
+                if (batch.size() < maxBatchSize)
+                    batch.push_back({ message, record.severity, record.timeMs });
+                else
+                    ++notShown;
+            }
+
+            qint64 const now = QDateTime::currentMSecsSinceEpoch();
+            mongo::logger::LogSeverity const warning = mongo::logger::LogSeverity::Warning();
+
+            long long const dropped = _dropped.exchange(0);
+            if (dropped > 0) {
+                QString const message = severityPrefix(warning) +
+                    QString("%1 log messages were dropped, logging is too frequent").arg(dropped);
+                file.write(QDateTime::fromMSecsSinceEpoch(now).toString("yyyy-MM-dd hh:mm:ss.zzz ") + message);
+                batch.push_back({ message, warning.toInt(), now });
+            }
+
+            if (notShown > 0) {
+                batch.push_back({ severityPrefix(warning) + QString("%1 more log messages are written to %2 only")
+                                  .arg(notShown).arg(QtUtils::toQString(getLoggerPath())), warning.toInt(), now });
+                notShown = 0;
+            }
+
+            file.flush();
+
+            // Log dock may be already destroyed when application exits
+            if (!batch.empty() && !stopping)
+                emit printed(batch);
+
+            batch.clear();
         }
     }
 }
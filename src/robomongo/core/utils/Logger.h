@@ -3,35 +3,93 @@
 
 // #define MONGO_LOG_DEFAULT_COMPONENT ::mongo::logger::LogComponent::kStorage
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <QObject>
 #include <QString>
 #include <string>
 #include <mongo/logger/log_severity.h>
+#include "robomongo/core/utils/MpscQueue.h"
 #include "robomongo/core/utils/SingletonPattern.hpp"
 
 namespace Robomongo
-{  
+{
+    /**
+     * @brief Message of log dock, severity prefix is already added to text.
+     */
+    struct LogEntry
+    {
+        QString message;
+        int severity;       // mongo::logger::LogSeverity::toInt()
+        qint64 timeMs;
+    };
+
+    typedef std::vector<LogEntry> LogEntries;
+
+    /**
+     * @brief Messages are queued without locks by any thread and written by background thread
+     *        to rotating file in temp directory. Messages with 'notify' flag are delivered to log
+     *        dock in batches, at most one batch per flush interval. Messages less severe than
+     *        threshold are dropped before they are converted or queued.
+     */
     class Logger : public QObject, public Patterns::LazySingleton<Logger>
     {
         Q_OBJECT
         friend class Patterns::LazySingleton<Logger>;
 
     public:
+        enum { queueCapacity = 8192 };          // messages above it are dropped and counted
+        enum { flushIntervalMs = 200 };
+        enum { maxBatchSize = 200 };            // messages above it are only written to file
+        enum { maxFileSize = 5 * 1024 * 1024 };
+        enum { maxBackupFiles = 3 };            // robomongo.log.1 ... robomongo.log.3
+
+        bool isEnabled(mongo::logger::LogSeverity level) const {
+            return level.toInt() <= _threshold.load(std::memory_order_relaxed);
+        }
+
+        mongo::logger::LogSeverity threshold() const;
+        void setThreshold(mongo::logger::LogSeverity level);
+
         void print(const char *mess, mongo::logger::LogSeverity level, bool notify);
         void print(const std::string &mess, mongo::logger::LogSeverity level, bool notify);
         void print(const QString &mess, mongo::logger::LogSeverity level, bool notify);
 
     Q_SIGNALS:
-        void printed(const QString &mess, mongo::logger::LogSeverity level);
+        void printed(const Robomongo::LogEntries &entries);
 
     private:
+        struct Record
+        {
+            std::string message;
+            int severity;
+            qint64 timeMs;
+            bool notify;
+        };
+
         Logger();
         ~Logger();
+
+        void enqueue(std::string &&mess, mongo::logger::LogSeverity level, bool notify);
+        void run();
+
+        MpscQueue<Record> _queue;
+        std::atomic<int> _threshold;
+        std::atomic<long long> _dropped;
+        std::atomic<bool> _stopping;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::thread _writer;
     };
 
     template<typename T>
     inline void LOG_MSG(const T &mess, mongo::logger::LogSeverity level, bool notify = true)
     {
-        return Logger::instance().print(mess, level, notify);
+        Logger &logger = Logger::instance();
+        if (logger.isEnabled(level))
+            logger.print(mess, level, notify);
     }
 }
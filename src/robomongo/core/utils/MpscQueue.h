@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+namespace Robomongo
+{
+    /**
+     * @brief Bounded lock-free queue for many producer threads and one consumer thread.
+     *        Storage is allocated once, tryPush() fails instead of blocking when queue is full.
+     *
+     *        Every cell carries sequence number which tells whether it is free for position
+     *        being pushed or holds value for position being popped (D. Vyukov's bounded queue).
+     */
+    template <typename T>
+    class MpscQueue
+    {
+    public:
+        /**
+         * @param capacity: rounded up to power of two
+         */
+        explicit MpscQueue(size_t capacity) :
+            _mask(roundUpToPowerOfTwo(capacity) - 1),
+            _cells(new Cell[_mask + 1]),
+            _pushPos(0),
+            _popPos(0)
+        {
+            for (size_t i = 0; i <= _mask; ++i)
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Called by any thread. Returns false if queue is full.
+         */
+        bool tryPush(T &&value)
+        {
+            size_t pos = _pushPos.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell &cell = _cells[pos & _mask];
+                size_t const sequence = cell.sequence.load(std::memory_order_acquire);
+                auto const diff = static_cast<std::ptrdiff_t>(sequence - pos);
+                if (diff == 0) {
+                    if (_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        cell.value = std::move(value);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0) {
+                    return false;   // cell still holds value pushed one lap ago
+                }
+                else {
+                    pos = _pushPos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Called by consumer thread only. Returns false if queue is empty.
+         */
+        bool tryPop(T &value)
+        {
+            Cell &cell = _cells[_popPos & _mask];
+            if (cell.sequence.load(std::memory_order_acquire) != _popPos + 1)
+                return false;
+
+            value = std::move(cell.value);
+            cell.sequence.store(_popPos + _mask + 1, std::memory_order_release);
+            ++_popPos;
+            return true;
+        }
+
+        size_t capacity() const { return _mask + 1; }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        static size_t roundUpToPowerOfTwo(size_t value)
+        {
+            assert(value > 0);
+            size_t result = 1;
+            while (result < value)
+                result <<= 1;
+            return result;
+        }
+
+        MpscQueue(const MpscQueue &);
+        MpscQueue &operator=(const MpscQueue &);
+
+        size_t const _mask;
+        std::unique_ptr<Cell[]> _cells;
+
+        // Producers and consumer update their positions on separate cache lines
+        char _padding1[64];
+        std::atomic<size_t> _pushPos;
+        char _padding2[64];
+        size_t _popPos;
+    };
+}
@@ -1,5 +1,6 @@
 #include "robomongo/core/utils/QtUtils.h"
 
+#include <unordered_set>
 #include <QThread>
 #include <QTreeWidgetItem>
 
@@ -53,5 +54,47 @@ namespace Robomongo
                 delete item;
             }
         }
+
+        void syncChildItems(QTreeWidgetItem *const root, int first, const std::vector<QTreeWidgetItem *> &items)
+        {
+            std::unordered_set<QTreeWidgetItem *> const keep(items.begin(), items.end());
+            for (int i = root->childCount() - 1; i >= first; --i) {
+                if (!keep.count(root->child(i)))
+                    delete root->takeChild(i);
+            }
+
+            int const count = static_cast<int>(items.size());
+            for (int i = 0; i < count; ++i) {
+                QTreeWidgetItem *const item = items[i];
+                if (root->child(first + i) == item)
+                    continue;
+
+                // Run of new items is inserted at once, so the view is updated once per run
+                if (!item->parent()) {
+                    QList<QTreeWidgetItem *> run;
+                    for (int j = i; j < count && !items[j]->parent(); ++j)
+                        run.append(items[j]);
+                    root->insertChildren(first + i, run);
+                    i += run.size() - 1;
+                    continue;
+                }
+
+                if (item->parent() == root)
+                    root->takeChild(root->indexOfChild(item));
+                root->insertChild(first + i, item);
+            }
+        }
+
+        QString sizeString(double bytes)
+        {
+            const char *const units[] = { "bytes", "KB", "MB", "GB", "TB" };
+            int unit = 0;
+            while (bytes >= 1024 && unit < 4) {
+                bytes /= 1024;
+                ++unit;
+            }
+            return unit == 0 ? QString("%1 %2").arg(bytes, 0, 'f', 0).arg(units[unit])
+                             : QString("%1 %2").arg(bytes, 0, 'f', 1).arg(units[unit]);
+        }
     }
 }
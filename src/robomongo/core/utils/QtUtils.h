@@ -1,6 +1,7 @@
 #pragma once
 #include <QString>
 #include <QModelIndex>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 class QThread;
@@ -29,6 +30,19 @@ namespace Robomongo
 
         void clearChildItems(QTreeWidgetItem *root);
 
+        /**
+         * @brief Make 'items' the children of 'root' from index 'first' on, in given order.
+         *        Other children from 'first' on are deleted, kept ones are moved only if their
+         *        position changed (so their expanded state and subtrees survive refresh).
+         *        New items should be passed without parent: consecutive ones are inserted at once.
+         */
+        void syncChildItems(QTreeWidgetItem *root, int first, const std::vector<QTreeWidgetItem *> &items);
+
+        /**
+         * @brief Human readable size, i.e. "512 bytes", "1.5 KB", "23.0 GB".
+         */
+        QString sizeString(double bytes);
+
         template<typename Type>
         inline Type item(const QModelIndex &index)
         {
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cassert>
+#include <vector>
+
+namespace Robomongo
+{
+    /**
+     * @brief Fixed-capacity FIFO: when full, push() overwrites the oldest item.
+     *        Storage is allocated once, items are indexed from the oldest (0) to the newest.
+     */
+    template <typename T>
+    class RingBuffer
+    {
+    public:
+        explicit RingBuffer(size_t capacity) :
+            _items(capacity), _first(0), _size(0)
+        {
+            assert(capacity > 0);
+        }
+
+        void push(const T &item)
+        {
+            _items[(_first + _size) % _items.size()] = item;
+            if (_size < _items.size())
+                ++_size;
+            else
+                _first = (_first + 1) % _items.size();
+        }
+
+        void clear()
+        {
+            _first = 0;
+            _size = 0;
+        }
+
+        const T &operator[](size_t index) const { return _items[(_first + index) % _items.size()]; }
+        const T &back() const { return (*this)[_size - 1]; }
+
+        size_t size() const { return _size; }
+        size_t capacity() const { return _items.size(); }
+        bool empty() const { return _size == 0; }
+
+    private:
+        std::vector<T> _items;
+        size_t _first;      // index of the oldest item in _items
+        size_t _size;
+    };
+}
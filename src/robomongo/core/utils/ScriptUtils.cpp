@@ -0,0 +1,111 @@
+#include "robomongo/core/utils/ScriptUtils.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // Functions and methods known to only read: shell and cursor helpers, constructors of BSON
+    // types and common JavaScript built-ins. Keywords followed by parenthesis are listed too.
+    // Sorted for binary search.
+    const char *const readOnlyCalls[] = {
+        "Array", "BinData", "Boolean", "Date", "ISODate", "JSON", "Number", "NumberDecimal", "NumberInt",
+        "NumberLong", "Object", "ObjectId", "RegExp", "String", "Timestamp", "UUID", "abs", "aggregate",
+        "allowDiskUse", "batchSize", "catch", "ceil", "close", "collation", "comment", "concat", "conf",
+        "count", "countDocuments", "dataSize", "distinct", "estimatedDocumentCount", "explain", "filter",
+        "find", "findOne", "floor", "for", "forEach", "function", "getCollection", "getCollectionInfos",
+        "getCollectionNames", "getDB", "getFullName", "getIndexKeys", "getIndexes", "getIndices", "getMongo",
+        "getName", "getProfilingLevel", "getProfilingStatus", "getReplicationInfo", "getSiblingDB", "getTime",
+        "getTimestamp", "hasNext", "hello", "help", "hint", "hostInfo", "if", "indexOf", "isMaster", "itcount",
+        "join", "keys", "latencyStats", "limit", "map", "max", "maxTimeMS", "min", "next", "now",
+        "objsLeftInBatch", "parse", "pow", "pretty", "print", "printReplicationInfo",
+        "printSecondaryReplicationInfo", "printSlaveReplicationInfo", "printjson", "printjsononeline",
+        "projection", "push", "random", "readConcern", "readPref", "reduce", "return", "returnKey", "round",
+        "serverBuildInfo", "serverStatus", "showRecordId", "size", "skip", "slice", "sort", "split", "sqrt",
+        "stats", "status", "storageSize", "stringify", "substring", "switch", "toArray", "toISOString",
+        "toLowerCase", "toString", "toUpperCase", "tojson", "tojsononeline", "totalIndexSize", "totalSize",
+        "trim", "typeof", "valueOf", "version", "while"
+    };
+
+    // Aggregation stages which write, allowed 'aggregate' call does not make such pipeline read-only
+    const char *const writeStages[] = { "$merge", "$out" };
+
+    bool isIdentifierStart(char ch)
+    {
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_' || ch == '$';
+    }
+
+    bool isIdentifierPart(char ch)
+    {
+        return isIdentifierStart(ch) || (ch >= '0' && ch <= '9');
+    }
+
+    bool isSpace(char ch)
+    {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    bool isReadOnlyCall(const std::string &identifier)
+    {
+        return std::binary_search(std::begin(readOnlyCalls), std::end(readOnlyCalls), identifier.c_str(),
+            [](const char *left, const char *right) { return std::strcmp(left, right) < 0; });
+    }
+
+    bool isWriteStage(const std::string &identifier)
+    {
+        return std::find_if(std::begin(writeStages), std::end(writeStages),
+            [&identifier](const char *stage) { return identifier == stage; }) != std::end(writeStages);
+    }
+
+    // Whether character at 'pos', after optional whitespace, opens argument list of a call
+    bool isCallAt(const std::string &script, size_t pos)
+    {
+        while (pos < script.size() && isSpace(script[pos]))
+            ++pos;
+        return pos < script.size() && script[pos] == '(';
+    }
+}
+
+namespace Robomongo
+{
+    namespace ScriptUtils
+    {
+        bool isReadOnlyScript(const std::string &script)
+        {
+            size_t pos = 0;
+            while (pos < script.size()) {
+                char const ch = script[pos];
+                if (!isIdentifierStart(ch)) {
+                    // Call of expression result, i.e. "(function() {...})()" or "coll['insert'](doc)",
+                    // can not be checked
+                    if ((ch == ')' || ch == ']') && isCallAt(script, pos + 1))
+                        return false;
+
+                    // Number literal (i.e. "0x1F", "1e5") is skipped whole, it never starts identifier
+                    bool const isNumber = isIdentifierPart(ch);
+                    ++pos;
+                    while (isNumber && pos < script.size() && isIdentifierPart(script[pos]))
+                        ++pos;
+                    continue;
+                }
+
+                size_t const start = pos;
+                while (pos < script.size() && isIdentifierPart(script[pos]))
+                    ++pos;
+
+                std::string const identifier = script.substr(start, pos - start);
+                if (isWriteStage(identifier))
+                    return false;
+
+                if (isCallAt(script, pos) && !isReadOnlyCall(identifier))
+                    return false;
+            }
+            return true;
+        }
+
+        bool isNotMasterError(const std::string &errorMessage)
+        {
+            return errorMessage.find("not master") != std::string::npos;
+        }
+    }
+}
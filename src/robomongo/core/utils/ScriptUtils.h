@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+namespace Robomongo
+{
+    namespace ScriptUtils
+    {
+        /**
+         * @brief Whether shell script only reads and may run on a secondary.
+         *        Check is conservative: every function or method the script calls has to be a known
+         *        read-only one, and no identifier of it (including ones in strings) may name
+         *        a writing aggregation stage ("$out", "$merge"). Other scripts run on primary.
+         */
+        bool isReadOnlyScript(const std::string &script);
+
+        /**
+         * @brief Whether error message of shell or server says that member is not primary.
+         */
+        bool isNotMasterError(const std::string &errorMessage);
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace Robomongo
+{
+    /**
+     * @brief Disjoint ranges [begin, end) of positions in text. Ranges follow the text
+     *        they cover when text is inserted or removed before or inside of them.
+     */
+    class TextRangeSet
+    {
+    public:
+        typedef std::pair<int, int> Range;
+
+        /**
+         * @brief Add range, it is merged with overlapping and adjacent ranges
+         */
+        void add(int begin, int end)
+        {
+            if (begin >= end)
+                return;
+
+            auto it = _ranges.upper_bound(begin);
+            if (it != _ranges.begin() && std::prev(it)->second >= begin)
+                --it;
+
+            while (it != _ranges.end() && it->first <= end) {
+                begin = std::min(begin, it->first);
+                end = std::max(end, it->second);
+                it = _ranges.erase(it);
+            }
+            _ranges[begin] = end;
+        }
+
+        void remove(int begin, int end)
+        {
+            if (begin >= end)
+                return;
+
+            std::vector<Range> const parts = intersect(begin, end);
+            for (const Range &part : parts) {
+                auto const range = std::prev(_ranges.upper_bound(part.first));
+                int const rangeBegin = range->first;
+                int const rangeEnd = range->second;
+                _ranges.erase(range);
+                if (rangeBegin < part.first)
+                    _ranges[rangeBegin] = part.first;
+                if (part.second < rangeEnd)
+                    _ranges[part.second] = rangeEnd;
+            }
+        }
+
+        /**
+         * @brief Parts of ranges which are inside of [begin, end)
+         */
+        std::vector<Range> intersect(int begin, int end) const
+        {
+            std::vector<Range> parts;
+            auto it = _ranges.upper_bound(begin);
+            if (it != _ranges.begin())
+                --it;
+
+            for (; it != _ranges.end() && it->first < end; ++it) {
+                int const partBegin = std::max(begin, it->first);
+                int const partEnd = std::min(end, it->second);
+                if (partBegin < partEnd)
+                    parts.push_back(Range(partBegin, partEnd));
+            }
+            return parts;
+        }
+
+        /**
+         * @brief Text of 'length' is inserted at 'position': ranges after it are moved,
+         *        range which contains it grows
+         */
+        void inserted(int position, int length)
+        {
+            std::map<int, int> moved;
+            for (auto const &range : _ranges) {
+                int const begin = range.first >= position ? range.first + length : range.first;
+                int const end = range.second > position ? range.second + length : range.second;
+                moved[begin] = end;
+            }
+            _ranges.swap(moved);
+        }
+
+        /**
+         * @brief Text of 'length' is removed at 'position': ranges after it are moved,
+         *        ranges inside of it are dropped
+         */
+        void removed(int position, int length)
+        {
+            auto const move = [position, length](int value) {
+                return value >= position + length ? value - length : std::min(value, position);
+            };
+
+            std::map<int, int> const ranges = std::move(_ranges);
+            _ranges.clear();
+            for (auto const &range : ranges)
+                add(move(range.first), move(range.second));
+        }
+
+        const std::map<int, int> &ranges() const { return _ranges; }
+        bool empty() const { return _ranges.empty(); }
+        void clear() { _ranges.clear(); }
+
+    private:
+        std::map<int, int> _ranges;     // begin -> end
+    };
+}
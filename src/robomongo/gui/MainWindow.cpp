@@ -27,6 +27,8 @@
 #include <mongo/logger/log_severity.h>
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/settings/SshSettings.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/domain/MongoCollection.h"
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/domain/App.h"
 #include "robomongo/core/AppRegistry.h"
@@ -123,7 +125,7 @@ namespace Robomongo
         _connectionsMenu(nullptr), _connectButton(nullptr), _viewMenu(nullptr), _toolbarsMenu(nullptr), 
         _connectAction(nullptr), _openAction(nullptr), _saveAction(nullptr), _saveAsAction(nullptr),
         _executeAction(nullptr), _stopAction(nullptr), _orientationAction(nullptr), _execToolBar(nullptr),
-        //_exportAction(nullptr), _importAction(nullptr), // Temporarily disabling export/import feature
+        _exportAction(nullptr),
 #if defined(Q_OS_WIN)
         _trayIcon(nullptr),
 #endif
@@ -600,7 +602,6 @@ namespace Robomongo
         _toolbarsMenu->addAction(_execToolBar->toggleViewAction());
         VERIFY(connect(_execToolBar->toggleViewAction(), SIGNAL(triggered(bool)), this, SLOT(onExecToolbarVisibilityChanged(bool))));
 
-        /* --- Temporarily disabling export/import feature
         // Export/Import Toolbar
         auto expImpToolBar = new QToolBar(tr("Export/Import Toolbar"), this);
         expImpToolBar->setToolButtonStyle(Qt::ToolButtonIconOnly);
@@ -609,10 +610,13 @@ namespace Robomongo
         _exportAction = new QAction(this);
         _exportAction->setData("Export");
         _exportAction->setIcon(GuiRegistry::instance().exportIcon());
+        _exportAction->setToolTip("Export documents of the selected collection");
         _exportAction->setDisabled(true);
         VERIFY(connect(_exportAction, SIGNAL(triggered()), this, SLOT(openExportDialog())));
         addToolBar(expImpToolBar);
         expImpToolBar->addAction(_exportAction);
+
+        /* --- Temporarily disabling import feature
         // Add import action
         _importAction = new QAction(this);
         _importAction->setData("Import");
@@ -1035,17 +1039,19 @@ namespace Robomongo
         _workArea->openWelcomeTab();
     }
 
-    /* --- Temporarily disabling export/import feature
     void MainWindow::openExportDialog()
     {
         auto selectedItem = dynamic_cast<ExplorerCollectionTreeItem*>(_explorer->getSelectedTreeItem());
-        auto dbName = QString::fromStdString(selectedItem->collection()->database()->name());
-        auto collName = QString::fromStdString(selectedItem->collection()->name());
+        if (!selectedItem)
+            return;
+
+        auto collection = selectedItem->collection();
+        auto server = collection->database()->server();
 
-        auto dialog = new ExportDialog(dbName, collName, this);
-        dialog->show(); // show it mode-less so that user can perform multiple simultaneous exports
+        ExportDialog dialog(server->worker(), QtUtils::toQString(server->connectionRecord()->getFullAddress()),
+                            MongoNamespace(collection->database()->name(), collection->name()), this);
+        dialog.exec();
     }
-    */
 
     void MainWindow::setDefaultUuidEncoding()
     {
@@ -1280,7 +1286,7 @@ namespace Robomongo
         addDockWidget(Qt::LeftDockWidgetArea, explorerDock);
 
         LogWidget *log = new LogWidget(this);        
-        VERIFY(connect(&Logger::instance(), SIGNAL(printed(const QString&, mongo::logger::LogSeverity)), log, SLOT(addMessage(const QString&, mongo::logger::LogSeverity))));
+        VERIFY(connect(&Logger::instance(), SIGNAL(printed(const Robomongo::LogEntries&)), log, SLOT(addMessages(const Robomongo::LogEntries&))));
         _logDock = new QDockWidget(tr("Logs"));
         _logDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea | Qt::BottomDockWidgetArea | Qt::TopDockWidgetArea);
         _logDock->setWidget(log);
@@ -1361,7 +1367,6 @@ namespace Robomongo
         AppRegistry::instance().settingsManager()->save();
     }
 
-    /* --- Temporarily disabling export/import feature
     void MainWindow::onExplorerItemSelected(QTreeWidgetItem *selectedItem)
     {
         auto collectionItem = dynamic_cast<ExplorerCollectionTreeItem*>(selectedItem);
@@ -1372,7 +1377,6 @@ namespace Robomongo
             _exportAction->setDisabled(true);
         }
     }
-    */
 
     void MainWindow::on_tabChange()
     {
@@ -95,16 +95,14 @@ namespace Robomongo
         void openPreferences();
         void openWelcomeTab();
 
-        // Temporarily disabling export/import feature
-        //void openExportDialog();
+        void openExportDialog();
 
         void onConnectToolbarVisibilityChanged(bool isVisisble);
         void onOpenSaveToolbarVisibilityChanged(bool isVisisble);
         void onExecToolbarVisibilityChanged(bool isVisisble);
         void onExplorerVisibilityChanged(bool isVisisble);
 
-        // Temporarily disabling export/import feature
-        //void onExplorerItemSelected(QTreeWidgetItem *selectedItem);
+        void onExplorerItemSelected(QTreeWidgetItem *selectedItem);
 
         void on_tabChange();
 
@@ -160,12 +158,10 @@ namespace Robomongo
 
         QNetworkAccessManager *_networkAccessManager;
 
-        // Temporarily disabling export/import feature
-        /*
         // Export/import tool bar
         QAction *_exportAction;
-        QAction *_importAction;
-        */
+        // Temporarily disabling import feature
+        //QAction *_importAction;
 
 #if defined(Q_OS_WIN)
         QSystemTrayIcon *_trayIcon;
@@ -0,0 +1,365 @@
+#include "robomongo/gui/dialogs/CurrentOpDialog.h"
+
+#include <QCheckBox>
+#include <QDialogButtonBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSet>
+#include <QSpinBox>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/MonitorWorker.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    enum Column
+    {
+        HostColumn,
+        OpidColumn,
+        OperationColumn,
+        NamespaceColumn,
+        RunningColumn,
+        PlanSummaryColumn,
+        ClientColumn,
+        DescriptionColumn,
+        WaitingColumn
+    };
+
+    // Index of operation in CurrentOpDialog::_ops
+    int const OpIndexRole = Qt::UserRole + 1;
+
+    // Running time and opid are sorted by value kept in Qt::UserRole, not by displayed text
+    class OpItem : public QTreeWidgetItem
+    {
+    public:
+        virtual bool operator<(const QTreeWidgetItem &other) const
+        {
+            int const column = treeWidget() ? treeWidget()->sortColumn() : RunningColumn;
+            if (column == RunningColumn || column == OpidColumn) {
+                QVariant const value = data(column, Qt::UserRole), otherValue = other.data(column, Qt::UserRole);
+                if (value.isValid() && otherValue.isValid())
+                    return value.toLongLong() < otherValue.toLongLong();
+            }
+
+            return QString::compare(text(column), other.text(column), Qt::CaseInsensitive) < 0;
+        }
+    };
+
+    QString opKey(const Robomongo::CurrentOpInfo &op)
+    {
+        return Robomongo::QtUtils::toQString(op.host + '/' + op.opid);
+    }
+}
+
+namespace Robomongo
+{
+    CurrentOpDialog::CurrentOpDialog(MongoServer *server, const QString &filter, QWidget *parent) :
+        QDialog(parent),
+        _server(server),
+        _pendingRequests(0),
+        _loading(false),
+        _closeRequested(false),
+        _columnsFitted(false)
+    {
+        setWindowTitle(QString("Current Operations - %1")
+                       .arg(QtUtils::toQString(server->connectionRecord()->getFullAddress())));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+        resize(1100, 550);
+
+        _filter = new QLineEdit(filter);
+        _filter->setPlaceholderText("Filter by host, operation, namespace, plan, client or description");
+        VERIFY(connect(_filter, SIGNAL(textChanged(const QString &)), this, SLOT(applyFilter())));
+
+        _threshold = new QSpinBox;
+        _threshold->setRange(1, 24 * 60 * 60);
+        _threshold->setSuffix(" sec");
+        _threshold->setValue(defaultThresholdSec);
+        VERIFY(connect(_threshold, SIGNAL(valueChanged(int)), this, SLOT(applyHighlight())));
+
+        _autoRefresh = new QCheckBox("Refresh every:");
+        _autoRefresh->setChecked(true);
+        VERIFY(connect(_autoRefresh, SIGNAL(toggled(bool)), this, SLOT(toggleAutoRefresh(bool))));
+
+        _interval = new QSpinBox;
+        _interval->setRange(1, 60);
+        _interval->setSuffix(" sec");
+        _interval->setValue(defaultIntervalSec);
+        VERIFY(connect(_interval, SIGNAL(valueChanged(int)), this, SLOT(changeInterval(int))));
+
+        QHBoxLayout *topLayout = new QHBoxLayout;
+        topLayout->addWidget(_filter, 1);
+        topLayout->addSpacing(10);
+        topLayout->addWidget(new QLabel("Highlight over:"));
+        topLayout->addWidget(_threshold);
+        topLayout->addSpacing(10);
+        topLayout->addWidget(_autoRefresh);
+        topLayout->addWidget(_interval);
+
+        _tree = new QTreeWidget;
+        _tree->setRootIsDecorated(false);
+        _tree->setUniformRowHeights(true);
+        _tree->setSelectionMode(QAbstractItemView::ExtendedSelection);
+        _tree->setHeaderLabels(QStringList() << "Host" << "Opid" << "Operation" << "Namespace" << "Running"
+                               << "Plan Summary" << "Client" << "Description" << "Waiting for Lock");
+        _tree->header()->setStretchLastSection(false);
+        _tree->setSortingEnabled(true);
+        _tree->sortByColumn(RunningColumn, Qt::DescendingOrder);
+        VERIFY(connect(_tree, SIGNAL(itemSelectionChanged()), this, SLOT(updateButtons())));
+
+        _status = new QLabel("Loading...");
+
+        auto buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        _killButton = buttonBox->addButton("&Kill", QDialogButtonBox::ActionRole);
+        _killButton->setToolTip("Kill selected operations");
+        _refreshButton = buttonBox->addButton("&Refresh", QDialogButtonBox::ActionRole);
+        VERIFY(connect(_killButton, SIGNAL(clicked()), this, SLOT(killSelected())));
+        VERIFY(connect(_refreshButton, SIGNAL(clicked()), this, SLOT(refresh())));
+        VERIFY(connect(buttonBox, SIGNAL(rejected()), this, SLOT(reject())));
+        VERIFY(connect(server, SIGNAL(destroyed()), this, SLOT(serverDestroyed())));
+
+        QHBoxLayout *bottomLayout = new QHBoxLayout;
+        bottomLayout->addWidget(_status, 1);
+        bottomLayout->addWidget(buttonBox);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addLayout(topLayout);
+        layout->addWidget(_tree);
+        layout->addLayout(bottomLayout);
+        setLayout(layout);
+
+        _timer = new QTimer(this);
+        _timer->setInterval(defaultIntervalSec * 1000);
+        VERIFY(connect(_timer, SIGNAL(timeout()), this, SLOT(refresh())));
+        _timer->start();
+
+        updateButtons();
+        refresh();
+    }
+
+    void CurrentOpDialog::reject()
+    {
+        _timer->stop();
+
+        // Responses of pending requests are still on their way to this dialog,
+        // it is closed (and deleted) when the last one arrives
+        if (_pendingRequests > 0) {
+            _closeRequested = true;
+            hide();
+            return;
+        }
+
+        QDialog::reject();
+    }
+
+    bool CurrentOpDialog::closeIfRequested()
+    {
+        if (!_closeRequested)
+            return false;
+
+        if (_pendingRequests == 0)
+            QDialog::reject();
+        return true;
+    }
+
+    void CurrentOpDialog::refresh()
+    {
+        // Slow server is polled as often as it is able to answer, requests are not queued
+        if (_loading || !_server)
+            return;
+
+        _loading = true;
+        ++_pendingRequests;
+        AppRegistry::instance().bus()->send(_server->monitorWorker(), new CurrentOpRequest(this));
+    }
+
+    void CurrentOpDialog::serverDestroyed()
+    {
+        // Worker of deleted server drops pending responses, they are not waited for
+        _timer->stop();
+        _pendingRequests = 0;
+        QDialog::reject();
+    }
+
+    void CurrentOpDialog::handle(CurrentOpResponse *event)
+    {
+        _loading = false;
+        --_pendingRequests;
+        if (closeIfRequested())
+            return;
+
+        if (event->isError()) {
+            _status->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        // Selection is kept by host and opid, rows are rebuilt on every refresh
+        QSet<QString> selected;
+        for (auto item : _tree->selectedItems())
+            selected.insert(opKey(_ops[item->data(HostColumn, OpIndexRole).toInt()]));
+
+        _ops = event->ops();
+        _failures = event->failures();
+
+        _tree->setUpdatesEnabled(false);
+        _tree->setSortingEnabled(false);
+        _tree->clear();
+
+        QList<QTreeWidgetItem *> items;
+        for (size_t i = 0; i < _ops.size(); ++i) {
+            CurrentOpInfo const& op = _ops[i];
+            auto item = new OpItem;
+            item->setData(HostColumn, OpIndexRole, static_cast<int>(i));
+            item->setText(HostColumn, QtUtils::toQString(op.host));
+            item->setText(OpidColumn, QtUtils::toQString(op.opid));
+            if (op.details["opid"].isNumber())
+                item->setData(OpidColumn, Qt::UserRole, op.details["opid"].safeNumberLong());
+            item->setText(OperationColumn, QtUtils::toQString(op.op));
+            item->setText(NamespaceColumn, QtUtils::toQString(op.ns));
+            item->setText(RunningColumn, QString("%1 s").arg(op.microsecs / 1000000.0, 0, 'f', 1));
+            item->setData(RunningColumn, Qt::UserRole, op.microsecs);
+            item->setTextAlignment(RunningColumn, Qt::AlignRight | Qt::AlignVCenter);
+            item->setText(PlanSummaryColumn, QtUtils::toQString(op.planSummary));
+            item->setText(ClientColumn, QtUtils::toQString(op.client));
+            item->setText(DescriptionColumn, QtUtils::toQString(op.desc));
+            item->setText(WaitingColumn, op.waitingForLock ? "yes" : "");
+            item->setToolTip(OpidColumn, QtUtils::toQString(
+                BsonUtils::jsonString(op.details, mongo::TenGen, 1, DefaultEncoding, Utc)));
+            items.append(item);
+        }
+        _tree->addTopLevelItems(items);
+
+        for (auto item : items) {
+            if (selected.contains(opKey(_ops[item->data(HostColumn, OpIndexRole).toInt()])))
+                item->setSelected(true);
+        }
+
+        _tree->setSortingEnabled(true);
+        applyHighlight();
+        applyFilter();
+        _tree->setUpdatesEnabled(true);
+
+        // Columns are fitted once, later user may resize them
+        if (!_columnsFitted && !items.isEmpty()) {
+            for (int i = HostColumn; i < _tree->columnCount(); ++i)
+                _tree->resizeColumnToContents(i);
+            _columnsFitted = true;
+        }
+    }
+
+    void CurrentOpDialog::handle(KillOpResponse *event)
+    {
+        --_pendingRequests;
+        if (closeIfRequested())
+            return;
+
+        if (event->isError()) {
+            _status->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        _status->setText(QString("Operation %1 killed on %2")
+                         .arg(QtUtils::toQString(event->op().opid)).arg(QtUtils::toQString(event->op().host)));
+        refresh();
+    }
+
+    void CurrentOpDialog::killSelected()
+    {
+        if (!_server)
+            return;
+
+        for (auto item : _tree->selectedItems()) {
+            CurrentOpInfo const& op = _ops[item->data(HostColumn, OpIndexRole).toInt()];
+            ++_pendingRequests;
+            AppRegistry::instance().bus()->send(_server->monitorWorker(), new KillOpRequest(this, op));
+
+            QFont font = item->font(HostColumn);
+            font.setStrikeOut(true);
+            for (int i = HostColumn; i < _tree->columnCount(); ++i)
+                item->setFont(i, font);
+        }
+        _tree->clearSelection();
+    }
+
+    void CurrentOpDialog::applyFilter()
+    {
+        QString const filter = _filter->text().trimmed();
+        for (int i = 0; i < _tree->topLevelItemCount(); ++i) {
+            QTreeWidgetItem *item = _tree->topLevelItem(i);
+            bool matches = filter.isEmpty();
+            for (int column : { HostColumn, OperationColumn, NamespaceColumn, PlanSummaryColumn, ClientColumn,
+                                DescriptionColumn }) {
+                if (matches)
+                    break;
+                matches = item->text(column).contains(filter, Qt::CaseInsensitive);
+            }
+            item->setHidden(!matches);
+        }
+        updateStatus();
+    }
+
+    void CurrentOpDialog::applyHighlight()
+    {
+        long long const thresholdMicros = _threshold->value() * 1000000LL;
+        QBrush const highlight(QColor(255, 215, 215));
+        for (int i = 0; i < _tree->topLevelItemCount(); ++i) {
+            QTreeWidgetItem *item = _tree->topLevelItem(i);
+            bool const slow = item->data(RunningColumn, Qt::UserRole).toLongLong() >= thresholdMicros;
+            for (int column = HostColumn; column < _tree->columnCount(); ++column)
+                item->setBackground(column, slow ? highlight : QBrush());
+        }
+        updateStatus();
+    }
+
+    void CurrentOpDialog::updateStatus()
+    {
+        long long const thresholdMicros = _threshold->value() * 1000000LL;
+        int shown = 0, slow = 0;
+        for (int i = 0; i < _tree->topLevelItemCount(); ++i) {
+            QTreeWidgetItem *item = _tree->topLevelItem(i);
+            if (item->isHidden())
+                continue;
+
+            ++shown;
+            if (item->data(RunningColumn, Qt::UserRole).toLongLong() >= thresholdMicros)
+                ++slow;
+        }
+
+        QString status = QString("%1 of %2 operations shown, %3 over %4 sec")
+                         .arg(shown).arg(_tree->topLevelItemCount()).arg(slow).arg(_threshold->value());
+        for (auto const& failure : _failures)
+            status += "; " + QtUtils::toQString(failure);
+        _status->setText(status);
+    }
+
+    void CurrentOpDialog::changeInterval(int seconds)
+    {
+        _timer->setInterval(seconds * 1000);
+    }
+
+    void CurrentOpDialog::toggleAutoRefresh(bool enabled)
+    {
+        _interval->setEnabled(enabled);
+        if (enabled)
+            _timer->start();
+        else
+            _timer->stop();
+    }
+
+    void CurrentOpDialog::updateButtons()
+    {
+        _killButton->setEnabled(!_tree->selectedItems().isEmpty());
+    }
+}
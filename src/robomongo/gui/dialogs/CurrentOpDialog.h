@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <QDialog>
+#include <QPointer>
+
+#include "robomongo/core/events/MongoEventsInfo.h"
+
+QT_BEGIN_NAMESPACE
+class QCheckBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QSpinBox;
+class QTimer;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class CurrentOpResponse;
+    class KillOpResponse;
+
+    /**
+     * @brief Operations in progress on all members of server in one sortable table, refreshed
+     *        automatically. Operations running longer than threshold are highlighted, selected
+     *        operations are killed with Kill button. currentOp is polled by MonitorWorker,
+     *        so table keeps refreshing while shells of server are busy.
+     *
+     *        Dialog is not modal and deletes itself when closed or when its server is deleted.
+     */
+    class CurrentOpDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        enum { defaultIntervalSec = 2 };
+        enum { defaultThresholdSec = 5 };
+
+        /**
+         * @param filter: initial filter, i.e. "dbname." to show operations of one database
+         */
+        CurrentOpDialog(MongoServer *server, const QString &filter = QString(), QWidget *parent = nullptr);
+
+    public Q_SLOTS:
+        virtual void reject();
+        void handle(CurrentOpResponse *event);
+        void handle(KillOpResponse *event);
+
+    private Q_SLOTS:
+        void refresh();
+        void killSelected();
+        void applyFilter();
+        void applyHighlight();
+        void changeInterval(int seconds);
+        void toggleAutoRefresh(bool enabled);
+        void updateButtons();
+        void serverDestroyed();
+
+    private:
+        void updateStatus();
+        bool closeIfRequested();
+
+        QPointer<MongoServer> _server;
+        int _pendingRequests;       // responses still on their way to this dialog
+        bool _loading;
+        bool _closeRequested;       // dialog is closed when all pending requests finish
+        bool _columnsFitted;
+
+        std::vector<CurrentOpInfo> _ops;
+        std::vector<std::string> _failures;
+
+        QTimer *_timer;
+        QLineEdit *_filter;
+        QSpinBox *_threshold;
+        QSpinBox *_interval;
+        QCheckBox *_autoRefresh;
+        QTreeWidget *_tree;
+        QLabel *_status;
+        QPushButton *_killButton;
+        QPushButton *_refreshButton;
+    };
+}
@@ -1,12 +1,15 @@
 #include "robomongo/gui/dialogs/DocumentTextEditor.h"
 
+#include <algorithm>
 #include <QApplication>
 #include <QHBoxLayout>
+#include <QLabel>
 #include <QPushButton>
 #include <QMessageBox>
 #include <QDialogButtonBox>
 #include <QDesktopWidget>
 #include <QSettings>
+#include <QTimer>
 #include <Qsci/qscilexerjavascript.h>
 
 #include <mongo/client/dbclientinterface.h>
@@ -17,9 +20,23 @@
 #include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
 #include "robomongo/gui/GuiRegistry.h"
 
+#include "robomongo/core/utils/JsonValidator.h"
 #include "robomongo/core/utils/QtUtils.h"
-#include "robomongo/shell/bson/json.h"
 
+namespace
+{
+    /**
+     * @brief Text of editor in UTF-8, offsets in it are positions of QScintilla
+     */
+    std::string editorText(QsciScintilla *editor)
+    {
+        long const length = editor->SendScintilla(QsciScintilla::SCI_GETLENGTH);
+        std::string text(length + 1, '\0');
+        editor->SendScintilla(QsciScintilla::SCI_GETTEXT, static_cast<unsigned long>(length + 1), &text[0]);
+        text.resize(length);
+        return text;
+    }
+}
 
 namespace Robomongo
 {
@@ -28,7 +45,12 @@ namespace Robomongo
     DocumentTextEditor::DocumentTextEditor(const CollectionInfo &info, const QString &json, bool readonly /* = false */, QWidget *parent) :
         QDialog(parent),
         _info(info),
-        _readonly(readonly)
+        _readonly(readonly),
+        _validator(NULL),
+        _validationTimer(NULL),
+        _validationStatus(NULL),
+        _revision(0),
+        _submittedRevision(-1)
     {
         QRect screenGeometry = QApplication::desktop()->availableGeometry();
         int horizontalMargin = (int)(screenGeometry.width() * 0.35);
@@ -62,6 +84,19 @@ namespace Robomongo
         // clear modification state after setting the content
         _queryText->sciScintilla()->setModified(false);
 
+        // Text is validated on background thread when typing pauses
+        _validator = new JsonValidator(this);
+        VERIFY(connect(_validator, SIGNAL(validated(int, Robomongo::JsonErrors)),
+                       this, SLOT(onValidated(int, Robomongo::JsonErrors))));
+
+        _validationTimer = new QTimer(this);
+        _validationTimer->setSingleShot(true);
+        _validationTimer->setInterval(validationDelayMs);
+        VERIFY(connect(_validationTimer, SIGNAL(timeout()), this, SLOT(startValidation())));
+
+        _validationStatus = new QLabel(this);
+        _validationStatus->setStyleSheet("QLabel { color: #c0392b; margin-left: 8px; }");
+
         VERIFY(connect(_queryText->sciScintilla(), SIGNAL(textChanged()), this, SLOT(onQueryTextChanged())));
 
         QHBoxLayout *hlayout = new QHBoxLayout();
@@ -80,6 +115,7 @@ namespace Robomongo
 
         QHBoxLayout *bottomlayout = new QHBoxLayout();
         bottomlayout->addWidget(validate);
+        bottomlayout->addWidget(_validationStatus);
         bottomlayout->addStretch(1);
         bottomlayout->addWidget(buttonBox);
 
@@ -97,6 +133,8 @@ namespace Robomongo
             validate->hide();
             buttonBox->button(QDialogButtonBox::Save)->hide();
             _queryText->sciScintilla()->setReadOnly(true);
+        } else {
+            startValidation();
         }
     }
 
@@ -146,34 +184,22 @@ namespace Robomongo
 
     bool DocumentTextEditor::validate(bool silentOnSuccess /* = true */)
     {
-        QString text = jsonText();
-        int len = 0;
-        try {
-            std::string textString = QtUtils::toStdString(text);
-            const char *json = textString.c_str();
-            int jsonLen = textString.length();
-            int offset = 0;
-            _obj.clear();
-            while (offset != jsonLen)
-            {
-                mongo::BSONObj doc = mongo::Robomongo::fromjson(json+offset, &len);
-                _obj.push_back(doc);
-                offset += len;
-            }
-        } catch (const mongo::Robomongo::ParseMsgAssertionException &ex) {
-//            v0.9
-            QString message = QtUtils::toQString(ex.reason());
-            int offset = ex.offset();
+        // Text changed after the last validation (i.e. Save pressed while typing) is parsed now
+        if (_submittedRevision != _revision)
+            startValidation();
+
+        JsonErrors errors;
+        _obj = _validator->wait(_revision, errors);
+        showErrors(errors);
 
+        if (!errors.empty()) {
+            const JsonError &error = errors.front();
             int line = 0, pos = 0;
-            _queryText->sciScintilla()->lineIndexFromPosition(offset, &line, &pos);
+            _queryText->sciScintilla()->lineIndexFromPosition(static_cast<int>(error.offset), &line, &pos);
             _queryText->sciScintilla()->setCursorPosition(line, pos);
 
-            int lineHeight = _queryText->sciScintilla()->lineLength(line);
-            _queryText->sciScintilla()->fillIndicatorRange(line, pos, line, lineHeight, 0);
-
-            message = QString("Unable to parse JSON:<br /> <b>%1</b>, at (%2, %3).")
-                .arg(message).arg(line + 1).arg(pos + 1);
+            QString const message = QString("Unable to parse JSON:<br /> <b>%1</b>, at (%2, %3).")
+                .arg(QtUtils::toQString(error.reason)).arg(line + 1).arg(pos + 1);
 
             QMessageBox::critical(NULL, "Parsing error", message);
             _queryText->setFocus();
@@ -192,7 +218,54 @@ namespace Robomongo
 
     void DocumentTextEditor::onQueryTextChanged()
     {
-        _queryText->sciScintilla()->clearIndicatorRange(0, 0, _queryText->sciScintilla()->lines(), 40, 0);
+        ++_revision;
+
+        // Restarted by every change
+        _validationTimer->start();
+    }
+
+    void DocumentTextEditor::startValidation()
+    {
+        _validationTimer->stop();
+        _submittedRevision = _revision;
+        _validator->submit(editorText(_queryText->sciScintilla()), _revision);
+    }
+
+    void DocumentTextEditor::onValidated(int revision, const JsonErrors &errors)
+    {
+        // Offsets of older text do not match the editor
+        if (revision == _revision)
+            showErrors(errors);
+    }
+
+    void DocumentTextEditor::showErrors(const JsonErrors &errors)
+    {
+        QsciScintilla *editor = _queryText->sciScintilla();
+        editor->markerDeleteAll(errorMarker);
+        editor->SendScintilla(QsciScintilla::SCI_SETINDICATORCURRENT, static_cast<unsigned long>(errorIndicator));
+        editor->SendScintilla(QsciScintilla::SCI_INDICATORCLEARRANGE, 0UL, editor->SendScintilla(QsciScintilla::SCI_GETLENGTH));
+
+        for (const JsonError &error : errors) {
+            long const line = editor->SendScintilla(QsciScintilla::SCI_LINEFROMPOSITION, static_cast<unsigned long>(error.offset));
+            editor->markerAdd(static_cast<int>(line), errorMarker);
+
+            // Rest of the line where parser stopped, at least one char
+            long const lineEnd = editor->SendScintilla(QsciScintilla::SCI_GETLINEENDPOSITION, static_cast<unsigned long>(line));
+            editor->SendScintilla(QsciScintilla::SCI_INDICATORFILLRANGE, static_cast<unsigned long>(error.offset),
+                                  std::max(lineEnd - static_cast<long>(error.offset), 1L));
+        }
+
+        if (errors.empty()) {
+            _validationStatus->clear();
+            return;
+        }
+
+        int line = 0, pos = 0;
+        editor->lineIndexFromPosition(static_cast<int>(errors.front().offset), &line, &pos);
+        QString status = QString("Line %1: %2").arg(line + 1).arg(QtUtils::toQString(errors.front().reason));
+        if (errors.size() > 1)
+            status += QString(" (%1 more errors)").arg(errors.size() - 1);
+        _validationStatus->setText(status);
     }
 
     void DocumentTextEditor::onValidateButtonClicked()
@@ -222,6 +295,16 @@ namespace Robomongo
         _queryText->sciScintilla()->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
         _queryText->sciScintilla()->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
 
+        // Symbol margin marks lines with parse errors
+        if (!_readonly) {
+            _queryText->sciScintilla()->markerDefine(QsciScintilla::Circle, errorMarker);
+            _queryText->sciScintilla()->setMarkerForegroundColor(QColor("#c0392b"), errorMarker);
+            _queryText->sciScintilla()->setMarkerBackgroundColor(QColor("#e06c6c"), errorMarker);
+            _queryText->sciScintilla()->setMarginType(1, QsciScintilla::SymbolMargin);
+            _queryText->sciScintilla()->setMarginMarkerMask(1, 1 << errorMarker);
+            _queryText->sciScintilla()->setMarginWidth(1, 14);
+        }
+
         _queryText->sciScintilla()->setStyleSheet("QFrame { background-color: rgb(73, 76, 78); border: 1px solid #c7c5c4; border-radius: 4px; margin: 0px; padding: 0px;}");
     }
 
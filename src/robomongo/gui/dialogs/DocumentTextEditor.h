@@ -3,10 +3,17 @@
 #include <QDialog>
 #include <mongo/bson/bsonobj.h>
 #include "robomongo/core/domain/MongoQueryInfo.h"
+#include "robomongo/core/utils/IncrementalJsonParser.h"
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QTimer;
+QT_END_NAMESPACE
 
 namespace Robomongo
 {
     class FindFrame;
+    class JsonValidator;
 
     class DocumentTextEditor : public QDialog
     {
@@ -16,6 +23,10 @@ namespace Robomongo
         typedef std::vector<mongo::BSONObj> ReturnType;
         static const QSize minimumSize;
 
+        enum { validationDelayMs = 300 };   // after last keystroke
+        enum { errorMarker = 0 };           // QScintilla marker of lines with parse errors
+        enum { errorIndicator = 0 };        // QScintilla indicator of text where parser stopped
+
         explicit DocumentTextEditor(const CollectionInfo &info, const QString &json, bool readonly = false, QWidget *parent = 0);
 
         QString jsonText() const;
@@ -36,6 +47,16 @@ namespace Robomongo
         void onQueryTextChanged();
         void onValidateButtonClicked();
 
+        /**
+         * @brief Submit current text to background validator
+         */
+        void startValidation();
+
+        /**
+         * @brief Show errors of background validation in margin, if text was not changed since
+         */
+        void onValidated(int revision, const Robomongo::JsonErrors &errors);
+
     protected:
         /**
         * @brief Reimplementing closeEvent in order to do some pre-close actions.
@@ -45,6 +66,11 @@ namespace Robomongo
     private:
         void _configureQueryText();
 
+        /**
+         * @brief Mark lines and ranges of 'errors'
+         */
+        void showErrors(const JsonErrors &errors);
+
         /**
         * @brief Restore window settings from system registry
         */
@@ -59,6 +85,12 @@ namespace Robomongo
         FindFrame *_queryText;
         bool _readonly;
         ReturnType _obj;
+
+        JsonValidator *_validator;
+        QTimer *_validationTimer;
+        QLabel *_validationStatus;
+        int _revision;                      // incremented on every change of text
+        int _submittedRevision;
     };
 }
 
@@ -0,0 +1,211 @@
+#include "robomongo/gui/dialogs/ImportDialog.h"
+
+#include <algorithm>
+#include <QCheckBox>
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QVBoxLayout>
+
+#include "robomongo/core/mongodb/DocumentImporter.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
+#include "robomongo/gui/GuiRegistry.h"
+
+namespace Robomongo
+{
+    ImportDialog::ImportDialog(const ConnectionSettings *connection, const QString &serverName, const MongoNamespace &ns,
+                               QWidget *parent) :
+        QDialog(parent),
+        _connection(connection),
+        _ns(ns),
+        _importer(nullptr),
+        _closeRequested(false)
+    {
+        setWindowTitle("Import Documents");
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setMinimumWidth(500);
+
+        QHBoxLayout *indicators = new QHBoxLayout();
+        indicators->addWidget(new Indicator(GuiRegistry::instance().serverIcon(), serverName), 0, Qt::AlignLeft);
+        indicators->addWidget(new Indicator(GuiRegistry::instance().databaseIcon(),
+                                            QtUtils::toQString(ns.databaseName())), 0, Qt::AlignLeft);
+        indicators->addWidget(new Indicator(GuiRegistry::instance().collectionIcon(),
+                                            QtUtils::toQString(ns.collectionName())), 0, Qt::AlignLeft);
+        indicators->addStretch(1);
+
+        QFrame *hline = new QFrame();
+        hline->setFrameShape(QFrame::HLine);
+        hline->setFrameShadow(QFrame::Sunken);
+
+        _filePath = new QLineEdit();
+        _filePath->setPlaceholderText("JSON array, NDJSON or concatenated JSON documents");
+        _browseButton = new QPushButton("...");
+        _browseButton->setFixedWidth(30);
+        VERIFY(connect(_browseButton, SIGNAL(clicked()), this, SLOT(ui_browseClicked())));
+        QHBoxLayout *fileLayout = new QHBoxLayout();
+        fileLayout->addWidget(_filePath);
+        fileLayout->addWidget(_browseButton);
+
+        _ordered = new QCheckBox("Stop on first error (ordered inserts)");
+        _ordered->setChecked(true);
+
+        _batchSize = new QSpinBox();
+        _batchSize->setRange(1, 100000);
+        _batchSize->setValue(ImportOptions().batchSize);
+
+        _maxDocsPerSecond = new QSpinBox();
+        _maxDocsPerSecond->setRange(0, 10000000);
+        _maxDocsPerSecond->setSpecialValueText("Unlimited");
+        _maxDocsPerSecond->setSuffix(" docs/s");
+
+        QFormLayout *form = new QFormLayout();
+        form->addRow("File:", fileLayout);
+        form->addRow("", _ordered);
+        form->addRow("Batch size:", _batchSize);
+        form->addRow("Throttle:", _maxDocsPerSecond);
+
+        _progress = new QProgressBar();
+        _progress->setRange(0, 1000);
+        _progress->setValue(0);
+        _progress->setTextVisible(false);
+        _status = new QLabel();
+
+        _buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        _importButton = _buttonBox->addButton("&Import", QDialogButtonBox::AcceptRole);
+        VERIFY(connect(_importButton, SIGNAL(clicked()), this, SLOT(ui_importClicked())));
+        VERIFY(connect(_buttonBox, SIGNAL(rejected()), this, SLOT(reject())));
+
+        QVBoxLayout *layout = new QVBoxLayout();
+        layout->addLayout(indicators);
+        layout->addWidget(hline);
+        layout->addLayout(form);
+        layout->addWidget(_progress);
+        layout->addWidget(_status);
+        layout->addWidget(_buttonBox);
+        setLayout(layout);
+    }
+
+    void ImportDialog::reject()
+    {
+        // Wait for batches already sent to the server, dialog is closed in onFinished()
+        if (_importer && _importer->isRunning()) {
+            _closeRequested = true;
+            _buttonBox->setEnabled(false);
+            _status->setText("Cancelling...");
+            _importer->cancel();
+            return;
+        }
+
+        QDialog::reject();
+    }
+
+    void ImportDialog::ui_browseClicked()
+    {
+        QString const path = QFileDialog::getOpenFileName(this, "Import Documents", _filePath->text(),
+                                                          "JSON (*.json *.ndjson *.jsonl);;All files (*)");
+        if (!path.isEmpty())
+            _filePath->setText(path);
+    }
+
+    void ImportDialog::ui_importClicked()
+    {
+        if (_importer && _importer->isRunning()) {
+            _status->setText("Cancelling...");
+            _importButton->setEnabled(false);
+            _importer->cancel();
+            return;
+        }
+
+        QString const path = _filePath->text();
+        if (!QFileInfo(path).isFile()) {
+            QMessageBox::warning(this, "Import Documents", "File not found: " + path);
+            return;
+        }
+
+        ImportOptions options;
+        options.ordered = _ordered->isChecked();
+        options.batchSize = _batchSize->value();
+        options.maxDocsPerSecond = _maxDocsPerSecond->value();
+
+        qint64 offset = 0;
+        long long inserted = 0;
+        if (DocumentImporter::loadCheckpoint(path, _ns, &offset, &inserted)) {
+            int const answer = QMessageBox::question(this, "Import Documents",
+                QString("Previous import of this file stopped at %1% (%2 documents inserted).\n\n"
+                        "Resume it? Choose No to import the whole file again.")
+                .arg(offset * 100 / std::max<qint64>(1, QFileInfo(path).size())).arg(inserted),
+                QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel, QMessageBox::Yes);
+
+            if (answer == QMessageBox::Cancel)
+                return;
+
+            if (answer == QMessageBox::Yes) {
+                options.resumeOffset = offset;
+                options.resumeInserted = inserted;
+            }
+            else {
+                DocumentImporter::removeCheckpoint(path);
+            }
+        }
+
+        delete _importer;
+        _importer = new DocumentImporter(_connection, path, _ns, options, this);
+        VERIFY(connect(_importer, SIGNAL(progress(qint64, qint64, long long, long long)),
+                       this, SLOT(onProgress(qint64, qint64, long long, long long))));
+        VERIFY(connect(_importer, SIGNAL(finished(bool, const QString &)),
+                       this, SLOT(onFinished(bool, const QString &))));
+
+        enableInputs(false);
+        _importButton->setText("&Stop");
+        _status->setText("Importing...");
+        _importer->start();
+    }
+
+    void ImportDialog::onProgress(qint64 bytesDone, qint64 bytesTotal, long long inserted, long long failed)
+    {
+        _progress->setValue(bytesTotal > 0 ? static_cast<int>(bytesDone * 1000 / bytesTotal) : 0);
+
+        QString status = QString("%1 of %2 MB, %3 documents inserted")
+            .arg(bytesDone / (1024.0 * 1024.0), 0, 'f', 1)
+            .arg(bytesTotal / (1024.0 * 1024.0), 0, 'f', 1)
+            .arg(inserted);
+        if (failed > 0)
+            status += QString(", %1 failed").arg(failed);
+        _status->setText(status);
+    }
+
+    void ImportDialog::onFinished(bool success, const QString &message)
+    {
+        enableInputs(true);
+        _importButton->setText("&Import");
+        _importButton->setEnabled(true);
+        _buttonBox->setEnabled(true);
+        _status->setText(message);
+
+        if (_closeRequested) {
+            QDialog::reject();
+            return;
+        }
+
+        if (!success)
+            QMessageBox::warning(this, "Import Documents", message);
+    }
+
+    void ImportDialog::enableInputs(bool enable)
+    {
+        _filePath->setEnabled(enable);
+        _browseButton->setEnabled(enable);
+        _ordered->setEnabled(enable);
+        _batchSize->setEnabled(enable);
+        _maxDocsPerSecond->setEnabled(enable);
+    }
+}
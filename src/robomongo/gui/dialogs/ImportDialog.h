@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QDialog>
+
+#include "robomongo/core/domain/MongoNamespace.h"
+
+QT_BEGIN_NAMESPACE
+class QCheckBox;
+class QDialogButtonBox;
+class QLabel;
+class QLineEdit;
+class QProgressBar;
+class QPushButton;
+class QSpinBox;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class DocumentImporter;
+    class ConnectionSettings;
+
+    /**
+     * @brief Imports JSON array, NDJSON or concatenated JSON documents from file
+     *        into collection (see DocumentImporter).
+     */
+    class ImportDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        ImportDialog(const ConnectionSettings *connection, const QString &serverName, const MongoNamespace &ns, QWidget *parent = 0);
+
+    public Q_SLOTS:
+        virtual void reject();
+
+    private Q_SLOTS:
+        void ui_browseClicked();
+        void ui_importClicked();
+        void onProgress(qint64 bytesDone, qint64 bytesTotal, long long inserted, long long failed);
+        void onFinished(bool success, const QString &message);
+
+    private:
+        void enableInputs(bool enable);
+
+        const ConnectionSettings *const _connection;
+        const MongoNamespace _ns;
+        DocumentImporter *_importer;
+        bool _closeRequested;
+
+        QLineEdit *_filePath;
+        QPushButton *_browseButton;
+        QCheckBox *_ordered;
+        QSpinBox *_batchSize;
+        QSpinBox *_maxDocsPerSecond;
+        QProgressBar *_progress;
+        QLabel *_status;
+        QPushButton *_importButton;
+        QDialogButtonBox *_buttonBox;
+    };
+}
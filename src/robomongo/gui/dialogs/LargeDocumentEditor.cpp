@@ -0,0 +1,342 @@
+#include "robomongo/gui/dialogs/LargeDocumentEditor.h"
+
+#include <QDialogButtonBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include <mongo/client/dbclientinterface.h>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/dialogs/DocumentTextEditor.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
+
+namespace
+{
+    using namespace Robomongo;
+
+    enum Column
+    {
+        KeyColumn,
+        ValueColumn,
+        TypeColumn
+    };
+
+    // Dotted path of field
+    int const PathRole = Qt::UserRole + 1;
+
+    // False for _id, fields of read-only document and fields which cannot be addressed by path
+    int const EditableRole = Qt::UserRole + 2;
+
+    bool isAddressable(const std::string &name)
+    {
+        return !name.empty() && name[0] != '$' && name.find('.') == std::string::npos;
+    }
+
+    std::string itemPath(const QTreeWidgetItem *item)
+    {
+        return QtUtils::toStdString(item->data(KeyColumn, PathRole).toString());
+    }
+
+    bool isEditable(const QTreeWidgetItem *item)
+    {
+        return item && item->data(KeyColumn, EditableRole).toBool();
+    }
+
+    QString fieldValue(const mongo::BSONElement &element)
+    {
+        if (element.type() == mongo::Array) {
+            int const count = BsonUtils::elementsCount(element.embeddedObject());
+            return QString("[ %1 %2 ]").arg(count).arg(count == 1 ? "element" : "elements");
+        }
+
+        if (element.type() == mongo::Object) {
+            int const count = BsonUtils::elementsCount(element.embeddedObject());
+            return QString("{ %1 %2 }").arg(count).arg(count == 1 ? "field" : "fields");
+        }
+
+        std::string result;
+        BsonUtils::buildJsonString(element, result, AppRegistry::instance().settingsManager()->uuidEncoding(),
+                                   AppRegistry::instance().settingsManager()->timeZone());
+        return QtUtils::toQString(result).simplified().left(300);
+    }
+}
+
+namespace Robomongo
+{
+    LargeDocumentEditor::LargeDocumentEditor(const CollectionInfo &info, const mongo::BSONObj &document, bool readonly, QWidget *parent) :
+        QDialog(parent),
+        _info(info),
+        _readonly(readonly),
+        _patch(document)
+    {
+        setWindowFlags(Qt::Window | Qt::WindowMaximizeButtonHint | Qt::WindowCloseButtonHint);
+        resize(900, 600);
+
+        _status = new QLabel;
+        _status->setWordWrap(true);
+
+        _tree = new QTreeWidget;
+        _tree->setUniformRowHeights(true);
+        _tree->setHeaderLabels(QStringList() << "Key" << "Value" << "Type");
+        _tree->header()->resizeSection(KeyColumn, 250);
+        _tree->header()->resizeSection(ValueColumn, 450);
+        VERIFY(connect(_tree, SIGNAL(itemExpanded(QTreeWidgetItem *)), this, SLOT(onItemExpanded(QTreeWidgetItem *))));
+        VERIFY(connect(_tree, SIGNAL(currentItemChanged(QTreeWidgetItem *, QTreeWidgetItem *)), this, SLOT(updateButtons())));
+
+        _editButton = new QPushButton("&Edit...");
+        _editButton->setToolTip("Edit value of selected field as JSON");
+        _addButton = new QPushButton("&Add Fields...");
+        _addButton->setToolTip("Add fields to selected object, or to document");
+        _removeButton = new QPushButton("&Remove");
+        _removeButton->setToolTip("Remove selected field");
+        VERIFY(connect(_editButton, SIGNAL(clicked()), this, SLOT(onEdit())));
+        VERIFY(connect(_addButton, SIGNAL(clicked()), this, SLOT(onAddFields())));
+        VERIFY(connect(_removeButton, SIGNAL(clicked()), this, SLOT(onRemove())));
+
+        QDialogButtonBox *buttonBox = new QDialogButtonBox(this);
+        buttonBox->setStandardButtons(_readonly ? QDialogButtonBox::Close : QDialogButtonBox::Cancel | QDialogButtonBox::Save);
+        VERIFY(connect(buttonBox, SIGNAL(accepted()), this, SLOT(accept())));
+        VERIFY(connect(buttonBox, SIGNAL(rejected()), this, SLOT(reject())));
+
+        QHBoxLayout *bottomLayout = new QHBoxLayout;
+        bottomLayout->addWidget(_editButton);
+        bottomLayout->addWidget(_addButton);
+        bottomLayout->addWidget(_removeButton);
+        bottomLayout->addStretch(1);
+        bottomLayout->addWidget(buttonBox);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addWidget(_status);
+        layout->addWidget(_tree);
+        layout->addLayout(bottomLayout);
+        setLayout(layout);
+
+        if (_readonly) {
+            _editButton->hide();
+            _addButton->hide();
+            _removeButton->hide();
+        }
+
+        refreshRoot();
+        updateButtons();
+        updateStatus();
+    }
+
+    void LargeDocumentEditor::reject()
+    {
+        if (!_patch.isEmpty()) {
+            int const ret = QMessageBox::warning(this, tr("Robomongo"),
+                               tr("The document has been modified.\n"
+                                  "Do you want to save your changes?"),
+                               QMessageBox::Save | QMessageBox::Discard | QMessageBox::Cancel,
+                               QMessageBox::Save);
+
+            if (ret == QMessageBox::Save)
+                accept();
+            else if (ret == QMessageBox::Discard)
+                QDialog::reject();
+            return;
+        }
+
+        QDialog::reject();
+    }
+
+    void LargeDocumentEditor::onItemExpanded(QTreeWidgetItem *item)
+    {
+        if (item->childCount() == 0)
+            addFields(item, itemPath(item));
+    }
+
+    void LargeDocumentEditor::onEdit()
+    {
+        QTreeWidgetItem *item = _tree->currentItem();
+        if (!isEditable(item))
+            return;
+
+        std::string const path = itemPath(item);
+        std::string const name = path.substr(path.rfind('.') + 1);
+
+        // Only this field is converted to text
+        mongo::BSONObjBuilder builder;
+        builder.appendAs(_patch.element(path), name);
+        std::string const json = BsonUtils::jsonString(builder.obj(), mongo::TenGen, 1,
+            AppRegistry::instance().settingsManager()->uuidEncoding(),
+            AppRegistry::instance().settingsManager()->timeZone());
+
+        DocumentTextEditor editor(_info, QtUtils::toQString(json), false, this);
+        editor.setWindowTitle("Edit " + QtUtils::toQString(path));
+        if (editor.exec() != QDialog::Accepted)
+            return;
+
+        DocumentTextEditor::ReturnType const documents = editor.bsonObj();
+        if (documents.size() != 1 || documents.front().nFields() != 1) {
+            QMessageBox::warning(this, "Edit Field", "Document should have one field with the new value.");
+            return;
+        }
+
+        _patch.set(path, documents.front().firstElement());
+        refresh(item);
+        updateStatus();
+    }
+
+    void LargeDocumentEditor::onAddFields()
+    {
+        // Fields are added to selected object, otherwise to object of selected field
+        QTreeWidgetItem *target = _tree->currentItem();
+        if (target && _patch.element(itemPath(target)).type() != mongo::Object)
+            target = target->parent();
+        if (target && !isEditable(target))
+            return;
+
+        std::string const path = target ? itemPath(target) : std::string();
+        if (!path.empty() && _patch.element(path).type() != mongo::Object)
+            return;
+
+        DocumentTextEditor editor(_info, "{\n    \n}", false, this);
+        editor.setCursorPosition(1, 4);
+        editor.setWindowTitle(path.empty() ? QString("Add Fields") : "Add Fields to " + QtUtils::toQString(path));
+        if (editor.exec() != QDialog::Accepted)
+            return;
+
+        QStringList skipped;
+        for (const mongo::BSONObj &document : editor.bsonObj()) {
+            mongo::BSONObjIterator it(document);
+            while (it.more()) {
+                mongo::BSONElement const element = it.next();
+                std::string const name = element.fieldName();
+                if (!isAddressable(name) || (path.empty() && name == "_id")) {
+                    skipped.append(QtUtils::toQString(name));
+                    continue;
+                }
+                _patch.set(path.empty() ? name : path + "." + name, element);
+            }
+        }
+
+        if (!skipped.isEmpty())
+            QMessageBox::warning(this, "Add Fields", "These fields cannot be set: " + skipped.join(", "));
+
+        if (target) {
+            refresh(target);
+            target->setExpanded(true);
+        } else {
+            refreshRoot();
+        }
+        updateStatus();
+    }
+
+    void LargeDocumentEditor::onRemove()
+    {
+        QTreeWidgetItem *item = _tree->currentItem();
+        if (!isEditable(item))
+            return;
+
+        std::string const path = itemPath(item);
+        _patch.unset(path);
+
+        // Array element is set to null
+        if (_patch.element(path).eoo()) {
+            QTreeWidgetItem *parent = item->parent();
+            delete item;
+            for (QTreeWidgetItem *current = parent; current; current = current->parent())
+                showField(current);
+        } else {
+            refresh(item);
+        }
+        updateStatus();
+    }
+
+    void LargeDocumentEditor::updateButtons()
+    {
+        QTreeWidgetItem *item = _tree->currentItem();
+        _editButton->setEnabled(isEditable(item));
+        _removeButton->setEnabled(isEditable(item));
+        _addButton->setEnabled(!_readonly);
+    }
+
+    void LargeDocumentEditor::addFields(QTreeWidgetItem *parent, const std::string &path)
+    {
+        bool const parentEditable = parent ? isEditable(parent) : !_readonly;
+        bool const isArray = !path.empty() && _patch.element(path).type() == mongo::Array;
+
+        std::vector<std::pair<std::string, mongo::BSONElement>> const fields = _patch.fields(path);
+        QList<QTreeWidgetItem *> items;
+        for (auto const& field : fields) {
+            std::string const& name = field.first;
+            std::string const fieldPath = path.empty() ? name : path + "." + name;
+            QString const key = QtUtils::toQString(name);
+
+            QTreeWidgetItem *item = new QTreeWidgetItem;
+            item->setText(KeyColumn, isArray ? "[" + key + "]" : key);
+            item->setData(KeyColumn, PathRole, QtUtils::toQString(fieldPath));
+            item->setData(KeyColumn, EditableRole, parentEditable && isAddressable(name) && fieldPath != "_id");
+            items.append(item);
+        }
+
+        if (parent)
+            parent->addChildren(items);
+        else
+            _tree->addTopLevelItems(items);
+
+        for (int i = 0; i < items.size(); ++i)
+            showField(items[i], fields[i].second);
+    }
+
+    void LargeDocumentEditor::showField(QTreeWidgetItem *item)
+    {
+        showField(item, _patch.element(itemPath(item)));
+    }
+
+    void LargeDocumentEditor::showField(QTreeWidgetItem *item, const mongo::BSONElement &element)
+    {
+        std::string const path = itemPath(item);
+        item->setText(ValueColumn, fieldValue(element));
+        item->setText(TypeColumn, BsonUtils::BSONTypeToString(element.type(),
+            element.type() == mongo::BinData ? element.binDataType() : mongo::BinDataGeneral,
+            AppRegistry::instance().settingsManager()->uuidEncoding()));
+        item->setIcon(KeyColumn, BsonTreeModel::getIcon(element.type()));
+
+        bool const hasFields = element.isABSONObj() && !element.embeddedObject().isEmpty();
+        item->setChildIndicatorPolicy(hasFields ? QTreeWidgetItem::ShowIndicator : QTreeWidgetItem::DontShowIndicatorWhenChildless);
+
+        // Changed fields and objects which contain them are bold
+        QFont font = item->font(KeyColumn);
+        font.setBold(_patch.isChanged(path));
+        item->setFont(KeyColumn, font);
+    }
+
+    void LargeDocumentEditor::refresh(QTreeWidgetItem *item)
+    {
+        // Fields inside are created again from the new value when expanded
+        item->setExpanded(false);
+        qDeleteAll(item->takeChildren());
+
+        // Objects which contain the field are changed too
+        for (QTreeWidgetItem *current = item; current; current = current->parent())
+            showField(current);
+    }
+
+    void LargeDocumentEditor::refreshRoot()
+    {
+        _tree->clear();
+        addFields(NULL, std::string());
+    }
+
+    void LargeDocumentEditor::updateStatus()
+    {
+        QString status = QString("Document is %1 MB, it is shown as tree: fields of objects and arrays are loaded when expanded.")
+            .arg(_patch.original().objsize() / (1024.0 * 1024.0), 0, 'f', 1);
+
+        if (!_patch.isEmpty())
+            status += QString(" %1 changed fields will be saved with $set / $unset.").arg(_patch.size());
+
+        _status->setText(status);
+    }
+}
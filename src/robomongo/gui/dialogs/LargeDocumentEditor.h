@@ -0,0 +1,85 @@
+#pragma once
+
+#include <QDialog>
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/domain/DocumentPatch.h"
+#include "robomongo/core/domain/MongoQueryInfo.h"
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QPushButton;
+class QTreeWidget;
+class QTreeWidgetItem;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    /**
+     * @brief Editor of documents too large to be shown as text in DocumentTextEditor.
+     *
+     *        Document is shown as tree of fields, folded: fields of object or array are
+     *        created when it is expanded. Field is edited as small JSON document in
+     *        DocumentTextEditor, changes are kept by path in DocumentPatch together with
+     *        the original document, and saved as $set / $unset of changed fields only.
+     */
+    class LargeDocumentEditor : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        enum { largeDocumentSize = 1024 * 1024 };   // smaller documents are edited as text
+
+        LargeDocumentEditor(const CollectionInfo &info, const mongo::BSONObj &document, bool readonly = false, QWidget *parent = 0);
+
+        /**
+         * @brief Use only if Dialog exec() method returns QDialog::Accepted
+         */
+        const DocumentPatch &patch() const { return _patch; }
+
+    public Q_SLOTS:
+        void reject() override;
+
+    private Q_SLOTS:
+        void onItemExpanded(QTreeWidgetItem *item);
+        void onEdit();
+        void onAddFields();
+        void onRemove();
+        void updateButtons();
+
+    private:
+        /**
+         * @brief Add items of fields of object or array at 'path' (root if empty) to 'parent'
+         */
+        void addFields(QTreeWidgetItem *parent, const std::string &path);
+
+        /**
+         * @brief Show current value and type of field, changed fields are bold
+         */
+        void showField(QTreeWidgetItem *item);
+        void showField(QTreeWidgetItem *item, const mongo::BSONElement &element);
+
+        /**
+         * @brief Show changed field and objects which contain it. Fields inside of it are
+         *        created again when it is expanded.
+         */
+        void refresh(QTreeWidgetItem *item);
+
+        /**
+         * @brief Fields of document are created again
+         */
+        void refreshRoot();
+
+        void updateStatus();
+
+        const CollectionInfo _info;
+        bool const _readonly;
+        DocumentPatch _patch;
+
+        QTreeWidget *_tree;
+        QLabel *_status;
+        QPushButton *_editButton;
+        QPushButton *_addButton;
+        QPushButton *_removeButton;
+    };
+}
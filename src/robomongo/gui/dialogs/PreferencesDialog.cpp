@@ -73,6 +73,9 @@ namespace Robomongo
         _disabelConnectionShortcutsCheckBox = new QCheckBox("Disable connection shortcuts");
         layout->addWidget(_disabelConnectionShortcutsCheckBox);
 
+        _checkConcurrentEditsCheckBox = new QCheckBox("Do not save document if edited fields were changed by others");
+        layout->addWidget(_checkConcurrentEditsCheckBox);
+
         QHBoxLayout *stylesLayout = new QHBoxLayout(this);
         QLabel *stylesLabel = new QLabel("Styles:");
         stylesLayout->addWidget(stylesLabel);
@@ -100,6 +103,7 @@ namespace Robomongo
         utils::setCurrentText(_uuidEncodingComboBox, convertUUIDEncodingToString(Robomongo::AppRegistry::instance().settingsManager()->uuidEncoding()));
         _loadMongoRcJsCheckBox->setChecked(AppRegistry::instance().settingsManager()->loadMongoRcJs());
         _disabelConnectionShortcutsCheckBox->setChecked(AppRegistry::instance().settingsManager()->disableConnectionShortcuts());
+        _checkConcurrentEditsCheckBox->setChecked(AppRegistry::instance().settingsManager()->checkConcurrentEdits());
         utils::setCurrentText(_stylesComboBox, Robomongo::AppRegistry::instance().settingsManager()->currentStyle());
     }
 
@@ -116,6 +120,7 @@ namespace Robomongo
 
         AppRegistry::instance().settingsManager()->setLoadMongoRcJs(_loadMongoRcJsCheckBox->isChecked());
         AppRegistry::instance().settingsManager()->setDisableConnectionShortcuts(_disabelConnectionShortcutsCheckBox->isChecked());
+        AppRegistry::instance().settingsManager()->setCheckConcurrentEdits(_checkConcurrentEditsCheckBox->isChecked());
         Robomongo::AppRegistry::instance().settingsManager()->setCurrentStyle(_stylesComboBox->currentText());
         AppStyleUtils::applyStyle(_stylesComboBox->currentText());
         Robomongo::AppRegistry::instance().settingsManager()->save();
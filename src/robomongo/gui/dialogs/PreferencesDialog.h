@@ -26,6 +26,7 @@ namespace Robomongo
         QComboBox *_uuidEncodingComboBox;
         QCheckBox *_loadMongoRcJsCheckBox;
         QCheckBox *_disabelConnectionShortcutsCheckBox;
+        QCheckBox *_checkConcurrentEditsCheckBox;
         QComboBox *_stylesComboBox;
     };
 }
@@ -0,0 +1,260 @@
+#include "robomongo/gui/dialogs/ServerMonitorDialog.h"
+
+#include <algorithm>
+
+#include <QDialogButtonBox>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPainter>
+#include <QPainterPath>
+#include <QScrollArea>
+#include <QSpinBox>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/MonitorWorker.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    using namespace Robomongo;
+
+    QString valueString(ServerMetric metric, double value)
+    {
+        if (metric == BytesInPerSec || metric == BytesOutPerSec) {
+            const char *const units[] = { "B/s", "KB/s", "MB/s", "GB/s" };
+            int unit = 0;
+            while (value >= 1024 && unit < 3) {
+                value /= 1024;
+                ++unit;
+            }
+            return QString("%1 %2").arg(value, 0, 'f', unit == 0 ? 0 : 1).arg(units[unit]);
+        }
+
+        if (metric == CacheUsedPercent || metric == CacheDirtyPercent)
+            return QString("%1%").arg(value, 0, 'f', 1);
+
+        return QString::number(value, 'f', value < 10 && value != static_cast<long long>(value) ? 1 : 0);
+    }
+
+    // Line chart of one metric of one member, newest point at the right edge
+    class SparklineWidget : public QWidget
+    {
+    public:
+        SparklineWidget(const RingBuffer<ServerStatusPoint> &points, ServerMetric metric) :
+            _points(points), _metric(metric)
+        {
+            setMinimumSize(180, 40);
+            setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+        }
+
+    protected:
+        virtual void paintEvent(QPaintEvent *)
+        {
+            QPainter painter(this);
+            painter.fillRect(rect(), palette().base());
+            painter.setPen(palette().mid().color());
+            painter.drawRect(rect().adjusted(0, 0, -1, -1));
+
+            size_t const count = _points.size();
+            if (count == 0)
+                return;
+
+            double maxValue = 0;
+            for (size_t i = 0; i < count; ++i)
+                maxValue = std::max(maxValue, _points[i].values[_metric]);
+
+            // Scale is never below 1, so idle server shows flat line at the bottom
+            double const scale = (height() - 4) / std::max(maxValue, 1.0);
+            double const step = static_cast<double>(width() - 2) / (_points.capacity() - 1);
+            double const left = width() - 1 - step * (count - 1);
+
+            QPainterPath path;
+            for (size_t i = 0; i < count; ++i) {
+                QPointF const point(left + step * i, height() - 2 - _points[i].values[_metric] * scale);
+                if (i == 0)
+                    path.moveTo(point);
+                else
+                    path.lineTo(point);
+            }
+
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.setPen(QPen(palette().highlight().color(), 1.5));
+            painter.drawPath(path);
+
+            painter.setPen(palette().text().color());
+            painter.drawText(rect().adjusted(4, 2, -4, -2), Qt::AlignLeft | Qt::AlignTop,
+                             valueString(_metric, _points.back().values[_metric]));
+            painter.setPen(palette().mid().color());
+            painter.drawText(rect().adjusted(4, 2, -4, -2), Qt::AlignRight | Qt::AlignTop,
+                             "max " + valueString(_metric, maxValue));
+        }
+
+    private:
+        const RingBuffer<ServerStatusPoint> &_points;
+        ServerMetric const _metric;
+    };
+}
+
+namespace Robomongo
+{
+    ServerMonitorDialog::ServerMonitorDialog(MongoServer *server, QWidget *parent) :
+        QDialog(parent),
+        _server(server),
+        _requestPending(false),
+        _closeRequested(false)
+    {
+        setWindowTitle(QString("Performance Monitor - %1")
+                       .arg(QtUtils::toQString(server->connectionRecord()->getFullAddress())));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+        resize(900, 700);
+
+        _interval = new QSpinBox;
+        _interval->setRange(1, 60);
+        _interval->setSuffix(" sec");
+        _interval->setValue(defaultIntervalSec);
+        VERIFY(connect(_interval, SIGNAL(valueChanged(int)), this, SLOT(changeInterval(int))));
+
+        _status = new QLabel("Connecting...");
+
+        QHBoxLayout *topLayout = new QHBoxLayout;
+        topLayout->addWidget(new QLabel("Refresh every:"));
+        topLayout->addWidget(_interval);
+        topLayout->addSpacing(10);
+        topLayout->addWidget(_status, 1);
+
+        // Metrics are rows, members are columns
+        QWidget *charts = new QWidget;
+        _grid = new QGridLayout(charts);
+        for (int metric = 0; metric < ServerMetricCount; ++metric)
+            _grid->addWidget(new QLabel(serverMetricName(static_cast<ServerMetric>(metric))), metric + 1, 0);
+        _grid->setRowStretch(ServerMetricCount + 1, 1);
+
+        QScrollArea *scrollArea = new QScrollArea;
+        scrollArea->setWidgetResizable(true);
+        scrollArea->setWidget(charts);
+
+        auto buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        VERIFY(connect(buttonBox, SIGNAL(rejected()), this, SLOT(reject())));
+        VERIFY(connect(server, SIGNAL(destroyed()), this, SLOT(serverDestroyed())));
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addLayout(topLayout);
+        layout->addWidget(scrollArea, 1);
+        layout->addWidget(buttonBox);
+        setLayout(layout);
+
+        _timer = new QTimer(this);
+        _timer->setInterval(defaultIntervalSec * 1000);
+        VERIFY(connect(_timer, SIGNAL(timeout()), this, SLOT(poll())));
+        _timer->start();
+        poll();
+    }
+
+    void ServerMonitorDialog::reject()
+    {
+        _timer->stop();
+
+        // Response of pending request is still on its way to this dialog,
+        // it is closed (and deleted) in handle() when response arrives
+        if (_requestPending) {
+            _closeRequested = true;
+            hide();
+            return;
+        }
+
+        QDialog::reject();
+    }
+
+    void ServerMonitorDialog::poll()
+    {
+        // Slow server is polled as often as it is able to answer, requests are not queued
+        if (_requestPending || !_server)
+            return;
+
+        _requestPending = true;
+        AppRegistry::instance().bus()->send(_server->monitorWorker(), new ServerStatusRequest(this));
+    }
+
+    void ServerMonitorDialog::changeInterval(int seconds)
+    {
+        _timer->setInterval(seconds * 1000);
+    }
+
+    void ServerMonitorDialog::serverDestroyed()
+    {
+        // Worker of deleted server drops pending response, it is not waited for
+        _timer->stop();
+        _requestPending = false;
+        QDialog::reject();
+    }
+
+    void ServerMonitorDialog::handle(ServerStatusResponse *event)
+    {
+        _requestPending = false;
+        if (_closeRequested) {
+            QDialog::reject();
+            return;
+        }
+
+        if (event->isError()) {
+            _status->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        int failed = 0;
+        for (auto const& sample : event->samples()) {
+            Member &info = member(sample.host);
+            if (!sample.error.empty()) {
+                ++failed;
+                info.header->setText(QString("<b>%1</b><br><font color='red'>unreachable</font>")
+                                     .arg(QtUtils::toQString(sample.host)));
+                info.header->setToolTip(QtUtils::toQString(sample.error));
+                info.last = sample;
+                continue;
+            }
+
+            ServerStatusPoint point;
+            if (ServerStatusSample::computePoint(info.last, sample, point)) {
+                info.points.push(point);
+                for (auto chart : info.charts)
+                    chart->update();
+            }
+
+            info.header->setText(QString("<b>%1</b>").arg(QtUtils::toQString(sample.host)));
+            info.header->setToolTip(QString());
+            info.last = sample;
+        }
+
+        _status->setText(failed ? QString("%1 of %2 members unreachable").arg(failed).arg(event->samples().size())
+                                : QString("%1 members").arg(event->samples().size()));
+    }
+
+    ServerMonitorDialog::Member &ServerMonitorDialog::member(const std::string &host)
+    {
+        std::unique_ptr<Member> &info = _members[host];
+        if (info)
+            return *info;
+
+        info.reset(new Member);
+        info->column = static_cast<int>(_members.size());
+        info->header = new QLabel;
+        info->header->setAlignment(Qt::AlignCenter);
+        _grid->addWidget(info->header, 0, info->column);
+
+        for (int metric = 0; metric < ServerMetricCount; ++metric) {
+            auto chart = new SparklineWidget(info->points, static_cast<ServerMetric>(metric));
+            _grid->addWidget(chart, metric + 1, info->column);
+            info->charts.push_back(chart);
+        }
+        _grid->setColumnStretch(info->column, 1);
+        return *info;
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <QDialog>
+#include <QPointer>
+
+#include "robomongo/core/domain/ServerStatusSample.h"
+#include "robomongo/core/utils/RingBuffer.h"
+
+QT_BEGIN_NAMESPACE
+class QGridLayout;
+class QLabel;
+class QSpinBox;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class ServerStatusResponse;
+
+    /**
+     * @brief Live charts of operation rates, network, queues, cache and connections of every
+     *        member of server. serverStatus is polled by MonitorWorker on its own connections,
+     *        rates are computed from two consecutive samples and kept in fixed-size history.
+     *
+     *        Dialog is not modal and deletes itself when closed or when its server is deleted.
+     */
+    class ServerMonitorDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        // Number of points kept for every member (5 minutes at default interval)
+        enum { historySize = 300 };
+        enum { defaultIntervalSec = 1 };
+
+        explicit ServerMonitorDialog(MongoServer *server, QWidget *parent = nullptr);
+
+    public Q_SLOTS:
+        virtual void reject();
+        void handle(ServerStatusResponse *event);
+
+    private Q_SLOTS:
+        void poll();
+        void changeInterval(int seconds);
+        void serverDestroyed();
+
+    private:
+        struct Member
+        {
+            Member() : points(historySize), column(0), header(nullptr) {}
+
+            ServerStatusSample last;
+            RingBuffer<ServerStatusPoint> points;
+            int column;
+            QLabel *header;
+            std::vector<QWidget *> charts;
+        };
+
+        Member &member(const std::string &host);
+
+        QPointer<MongoServer> _server;
+        bool _requestPending;
+        bool _closeRequested;    // dialog is closed when pending request finishes
+
+        std::map<std::string, std::unique_ptr<Member>> _members;
+
+        QTimer *_timer;
+        QSpinBox *_interval;
+        QLabel *_status;
+        QGridLayout *_grid;
+    };
+}
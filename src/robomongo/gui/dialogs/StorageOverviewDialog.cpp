@@ -0,0 +1,233 @@
+#include "robomongo/gui/dialogs/StorageOverviewDialog.h"
+
+#include <QDialogButtonBox>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/MonitorWorker.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    enum Column
+    {
+        DatabaseColumn,
+        CollectionColumn,
+        DocumentsColumn,
+        DataSizeColumn,
+        StorageSizeColumn,
+        IndexSizeColumn,
+        IndexesColumn,
+        IndexRatioColumn
+    };
+
+    // Numeric columns are sorted by value kept in Qt::UserRole, not by displayed text
+    class StatsItem : public QTreeWidgetItem
+    {
+    public:
+        virtual bool operator<(const QTreeWidgetItem &other) const
+        {
+            int const column = treeWidget() ? treeWidget()->sortColumn() : DatabaseColumn;
+            if (column <= CollectionColumn)
+                return QString::compare(text(column), other.text(column), Qt::CaseInsensitive) < 0;
+
+            return data(column, Qt::UserRole).toDouble() < other.data(column, Qt::UserRole).toDouble();
+        }
+
+        void setValue(int column, double value, const QString &text)
+        {
+            setData(column, Qt::UserRole, value);
+            setText(column, text);
+            setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+        }
+    };
+}
+
+namespace Robomongo
+{
+    StorageOverviewDialog::StorageOverviewDialog(MongoServer *server, QWidget *parent) :
+        QDialog(parent),
+        _server(server),
+        _closeRequested(false),
+        _databases(0),
+        _collections(0),
+        _documents(0),
+        _dataSize(0),
+        _storageSize(0),
+        _indexSize(0)
+    {
+        setWindowTitle(QString("Storage Overview - %1")
+                       .arg(QtUtils::toQString(server->connectionRecord()->getFullAddress())));
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+        resize(1000, 550);
+
+        _summary = new QLabel;
+        _summary->setTextInteractionFlags(Qt::TextSelectableByMouse);
+
+        _tree = new QTreeWidget;
+        _tree->setRootIsDecorated(false);
+        _tree->setAlternatingRowColors(true);
+        _tree->setUniformRowHeights(true);
+        _tree->setHeaderLabels(QStringList() << "Database" << "Collection" << "Documents" << "Data Size"
+                               << "Storage Size" << "Index Size" << "Indexes" << "Index / Data");
+        _tree->header()->setSectionResizeMode(CollectionColumn, QHeaderView::Stretch);
+        _tree->header()->setStretchLastSection(false);
+        _tree->setSortingEnabled(true);
+        _tree->sortByColumn(DataSizeColumn, Qt::DescendingOrder);
+
+        _status = new QLabel;
+
+        auto buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        _refreshButton = buttonBox->addButton("&Refresh", QDialogButtonBox::ActionRole);
+        VERIFY(connect(_refreshButton, SIGNAL(clicked()), this, SLOT(refresh())));
+        VERIFY(connect(buttonBox, SIGNAL(rejected()), this, SLOT(reject())));
+        VERIFY(connect(server, SIGNAL(destroyed()), this, SLOT(serverDestroyed())));
+
+        QHBoxLayout *bottomLayout = new QHBoxLayout;
+        bottomLayout->addWidget(_status, 1);
+        bottomLayout->addWidget(buttonBox);
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addWidget(_summary);
+        layout->addWidget(_tree);
+        layout->addLayout(bottomLayout);
+        setLayout(layout);
+
+        refresh();
+    }
+
+    void StorageOverviewDialog::reject()
+    {
+        // Responses of running request are still on their way to this dialog,
+        // it is closed (and deleted) in handle() when the last one arrives
+        if (_cancelled) {
+            *_cancelled = true;
+            _closeRequested = true;
+            hide();
+            return;
+        }
+
+        QDialog::reject();
+    }
+
+    void StorageOverviewDialog::refresh()
+    {
+        if (_cancelled || !_server)
+            return;
+
+        _tree->clear();
+        _databases = 0;
+        _collections = 0;
+        _documents = 0;
+        _dataSize = 0;
+        _storageSize = 0;
+        _indexSize = 0;
+        updateSummary();
+
+        _refreshButton->setEnabled(false);
+        _status->setText("Loading...");
+
+        _cancelled = std::make_shared<std::atomic<bool>>(false);
+        AppRegistry::instance().bus()->send(_server->monitorWorker(), new LoadStorageStatsRequest(this, _cancelled));
+    }
+
+    void StorageOverviewDialog::serverDestroyed()
+    {
+        // Worker of deleted server drops remaining responses, they are not waited for
+        if (_cancelled) {
+            *_cancelled = true;
+            _cancelled.reset();
+        }
+
+        QDialog::reject();
+    }
+
+    void StorageOverviewDialog::handle(LoadStorageStatsResponse *event)
+    {
+        if (event->finished()) {
+            _cancelled.reset();
+            _refreshButton->setEnabled(true);
+            if (_closeRequested) {
+                QDialog::reject();
+                return;
+            }
+        }
+
+        if (event->isError()) {
+            _status->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        // Sorting is applied once per batch, not once per row
+        _tree->setSortingEnabled(false);
+        QList<QTreeWidgetItem *> items;
+        for (auto const& stats : event->stats()) {
+            if (stats.isDatabase()) {
+                addDatabase(stats);
+                continue;
+            }
+
+            auto item = new StatsItem;
+            item->setText(DatabaseColumn, QtUtils::toQString(stats.dbName));
+            item->setText(CollectionColumn, QtUtils::toQString(stats.collectionName));
+            item->setValue(DocumentsColumn, stats.count, QString::number(stats.count));
+            item->setValue(DataSizeColumn, stats.dataSize, QtUtils::sizeString(stats.dataSize));
+            item->setValue(StorageSizeColumn, stats.storageSize, QtUtils::sizeString(stats.storageSize));
+            item->setValue(IndexSizeColumn, stats.indexSize, QtUtils::sizeString(stats.indexSize));
+            item->setValue(IndexesColumn, stats.indexes, QString::number(stats.indexes));
+
+            // Empty collections with indexes have the worst ratio of all
+            if (stats.dataSize > 0)
+                item->setValue(IndexRatioColumn, stats.indexSize / stats.dataSize,
+                               QString::number(stats.indexSize / stats.dataSize, 'f', 2));
+            else
+                item->setValue(IndexRatioColumn, stats.indexSize > 0 ? stats.indexSize : 0, "-");
+
+            items.append(item);
+        }
+        _tree->addTopLevelItems(items);
+        _tree->setSortingEnabled(true);
+
+        if (_tree->topLevelItemCount() == items.size()) {
+            for (int i = DocumentsColumn; i < _tree->columnCount(); ++i)
+                _tree->resizeColumnToContents(i);
+        }
+
+        updateSummary();
+
+        QString status = event->finished() ? QString("%1 collections").arg(_tree->topLevelItemCount())
+                                           : QString("Loading... %1 collections").arg(_tree->topLevelItemCount());
+        if (event->failed() > 0)
+            status += QString(", %1 failed (%2)").arg(event->failed()).arg(QtUtils::toQString(event->lastFailure()));
+        _status->setText(status);
+    }
+
+    void StorageOverviewDialog::addDatabase(const StorageStatsInfo &stats)
+    {
+        ++_databases;
+        _collections += stats.collections;
+        _documents += stats.count;
+        _dataSize += stats.dataSize;
+        _storageSize += stats.storageSize;
+        _indexSize += stats.indexSize;
+    }
+
+    void StorageOverviewDialog::updateSummary()
+    {
+        _summary->setText(QString("<b>%1</b> databases, <b>%2</b> collections, <b>%3</b> documents. "
+                                  "Data: <b>%4</b>, storage: <b>%5</b>, indexes: <b>%6</b>")
+                          .arg(_databases).arg(_collections).arg(_documents)
+                          .arg(QtUtils::sizeString(_dataSize)).arg(QtUtils::sizeString(_storageSize))
+                          .arg(QtUtils::sizeString(_indexSize)));
+    }
+}
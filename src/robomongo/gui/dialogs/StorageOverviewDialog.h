@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <QDialog>
+#include <QPointer>
+
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QPushButton;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class LoadStorageStatsResponse;
+    struct StorageStatsInfo;
+
+    /**
+     * @brief Data, storage and index sizes of all collections of server in one sortable table,
+     *        together with totals of all databases. Statistics are loaded by MonitorWorker over
+     *        several connections at once (see LoadStorageStatsRequest), rows are added as they arrive.
+     *
+     *        Dialog is not modal and deletes itself when closed or when its server is deleted.
+     */
+    class StorageOverviewDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        explicit StorageOverviewDialog(MongoServer *server, QWidget *parent = nullptr);
+
+    public Q_SLOTS:
+        virtual void reject();
+        void handle(LoadStorageStatsResponse *event);
+
+    private Q_SLOTS:
+        void refresh();
+        void serverDestroyed();
+
+    private:
+        void addDatabase(const StorageStatsInfo &stats);
+        void updateSummary();
+
+        QPointer<MongoServer> _server;
+        std::shared_ptr<std::atomic<bool>> _cancelled;  // of running request, null if there is no one
+        bool _closeRequested;                           // dialog is closed when running request finishes
+
+        // Totals of databases loaded so far
+        int _databases;
+        long long _collections;
+        long long _documents;
+        double _dataSize;
+        double _storageSize;
+        double _indexSize;
+
+        QTreeWidget *_tree;
+        QLabel *_summary;
+        QLabel *_status;
+        QPushButton *_refreshButton;
+    };
+}
@@ -0,0 +1,123 @@
+#include "robomongo/gui/dialogs/WorkerMetricsDialog.h"
+
+#include <QDialogButtonBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/mongodb/WorkerMetrics.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    QString formatUs(long long us)
+    {
+        if (us < 1000)
+            return QString("%1 us").arg(us);
+
+        if (us < 1000 * 1000)
+            return QString("%1 ms").arg(us / 1000.0, 0, 'f', 1);
+
+        return QString("%1 s").arg(us / 1000000.0, 0, 'f', 2);
+    }
+}
+
+namespace Robomongo
+{
+    WorkerMetricsDialog::WorkerMetricsDialog(QWidget *parent) :
+        QDialog(parent)
+    {
+        setWindowTitle("Worker Latency Statistics");
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        resize(1000, 450);
+
+        _tree = new QTreeWidget;
+        _tree->setRootIsDecorated(true);
+        _tree->setAlternatingRowColors(true);
+        _tree->setSortingEnabled(true);
+        _tree->setHeaderLabels(QStringList() << "Operation" << "Count" << "Errors"
+                               << "Queue p50" << "Queue p99" << "Handler p50" << "Handler p95"
+                               << "Handler p99" << "Handler max" << "Total p99" << "Avg payload");
+        _tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+        _tree->header()->setStretchLastSection(false);
+
+        auto buttonBox = new QDialogButtonBox(QDialogButtonBox::Close);
+        QPushButton *refreshButton = buttonBox->addButton("&Refresh", QDialogButtonBox::ActionRole);
+        QPushButton *exportButton = buttonBox->addButton("&Export JSON...", QDialogButtonBox::ActionRole);
+        QPushButton *resetButton = buttonBox->addButton("Re&set", QDialogButtonBox::ResetRole);
+        VERIFY(connect(refreshButton, SIGNAL(clicked()), this, SLOT(refresh())));
+        VERIFY(connect(exportButton, SIGNAL(clicked()), this, SLOT(exportJson())));
+        VERIFY(connect(resetButton, SIGNAL(clicked()), this, SLOT(resetMetrics())));
+        VERIFY(connect(buttonBox, SIGNAL(rejected()), this, SLOT(reject())));
+
+        QVBoxLayout *layout = new QVBoxLayout;
+        layout->addWidget(_tree);
+        layout->addWidget(buttonBox);
+        setLayout(layout);
+
+        refresh();
+    }
+
+    void WorkerMetricsDialog::refresh()
+    {
+        _tree->clear();
+        _tree->setSortingEnabled(false);
+
+        for (auto const& cluster : WorkerMetricsRegistry::instance().clusters()) {
+            auto const handlers = cluster.second->snapshot();
+            if (handlers.empty())
+                continue;
+
+            auto clusterItem = new QTreeWidgetItem(_tree, QStringList() << QtUtils::toQString(cluster.first));
+            for (auto const& handler : handlers) {
+                HandlerMetrics const& metrics = handler.second;
+                long long const count = metrics.total.count();
+                QStringList columns;
+                columns << QtUtils::toQString(handler.first)
+                        << QString::number(count)
+                        << QString::number(metrics.errors)
+                        << formatUs(metrics.queueWait.valueAtPercentile(50))
+                        << formatUs(metrics.queueWait.valueAtPercentile(99))
+                        << formatUs(metrics.service.valueAtPercentile(50))
+                        << formatUs(metrics.service.valueAtPercentile(95))
+                        << formatUs(metrics.service.valueAtPercentile(99))
+                        << formatUs(metrics.service.max())
+                        << formatUs(metrics.total.valueAtPercentile(99))
+                        << QString("%1 KB").arg(count ? metrics.payloadBytes / 1024.0 / count : 0, 0, 'f', 1);
+
+                auto item = new QTreeWidgetItem(clusterItem, columns);
+                for (int i = 1; i < columns.size(); ++i)
+                    item->setTextAlignment(i, Qt::AlignRight | Qt::AlignVCenter);
+            }
+            clusterItem->setExpanded(true);
+        }
+
+        _tree->setSortingEnabled(true);
+        for (int i = 1; i < _tree->columnCount(); ++i)
+            _tree->resizeColumnToContents(i);
+    }
+
+    void WorkerMetricsDialog::exportJson()
+    {
+        QString const path = QFileDialog::getSaveFileName(this, "Export Latency Statistics",
+                                                          "worker-metrics.json", "JSON (*.json)");
+        if (path.isEmpty())
+            return;
+
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+            file.write(WorkerMetricsRegistry::instance().toJson()) < 0) {
+            QMessageBox::warning(this, "Export Latency Statistics", "Failed to write file " + path);
+        }
+    }
+
+    void WorkerMetricsDialog::resetMetrics()
+    {
+        WorkerMetricsRegistry::instance().reset();
+        refresh();
+    }
+}
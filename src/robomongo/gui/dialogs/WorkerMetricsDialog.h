@@ -0,0 +1,30 @@
+#pragma once
+
+#include <QDialog>
+
+QT_BEGIN_NAMESPACE
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    /**
+     * @brief Shows per-cluster, per-request-type latency percentiles of MongoWorker handlers
+     *        (queue wait, handler execution and total time) and allows to export them as JSON.
+     */
+    class WorkerMetricsDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        explicit WorkerMetricsDialog(QWidget *parent = nullptr);
+
+    private Q_SLOTS:
+        void refresh();
+        void exportJson();
+        void resetMetrics();
+
+    private:
+        QTreeWidget *_tree;
+    };
+}
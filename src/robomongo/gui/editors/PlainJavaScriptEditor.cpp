@@ -1,8 +1,11 @@
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
 
+#include <algorithm>
+#include <limits>
 #include <QPainter>
 #include <QApplication>
 #include <QKeyEvent>
+#include <Qsci/qscilexer.h>
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/gui/GuiRegistry.h"
@@ -10,6 +13,9 @@
 
 namespace
 {
+    // KEYWORDSET_MAX of Scintilla
+    int const keywordSetMax = 8;
+
     /**
     * @brief Returns the number of digits in an 32-bit integer
     * http://stackoverflow.com/questions/1489830/efficient-way-to-determine-number-of-digits-in-an-integer
@@ -55,7 +61,8 @@ namespace Robomongo
         _ignoreEnterKey(false),
         _ignoreTabKey(false),
         _lineNumberDigitWidth(0),
-        _lineNumberMarginWidth(0)
+        _lineNumberMarginWidth(0),
+        _plainText(false)
     {
         setAutoIndent(true);
         setIndentationsUseTabs(false);
@@ -91,6 +98,11 @@ namespace Robomongo
         setLineNumbers(AppRegistry::instance().settingsManager()->lineNumbers());
         setUtf8(true);
         VERIFY(connect(this, SIGNAL(linesChanged()), this, SLOT(updateLineNumbersMarginWidth())));
+        VERIFY(connect(this, SIGNAL(SCN_MODIFIED(int, int, const char *, int, int, int, int, int, int, int)),
+                       this, SLOT(onModified(int, int, const char *, int, int, int, int, int, int, int))));
+
+        // Lexer is not changed while Scintilla notifies about modification
+        VERIFY(connect(this, SIGNAL(textChanged()), this, SLOT(updateHighlighting()), Qt::QueuedConnection));
     }
 
     int RoboScintilla::lineNumberMarginWidth() const
@@ -115,6 +127,12 @@ namespace Robomongo
         }
     }
 
+    void RoboScintilla::paintEvent(QPaintEvent *e)
+    {
+        styleVisibleText();
+        BaseClass::paintEvent(e);
+    }
+
     void RoboScintilla::setLineNumbers(bool displayNumbers)
     {
         if (displayNumbers) {
@@ -183,6 +201,86 @@ namespace Robomongo
         }
     }
 
+    void RoboScintilla::updateHighlighting()
+    {
+        if (!lexer())
+            return;
+
+        // Setting may be changed in preferences while editor is open
+        long const limit = AppRegistry::instance().settingsManager()->syntaxHighlightingLimitKb() * 1024L;
+        bool const plainText = limit > 0 && SendScintilla(SCI_GETLENGTH) > limit;
+        if (plainText == _plainText)
+            return;
+
+        _plainText = plainText;
+        _notLexed.clear();
+
+        // Null lexer styles text with default style of lexer as it becomes visible
+        if (_plainText) {
+            SendScintilla(SCI_SETLEXER, SCLEX_NULL);
+        } else {
+            // Styles are kept by editor, keywords and properties by Scintilla lexer which is created again.
+            // Not setLexer(): it resets all styles, including line numbers margin.
+            if (lexer()->lexer())
+                SendScintilla(SCI_SETLEXERLANGUAGE, lexer()->lexer());
+            else
+                SendScintilla(SCI_SETLEXER, lexer()->lexerId());
+
+            for (int set = 0; set <= keywordSetMax; ++set) {
+                const char *keywords = lexer()->keywords(set + 1);
+                SendScintilla(SCI_SETKEYWORDS, static_cast<unsigned long>(set), keywords ? keywords : "");
+            }
+
+            SendScintilla(SCI_SETPROPERTY, "fold", "1");
+            lexer()->refreshProperties();
+        }
+
+        SendScintilla(SCI_STARTSTYLING, 0UL, (1L << SendScintilla(SCI_GETSTYLEBITS)) - 1);
+        update();
+    }
+
+    void RoboScintilla::onModified(int position, int modificationType, const char *, int length, int,
+                                   int, int, int, int, int)
+    {
+        if (modificationType & SC_MOD_INSERTTEXT)
+            _notLexed.inserted(position, length);
+        else if (modificationType & SC_MOD_DELETETEXT)
+            _notLexed.removed(position, length);
+        else
+            return;
+
+        // Text after the new end of styled text is lexed again by Scintilla (or skipped
+        // again by styleVisibleText()), so it is not tracked any longer
+        int const endStyled = static_cast<int>(SendScintilla(SCI_GETENDSTYLED));
+        _notLexed.remove(endStyled, std::numeric_limits<int>::max());
+    }
+
+    void RoboScintilla::styleVisibleText()
+    {
+        if (!lexer() || _plainText)
+            return;
+
+        long const lineCount = SendScintilla(SCI_GETLINECOUNT);
+        long const firstLine = SendScintilla(SCI_DOCLINEFROMVISIBLE, SendScintilla(SCI_GETFIRSTVISIBLELINE));
+        long const lastLine = firstLine + SendScintilla(SCI_LINESONSCREEN) + highlightingMarginLines;
+        long const begin = SendScintilla(SCI_POSITIONFROMLINE, std::max(0L, firstLine - highlightingMarginLines));
+        long const end = lastLine < lineCount ? SendScintilla(SCI_POSITIONFROMLINE, lastLine) : SendScintilla(SCI_GETLENGTH);
+
+        // Scintilla lexes from the start of line of the last styled position up to the visible end
+        long const endStyled = SendScintilla(SCI_POSITIONFROMLINE, SendScintilla(SCI_LINEFROMPOSITION, SendScintilla(SCI_GETENDSTYLED)));
+        if (begin > endStyled) {
+            SendScintilla(SCI_STARTSTYLING, static_cast<unsigned long>(endStyled), (1L << SendScintilla(SCI_GETSTYLEBITS)) - 1);
+            SendScintilla(SCI_SETSTYLING, static_cast<unsigned long>(begin - endStyled), 0L);   // default style of lexer
+            _notLexed.add(endStyled, begin);
+        }
+
+        // Start of skipped text is lexed in the default state, as if it followed new line
+        for (const TextRangeSet::Range &range : _notLexed.intersect(begin, end)) {
+            _notLexed.remove(range.first, range.second);
+            SendScintilla(SCI_COLOURISE, static_cast<unsigned long>(range.first), static_cast<long>(range.second));
+        }
+    }
+
     void RoboScintilla::setAppropriateBraceMatching() {
 #ifdef Q_OS_MAC
         // On Mac OS when brace matching is enabled, text
@@ -2,6 +2,8 @@
 
 #include <Qsci/qsciscintilla.h>
 
+#include "robomongo/core/utils/TextRangeSet.h"
+
 namespace Robomongo
 {
     class RoboScintilla : public QsciScintilla
@@ -10,6 +12,7 @@ namespace Robomongo
     public:
         typedef QsciScintilla BaseClass;
         enum { rowNumberWidth = 6, indentationWidth = 4 };
+        enum { highlightingMarginLines = 100 };     // lexed lines above and below visible ones
         static const QColor marginsBackgroundColor;
         static const QColor caretForegroundColor;
         static const QColor matchedBraceForegroundColor;
@@ -24,16 +27,30 @@ namespace Robomongo
     protected:
         void wheelEvent(QWheelEvent *e);
         void keyPressEvent(QKeyEvent *e);
+        void paintEvent(QPaintEvent *e);
 
     private Q_SLOTS:
         void updateLineNumbersMarginWidth();
+        void updateHighlighting();
+        void onModified(int position, int modificationType, const char *text, int length, int linesAdded,
+                        int line, int foldNow, int foldPrev, int token, int annotationLinesAdded);
 
     private:
         void setLineNumbers(bool displayNumbers);
         void toggleLineNumbers();
+
+        /**
+         * @brief Lex only visible lines with margin. Text between the last lexed position and
+         *        them is marked as styled without lexing, it is lexed when it becomes visible.
+         */
+        void styleVisibleText();
+
         bool _ignoreEnterKey;
         bool _ignoreTabKey;
         int _lineNumberMarginWidth;
         int _lineNumberDigitWidth;
+
+        bool _plainText;                    // text is larger than limit, lexer is not used
+        TextRangeSet _notLexed;             // styled with default style by styleVisibleText()
     };
 }
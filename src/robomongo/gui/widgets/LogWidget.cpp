@@ -3,10 +3,12 @@
 #include <QHBoxLayout>
 #include <QScrollBar>
 #include <QMenu>
-#include <QTime>
+#include <QDateTime>
 #include <QAction>
 #include <QPlainTextEdit>
+#include <QTextDocument>
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/dialogs/WorkerMetricsDialog.h"
 
 namespace Robomongo
 {
@@ -14,6 +16,7 @@ namespace Robomongo
         : BaseClass(parent), _logTextEdit(new QTextEdit(this))
     {
         _logTextEdit->setReadOnly(true);
+        _logTextEdit->document()->setMaximumBlockCount(maxLines);
         _logTextEdit->setContextMenuPolicy(Qt::CustomContextMenu);
         VERIFY(connect(_logTextEdit, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(showContextMenu(const QPoint &))));
         QHBoxLayout *hlayout = new QHBoxLayout;
@@ -21,6 +24,8 @@ namespace Robomongo
         hlayout->addWidget(_logTextEdit);
         _clear = new QAction("Clear All", this);
         VERIFY(connect(_clear, SIGNAL(triggered()), _logTextEdit, SLOT(clear())));
+        _workerMetrics = new QAction("Latency Statistics...", this);
+        VERIFY(connect(_workerMetrics, SIGNAL(triggered()), this, SLOT(showWorkerMetrics())));
         setLayout(hlayout);      
     }
 
@@ -29,43 +34,53 @@ namespace Robomongo
         QMenu *menu = _logTextEdit->createStandardContextMenu();
         menu->addAction(_clear);
         _clear->setEnabled(!_logTextEdit->toPlainText().isEmpty());
+        menu->addSeparator();
+        menu->addAction(_workerMetrics);
 
         menu->exec(_logTextEdit->mapToGlobal(pt));
         delete menu;
     }
 
-    void LogWidget::addMessage(const QString &message, mongo::logger::LogSeverity level)
+    void LogWidget::showWorkerMetrics()
     {
-        // Print time
-        QTime time = QTime::currentTime();
-        _logTextEdit->moveCursor (QTextCursor::End);
-        _logTextEdit->setTextColor(QColor("#aaaaaa"));
-        _logTextEdit->insertPlainText(time.toString("h:mm:ss AP") + "\t");
+        WorkerMetricsDialog dialog(this);
+        dialog.exec();
+    }
+
+    void LogWidget::addMessages(const LogEntries &entries)
+    {
+        for (auto const& entry : entries) {
+            // Print time
+            _logTextEdit->moveCursor (QTextCursor::End);
+            _logTextEdit->setTextColor(QColor("#aaaaaa"));
+            _logTextEdit->insertPlainText(QDateTime::fromMSecsSinceEpoch(entry.timeMs).time().toString("h:mm:ss AP") + "\t");
 
-        // Print message
-        _logTextEdit->moveCursor (QTextCursor::End);
+            // Print message
+            _logTextEdit->moveCursor (QTextCursor::End);
 
-        // Nice color for the future: "#CD9800" :)
+            // Nice color for the future: "#CD9800" :)
 
-        QColor textColor = QColor(Qt::black);
+            QColor textColor = QColor(Qt::black);
 
-        if (level == mongo::logger::LogSeverity::Error())
-            textColor = QColor("#CD0000");
-        else if (level == mongo::logger::LogSeverity::Log())
-            textColor = QColor("#777777");
-        else if (level == mongo::logger::LogSeverity::Warning())
-            textColor = QColor("#CD9800");
+            mongo::logger::LogSeverity const level = mongo::logger::LogSeverity::cast(entry.severity);
+            if (level == mongo::logger::LogSeverity::Error())
+                textColor = QColor("#CD0000");
+            else if (level == mongo::logger::LogSeverity::Log())
+                textColor = QColor("#777777");
+            else if (level == mongo::logger::LogSeverity::Warning())
+                textColor = QColor("#CD9800");
 
-        _logTextEdit->setTextColor(textColor);
+            _logTextEdit->setTextColor(textColor);
 
-        const int maxLength = 500;
-        if (message.length() <= maxLength) {
-            _logTextEdit->insertPlainText(message.trimmed() + "\n");
-        } else {
-            _logTextEdit->insertPlainText(QString("(truncated) ") + message.left(maxLength).trimmed() + "...\n");
+            const int maxLength = 500;
+            if (entry.message.length() <= maxLength) {
+                _logTextEdit->insertPlainText(entry.message.trimmed() + "\n");
+            } else {
+                _logTextEdit->insertPlainText(QString("(truncated) ") + entry.message.left(maxLength).trimmed() + "...\n");
+            }
         }
 
-        // Scroll to the bottom
+        // Scroll to the bottom once per batch
         QScrollBar *sb = _logTextEdit->verticalScrollBar();
         sb->setValue(sb->maximum());
     }
@@ -2,7 +2,7 @@
 
 
 #include <QWidget>
-#include <mongo/logger/log_severity.h>
+#include "robomongo/core/utils/Logger.h"
 QT_BEGIN_NAMESPACE
 class QTextEdit;
 class QAction;
@@ -18,15 +18,20 @@ namespace Robomongo
         typedef QWidget BaseClass;
         LogWidget(QWidget* parent = 0);        
 
+        // Oldest lines are removed above this count
+        enum { maxLines = 5000 };
+
     public Q_SLOTS:
-        void addMessage(const QString &message, mongo::logger::LogSeverity level);
+        void addMessages(const Robomongo::LogEntries &entries);
 
     private Q_SLOTS:
         void showContextMenu(const QPoint &pt);
+        void showWorkerMetrics();
 
     private:        
         QTextEdit *const _logTextEdit;
         QAction *_clear;
+        QAction *_workerMetrics;
     };
 
 }
@@ -1,13 +1,18 @@
 #include "robomongo/gui/widgets/explorer/ExplorerCollectionTreeItem.h"
 
+#include <algorithm>
 #include <QAction>
+#include <QDateTime>
 #include <QMenu>
+#include <QPointer>
 
 #include "robomongo/gui/widgets/explorer/EditIndexDialog.h"
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseTreeItem.h"
 #include "robomongo/gui/dialogs/CreateDatabaseDialog.h"
 #include "robomongo/gui/dialogs/CopyCollectionDialog.h"
 #include "robomongo/gui/dialogs/DocumentTextEditor.h"
+#include "robomongo/gui/dialogs/ExportDialog.h"
+#include "robomongo/gui/dialogs/ImportDialog.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/gui/utils/DialogUtils.h"
 
@@ -22,17 +27,36 @@
 namespace
 {
     const char *tooltipTemplate =
-        "%s "
+        "%1 "
         "<table>"
-        "<tr><td>Count:</td> <td><b>&nbsp;&nbsp;%lld</b></td></tr>"
-        "<tr><td>Size:</td><td><b>&nbsp;&nbsp;%s</b></td></tr>"
+        "<tr><td>Count:</td> <td><b>&nbsp;&nbsp;%2</b></td></tr>"
+        "<tr><td>Size:</td><td><b>&nbsp;&nbsp;%3</b></td></tr>"
+        "<tr><td>Storage size:</td><td><b>&nbsp;&nbsp;%4</b></td></tr>"
         "</table>"
         ;
+
+    const char *tooltipRowTemplate = "<tr><td>%1</td><td><b>&nbsp;&nbsp;%2</b></td></tr>";
+
+    QString dateString(long long msSinceEpoch)
+    {
+        return QDateTime::fromMSecsSinceEpoch(msSinceEpoch).toString("yyyy-MM-dd HH:mm");
+    }
+
+    // Short form of document count, shown next to collection name: 950, 12.3K, 4.5M
+    QString countString(long long count)
+    {
+        if (count < 1000)
+            return QString::number(count);
+        if (count < 1000 * 1000)
+            return QString("%1K").arg(count / 1000.0, 0, 'f', 1);
+        if (count < 1000 * 1000 * 1000)
+            return QString("%1M").arg(count / (1000.0 * 1000), 0, 'f', 1);
+        return QString("%1B").arg(count / (1000.0 * 1000 * 1000), 0, 'f', 1);
+    }
 }
 
 namespace Robomongo
 {
-    R_REGISTER_EVENT(CollectionIndexesLoadingEvent)
     const QString ExplorerCollectionDirIndexesTreeItem::labelText = "Indexes";
 
 /* ------------ Class ExplorerCollectionDirIndexesTreeItem ------------ */
@@ -164,6 +188,37 @@ namespace Robomongo
         setIcon(0, Robomongo::GuiRegistry::instance().indexIcon());
     }
 
+    void ExplorerCollectionIndexesTreeItem::updateStats(const IndexStatsInfo &stats)
+    {
+        QString rows;
+        if (stats.sizeBytes >= 0)
+            rows += QString(tooltipRowTemplate).arg("Size:").arg(QtUtils::sizeString(stats.sizeBytes));
+
+        if (!stats.members.empty()) {
+            long long const ops = stats.totalOps();
+            rows += QString(tooltipRowTemplate).arg("Operations:").arg(ops);
+            rows += QString(tooltipRowTemplate).arg("Last used:")
+                .arg(stats.lastUsedMs ? dateString(stats.lastUsedMs) : QString("not seen"));
+
+            // Counters are kept by every member separately, since its restart
+            if (stats.members.size() > 1 || ops == 0) {
+                for (auto const& member : stats.members) {
+                    rows += QString(tooltipRowTemplate).arg(QtUtils::toQString(member.host).toHtmlEscaped() + ":",
+                        QString("%1 since %2").arg(member.ops).arg(dateString(member.sinceMs)));
+                }
+            }
+
+            // Unused indexes only cost writes and memory, make them stand out
+            setText(1, countString(ops));
+            setForeground(1, QBrush(ops == 0 ? Qt::darkRed : Qt::gray));
+            setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+        }
+
+        QString const toolTip = QString("%1 <table>%2</table>").arg(text(0).toHtmlEscaped(), rows);
+        setToolTip(0, toolTip);
+        setToolTip(1, toolTip);
+    }
+
     void ExplorerCollectionIndexesTreeItem::ui_dropIndex()
     {
         // Ask user
@@ -207,89 +262,83 @@ namespace Robomongo
 
 /* ------------ Class ExplorerCollectionTreeItem ------------ */
     ExplorerCollectionTreeItem::ExplorerCollectionTreeItem(QTreeWidgetItem *parent, ExplorerDatabaseTreeItem *databaseItem, MongoCollection *collection) :
-        BaseClass(parent), _collection(collection), _databaseItem(databaseItem)
+        BaseClass(parent, false), _indexDir(NULL), _collection(collection), _databaseItem(databaseItem)
     {
-        QAction *addDocument = new QAction("Insert Document...", this);
-        VERIFY(connect(addDocument, SIGNAL(triggered()), SLOT(ui_addDocument())));
-
-        QAction *updateDocument = new QAction("Update Documents...", this);
-        VERIFY(connect(updateDocument, SIGNAL(triggered()), SLOT(ui_updateDocument())));
-        QAction *removeDocument = new QAction("Remove Documents...", this);
-        VERIFY(connect(removeDocument, SIGNAL(triggered()), SLOT(ui_removeDocument())));
-
-        QAction *removeAllDocuments = new QAction("Remove All Documents...", this);
-        VERIFY(connect(removeAllDocuments, SIGNAL(triggered()), SLOT(ui_removeAllDocuments())));
-
-        QAction *collectionStats = new QAction("Statistics", this);
-        VERIFY(connect(collectionStats, SIGNAL(triggered()), SLOT(ui_collectionStatistics())));
-
-        QAction *storageSize = new QAction("Storage Size", this);
-        VERIFY(connect(storageSize, SIGNAL(triggered()), SLOT(ui_storageSize())));
-
-        QAction *totalIndexSize = new QAction("Total Index Size", this);
-        VERIFY(connect(totalIndexSize, SIGNAL(triggered()), SLOT(ui_totalIndexSize())));
-
-        QAction *totalSize = new QAction("Total Size", this);
-        VERIFY(connect(totalSize, SIGNAL(triggered()), SLOT(ui_totalSize())));
-        QAction *shardVersion = new QAction("Shard Version", this);
-        VERIFY(connect(shardVersion, SIGNAL(triggered()), SLOT(ui_shardVersion())));
-
-        QAction *shardDistribution = new QAction("Shard Distribution", this);
-        VERIFY(connect(shardDistribution, SIGNAL(triggered()), SLOT(ui_shardDistribution())));
-
-        QAction *dropCollection = new QAction("Drop Collection...", this);
-        VERIFY(connect(dropCollection, SIGNAL(triggered()), SLOT(ui_dropCollection())));
-
-        QAction *renameCollection = new QAction("Rename Collection...", this);
-        VERIFY(connect(renameCollection, SIGNAL(triggered()), SLOT(ui_renameCollection())));
-        QAction *duplicateCollection = new QAction("Duplicate Collection...", this);
-        VERIFY(connect(duplicateCollection, SIGNAL(triggered()), SLOT(ui_duplicateCollection())));
-
-        // Disabling for 0.8.5 release as this is currently a broken misfeature (see discussion on issue #398)
-        // QAction *copyCollectionToDiffrentServer = new QAction("Copy Collection to Database...", this);
-        // VERIFY(connect(copyCollectionToDiffrentServer, SIGNAL(triggered()), SLOT(ui_copyToCollectionToDiffrentServer())));
-
-        QAction *viewCollection = new QAction("View Documents", this);
-        VERIFY(connect(viewCollection, SIGNAL(triggered()), SLOT(ui_viewCollection())));
-
-        BaseClass::_contextMenu->addAction(viewCollection);
-        BaseClass::_contextMenu->addSeparator();
-        BaseClass::_contextMenu->addAction(addDocument);
-        BaseClass::_contextMenu->addAction(updateDocument);
-        BaseClass::_contextMenu->addAction(removeDocument);
-        BaseClass::_contextMenu->addAction(removeAllDocuments);
-        BaseClass::_contextMenu->addSeparator();
-        BaseClass::_contextMenu->addAction(renameCollection);
-        BaseClass::_contextMenu->addAction(duplicateCollection);
-        // Disabling for 0.8.5 release as this is currently a broken misfeature (see discussion on issue #398)
-        // BaseClass::_contextMenu->addAction(copyCollectionToDiffrentServer);
-        BaseClass::_contextMenu->addAction(dropCollection);
-        BaseClass::_contextMenu->addSeparator();
-        BaseClass::_contextMenu->addAction(collectionStats);
-        BaseClass::_contextMenu->addSeparator();
-        BaseClass::_contextMenu->addAction(shardVersion);
-        BaseClass::_contextMenu->addAction(shardDistribution);
-
-        AppRegistry::instance().bus()->subscribe(_databaseItem, LoadCollectionIndexesResponse::Type, this);
-        AppRegistry::instance().bus()->subscribe(_databaseItem, DeleteCollectionIndexResponse::Type, this);
-        AppRegistry::instance().bus()->subscribe(this, CollectionIndexesLoadingEvent::Type, this);
-
         setText(0, QtUtils::toQString(_collection->name()));
         setIcon(0, GuiRegistry::instance().collectionIcon());
-
-        _indexDir = new ExplorerCollectionDirIndexesTreeItem(this);
-        addChild(_indexDir);
+        updateStats();
 
         setExpanded(false);
         setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
     }
 
+    void ExplorerCollectionTreeItem::showContextMenuAtPos(const QPoint &pos)
+    {
+        typedef void (ExplorerCollectionTreeItem::*Handler)();
+        struct MenuEntry { const char *text; Handler handler; };
+
+        // Null text is a separator
+        static const MenuEntry entries[] = {
+            { "View Documents", &ExplorerCollectionTreeItem::ui_viewCollection },
+            { NULL, NULL },
+            { "Insert Document...", &ExplorerCollectionTreeItem::ui_addDocument },
+            { "Import JSON...", &ExplorerCollectionTreeItem::ui_importDocuments },
+            { "Export Documents...", &ExplorerCollectionTreeItem::ui_exportDocuments },
+            { "Update Documents...", &ExplorerCollectionTreeItem::ui_updateDocument },
+            { "Remove Documents...", &ExplorerCollectionTreeItem::ui_removeDocument },
+            { "Remove All Documents...", &ExplorerCollectionTreeItem::ui_removeAllDocuments },
+            { NULL, NULL },
+            { "Rename Collection...", &ExplorerCollectionTreeItem::ui_renameCollection },
+            { "Duplicate Collection...", &ExplorerCollectionTreeItem::ui_duplicateCollection },
+            // Disabling for 0.8.5 release as this is currently a broken misfeature (see discussion on issue #398)
+            // { "Copy Collection to Database...", &ExplorerCollectionTreeItem::ui_copyToCollectionToDiffrentServer },
+            { "Drop Collection...", &ExplorerCollectionTreeItem::ui_dropCollection },
+            { NULL, NULL },
+            { "Statistics", &ExplorerCollectionTreeItem::ui_collectionStatistics },
+            { NULL, NULL },
+            { "Shard Version", &ExplorerCollectionTreeItem::ui_shardVersion },
+            { "Shard Distribution", &ExplorerCollectionTreeItem::ui_shardDistribution }
+        };
+
+        // One menu for all collections, created on first use
+        static QPointer<QMenu> menu;
+        if (!menu) {
+            menu = new QMenu(treeWidget());
+            for (int i = 0; i < static_cast<int>(sizeof(entries) / sizeof(entries[0])); ++i) {
+                if (!entries[i].text) {
+                    menu->addSeparator();
+                    continue;
+                }
+                QAction *action = menu->addAction(entries[i].text);
+                action->setData(i);
+            }
+        }
+
+        // Item may be deleted while menu is shown (i.e. collection list is refreshed)
+        QPointer<ExplorerCollectionTreeItem> self(this);
+        QAction *chosen = menu->exec(pos);
+        if (!chosen || !self)
+            return;
+
+        (this->*entries[chosen->data().toInt()].handler)();
+    }
+
+    ExplorerCollectionDirIndexesTreeItem *ExplorerCollectionTreeItem::indexDir()
+    {
+        if (!_indexDir) {
+            _indexDir = new ExplorerCollectionDirIndexesTreeItem(this);
+            addChild(_indexDir);
+        }
+        return _indexDir;
+    }
+
     void ExplorerCollectionTreeItem::handle(LoadCollectionIndexesResponse *event)
     {
+        ExplorerCollectionDirIndexesTreeItem *const dir = indexDir();
         if (event->isError()) {
-            _indexDir->setText(0, "Indexes");
-            _indexDir->setExpanded(false);
-            QtUtils::clearChildItems(_indexDir);
+            dir->setText(0, "Indexes");
+            dir->setExpanded(false);
+            QtUtils::clearChildItems(dir);
 
             std::stringstream ss;
             ss << "Cannot load list of indexes.\n\nError:\n" << event->error().errorMessage();
@@ -298,17 +347,40 @@ namespace Robomongo
             return;
         }
 
-        QtUtils::clearChildItems(_indexDir);
+        QtUtils::clearChildItems(dir);
         const std::vector<EnsureIndexInfo> &indexes = event->indexes();
 
         // Do not expand, when we do not have functions
         if (indexes.size() == 0)
-            _indexDir->setExpanded(false);
+            dir->setExpanded(false);
 
         for (std::vector<EnsureIndexInfo>::const_iterator it = indexes.begin(); it != indexes.end(); ++it) {
-            _indexDir->addChild(new ExplorerCollectionIndexesTreeItem(_indexDir, *it));
+            dir->addChild(new ExplorerCollectionIndexesTreeItem(dir, *it));
+        }
+        dir->setText(0, detail::buildName(ExplorerCollectionDirIndexesTreeItem::labelText, dir->childCount()));
+
+        if (!indexes.empty() && _databaseItem)
+            _databaseItem->loadIndexStats(this);
+    }
+
+    void ExplorerCollectionTreeItem::handle(LoadIndexStatsResponse *event)
+    {
+        // Index list is usable without statistics, error is logged by worker
+        if (event->isError() || !_indexDir)
+            return;
+
+        std::vector<IndexStatsInfo> const stats = event->stats();
+        for (int i = 0; i < _indexDir->childCount(); ++i) {
+            auto indexItem = dynamic_cast<ExplorerCollectionIndexesTreeItem *>(_indexDir->child(i));
+            if (!indexItem)
+                continue;
+
+            std::string const name = QtUtils::toStdString(indexItem->text(0));
+            auto const it = std::find_if(stats.begin(), stats.end(),
+                [&name](const IndexStatsInfo &info) { return info.name == name; });
+            if (it != stats.end())
+                indexItem->updateStats(*it);
         }
-        _indexDir->setText(0, detail::buildName(ExplorerCollectionDirIndexesTreeItem::labelText, _indexDir->childCount()));
     }
 
     void ExplorerCollectionTreeItem::handle(DeleteCollectionIndexResponse *event)
@@ -317,11 +389,13 @@ namespace Robomongo
             return;
         }
 
+        ExplorerCollectionDirIndexesTreeItem *const dir = indexDir();
+
         if (!event->index().empty()) {
-            int itemCount = _indexDir->childCount();
+            int itemCount = dir->childCount();
             QString eventIndex = QtUtils::toQString(event->index());
             for (int i = 0; i < itemCount; ++i) {
-                QTreeWidgetItem *item = _indexDir->child(i);
+                QTreeWidgetItem *item = dir->child(i);
                 if (item->text(0) == eventIndex) {
                     removeChild(item);
                     delete item;
@@ -329,20 +403,15 @@ namespace Robomongo
                 }
             }
         }
-        _indexDir->setText(0, detail::buildName(ExplorerCollectionDirIndexesTreeItem::labelText, _indexDir->childCount()));
-    }
-
-    void ExplorerCollectionTreeItem::handle(CollectionIndexesLoadingEvent *event)
-    {
-        _indexDir->setText(0, detail::buildName(ExplorerCollectionDirIndexesTreeItem::labelText, -1));
+        dir->setText(0, detail::buildName(ExplorerCollectionDirIndexesTreeItem::labelText, dir->childCount()));
     }
 
     void ExplorerCollectionTreeItem::expand()
     {
-         AppRegistry::instance().bus()->publish(new CollectionIndexesLoadingEvent(this));
-         if (_databaseItem) {
-             _databaseItem->expandColection(this);
-         }
+        indexDir()->setText(0, detail::buildName(ExplorerCollectionDirIndexesTreeItem::labelText, -1));
+        if (_databaseItem) {
+            _databaseItem->expandColection(this);
+        }
     }
 
     void ExplorerCollectionTreeItem::dropIndex(const QTreeWidgetItem * const ind)
@@ -353,12 +422,28 @@ namespace Robomongo
         _databaseItem->dropIndexFromCollection(this, QtUtils::toStdString(ind->text(0)));
     }
 
+    void ExplorerCollectionTreeItem::updateStats()
+    {
+        MongoCollectionInfo const info = _collection->info();
+        if (!info.hasStats())
+            return;
+
+        QString const toolTip = buildToolTip(_collection);
+        setText(1, countString(info.count()));
+        setForeground(1, QBrush(Qt::gray));
+        setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+        setToolTip(0, toolTip);
+        setToolTip(1, toolTip);
+    }
+
     QString ExplorerCollectionTreeItem::buildToolTip(MongoCollection *collection)
     {
-        // This function does not used now
-        char buff[2048] = {0};
-//        sprintf(buff,tooltipTemplate,collection->name().c_str(),collection->info().count(),collection->sizeString().c_str());
-        return buff;
+        MongoCollectionInfo const info = collection->info();
+        // One multi-arg call: chained arg() would replace "%2" and the like in collection name
+        return QString(tooltipTemplate).arg(QtUtils::toQString(collection->name()).toHtmlEscaped(),
+                                            QString::number(info.count()),
+                                            QtUtils::sizeString(info.sizeBytes()),
+                                            QtUtils::sizeString(info.storageSizeBytes()));
     }
 
     void ExplorerCollectionTreeItem::ui_addDocument()
@@ -380,6 +465,26 @@ namespace Robomongo
         }
     }
 
+    void ExplorerCollectionTreeItem::ui_importDocuments()
+    {
+        MongoDatabase *database = _collection->database();
+        MongoServer *server = database->server();
+
+        ImportDialog dlg(server->connectionRecord(), QtUtils::toQString(server->connectionRecord()->getFullAddress()),
+                         MongoNamespace(database->name(), _collection->name()), treeWidget());
+        dlg.exec();
+    }
+
+    void ExplorerCollectionTreeItem::ui_exportDocuments()
+    {
+        MongoDatabase *database = _collection->database();
+        MongoServer *server = database->server();
+
+        ExportDialog dlg(server->worker(), QtUtils::toQString(server->connectionRecord()->getFullAddress()),
+                         MongoNamespace(database->name(), _collection->name()), treeWidget());
+        dlg.exec();
+    }
+
     void ExplorerCollectionTreeItem::ui_removeDocument()
     {
         openCurrentCollectionShell(
@@ -10,34 +10,54 @@ namespace Robomongo
 {
     class LoadCollectionIndexesResponse;
     class DeleteCollectionIndexResponse;
+    class LoadIndexStatsResponse;
     class ExplorerCollectionDirIndexesTreeItem;
     class ExplorerDatabaseTreeItem;
 
-    class CollectionIndexesLoadingEvent : public Event
-    {
-        R_EVENT
-            CollectionIndexesLoadingEvent(QObject *sender) : Event(sender) {}
-    };
-
+    /**
+     * @brief Collection node. Databases may have tens of thousands of collections, so the node
+     *        is kept lightweight: no own context menu (one menu is shared by all collections,
+     *        see showContextMenuAtPos()), no event subscriptions and "Indexes" folder is
+     *        created only when the node is expanded for the first time.
+     */
     class ExplorerCollectionTreeItem: public ExplorerTreeItem
     {
         Q_OBJECT
     public:
         typedef ExplorerTreeItem BaseClass;
+
+        /**
+         * @param parent: may be null, item is then inserted into the tree by the caller
+         */
         ExplorerCollectionTreeItem(QTreeWidgetItem *parent, ExplorerDatabaseTreeItem *databaseItem, MongoCollection *collection);
         MongoCollection *collection() const { return _collection; }
+        virtual void showContextMenuAtPos(const QPoint &pos);
         void expand();
+
+        /**
+         * @brief "Indexes" folder of collection, created on the first call.
+         */
+        ExplorerCollectionDirIndexesTreeItem *indexDir();
+
         void dropIndex(const QTreeWidgetItem * const ind);
         void openCurrentCollectionShell(const QString &script, bool execute = true, const CursorPosition &cursor = CursorPosition());
         ExplorerDatabaseTreeItem *const databaseItem() const { return _databaseItem; }
 
+        /**
+         * @brief Show statistics of collection (document count next to name, sizes in tooltip),
+         *        if they are loaded. See ExplorerTreeWidget::loadVisibleCollectionStats()
+         */
+        void updateStats();
+
     public Q_SLOTS:
         void handle(LoadCollectionIndexesResponse *event);
         void handle(DeleteCollectionIndexResponse *event);
-        void handle(CollectionIndexesLoadingEvent *event);
+        void handle(LoadIndexStatsResponse *event);
 
     private Q_SLOTS:
         void ui_addDocument();
+        void ui_importDocuments();
+        void ui_exportDocuments();
         void ui_removeDocument();
         void ui_updateDocument();
         void ui_collectionStatistics();
@@ -55,7 +75,7 @@ namespace Robomongo
 
     private:
         QString buildToolTip(MongoCollection *collection);
-        ExplorerCollectionDirIndexesTreeItem *_indexDir;
+        ExplorerCollectionDirIndexesTreeItem *_indexDir;    // created on first expand
         MongoCollection *const _collection;
         ExplorerDatabaseTreeItem *const _databaseItem;
     };
@@ -85,6 +105,12 @@ namespace Robomongo
         typedef ExplorerTreeItem BaseClass;
         explicit ExplorerCollectionIndexesTreeItem(ExplorerCollectionDirIndexesTreeItem *parent, const EnsureIndexInfo &info);
 
+        /**
+         * @brief Show number of operations that used index next to its name,
+         *        size and usage per replica set member in tooltip.
+         */
+        void updateStats(const IndexStatsInfo &stats);
+
     private Q_SLOTS:
         void ui_dropIndex();
         void ui_edit();
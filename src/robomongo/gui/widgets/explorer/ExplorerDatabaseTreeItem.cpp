@@ -1,8 +1,12 @@
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseTreeItem.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include <QMessageBox>
 #include <QAction>
 #include <QMenu>
+#include <QTimer>
 
 #include "robomongo/core/domain/MongoDatabase.h"
 #include "robomongo/core/domain/MongoCollection.h"
@@ -15,6 +19,7 @@
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/EventBus.h"
 
+#include "robomongo/gui/dialogs/CurrentOpDialog.h"
 #include "robomongo/gui/widgets/explorer/ExplorerCollectionTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseCategoryTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerUserTreeItem.h"
@@ -24,6 +29,9 @@
 
 namespace
 {
+    // Collection items created in one pass of event loop, see ExplorerDatabaseTreeItem::fillCollectionItems()
+    const size_t CollectionItemsPerFill = 1000;
+
     void openCurrentDatabaseShell(Robomongo::MongoDatabase *database, const QString &script, bool execute = true, 
                                   const Robomongo::CursorPosition &cursor = Robomongo::CursorPosition())
     {
@@ -48,7 +56,10 @@ namespace Robomongo
         BaseClass(parent),
         _database(database),
         _bus(AppRegistry::instance().bus()),
-        _collectionSystemFolderItem(NULL)
+        _collectionSystemFolderItem(NULL),
+        _shownBegin(0),
+        _shownEnd(0),
+        _fillNext(0)
     {
         auto openDbShellAction = new QAction("Open Shell", this);
 #ifdef __APPLE__
@@ -88,6 +99,7 @@ namespace Robomongo
         BaseClass::_contextMenu->addAction(dbDrop);
 
         _bus->subscribe(this, MongoDatabaseCollectionListLoadedEvent::Type, _database);
+        _bus->subscribe(this, MongoDatabaseCollectionStatsLoadedEvent::Type, _database);
         _bus->subscribe(this, MongoDatabaseUsersLoadedEvent::Type, _database);
         _bus->subscribe(this, MongoDatabaseFunctionsLoadedEvent::Type, _database);
         _bus->subscribe(this, MongoDatabaseCollectionsLoadingEvent::Type, _database);
@@ -117,6 +129,11 @@ namespace Robomongo
         setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
     }
 
+    ExplorerDatabaseTreeItem::~ExplorerDatabaseTreeItem()
+    {
+        clearCollectionItemsFill();
+    }
+
     void ExplorerDatabaseTreeItem::expandCollections() { _database->loadCollections(); }
 
     void ExplorerDatabaseTreeItem::expandUsers() { _database->loadUsers(); }
@@ -126,6 +143,11 @@ namespace Robomongo
          _bus->send(_database->server()->worker(), new LoadCollectionIndexesRequest(item, item->collection()->info()));
     }
 
+    void ExplorerDatabaseTreeItem::loadIndexStats(ExplorerCollectionTreeItem *const item)
+    {
+        _bus->send(_database->server()->worker(), new LoadIndexStatsRequest(item, item->collection()->info()));
+    }
+
     void ExplorerDatabaseTreeItem::dropIndexFromCollection(ExplorerCollectionTreeItem *const item, const std::string &indexName)
     {
         _bus->send(_database->server()->worker(), new DropCollectionIndexRequest(item, item->collection()->info(), indexName));
@@ -154,33 +176,169 @@ namespace Robomongo
             return;
         }
 
+        // Fill of previous list is dropped, its collections may be deleted already
+        clearCollectionItemsFill();
+
         std::vector<MongoCollection *> collections = event->collections;
         int count = collections.size();
-        _collectionFolderItem->setText(0, detail::buildName("Collections", count));
-        QtUtils::clearChildItems(_collectionFolderItem);
 
         // Do not expand, when we do not have collections
         if (count == 0) {
+            _collectionFolderItem->setText(0, detail::buildName("Collections", count));
+            QtUtils::clearChildItems(_collectionFolderItem);
+            _collectionSystemFolderItem = NULL;   // deleted with other children
+            rebuildCollectionIndex(std::vector<QTreeWidgetItem *>());
             _collectionFolderItem->setExpanded(false);
             return;
         }
 
-        _collectionSystemFolderItem = new ExplorerTreeItem(_collectionFolderItem);
-        _collectionSystemFolderItem->setIcon(0, GuiRegistry::instance().folderIcon());
-        _collectionSystemFolderItem->setText(0, "System");
-        _collectionFolderItem->addChild(_collectionSystemFolderItem);
+        if (!_collectionSystemFolderItem) {
+            _collectionSystemFolderItem = new ExplorerTreeItem(_collectionFolderItem);
+            _collectionSystemFolderItem->setIcon(0, GuiRegistry::instance().folderIcon());
+            _collectionSystemFolderItem->setText(0, "System");
+            _collectionFolderItem->insertChild(0, _collectionSystemFolderItem);
+        }
+
+        // List is reloaded after every change and refreshed after cached one was shown,
+        // items of collections that still exist are kept (with their loaded indexes).
+        // Items are matched by name: MongoCollection of removed item is already deleted.
+        for (QTreeWidgetItem *folder : { _collectionFolderItem, _collectionSystemFolderItem }) {
+            for (int i = 0; i < folder->childCount(); ++i) {
+                auto collectionItem = dynamic_cast<ExplorerCollectionTreeItem *>(folder->child(i));
+                if (collectionItem)
+                    _fillExisting[QtUtils::toStdString(collectionItem->text(0))] = collectionItem;
+            }
+        }
+
+        _fillCollections = collections;
+        _fillItems.reserve(collections.size());
+        fillCollectionItems();
+    }
+
+    void ExplorerDatabaseTreeItem::fillCollectionItems()
+    {
+        if (_fillNext >= _fillCollections.size())
+            return;     // fill was dropped (see handle(MongoDatabaseCollectionListLoadedEvent *))
 
-        for (int i = 0; i < collections.size(); ++i) {
-            MongoCollection *collection = collections[i];
+        // Items of large list are created batch by batch, so that GUI is not frozen meanwhile
+        size_t const end = std::min(_fillCollections.size(), _fillNext + CollectionItemsPerFill);
+        for (; _fillNext < end; ++_fillNext) {
+            MongoCollection *collection = _fillCollections[_fillNext];
+            auto const it = _fillExisting.find(collection->name());
+            bool const keep = it != _fillExisting.end() && it->second->collection() == collection;
 
             if (collection->isSystem()) {
-                addSystemCollectionItem(collection);
+                _fillSystemItems.push_back(keep ? it->second : addSystemCollectionItem(collection));
             } else {
-                addCollectionItem(collection);
+                _fillItems.push_back(keep ? it->second : addCollectionItem(collection));
             }
         }
 
+        if (_fillNext < _fillCollections.size()) {
+            _collectionFolderItem->setText(0, detail::buildName("Collections", -1));
+            QTimer::singleShot(0, this, SLOT(fillCollectionItems()));
+            return;
+        }
+
+        // Items are shown at once, when all of them are created
+        _collectionFolderItem->setText(0, detail::buildName("Collections", static_cast<int>(_fillCollections.size())));
+
+        // 'System' folder is the first child of 'Collections' folder
+        QtUtils::syncChildItems(_collectionFolderItem, 1, _fillItems);
+        QtUtils::syncChildItems(_collectionSystemFolderItem, 0, _fillSystemItems);
+        rebuildCollectionIndex(_fillItems);
+
         showCollectionSystemFolderIfNeeded();
+        clearCollectionItemsFill();
+    }
+
+    void ExplorerDatabaseTreeItem::clearCollectionItemsFill()
+    {
+        // Items not inserted into tree yet are owned by fill
+        for (auto items : { &_fillItems, &_fillSystemItems }) {
+            for (QTreeWidgetItem *item : *items) {
+                if (!item->parent())
+                    delete item;
+            }
+            items->clear();
+        }
+        _fillExisting.clear();
+        _fillCollections.clear();
+        _fillNext = 0;
+    }
+
+    void ExplorerDatabaseTreeItem::filterCollections(const QString &prefix)
+    {
+        QString const filter = prefix.trimmed().toLower();
+        if (filter == _collectionFilter)
+            return;
+
+        _collectionFilter = filter;
+
+        // Names with the same prefix are adjacent in sorted index
+        auto const first = std::lower_bound(_collectionIndex.begin(), _collectionIndex.end(), filter,
+            [](const CollectionIndexEntry &entry, const QString &key) { return entry.first < key; });
+        auto const last = std::partition_point(first, _collectionIndex.end(),
+            [&filter](const CollectionIndexEntry &entry) { return entry.first.startsWith(filter); });
+
+        size_t const begin = first - _collectionIndex.begin();
+        size_t const end = last - _collectionIndex.begin();
+
+        // Hide items which left shown range, show items which entered it
+        for (size_t i = _shownBegin; i < std::min(_shownEnd, begin); ++i)
+            _collectionIndex[i].second->setHidden(true);
+        for (size_t i = std::max(_shownBegin, end); i < _shownEnd; ++i)
+            _collectionIndex[i].second->setHidden(true);
+        for (size_t i = begin; i < std::min(end, _shownBegin); ++i)
+            _collectionIndex[i].second->setHidden(false);
+        for (size_t i = std::max(begin, _shownEnd); i < end; ++i)
+            _collectionIndex[i].second->setHidden(false);
+
+        _shownBegin = begin;
+        _shownEnd = end;
+    }
+
+    void ExplorerDatabaseTreeItem::rebuildCollectionIndex(const std::vector<QTreeWidgetItem *> &items)
+    {
+        _collectionIndex.clear();
+        _collectionIndex.reserve(items.size());
+        for (QTreeWidgetItem *item : items) {
+            // Kept items may be hidden by filter, it is applied again below
+            if (item->isHidden())
+                item->setHidden(false);
+            _collectionIndex.push_back(CollectionIndexEntry(item->text(0).toLower(),
+                                                            static_cast<ExplorerCollectionTreeItem *>(item)));
+        }
+
+        std::sort(_collectionIndex.begin(), _collectionIndex.end(),
+            [](const CollectionIndexEntry &left, const CollectionIndexEntry &right) { return left.first < right.first; });
+
+        _shownBegin = 0;
+        _shownEnd = _collectionIndex.size();
+
+        QString const filter = _collectionFilter;
+        _collectionFilter.clear();
+        filterCollections(filter);
+    }
+
+    void ExplorerDatabaseTreeItem::handle(MongoDatabaseCollectionStatsLoadedEvent *event)
+    {
+        std::unordered_set<std::string> names;
+        for (auto const& info : event->collectionInfos)
+            names.insert(info.name());
+
+        // Statistics are already stored in MongoCollection objects of items
+        QList<QTreeWidgetItem *> const folders = { _collectionFolderItem, _collectionSystemFolderItem };
+        for (QTreeWidgetItem *folder : folders) {
+            if (!folder)
+                continue;
+
+            for (int i = 0; i < folder->childCount(); ++i) {
+                auto collectionItem = dynamic_cast<ExplorerCollectionTreeItem *>(folder->child(i));
+                if (collectionItem && names.count(QtUtils::toStdString(collectionItem->text(0))))
+                    collectionItem->updateStats();
+            }
+        }
     }
 
     void ExplorerDatabaseTreeItem::handle(MongoDatabaseUsersLoadedEvent *event)
@@ -247,18 +405,16 @@ namespace Robomongo
         _usersFolderItem->setText(0, detail::buildName("Users", -1));
     }
 
-    void ExplorerDatabaseTreeItem::addCollectionItem(MongoCollection *collection)
+    ExplorerCollectionTreeItem *ExplorerDatabaseTreeItem::addCollectionItem(MongoCollection *collection)
     {
-        auto collectionItem = new ExplorerCollectionTreeItem(_collectionFolderItem, this, collection);
-        collectionItem->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
-        _collectionFolderItem->addChild(collectionItem);
+        // Inserted by QtUtils::syncChildItems() together with other new items
+        return new ExplorerCollectionTreeItem(NULL, this, collection);
     }
 
-    void ExplorerDatabaseTreeItem::addSystemCollectionItem(MongoCollection *collection)
+    ExplorerCollectionTreeItem *ExplorerDatabaseTreeItem::addSystemCollectionItem(MongoCollection *collection)
     {
-        auto collectionItem = new ExplorerCollectionTreeItem(_collectionSystemFolderItem, this, collection);
-        collectionItem->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
-        _collectionSystemFolderItem->addChild(collectionItem);
+        // Inserted by QtUtils::syncChildItems() together with other new items
+        return new ExplorerCollectionTreeItem(NULL, this, collection);
     }
 
     void ExplorerDatabaseTreeItem::showCollectionSystemFolderIfNeeded()
@@ -290,7 +446,9 @@ namespace Robomongo
 
     void ExplorerDatabaseTreeItem::ui_dbCurrentOps()
     {
-        openCurrentDatabaseShell(_database, "db.currentOp()");
+        auto dialog = new CurrentOpDialog(_database->server(), QtUtils::toQString(_database->name() + '.'),
+                                          treeWidget());
+        dialog->show();
     }
 
     void ExplorerDatabaseTreeItem::ui_dbKillOp()
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "robomongo/gui/widgets/explorer/ExplorerTreeItem.h"
 
 namespace Robomongo
@@ -13,6 +18,7 @@ namespace Robomongo
     class ExplorerDatabaseCategoryTreeItem;
     class EventBus;
     class MongoDatabaseCollectionListLoadedEvent;
+    class MongoDatabaseCollectionStatsLoadedEvent;
     class MongoDatabaseUsersLoadedEvent;
     class MongoDatabaseFunctionsLoadedEvent;
     class MongoDatabaseCollectionsLoadingEvent;
@@ -31,18 +37,33 @@ namespace Robomongo
     public:
         typedef ExplorerTreeItem BaseClass;
         ExplorerDatabaseTreeItem(QTreeWidgetItem *parent, MongoDatabase *const database);
+        ~ExplorerDatabaseTreeItem();
 
         MongoDatabase *database() const { return _database; }
         void expandCollections();
         void expandUsers();
         void expandFunctions();
         void expandColection(ExplorerCollectionTreeItem *const item);
+        void loadIndexStats(ExplorerCollectionTreeItem *const item);
         void dropIndexFromCollection(ExplorerCollectionTreeItem *const item, const std::string &indexName);
         void enshureIndex(ExplorerCollectionTreeItem *const item, const EnsureIndexInfo &oldInfo, const EnsureIndexInfo &newInfo);
         void editIndexFromCollection(ExplorerCollectionTreeItem *const item, const std::string& oldIndexText, const std::string& newIndexText);
 
+        /**
+         * @brief "Collections" folder of this database.
+         */
+        ExplorerDatabaseCategoryTreeItem *collectionFolderItem() const { return _collectionFolderItem; }
+
+        /**
+         * @brief Show only collections whose name starts with 'prefix' (case-insensitive),
+         *        empty prefix shows all of them. Matching range is found by binary search
+         *        in sorted index of names, only items entering or leaving it are updated.
+         */
+        void filterCollections(const QString &prefix);
+
     public Q_SLOTS:
         void handle(MongoDatabaseCollectionListLoadedEvent *event);
+        void handle(MongoDatabaseCollectionStatsLoadedEvent *event);
         void handle(MongoDatabaseUsersLoadedEvent *event);
         void handle(MongoDatabaseFunctionsLoadedEvent *event);
         void handle(MongoDatabaseCollectionsLoadingEvent *event);
@@ -58,10 +79,17 @@ namespace Robomongo
         void ui_dbOpenShell();
         void ui_refreshDatabase();
 
+        /**
+         * @brief Create next batch of collection items of loaded list, show all of them after the last batch
+         */
+        void fillCollectionItems();
+
     private:
-        void addCollectionItem(MongoCollection *collection);
-        void addSystemCollectionItem(MongoCollection *collection);
+        ExplorerCollectionTreeItem *addCollectionItem(MongoCollection *collection);
+        ExplorerCollectionTreeItem *addSystemCollectionItem(MongoCollection *collection);
         void showCollectionSystemFolderIfNeeded();
+        void rebuildCollectionIndex(const std::vector<QTreeWidgetItem *> &items);
+        void clearCollectionItemsFill();
 
         void addUserItem(MongoDatabase *database, const MongoUser &user);
         void addFunctionItem(MongoDatabase *database, const MongoFunction &function);
@@ -71,6 +99,20 @@ namespace Robomongo
         ExplorerDatabaseCategoryTreeItem *_functionsFolderItem;
         ExplorerDatabaseCategoryTreeItem *_usersFolderItem;
         ExplorerTreeItem *_collectionSystemFolderItem;
+
+        // Non-system collections sorted by lower-case name, used by filterCollections()
+        typedef std::pair<QString, ExplorerCollectionTreeItem *> CollectionIndexEntry;
+        std::vector<CollectionIndexEntry> _collectionIndex;
+        QString _collectionFilter;
+        size_t _shownBegin;     // range of _collectionIndex that matches _collectionFilter
+        size_t _shownEnd;
+
+        // Collection list being turned into items by fillCollectionItems()
+        std::vector<MongoCollection *> _fillCollections;
+        size_t _fillNext;
+        std::vector<QTreeWidgetItem *> _fillItems;
+        std::vector<QTreeWidgetItem *> _fillSystemItems;
+        std::unordered_map<std::string, ExplorerCollectionTreeItem *> _fillExisting;
         MongoDatabase *const _database;
     };
 }
@@ -1,5 +1,6 @@
 #include "robomongo/gui/widgets/explorer/ExplorerServerTreeItem.h"
 
+#include <unordered_map>
 #include <QAction>
 #include <QMenu>
 #include <QMessageBox>
@@ -17,6 +18,9 @@
 #include "robomongo/gui/widgets/explorer/ExplorerReplicaSetFolderItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerReplicaSetTreeItem.h"
 #include "robomongo/gui/dialogs/CreateDatabaseDialog.h"
+#include "robomongo/gui/dialogs/CurrentOpDialog.h"
+#include "robomongo/gui/dialogs/ServerMonitorDialog.h"
+#include "robomongo/gui/dialogs/StorageOverviewDialog.h"
 #include "robomongo/gui/GuiRegistry.h"
 
 
@@ -53,6 +57,15 @@ namespace Robomongo
         QAction *serverStatus = new QAction("Server Status", this);
         VERIFY(connect(serverStatus, SIGNAL(triggered()), SLOT(ui_serverStatus())));
 
+        QAction *storageOverview = new QAction("Storage Overview", this);
+        VERIFY(connect(storageOverview, SIGNAL(triggered()), SLOT(ui_storageOverview())));
+
+        QAction *performanceMonitor = new QAction("Performance Monitor", this);
+        VERIFY(connect(performanceMonitor, SIGNAL(triggered()), SLOT(ui_performanceMonitor())));
+
+        QAction *currentOps = new QAction("Current Operations", this);
+        VERIFY(connect(currentOps, SIGNAL(triggered()), SLOT(ui_currentOps())));
+
         QAction *serverVersion = new QAction("MongoDB Version", this);
         VERIFY(connect(serverVersion, SIGNAL(triggered()), SLOT(ui_serverVersion())));
 
@@ -71,6 +84,9 @@ namespace Robomongo
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(createDatabase);
         BaseClass::_contextMenu->addAction(serverStatus);
+        BaseClass::_contextMenu->addAction(storageOverview);
+        BaseClass::_contextMenu->addAction(performanceMonitor);
+        BaseClass::_contextMenu->addAction(currentOps);
         BaseClass::_contextMenu->addAction(serverHostInfo);
         BaseClass::_contextMenu->addAction(serverVersion);
         BaseClass::_contextMenu->addSeparator();
@@ -86,6 +102,11 @@ namespace Robomongo
         setText(0, buildServerName());
         setIcon(0, _server->connectionRecord()->isReplicaSet() ? GuiRegistry::instance().replicaSetIcon()
                                                                : GuiRegistry::instance().serverIcon());
+
+        // Databases known on connect (cached ones, if any) are shown until the list loaded by expand() arrives
+        if (!_server->connectionRecord()->isReplicaSet())
+            databaseRefreshed(_server->databases());
+
         setExpanded(true);
         setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
 
@@ -126,30 +147,54 @@ namespace Robomongo
         int count = dbs.count();
         setText(0, buildServerName(&count));
 
-        // Delete system folder and database items
-        QtUtils::clearChildItems(this);
-
         // Add 'System' folder
-        QIcon folderIcon = GuiRegistry::instance().folderIcon();
-        _systemFolder = new ExplorerTreeItem(this);
-        _systemFolder->setIcon(0, folderIcon);
-        _systemFolder->setText(0, "System");
-        addChild(_systemFolder);
+        if (!_systemFolder) {
+            QIcon folderIcon = GuiRegistry::instance().folderIcon();
+            _systemFolder = new ExplorerTreeItem(this);
+            _systemFolder->setIcon(0, folderIcon);
+            _systemFolder->setText(0, "System");
+            addChild(_systemFolder);
+        }
 
+        // Folder was emptied and disabled while replica set primary was unreachable
+        _systemFolder->setDisabled(false);
+
+        // MongoServer keeps databases which still exist, so are their items (with expanded
+        // folders and loaded collections). Items are matched by name, because MongoDatabase
+        // of removed item is already deleted.
+        std::unordered_map<std::string, ExplorerDatabaseTreeItem *> existing;
+        for (QTreeWidgetItem *parent : { static_cast<QTreeWidgetItem *>(this), _systemFolder }) {
+            for (int i = 0; i < parent->childCount(); ++i) {
+                auto dbItem = dynamic_cast<ExplorerDatabaseTreeItem *>(parent->child(i));
+                if (dbItem)
+                    existing[QtUtils::toStdString(dbItem->text(0))] = dbItem;
+            }
+        }
+
+        std::vector<QTreeWidgetItem *> items;
+        std::vector<QTreeWidgetItem *> systemItems;
         for (int i = 0; i < dbs.size(); i++)
         {
             MongoDatabase *database = dbs.at(i);
+            auto const it = existing.find(database->name());
+
+            // Items emptied and disabled while replica set primary was unreachable are recreated,
+            // their folder items are already deleted
+            bool const keep = it != existing.end() && it->second->database() == database &&
+                              !it->second->isDisabled();
 
             if (database->isSystem()) {
-                auto dbItem = new ExplorerDatabaseTreeItem(_systemFolder, database);
-                _systemFolder->addChild(dbItem);
+                systemItems.push_back(keep ? it->second : new ExplorerDatabaseTreeItem(_systemFolder, database));
                 continue;
             }
 
-            auto dbItem = new ExplorerDatabaseTreeItem(this, database);
-            addChild(dbItem);
+            items.push_back(keep ? it->second : new ExplorerDatabaseTreeItem(this, database));
         }
 
+        // Database items follow 'System' folder (and 'Replica Set' folder, if any)
+        QtUtils::syncChildItems(this, indexOfChild(_systemFolder) + 1, items);
+        QtUtils::syncChildItems(_systemFolder, 0, systemItems);
+
         // Show 'System' folder only if it has items
         _systemFolder->setHidden(_systemFolder->childCount() == 0);
     }
@@ -259,6 +304,24 @@ namespace Robomongo
         openCurrentServerShell(_server, "db.serverStatus()");
     }
 
+    void ExplorerServerTreeItem::ui_storageOverview()
+    {
+        auto dialog = new StorageOverviewDialog(_server, treeWidget());
+        dialog->show();
+    }
+
+    void ExplorerServerTreeItem::ui_performanceMonitor()
+    {
+        auto dialog = new ServerMonitorDialog(_server, treeWidget());
+        dialog->show();
+    }
+
+    void ExplorerServerTreeItem::ui_currentOps()
+    {
+        auto dialog = new CurrentOpDialog(_server, QString(), treeWidget());
+        dialog->show();
+    }
+
     void ExplorerServerTreeItem::ui_serverVersion()
     {
         openCurrentServerShell(_server, "db.version()");
@@ -332,6 +395,7 @@ namespace Robomongo
         // Delete all children (replica set folder, system folder and database items)
         QtUtils::clearChildItems(this);  
         _replicaSetFolder = nullptr;
+        _systemFolder = nullptr;
 
         buildReplicaSetFolder(false);
         buildDatabaseItems();
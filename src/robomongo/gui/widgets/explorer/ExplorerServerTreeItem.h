@@ -51,6 +51,9 @@ namespace Robomongo
         void ui_createDatabase();
         void ui_serverHostInfo();
         void ui_serverStatus();
+        void ui_storageOverview();
+        void ui_performanceMonitor();
+        void ui_currentOps();
         void ui_serverVersion();
 
     private:
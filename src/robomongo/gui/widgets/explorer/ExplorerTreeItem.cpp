@@ -6,8 +6,8 @@
 
 namespace Robomongo
 {
-    ExplorerTreeItem::ExplorerTreeItem(QTreeWidgetItem *parent)
-        :QObject(), BaseClass(parent), _contextMenu(new QMenu(treeWidget()) )
+    ExplorerTreeItem::ExplorerTreeItem(QTreeWidgetItem *parent, bool ownContextMenu /* = true */)
+        :QObject(), BaseClass(parent), _contextMenu(ownContextMenu ? new QMenu(treeWidget()) : nullptr)
     {
 
     }
@@ -20,12 +20,14 @@ namespace Robomongo
 
     void ExplorerTreeItem::showContextMenuAtPos(const QPoint &pos)
     {
-        _contextMenu->exec(pos);
+        if (_contextMenu)
+            _contextMenu->exec(pos);
     }
 
     ExplorerTreeItem::~ExplorerTreeItem()
     {
-        _contextMenu->deleteLater();
+        if (_contextMenu)
+            _contextMenu->deleteLater();
         QtUtils::clearChildItems(this);
     }
 }
@@ -13,12 +13,17 @@ namespace Robomongo
     public:
         typedef QTreeWidgetItem BaseClass;
         explicit ExplorerTreeItem(QTreeWidget *view);
-        explicit ExplorerTreeItem(QTreeWidgetItem *parent);
+
+        /**
+         * @param ownContextMenu: false for items created in large numbers (i.e. collections),
+         *        these share one context menu and override showContextMenuAtPos()
+         */
+        explicit ExplorerTreeItem(QTreeWidgetItem *parent, bool ownContextMenu = true);
         virtual void showContextMenuAtPos(const QPoint &pos);
         using BaseClass::parent;
         virtual ~ExplorerTreeItem();
 
     protected:
-        QMenu *const _contextMenu;
+        QMenu *const _contextMenu;      // null, if item has no own context menu
     };
 }
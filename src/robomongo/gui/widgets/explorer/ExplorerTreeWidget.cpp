@@ -1,9 +1,17 @@
 #include "robomongo/gui/widgets/explorer/ExplorerTreeWidget.h"
 
+#include "robomongo/core/domain/MongoCollection.h"
+#include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/widgets/explorer/ExplorerTreeItem.h"
+#include "robomongo/gui/widgets/explorer/ExplorerCollectionTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseTreeItem.h"
+#include "robomongo/gui/widgets/explorer/ExplorerDatabaseCategoryTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerReplicaSetTreeItem.h"
+#include <map>
 #include <QContextMenuEvent>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QTimer>
 #include <robomongo/gui/GuiRegistry.h>
 
 namespace Robomongo
@@ -22,6 +30,74 @@ namespace Robomongo
         setHeaderHidden(true);
         setSelectionMode(QAbstractItemView::SingleSelection);
         setExpandsOnDoubleClick(false);
+
+        // Second column shows document count of collections
+        setColumnCount(2);
+        header()->setStretchLastSection(false);
+        header()->setSectionResizeMode(0, QHeaderView::Stretch);
+        header()->setSectionResizeMode(1, QHeaderView::Fixed);
+        header()->resizeSection(1, fontMetrics().width("000.0K") + 10);
+
+        _loadStatsTimer = new QTimer(this);
+        _loadStatsTimer->setSingleShot(true);
+        _loadStatsTimer->setInterval(loadStatsDelayMs);
+        VERIFY(connect(_loadStatsTimer, SIGNAL(timeout()), this, SLOT(loadVisibleCollectionStats())));
+
+        // Collection items are added asynchronously, after their folder is expanded
+        VERIFY(connect(verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(scheduleLoadVisibleCollectionStats())));
+        VERIFY(connect(this, SIGNAL(itemExpanded(QTreeWidgetItem *)), this, SLOT(scheduleLoadVisibleCollectionStats())));
+        VERIFY(connect(model(), SIGNAL(rowsInserted(const QModelIndex &, int, int)),
+                       this, SLOT(scheduleLoadVisibleCollectionStats())));
+    }
+
+    void ExplorerTreeWidget::keyboardSearch(const QString &search)
+    {
+        // Find database whose "Collections" folder contains current item
+        QTreeWidgetItem *child = NULL;
+        for (QTreeWidgetItem *item = currentItem(); item; child = item, item = item->parent()) {
+            auto databaseItem = dynamic_cast<ExplorerDatabaseTreeItem *>(item);
+            if (!databaseItem)
+                continue;
+
+            if (child && child == databaseItem->collectionFolderItem()) {
+                emit collectionFilterRequested(databaseItem, search);
+                return;
+            }
+            break;
+        }
+
+        QTreeWidget::keyboardSearch(search);
+    }
+
+    void ExplorerTreeWidget::resizeEvent(QResizeEvent *event)
+    {
+        QTreeWidget::resizeEvent(event);
+        scheduleLoadVisibleCollectionStats();
+    }
+
+    void ExplorerTreeWidget::scheduleLoadVisibleCollectionStats()
+    {
+        _loadStatsTimer->start();
+    }
+
+    void ExplorerTreeWidget::loadVisibleCollectionStats()
+    {
+        std::map<MongoDatabase *, std::vector<std::string>> visible;
+        int const bottom = viewport()->rect().bottom();
+
+        for (QTreeWidgetItem *item = itemAt(0, 0); item; item = itemBelow(item)) {
+            if (visualItemRect(item).top() > bottom)
+                break;
+
+            auto collectionItem = dynamic_cast<ExplorerCollectionTreeItem *>(item);
+            if (collectionItem) {
+                MongoCollection *collection = collectionItem->collection();
+                visible[collection->database()].push_back(collection->name());
+            }
+        }
+
+        for (auto const& database : visible)
+            database.first->loadCollectionStats(database.second);
     }
 
     void ExplorerTreeWidget::contextMenuEvent(QContextMenuEvent *event)
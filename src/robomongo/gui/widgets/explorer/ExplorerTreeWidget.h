@@ -2,14 +2,49 @@
 
 #include <QTreeWidget>
 
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
 namespace Robomongo
 {
+    class ExplorerDatabaseTreeItem;
+
     class ExplorerTreeWidget : public QTreeWidget
     {
         Q_OBJECT
     public:
+        // Delay after scrolling, expanding or resizing before statistics of visible collections are requested
+        enum { loadStatsDelayMs = 150 };
+
         explicit ExplorerTreeWidget(QWidget *parent = 0);
+
+        /**
+         * @brief Typing inside of "Collections" folder filters collections of the database
+         *        (see collectionFilterRequested()), elsewhere it works as usual.
+         */
+        virtual void keyboardSearch(const QString &search);
+
+    Q_SIGNALS:
+        void collectionFilterRequested(ExplorerDatabaseTreeItem *databaseItem, const QString &text);
+
+    public Q_SLOTS:
+        void scheduleLoadVisibleCollectionStats();
+
     protected:
         virtual void contextMenuEvent(QContextMenuEvent *event);
+        virtual void resizeEvent(QResizeEvent *event);
+
+    private Q_SLOTS:
+
+        /**
+         * @brief Request statistics of collections currently visible in the viewport.
+         *        Collections out of view are never queried, so databases with thousands
+         *        of collections are listed without waiting for statistics.
+         */
+        void loadVisibleCollectionStats();
+
+    private:
+        QTimer *_loadStatsTimer;
     };
 }
@@ -1,7 +1,8 @@
 #include "robomongo/gui/widgets/explorer/ExplorerWidget.h"
 
-#include <QHBoxLayout>
+#include <QVBoxLayout>
 #include <QLabel>
+#include <QLineEdit>
 #include <QMovie>
 #include <QKeyEvent>
 
@@ -13,6 +14,7 @@
 #include "robomongo/gui/widgets/explorer/ExplorerTreeWidget.h"
 #include "robomongo/gui/widgets/explorer/ExplorerServerTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerCollectionTreeItem.h"
+#include "robomongo/gui/widgets/explorer/ExplorerDatabaseTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseCategoryTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerReplicaSetTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerReplicaSetFolderItem.h"
@@ -25,17 +27,30 @@ namespace Robomongo
     {
         _treeWidget = new ExplorerTreeWidget(this);
 
-        QHBoxLayout *vlaout = new QHBoxLayout();
+        // Shown when user starts typing inside of "Collections" folder
+        _filterEdit = new QLineEdit(this);
+        _filterEdit->setPlaceholderText("Filter collections");
+        _filterEdit->setClearButtonEnabled(true);
+        _filterEdit->installEventFilter(this);
+        _filterEdit->hide();
+        VERIFY(connect(_filterEdit, SIGNAL(textChanged(const QString &)), this, SLOT(ui_filterChanged(const QString &))));
+        VERIFY(connect(_filterEdit, SIGNAL(textChanged(const QString &)),
+                       _treeWidget, SLOT(scheduleLoadVisibleCollectionStats())));
+        VERIFY(connect(_treeWidget, SIGNAL(collectionFilterRequested(ExplorerDatabaseTreeItem *, const QString &)),
+                       this, SLOT(ui_collectionFilterRequested(ExplorerDatabaseTreeItem *, const QString &))));
+
+        QVBoxLayout *vlaout = new QVBoxLayout();
         vlaout->setMargin(0);
+        vlaout->setSpacing(0);
+        vlaout->addWidget(_filterEdit);
         vlaout->addWidget(_treeWidget, Qt::AlignJustify);
 
         VERIFY(connect(_treeWidget, SIGNAL(itemExpanded(QTreeWidgetItem *)), this, SLOT(ui_itemExpanded(QTreeWidgetItem *))));
         VERIFY(connect(_treeWidget, SIGNAL(itemDoubleClicked(QTreeWidgetItem *, int)), 
                        this, SLOT(ui_itemDoubleClicked(QTreeWidgetItem *, int))));
 
-        // Temporarily disabling export/import feature
-        //VERIFY(connect(_treeWidget, SIGNAL(currentItemChanged(QTreeWidgetItem *, QTreeWidgetItem *)),
-        //               parentMainWindow, SLOT(onExplorerItemSelected(QTreeWidgetItem *))));
+        VERIFY(connect(_treeWidget, SIGNAL(currentItemChanged(QTreeWidgetItem *, QTreeWidgetItem *)),
+                       parentMainWindow, SLOT(onExplorerItemSelected(QTreeWidgetItem *))));
 
         setLayout(vlaout);
 
@@ -77,6 +92,51 @@ namespace Robomongo
         BaseClass::keyPressEvent(event);
     }
 
+    bool ExplorerWidget::eventFilter(QObject *watched, QEvent *event)
+    {
+        if (watched == _filterEdit && event->type() == QEvent::KeyPress) {
+            QKeyEvent *keyEvent = static_cast<QKeyEvent *>(event);
+            switch (keyEvent->key()) {
+            case Qt::Key_Escape:
+                _filterEdit->clear();   // hides filter, see ui_filterChanged()
+                return true;
+            case Qt::Key_Down:
+            case Qt::Key_Return:
+            case Qt::Key_Enter:
+                _treeWidget->setFocus();
+                return true;
+            default:
+                break;
+            }
+        }
+
+        return BaseClass::eventFilter(watched, event);
+    }
+
+    void ExplorerWidget::ui_collectionFilterRequested(ExplorerDatabaseTreeItem *databaseItem, const QString &text)
+    {
+        // Filter applies to one database at a time
+        if (_filteredDatabase && _filteredDatabase != databaseItem)
+            _filteredDatabase->filterCollections(QString());
+
+        _filteredDatabase = databaseItem;
+        _filterEdit->show();
+        _filterEdit->setFocus();
+        _filterEdit->setText(text);
+    }
+
+    void ExplorerWidget::ui_filterChanged(const QString &text)
+    {
+        if (_filteredDatabase)
+            _filteredDatabase->filterCollections(text);
+
+        if (text.isEmpty()) {
+            _filterEdit->hide();
+            _filteredDatabase = NULL;
+            _treeWidget->setFocus();
+        }
+    }
+
     void ExplorerWidget::increaseProgress()
     {
         ++_progress;
@@ -139,6 +199,13 @@ namespace Robomongo
             return;
         }
        
+        // Collection nodes get their children only when expanded for the first time
+        auto collectionItem = dynamic_cast<ExplorerCollectionTreeItem *>(item);
+        if (collectionItem) {
+            collectionItem->indexDir();
+            return;
+        }
+
         auto dirItem = dynamic_cast<ExplorerCollectionDirIndexesTreeItem *>(item);
         if (dirItem) {
             dirItem->expand();
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <QPointer>
 #include <QWidget>
 QT_BEGIN_NAMESPACE
 class QTreeWidget;
 class QTreeWidgetItem;
 class QLabel;
+class QLineEdit;
 QT_END_NAMESPACE
 
 #include "robomongo/core/events/MongoEvents.h"
@@ -12,6 +14,7 @@ QT_END_NAMESPACE
 namespace Robomongo
 {
     class MainWindow;
+    class ExplorerDatabaseTreeItem;
 
     /**
      * @brief Explorer widget (usually you'll see it at the left of main window)
@@ -32,9 +35,12 @@ namespace Robomongo
     private Q_SLOTS:
         void ui_itemExpanded(QTreeWidgetItem *item);
         void ui_itemDoubleClicked(QTreeWidgetItem *item, int column);
+        void ui_collectionFilterRequested(ExplorerDatabaseTreeItem *databaseItem, const QString &text);
+        void ui_filterChanged(const QString &text);
 
     protected:
         virtual void keyPressEvent(QKeyEvent *event);   
+        virtual bool eventFilter(QObject *watched, QEvent *event);
 
     private:
         int _progress;
@@ -42,5 +48,7 @@ namespace Robomongo
         void decreaseProgress();
         QLabel *_progressLabel;
         QTreeWidget *_treeWidget;
+        QLineEdit *_filterEdit;
+        QPointer<ExplorerDatabaseTreeItem> _filteredDatabase;  // database whose collections are filtered
     };
 }
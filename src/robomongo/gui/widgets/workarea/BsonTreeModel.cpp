@@ -129,7 +129,12 @@ namespace Robomongo
 
     const QIcon &BsonTreeModel::getIcon(BsonTreeItem *item)
     {
-        switch(item->type()) {
+        return getIcon(item->type());
+    }
+
+    const QIcon &BsonTreeModel::getIcon(mongo::BSONType type)
+    {
+        switch(type) {
         case mongo::NumberDouble: return GuiRegistry::instance().bsonDoubleIcon();
         case mongo::NumberDecimal: return GuiRegistry::instance().bsonNumberDecimalIcon();
         case mongo::String: return GuiRegistry::instance().bsonStringIcon();
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <QAbstractItemModel>
+#include <mongo/bson/bsontypes.h>
 #include "robomongo/core/Core.h"
 
 namespace Robomongo
@@ -14,6 +15,7 @@ namespace Robomongo
     public:
         typedef QAbstractItemModel BaseClass;
         static const QIcon &getIcon(BsonTreeItem *item);
+        static const QIcon &getIcon(mongo::BSONType type);
         explicit BsonTreeModel(const std::vector<MongoDocumentPtr> &documents, QObject *parent = 0);
         QVariant data(const QModelIndex &index, int role) const;
 
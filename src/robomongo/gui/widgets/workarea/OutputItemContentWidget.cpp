@@ -96,6 +96,12 @@ namespace Robomongo
 
         _header->setTime(QString("%1 sec.").arg(secs));
 
+        // Show which replica set member served the result when tab reads from non-primary
+        if (_shell->readPreference() != ReadPrimary) {
+            _servedBy = _queryInfo._info._serverAddress;
+            _header->setServer(QtUtils::toQString(_servedBy));
+        }
+
         QVBoxLayout *layout = new QVBoxLayout();
         layout->setContentsMargins(0, 0, 0, 0);
         layout->setSpacing(0);
@@ -168,14 +174,28 @@ namespace Robomongo
         info._skip = skip;
         info._batchSize = batchSize;
         _outputWidget->showProgress();
-        _shell->query(_outputWidget->resultIndex(this), info);
+        _shell->query(_outputWidget->resultIndex(this), info, _servedBy);
+    }
+
+    void OutputItemContentWidget::setPlan(const QueryPlanSummary &plan)
+    {
+        _header->setPlan(plan);
     }
 
-    void OutputItemContentWidget::update(const MongoQueryInfo &inf, const std::vector<MongoDocumentPtr> &documents)
+    void OutputItemContentWidget::update(const MongoQueryInfo &inf, const std::vector<MongoDocumentPtr> &documents,
+                                         const std::string &servedBy)
     {
         _queryInfo = inf;
         _documents = documents;
 
+        if (!servedBy.empty()) {
+            _servedBy = servedBy;
+            _header->setServer(QtUtils::toQString(servedBy));
+        }
+
+        // Plan of previous page does not describe new one, it is explained again if still slow
+        _header->clearPlan();
+
         _header->paging()->setSkip(_queryInfo._skip);
         _header->paging()->setBatchSize(_queryInfo._batchSize);
 
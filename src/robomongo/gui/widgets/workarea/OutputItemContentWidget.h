@@ -18,6 +18,7 @@ namespace Robomongo
     class MongoShell;
     class OutputItemHeaderWidget;
     class OutputWidget;
+    struct QueryPlanSummary;
 
     class OutputItemContentWidget : public QWidget
     {
@@ -32,13 +33,15 @@ namespace Robomongo
                                 double secs, bool multipleResults, bool firstItem, bool lastItem, QWidget *parent);
         int _initialSkip;
         int _initialLimit;
-        void update(const MongoQueryInfo &inf, const std::vector<MongoDocumentPtr> &documents);
+        void update(const MongoQueryInfo &inf, const std::vector<MongoDocumentPtr> &documents,
+                    const std::string &servedBy = std::string());
         bool isTextModeSupported() const { return _isTextModeSupported; }
         bool isTreeModeSupported() const { return _isTreeModeSupported; }
         bool isCustomModeSupported() const { return _isCustomModeSupported; }
         bool isTableModeSupported() const { return _isTableModeSupported; }
         ViewMode viewMode() const { return _viewMode; }
 
+        void setPlan(const QueryPlanSummary &plan);
         void refreshOutputItem();
         void markUninitialized();
 
@@ -77,6 +80,9 @@ namespace Robomongo
         std::vector<MongoDocumentPtr> _documents;
         MongoQueryInfo _queryInfo;
 
+        // Replica set member which served the result, next pages are read from it
+        std::string _servedBy;
+
         QStackedWidget *_stack;
         JsonPrepareThread *_thread;
 
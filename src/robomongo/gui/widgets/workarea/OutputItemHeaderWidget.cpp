@@ -5,6 +5,8 @@
 #include <QPushButton>
 #include <QSplitter>
 
+#include "robomongo/core/domain/QueryPlanSummary.h"
+#include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/gui/widgets/workarea/QueryWidget.h"
@@ -104,10 +106,14 @@ namespace Robomongo
 
         _collectionIndicator = new Indicator(GuiRegistry::instance().collectionIcon());
         _timeIndicator = new Indicator(GuiRegistry::instance().timeIcon());
+        _serverIndicator = new Indicator(GuiRegistry::instance().serverSecondaryIcon());
+        _planBadge = new QLabel();
         _paging = new PagingWidget();
 
         _collectionIndicator->hide();
         _timeIndicator->hide();
+        _serverIndicator->hide();
+        _planBadge->hide();
         _paging->hide();
 
         QHBoxLayout *layout = new QHBoxLayout();
@@ -116,6 +122,9 @@ namespace Robomongo
 
         layout->addWidget(_collectionIndicator);
         layout->addWidget(_timeIndicator);
+        layout->addWidget(_serverIndicator);
+        layout->addSpacing(4);
+        layout->addWidget(_planBadge);
         QSpacerItem *hSpacer = new QSpacerItem(2000, 24, QSizePolicy::Preferred, QSizePolicy::Minimum);
         layout->addSpacerItem(hSpacer);
         layout->addWidget(_paging);
@@ -248,6 +257,39 @@ namespace Robomongo
         _collectionIndicator->setText(collection);
     }
 
+    void OutputItemHeaderWidget::setServer(const QString &server)
+    {
+        _serverIndicator->setVisible(!server.isEmpty());
+        _serverIndicator->setText(server);
+    }
+
+    void OutputItemHeaderWidget::setPlan(const QueryPlanSummary &plan)
+    {
+        // Collection scan is the worst plan, index which is not selective enough is next
+        QString const color = plan.isCollectionScan() ? "#f4cccc" : plan.isInefficient() ? "#fce5cd" : "#d9ead3";
+        long long const examined = plan.isCollectionScan() ? plan.docsExamined : plan.keysExamined;
+
+        _planBadge->setText(QString("%1  %2 %3 / returned %4")
+            .arg(QtUtils::toQString(plan.plan.empty() ? std::string("UNKNOWN") : plan.plan))
+            .arg(plan.isCollectionScan() ? "docs" : "keys")
+            .arg(examined)
+            .arg(plan.returned));
+        _planBadge->setStyleSheet(QString("QLabel { background-color: %1; border-radius: 3px; padding: 1px 4px; }")
+            .arg(color));
+        _planBadge->setToolTip(QString("<b>Slow query explained in %1 ms</b><pre>%2</pre>")
+            .arg(plan.executionMs)
+            .arg(QtUtils::toQString(BsonUtils::jsonString(plan.explain, mongo::TenGen, 1, DefaultEncoding, Utc))
+                .toHtmlEscaped()));
+        _planBadge->show();
+    }
+
+    void OutputItemHeaderWidget::clearPlan()
+    {
+        _planBadge->hide();
+        _planBadge->clear();
+        _planBadge->setToolTip(QString());
+    }
+
     void OutputItemHeaderWidget::maximizeMinimizePart()
     {
         // No maximize/minimize behaviour if there is only one query result
@@ -2,6 +2,7 @@
 
 #include <QWidget>
 QT_BEGIN_NAMESPACE
+class QLabel;
 class QPushButton;
 QT_END_NAMESPACE
 
@@ -13,6 +14,7 @@ namespace Robomongo
 {
     class OutputItemContentWidget;
     class Indicator;
+    struct QueryPlanSummary;
 
     class OutputItemHeaderWidget : public QFrame
     {
@@ -29,6 +31,12 @@ namespace Robomongo
         void applyDockUndockSettings(bool docking);
         void toggleOrientation(Qt::Orientation orientation);
 
+        /**
+         * @brief Show winning plan of slow query next to server, colored by its efficiency.
+         */
+        void setPlan(const QueryPlanSummary &plan);
+        void clearPlan();
+
     protected:
         virtual void mouseDoubleClickEvent(QMouseEvent *);
 
@@ -39,6 +47,7 @@ namespace Robomongo
     public Q_SLOTS:        
         void setTime(const QString &time);
         void setCollection(const QString &collection);
+        void setServer(const QString &server);
         void maximizeMinimizePart();
 
     private:
@@ -53,6 +62,8 @@ namespace Robomongo
         QPushButton *_dockUndockButton;
         Indicator *_collectionIndicator;
         Indicator *_timeIndicator;
+        Indicator *_serverIndicator;
+        QLabel *_planBadge;
         PagingWidget *_paging;
 
         bool _maximized;
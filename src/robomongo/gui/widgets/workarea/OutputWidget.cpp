@@ -4,6 +4,7 @@
 #include <QSplitter>
 
 #include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/domain/MongoShell.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/utils/QtUtils.h"
 
@@ -65,21 +66,38 @@ namespace Robomongo
             VERIFY(connect(item, SIGNAL(restoredSize()), this, SLOT(restoreSize())));
             _splitter->addWidget(item);
             _outputItemContentWidgets.push_back(item);
+
+            // Query of script is explained only when script has single result, its elapsed
+            // time is time of query then
+            if (!multipleResults && shellResult.queryInfo()._info.isValid()) {
+                std::string const servedBy = shell->readPreference() == ReadPrimary
+                                           ? std::string() : shellResult.queryInfo()._info._serverAddress;
+                shell->explainIfSlow(i, shellResult.queryInfo(), shellResult.elapsedMs(), servedBy);
+            }
         }
         
         tryToMakeAllPartsEqualInSize();
     }
 
-    void OutputWidget::updatePart(int partIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents)
+    void OutputWidget::updatePart(int partIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents,
+                                  const std::string &servedBy)
     {
         if (partIndex >= _splitter->count())
             return;
 
         auto outputItemContentWidget = qobject_cast<OutputItemContentWidget*>(_splitter->widget(partIndex));
-        outputItemContentWidget->update(queryInfo, documents);
+        outputItemContentWidget->update(queryInfo, documents, servedBy);
         outputItemContentWidget->refreshOutputItem();
     }
 
+    void OutputWidget::setPlan(int partIndex, const QueryPlanSummary &plan)
+    {
+        if (partIndex >= _splitter->count())
+            return;
+
+        qobject_cast<OutputItemContentWidget*>(_splitter->widget(partIndex))->setPlan(plan);
+    }
+
     void OutputWidget::toggleOrientation()
     {
         bool const horizontal = _splitter->orientation() == Qt::Horizontal;
@@ -13,6 +13,7 @@ namespace Robomongo
     class OutputItemContentWidget;
     class ProgressBarPopup;
     class MongoShell;
+    struct QueryPlanSummary;
 
     class OutputWidget : public QFrame
     {
@@ -22,7 +23,9 @@ namespace Robomongo
         explicit OutputWidget(QWidget *parent);
 
         void present(MongoShell *shell, const std::vector<MongoShellResult> &documents);
-        void updatePart(int partIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents);
+        void updatePart(int partIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents,
+                        const std::string &servedBy = std::string());
+        void setPlan(int partIndex, const QueryPlanSummary &plan);
         void toggleOrientation();
 
         void enterTreeMode();
@@ -49,6 +49,7 @@ namespace Robomongo
         AppRegistry::instance().bus()->subscribe(this, DocumentListLoadedEvent::Type, shell);
         AppRegistry::instance().bus()->subscribe(this, ScriptExecutedEvent::Type, shell);
         AppRegistry::instance().bus()->subscribe(this, AutocompleteResponse::Type, shell);
+        AppRegistry::instance().bus()->subscribe(this, ExplainQueryResponse::Type, shell);
 
         // Make QMessageBox text selectable
         // setStyleSheet("QMessageBox { messagebox-text-interaction-flags: 5; }");
@@ -253,7 +254,8 @@ namespace Robomongo
             return;
         }
 
-        _viewer->updatePart(event->resultIndex(), event->queryInfo(), event->documents()); // this should be in viewer, subscribed to ScriptExecutedEvent
+        _viewer->updatePart(event->resultIndex(), event->queryInfo(), event->documents(), 
+                            event->servedBy()); // this should be in viewer, subscribed to ScriptExecutedEvent
     }
 
     void QueryWidget::handle(ScriptExecutedEvent *event)
@@ -317,6 +319,11 @@ namespace Robomongo
         _scriptWidget->showAutocompletion(event->list, QtUtils::toQString(event->prefix) );
     }
 
+    void QueryWidget::handle(ExplainQueryResponse *event)
+    {
+        _viewer->setPlan(event->resultIndex(), event->plan());
+    }
+
     void QueryWidget::on_dock_undock()
     {
         if (!_dock->isFloating()) {    // If output window docked 
@@ -21,6 +21,7 @@ namespace Robomongo
     class DocumentListLoadedEvent;
     class ScriptExecutedEvent;
     class AutocompleteResponse;
+    class ExplainQueryResponse;
     class OutputWidget;
     class ScriptWidget;
     class MongoShell;
@@ -72,6 +73,7 @@ namespace Robomongo
         void handle(DocumentListLoadedEvent *event);
         void handle(ScriptExecutedEvent *event);
         void handle(AutocompleteResponse *event);
+        void handle(ExplainQueryResponse *event);
 
     private Q_SLOTS:
         // Make adjustments between output window dock/undock events
@@ -3,6 +3,7 @@
 #include <QVBoxLayout>
 #include <QKeyEvent>
 #include <QCompleter>
+#include <QComboBox>
 #include <QStringListModel>
 #include <Qsci/qscilexerjavascript.h>
 #include <Qsci/qsciscintilla.h>
@@ -60,7 +61,9 @@ namespace Robomongo
 
         _queryText = new FindFrame(this);
         _topStatusBar = new TopStatusBar(_shell->server()->connectionRecord()->connectionName(), 
-                                         _shell->server()->connectionRecord()->getFullAddress(), "loading...");
+                                         _shell->server()->connectionRecord()->getFullAddress(), "loading...",
+                                         _shell->server()->connectionRecord()->isReplicaSet());
+        VERIFY(connect(_topStatusBar, SIGNAL(readPreferenceChanged(int)), this, SLOT(onReadPreferenceChanged(int))));
 
         QVBoxLayout *layout = new QVBoxLayout;
         layout->setSpacing(0);
@@ -113,6 +116,11 @@ namespace Robomongo
         setCurrentServer(execResult.currentServer(), execResult.isCurrentServerValid());
     }
 
+    void ScriptWidget::onReadPreferenceChanged(int mode)
+    {
+        _shell->setReadPreference(static_cast<ReadPreferenceMode>(mode));
+    }
+
     void ScriptWidget::setText(const QString &text)
     {
         _queryText->sciScintilla()->setText(text);
@@ -388,7 +396,9 @@ namespace Robomongo
         return AutoCompletionInfo(final, row, leftStop, rightStop);
     }
 
-    TopStatusBar::TopStatusBar(const std::string &connectionName, const std::string &serverName, const std::string &dbName)
+    TopStatusBar::TopStatusBar(const std::string &connectionName, const std::string &serverName, const std::string &dbName,
+                               bool isReplicaSet) :
+        _readPreferenceBox(nullptr)
     {
         setContentsMargins(0, 0, 0, 0);
         _textColor = palette().text().color().lighter(200);
@@ -417,6 +427,19 @@ namespace Robomongo
         topLayout->addWidget(_currentDatabaseLabel, 0, Qt::AlignLeft);
         topLayout->addStretch(1);
 
+        // Read preference is meaningful only for replica sets
+        if (isReplicaSet) {
+            _readPreferenceBox = new QComboBox;
+            _readPreferenceBox->addItem("Primary", ReadPrimary);
+            _readPreferenceBox->addItem("Secondary Preferred", ReadSecondaryPreferred);
+            _readPreferenceBox->addItem("Nearest", ReadNearest);
+            _readPreferenceBox->setToolTip("Read preference of this tab. Queries are sent to the "
+                                           "lowest-latency eligible member of the set.");
+            VERIFY(connect(_readPreferenceBox, SIGNAL(currentIndexChanged(int)), 
+                           this, SIGNAL(readPreferenceChanged(int))));
+            topLayout->addWidget(_readPreferenceBox, 0, Qt::AlignRight);
+        }
+
         setLayout(topLayout);
     }
 
@@ -4,6 +4,7 @@
 QT_BEGIN_NAMESPACE
 class QLabel;
 class QCompleter;
+class QComboBox;
 QT_END_NAMESPACE
 
 #include "robomongo/core/domain/MongoShellResult.h"
@@ -84,6 +85,7 @@ namespace Robomongo
         void onTextChanged();
         void onCursorPositionChanged(int line, int index);
         void onCompletionActivated(const QString&);
+        void onReadPreferenceChanged(int index);
 
     private:
         void configureQueryText();
@@ -128,16 +130,24 @@ namespace Robomongo
         Q_OBJECT
 
     public:
-        TopStatusBar(const std::string &connectionName, const std::string &serverName, const std::string &dbName);
+        TopStatusBar(const std::string &connectionName, const std::string &serverName, const std::string &dbName,
+                     bool isReplicaSet = false);
         void setCurrentDatabase(const std::string &database, bool isValid = true);
         void setCurrentServer(const std::string &address, bool isValid = true);
         void showProgress();
         void hideProgress();
 
+    Q_SIGNALS:
+        /**
+         * @brief Emitted with new ReadPreferenceMode when user changes read preference of the tab
+         */
+        void readPreferenceChanged(int mode);
+
     private:
         Indicator *_currentDatabaseLabel;
         Indicator *_currentServerLabel;
         Indicator *_currentConnectionLabel;
+        QComboBox *_readPreferenceBox;
         QColor _textColor;
     };
 }
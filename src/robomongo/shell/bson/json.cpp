@@ -31,9 +31,21 @@
 #include "robomongo/shell/db/ptimeutil.h"
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
-#include <boost/scoped_array.hpp>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <future>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ROBOMONGO_JSON_SSE2
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 #include "mongo/base/parse_number.h"
 #include "mongo/db/jsobj.h"
@@ -72,7 +84,6 @@ enum {
     PAT_RESERVE_SIZE = 4096,
     OPT_RESERVE_SIZE = 64,
     FIELD_RESERVE_SIZE = 4096,
-    STRINGVAL_RESERVE_SIZE = 4096,
     BINDATA_RESERVE_SIZE = 4096,
     BINDATATYPE_RESERVE_SIZE = 4096,
     NS_RESERVE_SIZE = 64,
@@ -86,6 +97,108 @@ static const char* LBRACE = "{", * RBRACE = "}", * LBRACKET = "[", * RBRACKET =
                    * RPAREN = ")", * COLON = ":", * COMMA = ",", * FORWARDSLASH = "/",
                    * SINGLEQUOTE = "'", * DOUBLEQUOTE = "\"";
 
+namespace {
+
+#ifdef ROBOMONGO_JSON_SSE2
+inline int lowestSetBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+/*
+ * Returns the first character in [p, end) which interrupts a run of plain characters of a
+ * literal terminated by 'quote': the quote itself, a backslash or a control character
+ * (0x00..0x1F).  Returns 'end' if there is no such character.  Scans 16 bytes at a time
+ * when SSE2 is available.
+ */
+const char* findStringSpecial(const char* p, const char* end, char quote) {
+#ifdef ROBOMONGO_JSON_SSE2
+    const __m128i quotes = _mm_set1_epi8(quote);
+    const __m128i backslashes = _mm_set1_epi8('\\');
+    const __m128i controlMax = _mm_set1_epi8(0x1F);
+    for (; end - p >= 16; p += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i special =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quotes), _mm_cmpeq_epi8(chunk, backslashes)),
+                         _mm_cmpeq_epi8(_mm_max_epu8(chunk, controlMax), controlMax));
+        const int mask = _mm_movemask_epi8(special);
+        if (mask) {
+            return p + lowestSetBit(static_cast<unsigned>(mask));
+        }
+    }
+#endif
+    for (; p < end; ++p) {
+        const unsigned char c = static_cast<unsigned char>(*p);
+        if (c == static_cast<unsigned char>(quote) || c == '\\' || c <= 0x1F) {
+            return p;
+        }
+    }
+    return end;
+}
+
+/*
+ * Returns the first structural character ({, }, [, ], ", ', /) in [p, end) or 'end'.
+ */
+const char* findStructural(const char* p, const char* end) {
+#ifdef ROBOMONGO_JSON_SSE2
+    const __m128i lbraces = _mm_set1_epi8('{'), rbraces = _mm_set1_epi8('}');
+    const __m128i lbrackets = _mm_set1_epi8('['), rbrackets = _mm_set1_epi8(']');
+    const __m128i dquotes = _mm_set1_epi8('"'), squotes = _mm_set1_epi8('\'');
+    const __m128i slashes = _mm_set1_epi8('/');
+    for (; end - p >= 16; p += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i structural = _mm_or_si128(_mm_cmpeq_epi8(chunk, lbraces), _mm_cmpeq_epi8(chunk, rbraces));
+        structural = _mm_or_si128(structural, _mm_cmpeq_epi8(chunk, lbrackets));
+        structural = _mm_or_si128(structural, _mm_cmpeq_epi8(chunk, rbrackets));
+        structural = _mm_or_si128(structural, _mm_cmpeq_epi8(chunk, dquotes));
+        structural = _mm_or_si128(structural, _mm_cmpeq_epi8(chunk, squotes));
+        structural = _mm_or_si128(structural, _mm_cmpeq_epi8(chunk, slashes));
+        const int mask = _mm_movemask_epi8(structural);
+        if (mask) {
+            return p + lowestSetBit(static_cast<unsigned>(mask));
+        }
+    }
+#endif
+    for (; p < end; ++p) {
+        switch (*p) {
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case '"':
+            case '\'':
+            case '/':
+                return p;
+        }
+    }
+    return end;
+}
+
+/*
+ * A forward slash starts a regular expression only where a value is expected,
+ * i.e. after ':', ',', '[' or '('.
+ */
+bool startsRegex(const char* begin, const char* slash) {
+    const char* p = slash;
+    while (p > begin && isspace(*reinterpret_cast<const unsigned char*>(p - 1))) {
+        --p;
+    }
+    return p > begin && strchr(":,[(", *(p - 1)) != NULL;
+}
+
+inline bool isFieldChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' ||
+        c == '$';
+}
+
+}  // namespace
+
 JParse::JParse(StringData str)
     : _buf(str.rawData()), _input(_buf), _input_end(_input + str.size()) {}
 
@@ -104,6 +217,26 @@ Status JParse::parseError(StringData msg) {
 
 Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
     MONGO_JSON_DEBUG("fieldName: " << fieldName);
+
+    // Strings and numbers are the most common values: dispatch them on the first character
+    // instead of trying every keyword below
+    const char* next = skipWhitespace(_input);
+    if (next < _input_end) {
+        if (*next == '"' || *next == '\'') {
+            std::string scratch;
+            StringData valueString;
+            Status ret = quotedString(&valueString, &scratch);
+            if (ret != Status::OK()) {
+                return ret;
+            }
+            builder.append(fieldName, valueString);
+            return Status::OK();
+        }
+        if (*next >= '0' && *next <= '9') {
+            return number(fieldName, builder);
+        }
+    }
+
     if (peekToken(LBRACE)) {
         Status ret = object(fieldName, builder);
         if (ret != Status::OK()) {
@@ -200,14 +333,6 @@ Status JParse::value(StringData fieldName, BSONObjBuilder& builder) {
         if (ret != Status::OK()) {
             return ret;
         }
-    } else if (peekToken(DOUBLEQUOTE) || peekToken(SINGLEQUOTE)) {
-        std::string valueString;
-        valueString.reserve(STRINGVAL_RESERVE_SIZE);
-        Status ret = quotedString(&valueString);
-        if (ret != Status::OK()) {
-            return ret;
-        }
-        builder.append(fieldName, valueString);
     } else if (readToken("true")) {
         builder.append(fieldName, true);
     } else if (readToken("false")) {
@@ -251,9 +376,9 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
     }
 
     // Special object
-    std::string firstField;
-    firstField.reserve(FIELD_RESERVE_SIZE);
-    Status ret = field(&firstField);
+    std::string firstFieldScratch;
+    StringData firstField;
+    Status ret = field(&firstField, &firstFieldScratch);
     if (ret != Status::OK()) {
         return ret;
     }
@@ -364,10 +489,10 @@ Status JParse::object(StringData fieldName, BSONObjBuilder& builder, bool subObj
         if (valueRet != Status::OK()) {
             return valueRet;
         }
+        std::string fieldNameScratch;
         while (readToken(COMMA)) {
-            std::string fieldName;
-            fieldName.reserve(FIELD_RESERVE_SIZE);
-            Status fieldRet = field(&fieldName);
+            StringData fieldName;
+            Status fieldRet = field(&fieldName, &fieldNameScratch);
             if (fieldRet != Status::OK()) {
                 return fieldRet;
             }
@@ -499,10 +624,12 @@ Status JParse::dateObject(StringData fieldName, BSONObjBuilder& builder) {
         }
         date = Date_t::fromMillisSinceEpoch(numberLong);
     } else {
+        std::string numberScratch;
+        const char* number = numberStart(&numberScratch);
         // SERVER-11920: We should use parseNumberFromString here, but that function requires
         // that we know ahead of time where the number ends, which is not currently the case.
-        date = Date_t::fromMillisSinceEpoch(strtoll(_input, &endptr, 10));
-        if (_input == endptr) {
+        date = Date_t::fromMillisSinceEpoch(strtoll(number, &endptr, 10));
+        if (number == endptr) {
             return parseError("Date expecting integer milliseconds");
         }
         if (errno == ERANGE) {
@@ -513,12 +640,12 @@ Status JParse::dateObject(StringData fieldName, BSONObjBuilder& builder) {
             // requires that we know ahead of time where the number ends, which is not currently
             // the case.
             date =
-                Date_t::fromMillisSinceEpoch(static_cast<long long>(strtoull(_input, &endptr, 10)));
+                Date_t::fromMillisSinceEpoch(static_cast<long long>(strtoull(number, &endptr, 10)));
             if (errno == ERANGE) {
                 return parseError("Date milliseconds overflow");
             }
         }
-        _input = endptr;
+        _input += endptr - number;
     }
     builder.appendDate(fieldName, date);
     return Status::OK();
@@ -542,18 +669,20 @@ Status JParse::timestampObject(StringData fieldName, BSONObjBuilder& builder) {
     if (readToken("-")) {
         return parseError("Negative seconds in \"$timestamp\"");
     }
+    std::string numberScratch;
+    const char* number = numberStart(&numberScratch);
     errno = 0;
     char* endptr;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
     // we know ahead of time where the number ends, which is not currently the case.
-    uint32_t seconds = strtoul(_input, &endptr, 10);
+    uint32_t seconds = strtoul(number, &endptr, 10);
     if (errno == ERANGE) {
         return parseError("Timestamp seconds overflow");
     }
-    if (_input == endptr) {
+    if (number == endptr) {
         return parseError("Expecting unsigned integer seconds in \"$timestamp\"");
     }
-    _input = endptr;
+    _input += endptr - number;
     if (!readToken(COMMA)) {
         return parseError("Expecting ','");
     }
@@ -567,17 +696,18 @@ Status JParse::timestampObject(StringData fieldName, BSONObjBuilder& builder) {
     if (readToken("-")) {
         return parseError("Negative increment in \"$timestamp\"");
     }
+    number = numberStart(&numberScratch);
     errno = 0;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
     // we know ahead of time where the number ends, which is not currently the case.
-    uint32_t count = strtoul(_input, &endptr, 10);
+    uint32_t count = strtoul(number, &endptr, 10);
     if (errno == ERANGE) {
         return parseError("Timestamp increment overflow");
     }
-    if (_input == endptr) {
+    if (number == endptr) {
         return parseError("Expecting unsigned integer increment in \"$timestamp\"");
     }
-    _input = endptr;
+    _input += endptr - number;
 
     if (!readToken(RBRACE)) {
         return parseError("Expecting '}'");
@@ -791,12 +921,14 @@ Status JParse::date(StringData fieldName, BSONObjBuilder& builder) {
     if (!readToken(LPAREN)) {
         return parseError("Expecting '('");
     }
+    std::string numberScratch;
+    const char* number = numberStart(&numberScratch);
     errno = 0;
     char* endptr;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
     // we know ahead of time where the number ends, which is not currently the case.
-    Date_t date = Date_t::fromMillisSinceEpoch(strtoll(_input, &endptr, 10));
-    if (_input == endptr) {
+    Date_t date = Date_t::fromMillisSinceEpoch(strtoll(number, &endptr, 10));
+    if (number == endptr) {
         return parseError("Date expecting integer milliseconds");
     }
     if (errno == ERANGE) {
@@ -805,12 +937,12 @@ Status JParse::date(StringData fieldName, BSONObjBuilder& builder) {
         errno = 0;
         // SERVER-11920: We should use parseNumberFromString here, but that function requires
         // that we know ahead of time where the number ends, which is not currently the case.
-        date = Date_t::fromMillisSinceEpoch(static_cast<long long>(strtoull(_input, &endptr, 10)));
+        date = Date_t::fromMillisSinceEpoch(static_cast<long long>(strtoull(number, &endptr, 10)));
         if (errno == ERANGE) {
             return parseError("Date milliseconds overflow");
         }
     }
-    _input = endptr;
+    _input += endptr - number;
     if (!readToken(RPAREN)) {
         return parseError("Expecting ')'");
     }
@@ -824,8 +956,9 @@ Status JParse::date(StringData fieldName, BSONObjBuilder& builder) {
             return parseError("Expecting '('");
         }
 
-        std::string datestr;
-        Status ret = quotedString(&datestr);
+        StringData datestr;
+        std::string scratch;
+        Status ret = quotedString(&datestr, &scratch);
         if (ret != Status::OK()) {
             return ret;
         }
@@ -837,15 +970,19 @@ Status JParse::date(StringData fieldName, BSONObjBuilder& builder) {
         //    return parseError("Invalid date format");
         // }
 
-        bool isSuccessfull = false;
-        boost::posix_time::ptime isotime = miutil::ptimeFromIsoString(datestr, isSuccessfull);
-        if (!isSuccessfull) {
-            return parseError("Invalid date format");
-        }
+        long long millis = 0;
+        if (!miutil::millisFromIsoString(datestr.rawData(), datestr.size(), millis)) {
+            // Keywords ("now", "epoch", ...), RFC 1123 and other rare forms
+            bool isSuccessfull = false;
+            boost::posix_time::ptime isotime = miutil::ptimeFromIsoString(datestr.toString(), isSuccessfull);
+            if (!isSuccessfull) {
+                return parseError("Invalid date format");
+            }
 
-        boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
-        boost::posix_time::time_duration diff = isotime - epoch;
-        int64_t millis = diff.total_milliseconds();
+            boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+            boost::posix_time::time_duration diff = isotime - epoch;
+            millis = diff.total_milliseconds();
+        }
         Date_t datet = Date_t::fromMillisSinceEpoch(millis);
 
         if (!readToken(RPAREN)) {
@@ -892,23 +1029,17 @@ Status JParse::date(StringData fieldName, BSONObjBuilder& builder) {
             return ret;
         }
 
-        std::string hex = ::Robomongo::HexUtils::uuidToHex(datastr, uuidEncoding);
-
-        if (hex.empty() || !::Robomongo::HexUtils::isHexString(hex)) {
+        char data[::Robomongo::HexUtils::uuidSize];
+        if (!::Robomongo::HexUtils::parseUuidBytes(datastr, uuidEncoding, data)) {
             return parseError("Invalid hex string for UUID");
         }
 
-        int len;
-        boost::scoped_array<const char> data(::Robomongo::HexUtils::fromHex(hex, &len));
-        if (data == NULL)
-            return parseError("Invalid UUID");
-
         if (!readToken(RPAREN))
             return parseError("Expecting ')'");
 
-        builder.appendBinData(fieldName, len,
+        builder.appendBinData(fieldName, sizeof(data),
                 binType,
-                data.get());
+                data);
 
         return Status::OK();
     }
@@ -921,35 +1052,38 @@ Status JParse::timestamp(StringData fieldName, BSONObjBuilder& builder) {
     if (readToken("-")) {
         return parseError("Negative seconds in \"$timestamp\"");
     }
+    std::string numberScratch;
+    const char* number = numberStart(&numberScratch);
     errno = 0;
     char* endptr;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
     // we know ahead of time where the number ends, which is not currently the case.
-    uint32_t seconds = strtoul(_input, &endptr, 10);
+    uint32_t seconds = strtoul(number, &endptr, 10);
     if (errno == ERANGE) {
         return parseError("Timestamp seconds overflow");
     }
-    if (_input == endptr) {
+    if (number == endptr) {
         return parseError("Expecting unsigned integer seconds in \"$timestamp\"");
     }
-    _input = endptr;
+    _input += endptr - number;
     if (!readToken(COMMA)) {
         return parseError("Expecting ','");
     }
     if (readToken("-")) {
         return parseError("Negative seconds in \"$timestamp\"");
     }
+    number = numberStart(&numberScratch);
     errno = 0;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
     // we know ahead of time where the number ends, which is not currently the case.
-    uint32_t count = strtoul(_input, &endptr, 10);
+    uint32_t count = strtoul(number, &endptr, 10);
     if (errno == ERANGE) {
         return parseError("Timestamp increment overflow");
     }
-    if (_input == endptr) {
+    if (number == endptr) {
         return parseError("Expecting unsigned integer increment in \"$timestamp\"");
     }
-    _input = endptr;
+    _input += endptr - number;
     if (!readToken(RPAREN)) {
         return parseError("Expecting ')'");
     }
@@ -984,18 +1118,20 @@ Status JParse::numberLong(StringData fieldName, BSONObjBuilder& builder) {
     if (!readToken(LPAREN)) {
         return parseError("Expecting '('");
     }
+    std::string numberScratch;
+    const char* number = numberStart(&numberScratch);
     errno = 0;
     char* endptr;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
     // we know ahead of time where the number ends, which is not currently the case.
-    int64_t val = strtoll(_input, &endptr, 10);
+    int64_t val = strtoll(number, &endptr, 10);
     if (errno == ERANGE) {
         return parseError("NumberLong out of range");
     }
-    if (_input == endptr) {
+    if (number == endptr) {
         return parseError("Expecting number in NumberLong");
     }
-    _input = endptr;
+    _input += endptr - number;
     if (!readToken(RPAREN)) {
         return parseError("Expecting ')'");
     }
@@ -1026,18 +1162,20 @@ Status JParse::numberInt(StringData fieldName, BSONObjBuilder& builder) {
     if (!readToken(LPAREN)) {
         return parseError("Expecting '('");
     }
+    std::string numberScratch;
+    const char* number = numberStart(&numberScratch);
     errno = 0;
     char* endptr;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
     // we know ahead of time where the number ends, which is not currently the case.
-    int32_t val = strtol(_input, &endptr, 10);
+    int32_t val = strtol(number, &endptr, 10);
     if (errno == ERANGE) {
         return parseError("NumberInt out of range");
     }
-    if (_input == endptr) {
+    if (number == endptr) {
         return parseError("Expecting unsigned number in NumberInt");
     }
-    _input = endptr;
+    _input += endptr - number;
     if (!readToken(RPAREN)) {
         return parseError("Expecting ')'");
     }
@@ -1140,13 +1278,15 @@ Status JParse::number(StringData fieldName, BSONObjBuilder& builder) {
     long long retll;
     double retd;
 
+    std::string numberScratch;
+    const char* number = numberStart(&numberScratch);
     // reset errno to make sure that we are getting it from strtod
     errno = 0;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
     // we know ahead of time where the number ends, which is not currently the case.
-    retd = strtod(_input, &endptrd);
+    retd = strtod(number, &endptrd);
     // if pointer does not move, we found no digits
-    if (_input == endptrd) {
+    if (number == endptrd) {
         return parseError("Bad characters in value");
     }
     if (errno == ERANGE) {
@@ -1156,7 +1296,7 @@ Status JParse::number(StringData fieldName, BSONObjBuilder& builder) {
     errno = 0;
     // SERVER-11920: We should use parseNumberFromString here, but that function requires that
     // we know ahead of time where the number ends, which is not currently the case.
-    retll = strtoll(_input, &endptrll, 10);
+    retll = strtoll(number, &endptrll, 10);
     if (endptrll < endptrd || errno == ERANGE) {
         // The number either had characters only meaningful for a double or
         // could not fit in a 64 bit int
@@ -1171,7 +1311,7 @@ Status JParse::number(StringData fieldName, BSONObjBuilder& builder) {
         MONGO_JSON_DEBUG("Type: 64 bit int");
         builder.append(fieldName, retll);
     }
-    _input = endptrd;
+    _input += endptrd - number;
     if (_input >= _input_end) {
         return parseError("Trailing number at end of input");
     }
@@ -1202,6 +1342,55 @@ Status JParse::field(std::string* result) {
     }
 }
 
+Status JParse::field(StringData* result, std::string* scratch) {
+    MONGO_JSON_DEBUG("");
+    const char* p = skipWhitespace(_input);
+    if (p < _input_end && (*p == '"' || *p == '\'')) {
+        return quotedString(result, scratch);
+    }
+
+    // Unquoted key, always a view into the input
+    _input = p;
+    if (_input >= _input_end) {
+        return parseError("Field name expected");
+    }
+    if (!match(*_input, ALPHA "_$")) {
+        return parseError("First character in field must be [A-Za-z$_]");
+    }
+    const char* q = _input;
+    while (q < _input_end && isFieldChar(*q)) {
+        ++q;
+    }
+    if (q >= _input_end) {
+        return parseError("Unexpected end of input");
+    }
+    *result = StringData(_input, q - _input);
+    _input = q;
+    return Status::OK();
+}
+
+Status JParse::quotedString(StringData* result, std::string* scratch) {
+    MONGO_JSON_DEBUG("");
+    const char* p = skipWhitespace(_input);
+    if (p < _input_end && (*p == '"' || *p == '\'')) {
+        const char* q = findStringSpecial(p + 1, _input_end, *p);
+        if (q < _input_end && *q == *p) {
+            // No escape sequences: the string is used straight from the input
+            *result = StringData(p + 1, q - p - 1);
+            _input = q + 1;
+            return Status::OK();
+        }
+    }
+
+    scratch->clear();
+    Status ret = quotedString(scratch);
+    if (ret != Status::OK()) {
+        return ret;
+    }
+    *result = StringData(*scratch);
+    return Status::OK();
+}
+
 Status JParse::quotedString(std::string* result) {
     MONGO_JSON_DEBUG("");
     if (readToken(DOUBLEQUOTE)) {
@@ -1235,8 +1424,22 @@ Status JParse::chars(std::string* result, const char* terminalSet, const char* a
     if (_input >= _input_end) {
         return parseError("Unexpected end of input");
     }
+    // Quoted strings and regular expressions have a single terminal character and no allowed
+    // set, their runs of plain characters are located by vectorised scan and copied at once
+    const bool copyRuns = allowedSet == NULL && terminalSet[0] != '\0' && terminalSet[1] == '\0';
     const char* q = _input;
-    while (q < _input_end && !match(*q, terminalSet)) {
+    while (q < _input_end) {
+        if (copyRuns) {
+            const char* special = findStringSpecial(q, _input_end, terminalSet[0]);
+            result->append(q, special - q);
+            q = special;
+            if (q >= _input_end) {
+                break;
+            }
+        }
+        if (match(*q, terminalSet)) {
+            break;
+        }
         MONGO_JSON_DEBUG("q: " << q);
         if (allowedSet != NULL) {
             if (!match(*q, allowedSet)) {
@@ -1345,6 +1548,32 @@ std::string JParse::encodeUTF8(unsigned char first, unsigned char second) const
     return oss.str();
 }
 
+inline const char* JParse::skipWhitespace(const char* p) const {
+    // 'isspace()' takes an 'int' (signed), so (default signed) 'char's get sign-extended
+    while (p < _input_end && isspace(*reinterpret_cast<const unsigned char*>(p))) {
+        ++p;
+    }
+    return p;
+}
+
+const char* JParse::numberStart(std::string* scratch) const {
+    // strtod() and friends only stop at a character which cannot continue a number, leading
+    // whitespace, sign, digits, '.', exponent, hex, "inf" and "nan(...)" included
+    const char* p = _input;
+    while (p < _input_end && (isalnum(*reinterpret_cast<const unsigned char*>(p)) ||
+                              isspace(*reinterpret_cast<const unsigned char*>(p)) ||
+                              strchr("+-.()_", *p))) {
+        ++p;
+    }
+    if (p < _input_end) {
+        return _input;
+    }
+
+    // Number runs up to the bound, parse a null terminated copy instead of what follows
+    scratch->assign(_input, _input_end - _input);
+    return scratch->c_str();
+}
+
 inline bool JParse::peekToken(const char* token) {
     return readTokenImpl(token, false);
 }
@@ -1381,9 +1610,9 @@ bool JParse::readTokenImpl(const char* token, bool advance) {
 
 bool JParse::readField(StringData expectedField) {
     MONGO_JSON_DEBUG("expectedField: " << expectedField);
-    std::string nextField;
-    nextField.reserve(FIELD_RESERVE_SIZE);
-    Status ret = field(&nextField);
+    std::string scratch;
+    StringData nextField;
+    Status ret = field(&nextField, &scratch);
     if (ret != Status::OK()) {
         return false;
     }
@@ -1430,13 +1659,17 @@ bool JParse::isArray() {
 }
 
 BSONObj fromjson(const char* jsonString, int* len) {
-    MONGO_JSON_DEBUG("jsonString: " << jsonString);
-    if (jsonString[0] == '\0') {
+    return fromjson(jsonString, strlen(jsonString), len);
+}
+
+BSONObj fromjson(const char* jsonString, size_t length, int* len) {
+    MONGO_JSON_DEBUG("jsonString: " << StringData(jsonString, length));
+    if (length == 0) {
         if (len)
             *len = 0;
         return BSONObj();
     }
-    JParse jparse(jsonString);
+    JParse jparse(StringData(jsonString, length));
     BSONObjBuilder builder;
     Status ret = Status::OK();
     try {
@@ -1462,7 +1695,228 @@ BSONObj fromjson(const char* jsonString, int* len) {
 }
 
 BSONObj fromjson(const std::string& str) {
-    return fromjson(str.c_str());
+    return fromjson(str.c_str(), str.size());
+}
+
+namespace {
+
+/*
+ * Splits [p, end) into slices which end where nesting returns to the level of 'p'.  'begin' is
+ * the start of the whole input, for the regular expression look-behind.  Returns the end of the
+ * last slice: the rest is unbalanced or unterminated.
+ */
+const char* splitTopLevel(const char* begin, const char* p, const char* end,
+                          std::vector<StringData>* slices) {
+    const char* start = p;
+    int depth = 0;
+
+    while ((p = findStructural(p, end)) < end) {
+        const char c = *p;
+        if (c == '{' || c == '[') {
+            ++depth;
+            ++p;
+            continue;
+        }
+
+        if (c == '}' || c == ']') {
+            if (--depth < 0) {
+                break;  // Unbalanced, the rest is left to the parser
+            }
+            ++p;
+            if (depth == 0) {
+                slices->push_back(StringData(start, p - start));
+                start = p;
+            }
+            continue;
+        }
+
+        if (c == '/' && !startsRegex(begin, p)) {
+            ++p;
+            continue;
+        }
+
+        // String or regular expression literal: skip to its unescaped terminator
+        const char* q = p + 1;
+        while ((q = findStringSpecial(q, end, c)) < end && *q != c) {
+            q += (*q == '\\') ? 2 : 1;
+        }
+        if (q >= end) {
+            break;  // Unterminated, the rest is left to the parser
+        }
+        p = q + 1;
+    }
+    return start;
+}
+
+/*
+ * Elements of top level array 'slice' ("[{a: 1}, {b: 2}]" with leading whitespace) without
+ * separators, if all of them are documents or arrays.  Empty otherwise: the array is parsed as
+ * a whole.
+ */
+std::vector<StringData> splitJsonArray(StringData slice) {
+    const char* const begin = slice.rawData();
+    const char* const end = begin + slice.size();
+    const char* p = begin;
+    while (p < end && isspace(*reinterpret_cast<const unsigned char*>(p))) {
+        ++p;
+    }
+    if (p == end || *p != '[') {
+        return std::vector<StringData>();
+    }
+
+    std::vector<StringData> elements;
+    const char* rest = splitTopLevel(begin, p + 1, end, &elements);
+    while (rest < end && isspace(*reinterpret_cast<const unsigned char*>(rest))) {
+        ++rest;
+    }
+    if (rest == end || *rest != ']') {
+        return std::vector<StringData>();
+    }
+    ++rest;
+    while (rest < end && isspace(*reinterpret_cast<const unsigned char*>(rest))) {
+        ++rest;
+    }
+    if (rest != end) {
+        return std::vector<StringData>();
+    }
+
+    for (size_t i = 0; i < elements.size(); ++i) {
+        const char* q = elements[i].rawData();
+        const char* const elementEnd = q + elements[i].size();
+        while (q < elementEnd && isspace(*reinterpret_cast<const unsigned char*>(q))) {
+            ++q;
+        }
+        if (i > 0) {
+            if (q == elementEnd || *q != ',') {
+                return std::vector<StringData>();
+            }
+            ++q;
+            while (q < elementEnd && isspace(*reinterpret_cast<const unsigned char*>(q))) {
+                ++q;
+            }
+        }
+        if (q == elementEnd || (*q != '{' && *q != '[')) {
+            return std::vector<StringData>();
+        }
+        elements[i] = StringData(q, elementEnd - q);
+    }
+    return elements;
+}
+
+/*
+ * Parses every slice within its own bounds, on all cores for large inputs.  Returns the number
+ * of leading slices which were parsed completely, the rest of 'parsed' is unspecified.
+ */
+size_t parseSlices(const std::vector<StringData>& slices, std::vector<BSONObj>* parsed) {
+    const size_t MinSlicesPerThread = 256;
+    const size_t threads = std::max<size_t>(
+        1, std::min<size_t>(std::thread::hardware_concurrency(), slices.size() / MinSlicesPerThread));
+    const size_t perThread = (slices.size() + threads - 1) / threads;
+    std::vector<size_t> failed(threads, slices.size());
+
+    auto parseRange = [&slices, parsed, &failed, perThread](size_t thread) {
+        const size_t end = std::min(slices.size(), (thread + 1) * perThread);
+        for (size_t i = thread * perThread; i < end; ++i) {
+            int len = 0;
+            try {
+                (*parsed)[i] = fromjson(slices[i].rawData(), slices[i].size(), &len);
+            } catch (const ParseMsgAssertionException&) {
+                len = -1;
+            }
+            if (static_cast<size_t>(len) != slices[i].size()) {
+                failed[thread] = i;
+                return;
+            }
+        }
+    };
+
+    std::vector<std::future<void>> tasks;
+    for (size_t thread = 1; thread < threads; ++thread) {
+        tasks.push_back(std::async(std::launch::async, parseRange, thread));
+    }
+    parseRange(0);
+    for (auto& task : tasks) {
+        task.get();
+    }
+    return *std::min_element(failed.begin(), failed.end());
+}
+
+}  // namespace
+
+std::vector<StringData> splitJsonDocuments(StringData str, size_t* complete) {
+    std::vector<StringData> documents;
+    const char* const begin = str.rawData();
+    const char* const end = begin + str.size();
+    const char* const start = splitTopLevel(begin, begin, end, &documents);
+
+    if (complete) {
+        *complete = start - begin;
+    } else if (start < end) {
+        documents.push_back(StringData(start, end - start));
+    }
+    return documents;
+}
+
+std::vector<BSONObj> fromjsonDocuments(const std::string& str) {
+    std::vector<BSONObj> documents;
+    const char* const json = str.c_str();
+    const int jsonLength = static_cast<int>(str.size());
+    int offset = 0;
+
+    // Stage 1: structural pre-pass, elements of top level arrays are split as well
+    const std::vector<StringData> slices = splitJsonDocuments(str);
+    std::vector<StringData> parts;
+    std::vector<size_t> partsEnd(slices.size());    // parts of slice i end at partsEnd[i]
+    std::vector<bool> arrays(slices.size());
+    for (size_t i = 0; i < slices.size(); ++i) {
+        const std::vector<StringData> elements = splitJsonArray(slices[i]);
+        arrays[i] = !elements.empty();
+        if (arrays[i]) {
+            parts.insert(parts.end(), elements.begin(), elements.end());
+        } else {
+            parts.push_back(slices[i]);
+        }
+        partsEnd[i] = parts.size();
+    }
+
+    // Stage 2: every part parsed within its own bounds
+    std::vector<BSONObj> parsed(parts.size());
+    const size_t parsedCount = parseSlices(parts, &parsed);
+
+    size_t part = 0;
+    for (size_t i = 0; i < slices.size() && partsEnd[i] <= parsedCount; ++i) {
+        if (arrays[i]) {
+            // Same as parsing the array as a whole
+            BSONObjBuilder builder;
+            for (uint32_t index = 0; part < partsEnd[i]; ++part, ++index) {
+                if (parts[part][0] == '[') {
+                    builder.appendArray(builder.numStr(index), parsed[part]);
+                } else {
+                    builder.append(builder.numStr(index), parsed[part]);
+                }
+            }
+            documents.push_back(builder.obj());
+        } else {
+            documents.push_back(parsed[part++]);
+        }
+        offset += static_cast<int>(slices[i].size());
+    }
+
+    // Whatever the pre-pass could not split reliably (parse errors included) is parsed document
+    // after document, so offsets are exactly the ones of the plain parser
+    while (offset < jsonLength) {
+        int len = 0;
+        try {
+            documents.push_back(fromjson(json + offset, jsonLength - offset, &len));
+        } catch (const ParseMsgAssertionException& ex) {
+            throw ParseMsgAssertionException(ex.getCode(), ex.what(), ex.offset() + offset, ex.reason());
+        }
+        if (len == 0) {
+            break;
+        }
+        offset += len;
+    }
+    return documents;
 }
 
 std::string tojson(const BSONObj& obj, JsonStringFormat format, bool pretty) {
@@ -29,6 +29,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/base/status.h"
@@ -55,6 +56,30 @@ BSONObj fromjson(const std::string& str);
 /** @param len will be size of JSON object in text chars. */
 BSONObj fromjson(const char* str, int* len = NULL);
 
+/**
+ * Same as above, but parses at most 'length' chars of 'str', which does not need to be null
+ * terminated: nothing after the range is read.
+ */
+BSONObj fromjson(const char* str, size_t length, int* len = NULL);
+
+/**
+ * Structural pre-pass over concatenated JSON documents ("{a: 1} {b: 2}"): vectorised scan for
+ * braces, brackets and literals, returns the text of every top level document (with leading
+ * whitespace).  Unbalanced or unterminated rest of the input is returned as the last slice,
+ * unless 'complete' is given: then the rest is left out and 'complete' is set to its offset
+ * (used to split input which is read in windows).
+ */
+std::vector<StringData> splitJsonDocuments(StringData str, size_t* complete = NULL);
+
+/**
+ * Parses concatenated JSON documents in two stages: splitJsonDocuments() and then fromjson()
+ * of every slice, on all cores for large inputs.  Elements of a top level array of documents
+ * ("[{a: 1}, {b: 2}]", i.e. mongoexport --jsonArray) are split and parsed on their own as well.
+ *
+ * @throws ParseMsgAssertionException with offset relative to the beginning of 'str'.
+ */
+std::vector<BSONObj> fromjsonDocuments(const std::string& str);
+
 /**
  * Tests whether the JSON string is an Array.
  *
@@ -391,6 +416,13 @@ private:
      */
     Status field(std::string* result);
 
+    /**
+     * Same as field(std::string*) without copying: unquoted names and quoted names without
+     * escape sequences are returned as a view into the input buffer, others are decoded into
+     * 'scratch' which must outlive 'result'.
+     */
+    Status field(StringData* result, std::string* scratch);
+
     /*
      * std::string :
      *     " "
@@ -400,6 +432,11 @@ private:
      */
     Status quotedString(std::string* result);
 
+    /**
+     * Same as quotedString(std::string*) with the same view rules as field(StringData*, ...)
+     */
+    Status quotedString(StringData* result, std::string* scratch);
+
     /*
      * CHARS :
      *     CHAR
@@ -452,6 +489,19 @@ private:
      */
     inline bool peekToken(const char* token);
 
+    /**
+     * @return first non whitespace character at or after p, or _input_end
+     */
+    inline const char* skipWhitespace(const char* p) const;
+
+    /**
+     * @return text of the number at _input for strtod, strtoll and strtol: _input itself, or
+     * a null terminated copy in 'scratch' if the number may run up to _input_end, so that they
+     * never read past the end of a bounded input.  Their end pointer 'e' corresponds to
+     * _input + (e - returned pointer).
+     */
+    const char* numberStart(std::string* scratch) const;
+
     /**
      * @return true if the given token matches the next non whitespace
      * sequence in our buffer, and false if the token doesn't match or
@@ -508,11 +558,11 @@ private:
      * _input - cursor we advance in our input buffer
      * _input_end - sentinel for the end of our input buffer
      *
-     * _buf is the null terminated buffer containing the JSON std::string we
-     * are parsing.  _input_end points to the null byte at the end of
-     * the buffer.  strtoll, strtol, and strtod will access the null
-     * byte at the end of the buffer because they are assuming a c-style
-     * string.
+     * _buf is the buffer containing the JSON std::string we are parsing,
+     * _input_end points past its last character.  The buffer does not need
+     * to be null terminated: strtoll, strtol, and strtod, which assume a
+     * c-style string, are given a null terminated copy by numberStart()
+     * when a number runs up to _input_end.
      */
     const char* const _buf;
     const char* _input;
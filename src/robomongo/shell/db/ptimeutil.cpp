@@ -50,6 +50,53 @@ namespace
         }
         return atoi( buf );
     }
+
+    // Exactly 'count' digits, -1 if any of them is not a digit
+    inline int getDigits( const char *p, int count )
+    {
+        int value = 0;
+        for( int i = 0; i < count; ++i ) {
+            unsigned const digit = static_cast<unsigned char>( p[i] ) - '0';
+            if( digit > 9 )
+                return -1;
+            value = value * 10 + static_cast<int>( digit );
+        }
+        return value;
+    }
+
+    int daysInMonth( int year, int month )
+    {
+        static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        if( month == 2 && year % 4 == 0 && ( year % 100 != 0 || year % 400 == 0 ) )
+            return 29;
+        return days[month - 1];
+    }
+
+    // Days since 1970-01-01 of proleptic Gregorian date (H. Hinnant's days_from_civil)
+    long long daysFromCivil( int year, int month, int day )
+    {
+        year -= month <= 2;
+        int const era = ( year >= 0 ? year : year - 399 ) / 400;
+        int const yearOfEra = year - era * 400;
+        int const dayOfYear = ( 153 * ( month > 2 ? month - 3 : month + 9 ) + 2 ) / 5 + day - 1;
+        int const dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097LL + dayOfEra - 719468;
+    }
+
+    boost::posix_time::ptime ptimeFromMillis( long long millis )
+    {
+        const long long msPerDay = 86400000;
+        long long days = millis / msPerDay;
+        long long msOfDay = millis % msPerDay;
+        if( msOfDay < 0 ) {
+            msOfDay += msPerDay;
+            --days;
+        }
+
+        // Both fit into 'long', which is 32 bit on Windows
+        return boost::posix_time::ptime( boost::gregorian::date( 1970, 1, 1 ) + boost::gregorian::days( static_cast<long>( days ) ),
+            boost::posix_time::milliseconds( static_cast<long>( msOfDay ) ) );
+    }
 }
 namespace miutil 
 {
@@ -249,8 +296,98 @@ namespace miutil
         return ptimeFromIsoString(isoTime, isSuccessfull);
     }
 
+    bool millisFromIsoString( const char *isoTime, size_t length, long long &millis)
+    {
+        const char *p = isoTime;
+        const char *const end = isoTime + length;
+
+        // YYYY-MM-DDThh:mm:ss
+        if( length < 19 || p[4] != '-' || p[7] != '-' || ( p[10] != 'T' && p[10] != ' ' ) ||
+            p[13] != ':' || p[16] != ':' )
+            return false;
+
+        int const year = getDigits( p, 4 );
+        int const month = getDigits( p + 5, 2 );
+        int const day = getDigits( p + 8, 2 );
+        int const hour = getDigits( p + 11, 2 );
+        int const minute = getDigits( p + 14, 2 );
+        int const second = getDigits( p + 17, 2 );
+
+        if( ( year | month | day | hour | minute | second ) < 0 )
+            return false;
+
+        if( year < 1400 || month < 1 || month > 12 || day < 1 || day > daysInMonth( year, month ) )
+            return false;
+
+        p += 19;
+
+        // Fraction, digits after milliseconds are ignored
+        int msecond = 0;
+        if( p < end && *p == '.' ) {
+            const char *const fraction = ++p;
+            while( p < end && static_cast<unsigned>( *p - '0' ) <= 9 ) {
+                if( p - fraction < 3 )
+                    msecond = msecond * 10 + ( *p - '0' );
+                ++p;
+            }
+            if( p == fraction )
+                return false;
+            for( ptrdiff_t n = p - fraction; n < 3; ++n )
+                msecond *= 10;
+        }
+
+        // Z or SHH[[:]MM]
+        int offsetMinutes = 0;
+        if( p < end && *p == 'Z' ) {
+            ++p;
+        }
+        else if( p < end && ( *p == '+' || *p == '-' ) ) {
+            int const sign = *p == '-' ? -1 : 1;
+            ++p;
+
+            int const hourOffset = end - p >= 2 ? getDigits( p, 2 ) : -1;
+            if( hourOffset < 0 )
+                return false;
+            p += 2;
+
+            int minuteOffset = 0;
+            if( p < end ) {
+                if( *p == ':' )
+                    ++p;
+                minuteOffset = end - p >= 2 ? getDigits( p, 2 ) : -1;
+                if( minuteOffset < 0 )
+                    return false;
+                p += 2;
+            }
+
+            offsetMinutes = sign * ( hourOffset * 60 + minuteOffset );
+        }
+
+        if( p != end )
+            return false;
+
+        long long const seconds = daysFromCivil( year, month, day ) * 86400 +
+            hour * 3600 + ( minute - offsetMinutes ) * 60 + second;
+        long long const result = seconds * 1000 + msecond;
+
+        // Offset and time of day may move the date out of boost::gregorian range
+        static const long long minMillis = daysFromCivil( 1400, 1, 1 ) * 86400000;
+        static const long long maxMillis = daysFromCivil( 10000, 1, 1 ) * 86400000;
+        if( result < minMillis || result >= maxMillis )
+            return false;
+
+        millis = result;
+        return true;
+    }
+
     boost::posix_time::ptime ptimeFromIsoString( const std::string &isoTime, bool &isSuccessfull)
     {
+        long long millis = 0;
+        if( millisFromIsoString( isoTime.data(), isoTime.size(), millis ) ) {
+            isSuccessfull = true;
+            return ptimeFromMillis( millis );
+        }
+
         struct DEF {
             int number;
             unsigned char numberOfChars;
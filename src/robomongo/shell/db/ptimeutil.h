@@ -121,6 +121,28 @@ namespace miutil {
     */
    boost::posix_time::ptime ptimeFromIsoString( const std::string &isoTime);
    boost::posix_time::ptime ptimeFromIsoString( const std::string &isoTime, bool &isSuccessfull);
+
+   /**
+    * millisFromIsoString decodes the canonical ISO-8601 forms without
+    * allocations and without going through boost::posix_time:
+    *
+    * - YYYY-MM-DDThh:mm:ss[.fff][Z]
+    * - YYYY-MM-DDThh:mm:ss[.fff]SHH[[:]MM]
+    *
+    * T may be a space. The fraction may have any number of digits, digits
+    * after milliseconds are ignored. Years 1400..9999 and existing days of
+    * month are accepted (as by boost::gregorian::date), time components are
+    * not limited, i.e. "24:00:00" is the start of the next day.
+    *
+    * It is tried first by ptimeFromIsoString, which handles everything else
+    * (keywords, RFC 1123 dates, legacy variations) the way it always did.
+    *
+    * @param isoTime A timestring, not necessarily null-terminated.
+    * @param length Length of the timestring.
+    * @param millis Milliseconds since the epoch (UTC) on success.
+    * @return false if the string is not in one of the forms above.
+    */
+   bool millisFromIsoString( const char *isoTime, size_t length, long long &millis);
    
 }
 #endif 